@@ -20,6 +20,7 @@
 #include "util/progress.h"
 #include "util/string.h"
 #include "util/time.h"
+#include "util/time_trace.h"
 #include "util/transform.h"
 #include "util/unique_ptr.h"
 #include "util/version.h"
@@ -49,6 +50,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string trace_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -101,6 +103,12 @@ static void scene_init()
 {
   options.scene = options.session->scene;
 
+  if (!options.trace_filepath.empty()) {
+    options.scene->enable_time_trace();
+  }
+
+  scoped_time_trace trace(options.scene->time_trace, "app", "Read Scene");
+
   /* Read XML or USD */
 #ifdef WITH_USD
   if (!string_endswith(string_to_lower(options.filepath), ".xml")) {
@@ -166,6 +174,16 @@ static void session_init()
 static void session_exit()
 {
   if (options.session) {
+    TimeTrace *time_trace = options.session->scene->time_trace;
+    if (time_trace) {
+      if (!options.quiet) {
+        printf("\nScene update trace:\n%s", time_trace->full_report().c_str());
+      }
+      if (!time_trace->write_chrome_trace(options.trace_filepath)) {
+        fprintf(stderr, "Failed to write trace to %s\n", options.trace_filepath.c_str());
+      }
+    }
+
     delete options.session;
     options.session = NULL;
   }
@@ -432,6 +450,9 @@ static void options_parse(int argc, const char **argv)
              "--profile",
              &profile,
              "Enable profile logging",
+             "--trace %s",
+             &options.trace_filepath,
+             "Write a Chrome trace of scene loading and update times to the file",
 #ifdef WITH_CYCLES_LOGGING
              "--debug",
              &debug,
@@ -431,6 +431,15 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Perform denoising on GPU devices configured in the system tab in the user preferences. This is significantly faster than on CPU, but requires additional GPU memory. When large scenes need more GPU memory, this option can be disabled",
         default=False,
     )
+    denoising_max_memory: IntProperty(
+        name="Denoising Memory Limit",
+        description="Maximum amount of memory in megabytes used for denoising on the CPU. "
+        "Larger images are denoised in overlapping tiles. "
+        "Zero disables the limit",
+        min=0,
+        soft_max=65536,
+        default=0,
+    )
 
     use_preview_denoising: BoolProperty(
         name="Use Viewport Denoising",
@@ -350,6 +350,10 @@ class CYCLES_RENDER_PT_sampling_render_denoise(CyclesButtonsPanel, Panel):
             row.active = has_oidn_gpu_devices(context)
             row.prop(cscene, "denoising_use_gpu", text="Use GPU")
 
+            sub = col.column()
+            sub.active = not (cscene.denoising_use_gpu and has_oidn_gpu_devices(context))
+            sub.prop(cscene, "denoising_max_memory", text="Memory Limit")
+
 
 class CYCLES_RENDER_PT_sampling_path_guiding(CyclesButtonsPanel, Panel):
     bl_label = "Path Guiding"
@@ -14,6 +14,7 @@
 
 #include "util/foreach.h"
 #include "util/task.h"
+#include "util/time_trace.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -157,6 +158,8 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
 
     progress.set_sync_status("Synchronizing object", b_ob_info.real_object.name());
 
+    scoped_time_trace trace(scene->time_trace, "sync", b_ob_info.real_object.name());
+
     if (geom_type == Geometry::HAIR) {
       Hair *hair = static_cast<Hair *>(geom);
       sync_hair(b_depsgraph, b_ob_info, hair);
@@ -29,6 +29,7 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/time.h"
+#include "util/time_trace.h"
 
 #include "blender/display_driver.h"
 #include "blender/output_driver.h"
@@ -41,6 +42,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+string BlenderSession::trace_filepath;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -367,6 +369,10 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     draw_state_.last_pass_index = -1;
   }
 
+  if (!b_engine.is_preview() && background && !trace_filepath.empty()) {
+    scene->enable_time_trace();
+  }
+
   /* Compute render passes and film settings. */
   sync->sync_render_passes(b_rlay, b_view_layer);
 
@@ -469,6 +475,15 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
   /* free result without merging */
   b_engine.end_result(b_rr, true, false, false);
 
+  if (scene->time_trace) {
+    if (print_render_stats) {
+      printf("Scene update trace:\n%s\n", scene->time_trace->full_report().c_str());
+    }
+    if (!scene->time_trace->write_chrome_trace(trace_filepath)) {
+      fprintf(stderr, "Failed to write Cycles trace to %s\n", trace_filepath.c_str());
+    }
+  }
+
   /* When tiled rendering is used there will be no "write" done for the tile. Forcefully clear
    * highlighted tiles now, so that the highlight will be removed while processing full frame from
    * file. */
@@ -120,6 +120,10 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* When not empty, a Chrome trace of the scene synchronization and update is written to this
+   * file after rendering. */
+  static string trace_filepath;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
@@ -30,6 +30,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/openimagedenoise.h"
+#include "util/time_trace.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -266,6 +267,10 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   }
 
   scoped_timer timer;
+  scoped_time_trace trace(scene->time_trace, "sync", "sync_data");
+
+  /* Procedurals may still be reading data for this frame, finish before modifying the scene. */
+  scene->procedural_manager->wait_for_background_tasks(scene);
 
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
 
@@ -276,17 +281,27 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_view_layer(b_view_layer);
   sync_integrator(b_view_layer, background, denoise_device_info);
   sync_film(b_view_layer, b_v3d);
-  sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
-  sync_images();
+  {
+    scoped_time_trace stage_trace(scene->time_trace, "sync", "Shaders");
+    sync_shaders(b_depsgraph, b_v3d, auto_refresh_update);
+  }
+  {
+    scoped_time_trace stage_trace(scene->time_trace, "sync", "Images");
+    sync_images();
+  }
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == MOTION_POSITION_CENTER)
   {
+    scoped_time_trace stage_trace(scene->time_trace, "sync", "Objects");
     sync_objects(b_depsgraph, b_v3d);
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  {
+    scoped_time_trace stage_trace(scene->time_trace, "sync", "Motion");
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  }
 
   geometry_synced.clear();
 
@@ -1017,6 +1032,7 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
         cscene, "denoising_prefilter", DENOISER_PREFILTER_NUM, DENOISER_PREFILTER_NONE);
     denoising.quality = (DenoiserQuality)get_enum(
         cscene, "denoising_quality", DENOISER_QUALITY_NUM, DENOISER_QUALITY_HIGH);
+    denoising.max_memory_mb = get_int(cscene, "denoising_max_memory");
 
     input_passes = (DenoiserInput)get_enum(
         cscene, "denoising_input_passes", DENOISER_INPUT_NUM, DENOISER_INPUT_RGB_ALBEDO_NORMAL);
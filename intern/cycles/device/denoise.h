@@ -77,6 +77,10 @@ class DenoiseParams : public Node {
   DenoiserPrefilter prefilter = DENOISER_PREFILTER_FAST;
   DenoiserQuality quality = DENOISER_QUALITY_HIGH;
 
+  /* Maximum amount of memory in megabytes the CPU denoiser is allowed to use. When the image does
+   * not fit it is denoised in overlapping tiles. Zero means no limit. */
+  int max_memory_mb = 0;
+
   static const NodeEnum *get_type_enum();
   static const NodeEnum *get_prefilter_enum();
   static const NodeEnum *get_quality_enum();
@@ -9,6 +9,7 @@
 #include "device/device.h"
 #include "device/queue.h"
 #include "integrator/pass_accessor_cpu.h"
+#include "integrator/tile.h"
 #include "session/buffers.h"
 #include "util/array.h"
 #include "util/log.h"
@@ -37,6 +38,13 @@ OIDNDenoiser::OIDNDenoiser(Device *denoiser_device, const DenoiseParams &params)
 }
 
 #ifdef WITH_OPENIMAGEDENOISE
+/* Number of pixels every tile is extended by on each side when denoising in tiles. Needs to cover
+ * the receptive field of the denoiser network to avoid visible seams between tiles. */
+static constexpr int OIDN_TILE_OVERLAP = 128;
+
+/* Per-pixel memory of the color, albedo, normal and output buffers of a tile. */
+static constexpr size_t OIDN_TILE_BYTES_PER_PIXEL = 4 * 3 * sizeof(float);
+
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
   OIDNDenoiser *oidn_denoiser = reinterpret_cast<OIDNDenoiser *>(user_ptr);
@@ -208,7 +216,264 @@ class OIDNDenoiseContext {
     postprocess_output(oidn_color_pass, oidn_output_pass);
   }
 
+  /* Calculate size of tiles in which the image is to be denoised to stay within the memory limit.
+   * Half of the limit goes to the buffers of a tile, the other half is used by OIDN itself.
+   * Returns the image size when no tiling is needed. */
+  int2 get_tile_size() const
+  {
+    const int2 image_size = make_int2(buffer_params_.width, buffer_params_.height);
+    if (denoise_params_.max_memory_mb <= 0) {
+      return image_size;
+    }
+
+    const size_t max_memory = size_t(denoise_params_.max_memory_mb) * 1024 * 1024 / 2;
+    return tile_calculate_denoise_size(
+        image_size, OIDN_TILE_OVERLAP, OIDN_TILE_BYTES_PER_PIXEL, max_memory);
+  }
+
+  /* Denoise the pass in overlapping tiles, so that the memory used for denoising stays bounded
+   * for very large images. Pixels of a tile are read from the render buffers into temporary
+   * buffers, and only the inner part of the denoised tile is written back. */
+  void denoise_pass_tiled(const PassType pass_type, const int2 tile_size)
+  {
+    OIDNPass oidn_color_pass(buffer_params_, "color", pass_type);
+    if (oidn_color_pass.offset == PASS_UNUSED) {
+      return;
+    }
+
+    OIDNPass oidn_output_pass(buffer_params_, "output", pass_type, PassMode::DENOISED);
+    if (oidn_output_pass.offset == PASS_UNUSED) {
+      LOG(DFATAL) << "Missing denoised pass " << pass_type_as_string(pass_type);
+      return;
+    }
+
+    const int width = buffer_params_.width;
+    const int height = buffer_params_.height;
+    const int num_tiles_x = divide_up(width, tile_size.x);
+    const int num_tiles_y = divide_up(height, tile_size.y);
+
+    VLOG_WORK << "Denoising " << pass_type_as_string(pass_type) << " in " << num_tiles_x << "x"
+              << num_tiles_y << " tiles of " << tile_size.x << "x" << tile_size.y << " pixels";
+
+    /* Buffers are allocated once for the largest tile and reused. */
+    const size_t max_tile_num_pixels = size_t(min(tile_size.x + 2 * OIDN_TILE_OVERLAP, width)) *
+                                       min(tile_size.y + 2 * OIDN_TILE_OVERLAP, height);
+    array<float> color(max_tile_num_pixels * 3);
+    array<float> output(max_tile_num_pixels * 3);
+    array<float> albedo, normal;
+    if (oidn_albedo_pass_) {
+      albedo.resize(max_tile_num_pixels * 3);
+    }
+    if (oidn_normal_pass_) {
+      normal.resize(max_tile_num_pixels * 3);
+    }
+
+    /* OIDN computes auto-exposure from the image it is given, which would differ from tile to
+     * tile and cause seams. Compute it once for the entire image instead. */
+    const float input_scale = calculate_input_scale(oidn_color_pass, tile_size, color);
+
+    oidn::DeviceRef oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
+    oidn_device.set("setAffinity", false);
+    oidn_device.commit();
+
+    for (int tile_y = 0; tile_y < num_tiles_y; ++tile_y) {
+      for (int tile_x = 0; tile_x < num_tiles_x; ++tile_x) {
+        if (denoiser_->is_cancelled()) {
+          return;
+        }
+
+        const int x = tile_x * tile_size.x;
+        const int y = tile_y * tile_size.y;
+        const int4 tile = make_int4(
+            x, y, min(tile_size.x, width - x), min(tile_size.y, height - y));
+        const int region_x = max(tile.x - OIDN_TILE_OVERLAP, 0);
+        const int region_y = max(tile.y - OIDN_TILE_OVERLAP, 0);
+        const int4 region = make_int4(region_x,
+                                      region_y,
+                                      min(tile.x + tile.z + OIDN_TILE_OVERLAP, width) - region_x,
+                                      min(tile.y + tile.w + OIDN_TILE_OVERLAP, height) - region_y);
+
+        read_pass_pixels(oidn_color_pass, region, PassAccessor::Destination(color.data(), 3));
+        if (oidn_albedo_pass_) {
+          if (oidn_color_pass.use_denoising_albedo) {
+            read_pass_pixels(
+                oidn_albedo_pass_, region, PassAccessor::Destination(albedo.data(), 3));
+          }
+          else {
+            /* NOTE: OpenImageDenoise library implicitly expects albedo pass when normal pass has
+             * been provided. */
+            std::fill(albedo.begin(), albedo.begin() + size_t(region.z) * region.w * 3, 0.5f);
+          }
+        }
+        if (oidn_normal_pass_) {
+          read_pass_pixels(oidn_normal_pass_, region, PassAccessor::Destination(normal.data(), 3));
+        }
+
+        if (denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
+          if (oidn_albedo_pass_ && oidn_color_pass.use_denoising_albedo) {
+            filter_tile_buffer(oidn_device, "albedo", albedo.data(), region);
+          }
+          if (oidn_normal_pass_) {
+            filter_tile_buffer(oidn_device, "normal", normal.data(), region);
+          }
+        }
+
+        oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+        set_tile_image(oidn_filter, "color", color.data(), region);
+        if (oidn_albedo_pass_) {
+          set_tile_image(oidn_filter, "albedo", albedo.data(), region);
+        }
+        if (oidn_normal_pass_) {
+          set_tile_image(oidn_filter, "normal", normal.data(), region);
+        }
+        set_tile_image(oidn_filter, "output", output.data(), region);
+        oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
+        oidn_filter.set("hdr", true);
+        oidn_filter.set("srgb", false);
+        oidn_filter.set("inputScale", input_scale);
+        oidn_filter.set("maxMemoryMB", max(denoise_params_.max_memory_mb / 2, 1));
+        if (custom_weights.size()) {
+          oidn_filter.setData("weights", custom_weights.data(), custom_weights.size());
+        }
+        set_quality(oidn_filter);
+        if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
+            denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE)
+        {
+          oidn_filter.set("cleanAux", true);
+        }
+        oidn_filter.commit();
+        oidn_filter.execute();
+
+        const char *error_message;
+        const oidn::Error error = oidn_device.getError(error_message);
+        if (error != oidn::Error::None) {
+          if (error != oidn::Error::Cancelled) {
+            denoiser_->set_error("OpenImageDenoise error: " + string(error_message));
+          }
+          return;
+        }
+
+        write_tile_output(oidn_color_pass, oidn_output_pass, tile, region, output.data());
+      }
+    }
+  }
+
  protected:
+  void set_tile_image(oidn::FilterRef &oidn_filter,
+                      const char *name,
+                      float *pixels,
+                      const int4 region)
+  {
+    oidn_filter.setImage(name, pixels, oidn::Format::Float3, region.z, region.w, 0, 0, 0);
+  }
+
+  /* In-place prefiltering of a guiding pass tile, `name` is the input image of the pass. */
+  void filter_tile_buffer(oidn::DeviceRef &oidn_device,
+                          const char *name,
+                          float *pixels,
+                          const int4 region)
+  {
+    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    set_tile_image(oidn_filter, name, pixels, region);
+    set_tile_image(oidn_filter, "output", pixels, region);
+    set_quality(oidn_filter);
+    oidn_filter.commit();
+    oidn_filter.execute();
+  }
+
+  /* Scale of the color input which matches the auto-exposure OIDN would compute for the entire
+   * image: geometric mean of luminance of blocks of 16x16 pixels, mapped to middle gray. */
+  float calculate_input_scale(const OIDNPass &oidn_color_pass,
+                              const int2 tile_size,
+                              array<float> &color)
+  {
+    const int block_size = 16;
+    const float key = 0.18f;
+    const float eps = 1e-8f;
+
+    const int width = buffer_params_.width;
+    const int height = buffer_params_.height;
+
+    double log_sum = 0.0;
+    int64_t num_blocks = 0;
+
+    for (int y = 0; y < height; y += tile_size.y) {
+      for (int x = 0; x < width; x += tile_size.x) {
+        const int4 tile = make_int4(
+            x, y, min(tile_size.x, width - x), min(tile_size.y, height - y));
+        read_pass_pixels(oidn_color_pass, tile, PassAccessor::Destination(color.data(), 3));
+
+        for (int block_y = 0; block_y < tile.w; block_y += block_size) {
+          for (int block_x = 0; block_x < tile.z; block_x += block_size) {
+            const int block_width = min(block_size, tile.z - block_x);
+            const int block_height = min(block_size, tile.w - block_y);
+
+            float luminance_sum = 0.0f;
+            for (int i = 0; i < block_height; ++i) {
+              const float *pixel = color.data() + (size_t(block_y + i) * tile.z + block_x) * 3;
+              for (int j = 0; j < block_width; ++j, pixel += 3) {
+                luminance_sum += 0.212671f * pixel[0] + 0.715160f * pixel[1] +
+                                 0.072169f * pixel[2];
+              }
+            }
+
+            const float luminance = luminance_sum / (block_width * block_height);
+            if (luminance > eps) {
+              log_sum += log2(luminance);
+              ++num_blocks;
+            }
+          }
+        }
+      }
+    }
+
+    return (num_blocks > 0) ? key / exp2(float(log_sum / num_blocks)) : 1.0f;
+  }
+
+  /* Write the inner part of the denoised tile into the output pass of the render buffers, undoing
+   * the per-sample scale of the input and bringing alpha channel back. */
+  void write_tile_output(const OIDNPass &oidn_input_pass,
+                         const OIDNPass &oidn_output_pass,
+                         const int4 tile,
+                         const int4 region,
+                         const float *output)
+  {
+    const int64_t offset = buffer_params_.offset;
+    const int64_t stride = buffer_params_.stride;
+    const int64_t pass_stride = buffer_params_.pass_stride;
+    const int64_t row_stride = stride * pass_stride;
+
+    const int64_t pixel_offset = offset + buffer_params_.full_x + buffer_params_.full_y * stride;
+    float *buffer_data = render_buffers_->buffer.data() + pixel_offset * pass_stride;
+
+    const bool has_pass_sample_count = (pass_sample_count_ != PASS_UNUSED);
+
+    for (int y = tile.y; y < tile.y + tile.w; ++y) {
+      float *buffer_row = buffer_data + y * row_stride;
+      const float *output_row = output + size_t(y - region.y) * region.z * 3;
+      for (int x = tile.x; x < tile.x + tile.z; ++x) {
+        float *buffer_pixel = buffer_row + x * pass_stride;
+        float *denoised_pixel = buffer_pixel + oidn_output_pass.offset;
+        const float *output_pixel = output_row + (x - region.x) * 3;
+
+        const float pixel_scale = has_pass_sample_count ?
+                                      __float_as_uint(buffer_pixel[pass_sample_count_]) :
+                                      num_samples_;
+
+        denoised_pixel[0] = output_pixel[0] * pixel_scale;
+        denoised_pixel[1] = output_pixel[1] * pixel_scale;
+        denoised_pixel[2] = output_pixel[2] * pixel_scale;
+
+        /* Same alpha handling as in postprocess_output(). */
+        if (oidn_output_pass.num_components == 4) {
+          denoised_pixel[3] = oidn_input_pass.use_compositing ?
+                                  0.0f :
+                                  buffer_pixel[oidn_input_pass.offset + 3];
+        }
+      }
+    }
+  }
+
   void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
@@ -280,6 +545,16 @@ class OIDNDenoiseContext {
 
   /* Read pass pixels using PassAccessor into the given destination. */
   void read_pass_pixels(const OIDNPass &oidn_pass, const PassAccessor::Destination &destination)
+  {
+    read_pass_pixels(
+        oidn_pass, make_int4(0, 0, buffer_params_.width, buffer_params_.height), destination);
+  }
+
+  /* Read pixels of the pass in the given region (x, y, width, height) into the destination. Rows
+   * of the destination are tightly packed, with the width of the region. */
+  void read_pass_pixels(const OIDNPass &oidn_pass,
+                        const int4 region,
+                        const PassAccessor::Destination &destination)
   {
     PassAccessor::PassAccessInfo pass_access_info;
     pass_access_info.type = oidn_pass.type;
@@ -299,10 +574,12 @@ class OIDNDenoiseContext {
     const PassAccessorCPU pass_accessor(pass_access_info, 1.0f, num_samples_);
 
     BufferParams buffer_params = buffer_params_;
-    buffer_params.window_x = 0;
-    buffer_params.window_y = 0;
-    buffer_params.window_width = buffer_params.width;
-    buffer_params.window_height = buffer_params.height;
+    buffer_params.width = region.z;
+    buffer_params.height = region.w;
+    buffer_params.window_x = region.x;
+    buffer_params.window_y = region.y;
+    buffer_params.window_width = region.z;
+    buffer_params.window_height = region.w;
 
     pass_accessor.get_render_tile_pixels(render_buffers_, buffer_params, destination);
   }
@@ -631,8 +908,6 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
       this, params_, buffer_params, render_buffers, num_samples, allow_inplace_modification);
 
   if (context.need_denoising()) {
-    context.read_guiding_passes();
-
     const std::array<PassType, 3> passes = {
         {/* Passes which will use real albedo when it is available. */
          PASS_COMBINED,
@@ -642,10 +917,24 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
           */
          PASS_SHADOW_CATCHER}};
 
-    for (const PassType pass_type : passes) {
-      context.denoise_pass(pass_type);
-      if (is_cancelled()) {
-        return false;
+    const int2 tile_size = context.get_tile_size();
+    if (tile_size.x < buffer_params.width || tile_size.y < buffer_params.height) {
+      /* Guiding passes are read per tile, the render buffers are not modified in-place. */
+      for (const PassType pass_type : passes) {
+        context.denoise_pass_tiled(pass_type, tile_size);
+        if (is_cancelled()) {
+          return false;
+        }
+      }
+    }
+    else {
+      context.read_guiding_passes();
+
+      for (const PassType pass_type : passes) {
+        context.denoise_pass(pass_type);
+        if (is_cancelled()) {
+          return false;
+        }
       }
     }
 
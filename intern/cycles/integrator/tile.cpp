@@ -104,4 +104,26 @@ TileSize tile_calculate_best_size(const bool accel_rt,
   return tile_size;
 }
 
+int2 tile_calculate_denoise_size(const int2 &image_size,
+                                 const int overlap,
+                                 const size_t bytes_per_pixel,
+                                 const size_t max_memory)
+{
+  const size_t num_pixels = size_t(image_size.x) * image_size.y;
+  if (max_memory == 0 || num_pixels * bytes_per_pixel <= max_memory) {
+    return image_size;
+  }
+
+  /* Never go below this size, otherwise the overlap dominates the denoising time. */
+  const int min_tile_size = 64;
+
+  const int max_tile_size = int(sqrt(double(max_memory / bytes_per_pixel)));
+  int tile_size = max_tile_size - 2 * overlap;
+
+  /* Keep the size aligned, denoisers process images in blocks of 16 pixels. */
+  tile_size = max(tile_size & ~15, min_tile_size);
+
+  return make_int2(min(tile_size, image_size.x), min(tile_size, image_size.y));
+}
+
 CCL_NAMESPACE_END
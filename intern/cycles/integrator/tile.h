@@ -43,4 +43,13 @@ TileSize tile_calculate_best_size(const bool accel_rt,
                                   const int max_num_path_states,
                                   const float scrambling_distance);
 
+/* Calculate size of the tiles in which an image is to be denoised so that the per-tile buffers fit
+ * into the given memory budget. Every tile is extended by the overlap on each side, the returned
+ * size is the size of the non-overlapping part of the tile.
+ * Returns the image size when the whole image fits into the budget, or when the budget is zero. */
+int2 tile_calculate_denoise_size(const int2 &image_size,
+                                 const int overlap,
+                                 const size_t bytes_per_pixel,
+                                 const size_t max_memory);
+
 CCL_NAMESPACE_END
@@ -263,7 +263,7 @@ ray_get_shadow_set_membership(KernelGlobals kg, ccl_ray_data const RaySelfPrimit
   }
 
   if (self.light_object != OBJECT_NONE) {
-    return kernel_data_fetch(objects, self.light_object).shadow_set_membership;
+    return kernel_data_fetch(object_light_link, self.light_object).shadow_set_membership;
   }
 
   return LIGHT_LINK_MASK_ALL;
@@ -284,7 +284,7 @@ ccl_device_inline bool intersection_skip_shadow_link(KernelGlobals kg,
     return false;
   }
 
-  const uint blocker_set = kernel_data_fetch(objects, isect_object).blocker_shadow_set;
+  const uint blocker_set = kernel_data_fetch(object_light_link, isect_object).blocker_shadow_set;
   return ((uint64_t(1) << uint64_t(blocker_set)) & set_membership) == 0;
 #else
   return false;
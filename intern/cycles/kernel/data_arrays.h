@@ -23,6 +23,7 @@ KERNEL_DATA_ARRAY(DecomposedTransform, object_motion)
 KERNEL_DATA_ARRAY(uint, object_flag)
 KERNEL_DATA_ARRAY(float, object_volume_step)
 KERNEL_DATA_ARRAY(uint, object_prim_offset)
+KERNEL_DATA_ARRAY(KernelObjectLightLink, object_light_link)
 
 /* cameras */
 KERNEL_DATA_ARRAY(DecomposedTransform, camera_motion)
@@ -63,7 +63,7 @@ ccl_device int shadow_linking_pick_mesh_intersection(KernelGlobals kg,
         (shader_flags & SD_HAS_EMISSION))
     {
       const uint64_t set_membership =
-          kernel_data_fetch(objects, current_isect.object).shadow_set_membership;
+          kernel_data_fetch(object_light_link, current_isect.object).shadow_set_membership;
       if (set_membership != LIGHT_LINK_MASK_ALL) {
         ++num_hits;
 
@@ -76,7 +76,8 @@ ccl_device int shadow_linking_pick_mesh_intersection(KernelGlobals kg,
     /* Contribution from the lights past the default opaque blocker is accumulated
      * using the main path. */
     if (!(shader_flags & (SD_HAS_ONLY_VOLUME | SD_HAS_TRANSPARENT_SHADOW))) {
-      const uint blocker_set = kernel_data_fetch(objects, current_isect.object).blocker_shadow_set;
+      const uint blocker_set =
+          kernel_data_fetch(object_light_link, current_isect.object).blocker_shadow_set;
       if (blocker_set == 0) {
         ray->tmax = current_isect.t;
         break;
@@ -62,7 +62,8 @@ ccl_device_inline bool light_link_light_match(KernelGlobals kg,
 
   const uint64_t set_membership = kernel_data_fetch(lights, light_emitter).light_set_membership;
   const uint receiver_set = (object_receiver != OBJECT_NONE) ?
-                                kernel_data_fetch(objects, object_receiver).receiver_light_set :
+                                kernel_data_fetch(object_light_link, object_receiver)
+                                    .receiver_light_set :
                                 0;
   return ((uint64_t(1) << uint64_t(receiver_set)) & set_membership) != 0;
 #else
@@ -86,9 +87,11 @@ ccl_device_inline bool light_link_object_match(KernelGlobals kg,
     return true;
   }
 
-  const uint64_t set_membership = kernel_data_fetch(objects, object_emitter).light_set_membership;
+  const uint64_t set_membership =
+      kernel_data_fetch(object_light_link, object_emitter).light_set_membership;
   const uint receiver_set = (object_receiver != OBJECT_NONE) ?
-                                kernel_data_fetch(objects, object_receiver).receiver_light_set :
+                                kernel_data_fetch(object_light_link, object_receiver)
+                                    .receiver_light_set :
                                 0;
   return ((uint64_t(1) << uint64_t(receiver_set)) & set_membership) != 0;
 #else
@@ -689,7 +689,7 @@ ccl_device int light_tree_root_node_index(KernelGlobals kg, const int object_rec
   if (kernel_data.kernel_features & KERNEL_FEATURE_LIGHT_LINKING) {
     const uint receiver_light_set =
         (object_receiver != OBJECT_NONE) ?
-            kernel_data_fetch(objects, object_receiver).receiver_light_set :
+            kernel_data_fetch(object_light_link, object_receiver).receiver_light_set :
             0;
     return kernel_data.light_link_sets[receiver_light_set].light_tree_root;
   }
@@ -6,22 +6,76 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device_noinline void svm_node_math(KernelGlobals kg,
-                                       ccl_private ShaderData *sd,
-                                       ccl_private float *stack,
-                                       uint type,
-                                       uint inputs_stack_offsets,
-                                       uint result_stack_offset)
+/* Load the inputs of a math operation. Values of unlinked inputs are stored in an extra node
+ * following the operation. When chain_input is not zero, the input with index chain_input - 1
+ * receives the result of the previous operation of a math chain. */
+ccl_device_inline void svm_math_load_inputs(KernelGlobals kg,
+                                            ccl_private float *stack,
+                                            uint inputs_stack_offsets,
+                                            float chain_value,
+                                            ccl_private float *a,
+                                            ccl_private float *b,
+                                            ccl_private float *c,
+                                            ccl_private int *offset)
 {
-  uint a_stack_offset, b_stack_offset, c_stack_offset;
-  svm_unpack_node_uchar3(inputs_stack_offsets, &a_stack_offset, &b_stack_offset, &c_stack_offset);
+  uint a_stack_offset, b_stack_offset, c_stack_offset, chain_input;
+  svm_unpack_node_uchar4(
+      inputs_stack_offsets, &a_stack_offset, &b_stack_offset, &c_stack_offset, &chain_input);
 
-  float a = stack_load_float(stack, a_stack_offset);
-  float b = stack_load_float(stack, b_stack_offset);
-  float c = stack_load_float(stack, c_stack_offset);
+  const bool a_is_constant = !stack_valid(a_stack_offset) && chain_input != 1;
+  const bool b_is_constant = !stack_valid(b_stack_offset) && chain_input != 2;
+  const bool c_is_constant = !stack_valid(c_stack_offset) && chain_input != 3;
+
+  uint4 defaults = make_uint4(0, 0, 0, 0);
+  if (a_is_constant || b_is_constant || c_is_constant) {
+    defaults = read_node(kg, offset);
+  }
+
+  *a = (chain_input == 1) ? chain_value :
+                            stack_load_float_default(stack, a_stack_offset, defaults.x);
+  *b = (chain_input == 2) ? chain_value :
+                            stack_load_float_default(stack, b_stack_offset, defaults.y);
+  *c = (chain_input == 3) ? chain_value :
+                            stack_load_float_default(stack, c_stack_offset, defaults.z);
+}
+
+ccl_device_noinline int svm_node_math(KernelGlobals kg,
+                                      ccl_private ShaderData *sd,
+                                      ccl_private float *stack,
+                                      uint type,
+                                      uint inputs_stack_offsets,
+                                      uint result_stack_offset,
+                                      int offset)
+{
+  float a, b, c;
+  svm_math_load_inputs(kg, stack, inputs_stack_offsets, 0.0f, &a, &b, &c, &offset);
   float result = svm_math((NodeMathType)type, a, b, c);
 
   stack_store_float(stack, result_stack_offset, result);
+  return offset;
+}
+
+/* Sequence of math operations where each operation uses the result of the previous one, fused
+ * into a single node so the intermediate results do not go through the stack. */
+ccl_device_noinline int svm_node_math_chain(KernelGlobals kg,
+                                            ccl_private ShaderData *sd,
+                                            ccl_private float *stack,
+                                            uint num_operations,
+                                            uint result_stack_offset,
+                                            int offset)
+{
+  float result = 0.0f;
+
+  for (uint i = 0; i < num_operations; i++) {
+    const uint4 operation_node = read_node(kg, &offset);
+
+    float a, b, c;
+    svm_math_load_inputs(kg, stack, operation_node.y, result, &a, &b, &c, &offset);
+    result = svm_math((NodeMathType)operation_node.x, a, b, c);
+  }
+
+  stack_store_float(stack, result_stack_offset, result);
+  return offset;
 }
 
 ccl_device_noinline int svm_node_vector_math(KernelGlobals kg,
@@ -28,11 +28,13 @@ ccl_device_noinline int svm_node_mix(KernelGlobals kg,
   return offset;
 }
 
-ccl_device_noinline void svm_node_mix_color(ccl_private ShaderData *sd,
-                                            ccl_private float *stack,
-                                            uint options,
-                                            uint input_offset,
-                                            uint result_offset)
+ccl_device_noinline int svm_node_mix_color(KernelGlobals kg,
+                                           ccl_private ShaderData *sd,
+                                           ccl_private float *stack,
+                                           uint options,
+                                           uint input_offset,
+                                           uint result_offset,
+                                           int offset)
 {
   uint use_clamp, blend_type, use_clamp_result;
   uint fac_in_stack_offset, a_in_stack_offset, b_in_stack_offset;
@@ -40,17 +42,41 @@ ccl_device_noinline void svm_node_mix_color(ccl_private ShaderData *sd,
   svm_unpack_node_uchar3(
       input_offset, &fac_in_stack_offset, &a_in_stack_offset, &b_in_stack_offset);
 
-  float t = stack_load_float(stack, fac_in_stack_offset);
+  float t;
+  float3 a, b;
+  if (stack_valid(fac_in_stack_offset) && stack_valid(a_in_stack_offset) &&
+      stack_valid(b_in_stack_offset))
+  {
+    t = stack_load_float(stack, fac_in_stack_offset);
+    a = stack_load_float3(stack, a_in_stack_offset);
+    b = stack_load_float3(stack, b_in_stack_offset);
+  }
+  else {
+    /* Values of unlinked inputs are stored in two extra nodes. */
+    const uint4 a_node = read_node(kg, &offset);
+    const uint4 b_node = read_node(kg, &offset);
+    t = stack_load_float_default(stack, fac_in_stack_offset, a_node.w);
+    a = stack_valid(a_in_stack_offset) ?
+            stack_load_float3(stack, a_in_stack_offset) :
+            make_float3(__uint_as_float(a_node.x),
+                        __uint_as_float(a_node.y),
+                        __uint_as_float(a_node.z));
+    b = stack_valid(b_in_stack_offset) ?
+            stack_load_float3(stack, b_in_stack_offset) :
+            make_float3(__uint_as_float(b_node.x),
+                        __uint_as_float(b_node.y),
+                        __uint_as_float(b_node.z));
+  }
+
   if (use_clamp > 0) {
     t = saturatef(t);
   }
-  float3 a = stack_load_float3(stack, a_in_stack_offset);
-  float3 b = stack_load_float3(stack, b_in_stack_offset);
   float3 result = svm_mix((NodeMix)blend_type, t, a, b);
   if (use_clamp_result) {
     result = saturate(result);
   }
   stack_store_float3(stack, result_offset, result);
+  return offset;
 }
 
 ccl_device_noinline void svm_node_mix_float(ccl_private ShaderData *sd,
@@ -423,7 +423,7 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
       }
       break;
       SVM_CASE(NODE_MATH)
-      svm_node_math(kg, sd, stack, node.y, node.z, node.w);
+      offset = svm_node_math(kg, sd, stack, node.y, node.z, node.w, offset);
       break;
       SVM_CASE(NODE_VECTOR_MATH)
       offset = svm_node_vector_math(kg, sd, stack, node.y, node.z, node.w, offset);
@@ -592,7 +592,7 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
       svm_node_aov_value<node_feature_mask>(kg, state, sd, stack, node, render_buffer);
       break;
       SVM_CASE(NODE_MIX_COLOR)
-      svm_node_mix_color(sd, stack, node.y, node.z, node.w);
+      offset = svm_node_mix_color(kg, sd, stack, node.y, node.z, node.w, offset);
       break;
       SVM_CASE(NODE_MIX_FLOAT)
       svm_node_mix_float(sd, stack, node.y, node.z, node.w);
@@ -603,6 +603,9 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
       SVM_CASE(NODE_MIX_VECTOR_NON_UNIFORM)
       svm_node_mix_vector_non_uniform(sd, stack, node.y, node.z);
       break;
+      SVM_CASE(NODE_MATH_CHAIN)
+      offset = svm_node_math_chain(kg, sd, stack, node.y, node.z, offset);
+      break;
       default:
         kernel_assert(!"Unknown node type was passed to the SVM machine");
         return;
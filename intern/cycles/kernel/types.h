@@ -1533,14 +1533,19 @@ typedef struct KernelObject {
 
   /* Volume velocity scale. */
   float velocity_scale;
+} KernelObject;
+static_assert_align(KernelObject, 16);
 
-  /* TODO: separate array to avoid memory overhead when not used. */
+/* Light and shadow linking sets of an object. Stored in a separate array which is only allocated
+ * when the scene uses light or shadow linking, to keep KernelObject small for scenes with many
+ * instances. */
+typedef struct KernelObjectLightLink {
   uint64_t light_set_membership;
-  uint receiver_light_set;
   uint64_t shadow_set_membership;
+  uint receiver_light_set;
   uint blocker_shadow_set;
-} KernelObject;
-static_assert_align(KernelObject, 16);
+} KernelObjectLightLink;
+static_assert_align(KernelObjectLightLink, 8);
 
 typedef struct KernelCurve {
   int shader_id;
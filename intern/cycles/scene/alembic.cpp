@@ -16,6 +16,7 @@
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/time.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -404,6 +405,44 @@ static void concatenate_xform_samples(const MatrixSampleMap &parent_samples,
   }
 }
 
+static bool compound_property_is_constant(const ICompoundProperty &compound);
+
+static bool property_is_constant(const ICompoundProperty &parent,
+                                 const Alembic::AbcCoreAbstract::PropertyHeader &header)
+{
+  if (header.isCompound()) {
+    return compound_property_is_constant(ICompoundProperty(parent, header.getName()));
+  }
+  if (header.isArray()) {
+    return IArrayProperty(parent, header.getName()).isConstant();
+  }
+  return IScalarProperty(parent, header.getName()).isConstant();
+}
+
+static bool compound_property_is_constant(const ICompoundProperty &compound)
+{
+  for (size_t i = 0; i < compound.getNumProperties(); i++) {
+    if (!property_is_constant(compound, compound.getPropertyHeader(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Check the properties of the object and of its children, which includes the face sets. */
+static bool object_is_constant(const IObject &iobject)
+{
+  if (!compound_property_is_constant(iobject.getProperties())) {
+    return false;
+  }
+  for (size_t i = 0; i < iobject.getNumChildren(); i++) {
+    if (!object_is_constant(iobject.getChild(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static Transform make_transform(const M44d &a, float scale)
 {
   M44d m = convert_yup_zup(a, scale);
@@ -450,6 +489,32 @@ Object *AlembicObject::get_object()
   return object;
 }
 
+void AlembicObject::load_data_in_cache(CachedData &cached_data,
+                                       AlembicProcedural *proc,
+                                       Progress &progress)
+{
+  if (schema_type == POLY_MESH) {
+    IPolyMesh polymesh(iobject, Alembic::Abc::kWrapExisting);
+    IPolyMeshSchema schema = polymesh.getSchema();
+    load_data_in_cache(cached_data, proc, schema, progress);
+  }
+  else if (schema_type == CURVES) {
+    ICurves curves(iobject, Alembic::Abc::kWrapExisting);
+    ICurvesSchema schema = curves.getSchema();
+    load_data_in_cache(cached_data, proc, schema, progress);
+  }
+  else if (schema_type == POINTS) {
+    IPoints points(iobject, Alembic::Abc::kWrapExisting);
+    IPointsSchema schema = points.getSchema();
+    load_data_in_cache(cached_data, proc, schema, progress);
+  }
+  else if (schema_type == SUBD) {
+    ISubD subd_mesh(iobject, Alembic::Abc::kWrapExisting);
+    ISubDSchema schema = subd_mesh.getSchema();
+    load_data_in_cache(cached_data, proc, schema, progress);
+  }
+}
+
 bool AlembicObject::has_data_loaded() const
 {
   return data_loaded;
@@ -486,7 +551,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes_, progress);
 
   if (progress.get_cancel()) {
     return;
@@ -528,7 +593,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
     /* Use the schema as the base compound property to also be able to look for top level
      * properties. */
     read_attributes(
-        proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+        proc, cached_data, schema, schema.getUVsParam(), requested_attributes_, progress);
 
     cached_data.invalidate_last_loaded_time(true);
     data_loaded = true;
@@ -564,7 +629,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes_, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -606,7 +671,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), requested_attributes_, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -641,7 +706,7 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
-  read_attributes(proc, cached_data, schema, {}, get_requested_attributes(), progress);
+  read_attributes(proc, cached_data, schema, {}, requested_attributes_, progress);
 
   cached_data.invalidate_last_loaded_time(true);
   data_loaded = true;
@@ -792,6 +857,9 @@ AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 
 AlembicProcedural::~AlembicProcedural()
 {
+  prefetch_progress_.set_cancel("Cancel");
+  prefetch_pool_.cancel();
+
   ccl::set<Geometry *> geometries_set;
   ccl::set<Object *> objects_set;
   ccl::set<AlembicObject *> abc_objects_set;
@@ -826,6 +894,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   assert(scene_ == nullptr || scene_ == scene);
   scene_ = scene;
 
+  wait_for_background_tasks();
+
   if (frame < start_frame || frame > end_frame) {
     clear_modified();
     return;
@@ -870,6 +940,9 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
 
+    /* Use a stream per thread, so objects can be read in parallel. */
+    factory.setOgawaNumStreams(TaskScheduler::max_concurrency());
+
     std::vector<std::string> filenames;
     filenames.push_back(filepath.c_str());
 
@@ -920,6 +993,13 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
+  /* Without prefetching only the data of the current frame is in the cache, so it has to be
+   * replaced when the frame changes, unless the object is not animated. */
+  const bool need_frame_reload = !use_prefetch && frame_is_modified();
+  if (need_frame_reload) {
+    use_prefetched_frame();
+  }
+
   if (prefetch_cache_size_is_modified()) {
     /* Check whether the current memory usage fits in the new requested size,
      * abort the render if it is any higher. */
@@ -946,7 +1026,7 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
 
     /* skip constant objects */
     if (object->is_constant() && !object->is_modified() && !object->need_shader_update &&
-        !scale_is_modified())
+        !scale_is_modified() && (!need_frame_reload || object->schema_is_constant))
     {
       continue;
     }
@@ -968,6 +1048,26 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     object->clear_modified();
   }
 
+  {
+    thread_scoped_lock lock(read_stats_mutex_);
+    if (read_stats_time_ > 0.0) {
+      VLOG_WORK << "AlembicProcedural read " << string_human_readable_size(read_stats_bytes_)
+                << " in " << read_stats_time_ << " seconds ("
+                << (read_stats_bytes_ / (1024.0 * 1024.0)) / read_stats_time_ << " MB/s)";
+    }
+    if (prefetch_stats_hits_ || prefetch_stats_misses_) {
+      VLOG_WORK << "AlembicProcedural background frame reads : " << prefetch_stats_hits_
+                << " used, " << prefetch_stats_misses_ << " discarded";
+    }
+    read_stats_bytes_ = 0;
+    read_stats_time_ = 0.0;
+  }
+
+  /* Read the next frame in the background while the current one is rendered. */
+  if (!use_prefetch) {
+    prefetch_next_frame();
+  }
+
   clear_modified();
 }
 
@@ -1066,6 +1166,24 @@ void AlembicProcedural::load_objects(Progress &progress)
       abc_object->schema_type = abc_object->instance_of->schema_type;
     }
   }
+
+  foreach (Node *node, objects) {
+    AlembicObject *abc_object = static_cast<AlembicObject *>(node);
+
+    if (abc_object->schema_type == AlembicObject::INVALID) {
+      continue;
+    }
+
+    const bool transform_is_constant = abc_object->xform_samples.size() <= 1;
+    if (abc_object->instance_of) {
+      abc_object->schema_is_constant = transform_is_constant &&
+                                       abc_object->instance_of->schema_is_constant;
+    }
+    else {
+      abc_object->schema_is_constant = transform_is_constant &&
+                                       object_is_constant(abc_object->iobject);
+    }
+  }
 }
 
 void AlembicProcedural::read_mesh(AlembicObject *abc_object, Abc::chrono_t frame_time)
@@ -1481,83 +1599,197 @@ void AlembicProcedural::walk_hierarchy(
 
 void AlembicProcedural::build_caches(Progress &progress)
 {
-  size_t memory_used = 0;
+  /* Objects are read in parallel, the archive is opened with a stream per thread. */
+  TaskPool pool;
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+    pool.push([this, object, &progress]() { build_object_cache(object, progress); });
+  }
+  pool.wait_work();
 
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  size_t memory_used = 0;
   for (Node *node : objects) {
     AlembicObject *object = static_cast<AlembicObject *>(node);
+    memory_used += object->get_cached_data().memory_used();
+  }
 
-    if (progress.get_cancel()) {
+  if (use_prefetch) {
+    if (memory_used > get_prefetch_cache_size_in_bytes()) {
+      progress.set_error("Error: Alembic Procedural memory limit reached");
       return;
     }
+  }
 
-    if (object->schema_type == AlembicObject::POLY_MESH) {
-      if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified())
-      {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::POINTS) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified())
-      {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
+  VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+}
+
+void AlembicProcedural::build_object_cache(AlembicObject *object, Progress &progress)
+{
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  CachedData &cached_data = object->get_cached_data();
+  if (use_prefetch) {
+    set_cache_frame_range(cached_data, start_frame, end_frame);
+  }
+  else {
+    set_cache_frame_range(cached_data, frame, frame);
+  }
+
+  object->requested_attributes_ = object->get_requested_attributes();
+
+  const double time_start = time_dt();
+  bool need_load = false;
+
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    need_load = !object->has_data_loaded();
+    if (!need_load && object->need_shader_update) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      read_attributes(this,
+                      cached_data,
+                      schema,
+                      schema.getUVsParam(),
+                      object->requested_attributes_,
+                      progress);
     }
-    else if (object->schema_type == AlembicObject::SUBD) {
-      if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
+  }
+  else if (object->schema_type == AlembicObject::CURVES ||
+           object->schema_type == AlembicObject::POINTS)
+  {
+    need_load = !object->has_data_loaded() || default_radius_is_modified() ||
+                object->radius_scale_is_modified();
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    need_load = !object->has_data_loaded();
+    if (!need_load && object->need_shader_update) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      read_attributes(this,
+                      cached_data,
+                      schema,
+                      schema.getUVsParam(),
+                      object->requested_attributes_,
+                      progress);
     }
+  }
 
-    if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
-      object->setup_transform_cache(object->get_cached_data(), scale);
-    }
+  if (need_load) {
+    object->load_data_in_cache(cached_data, this, progress);
+    add_read_stats(cached_data.memory_used(), time_dt() - time_start);
+  }
+
+  if (scale_is_modified() || cached_data.transforms.size() == 0) {
+    object->setup_transform_cache(cached_data, scale);
+  }
+}
 
+void AlembicProcedural::set_cache_frame_range(CachedData &cached_data,
+                                              const float first_frame,
+                                              const float last_frame) const
+{
+  const double frame_rate_d = static_cast<double>(frame_rate);
+  cached_data.start_time = static_cast<double>(first_frame) / frame_rate_d;
+  cached_data.end_time = (static_cast<double>(last_frame) + 1.0) / frame_rate_d;
+}
+
+void AlembicProcedural::prefetch_next_frame()
+{
+  const float next_frame = frame + 1.0f;
+  if (next_frame > end_frame) {
+    return;
+  }
+
+  /* The data of the next frame takes about as much memory as the data of the current one, only
+   * read it when both fit in the cache. */
+  size_t memory_used = 0;
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
     memory_used += object->get_cached_data().memory_used();
+  }
+
+  if (memory_used * 2 > get_prefetch_cache_size_in_bytes()) {
+    VLOG_WORK << "AlembicProcedural not reading frame " << next_frame
+              << " in the background, cache size limit reached";
+    return;
+  }
 
-    if (use_prefetch) {
-      if (memory_used > get_prefetch_cache_size_in_bytes()) {
-        progress.set_error("Error: Alembic Procedural memory limit reached");
-        return;
+  has_prefetched_frame_ = true;
+  prefetched_frame_ = next_frame;
+  prefetch_progress_.reset();
+
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+
+    if (object->instance_of || object->schema_type == AlembicObject::INVALID ||
+        object->schema_is_constant)
+    {
+      continue;
+    }
+
+    /* Shaders may be modified while the data is read, so gather the attributes now. */
+    object->requested_attributes_ = object->get_requested_attributes();
+
+    prefetch_pool_.push([this, object, next_frame]() {
+      CachedData &cached_data = object->prefetched_data_;
+      set_cache_frame_range(cached_data, next_frame, next_frame);
+
+      const double time_start = time_dt();
+      object->load_data_in_cache(cached_data, this, prefetch_progress_);
+      add_read_stats(cached_data.memory_used(), time_dt() - time_start);
+    });
+  }
+}
+
+void AlembicProcedural::use_prefetched_frame()
+{
+  const bool is_prefetched_frame_valid = has_prefetched_frame_ && prefetched_frame_ == frame &&
+                                         !prefetch_progress_.get_cancel() &&
+                                         !filepath_is_modified() && !layers_is_modified() &&
+                                         !default_radius_is_modified();
+
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+
+    if (object->instance_of || object->schema_type == AlembicObject::INVALID ||
+        object->schema_is_constant)
+    {
+      continue;
+    }
+
+    if (is_prefetched_frame_valid && !object->is_modified() && !object->need_shader_update) {
+      std::swap(object->cached_data_, object->prefetched_data_);
+      object->data_loaded = true;
+      prefetch_stats_hits_++;
+    }
+    else {
+      object->data_loaded = false;
+      if (has_prefetched_frame_) {
+        prefetch_stats_misses_++;
       }
     }
+
+    object->prefetched_data_.clear();
   }
 
-  VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+  has_prefetched_frame_ = false;
+}
+
+void AlembicProcedural::add_read_stats(const size_t bytes, const double time)
+{
+  thread_scoped_lock lock(read_stats_mutex_);
+  read_stats_bytes_ += bytes;
+  read_stats_time_ += time;
+}
+
+void AlembicProcedural::wait_for_background_tasks()
+{
+  prefetch_pool_.wait_work();
 }
 
 CCL_NAMESPACE_END
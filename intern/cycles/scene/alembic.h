@@ -7,7 +7,9 @@
 #include "graph/node.h"
 #include "scene/attribute.h"
 #include "scene/procedural.h"
+#include "util/progress.h"
 #include "util/set.h"
+#include "util/task.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -330,6 +332,10 @@ struct CachedData {
 
   vector<CachedAttribute> attributes{};
 
+  /* Time range in seconds of the samples to read from the archive. Not reset by clear(). */
+  double start_time = 0.0;
+  double end_time = 0.0;
+
   void clear();
 
   CachedAttribute &add_attribute(const ustring &name,
@@ -402,6 +408,9 @@ class AlembicObject : public Node {
                           const Alembic::AbcGeom::IPointsSchema &schema,
                           Progress &progress);
 
+  /* Load the data for the schema of the IObject. */
+  void load_data_in_cache(CachedData &cached_data, AlembicProcedural *proc, Progress &progress);
+
   bool has_data_loaded() const;
 
   /* Enumeration used to speed up the discrimination of an IObject as IObject::matches() methods
@@ -425,6 +434,10 @@ class AlembicObject : public Node {
   /* Set if the path points to a valid IObject whose type is supported. */
   AbcSchemaType schema_type;
 
+  /* Set if none of the properties and transforms of the IObject are animated, the data read for
+   * one frame is then valid for all frames. */
+  bool schema_is_constant = false;
+
   CachedData &get_cached_data()
   {
     return cached_data_;
@@ -446,9 +459,15 @@ class AlembicObject : public Node {
 
   CachedData cached_data_;
 
+  /* Data of the next frame, read in the background while the current frame is rendering. */
+  CachedData prefetched_data_;
+
   void setup_transform_cache(CachedData &cached_data, float scale);
 
   AttributeRequestSet get_requested_attributes();
+
+  /* Attributes to read when loading data, gathered from the shaders before reading starts. */
+  AttributeRequestSet requested_attributes_;
 };
 
 /* Procedural to render objects from a single Alembic archive.
@@ -528,6 +547,8 @@ class AlembicProcedural : public Procedural {
    * Returns a pointer to an existing or a newly created AlembicObject for the given path. */
   AlembicObject *get_or_create_object(const ustring &path);
 
+  void wait_for_background_tasks() override;
+
  private:
   /* Add an object to our list of objects, and tag the socket as modified. */
   void add_object(AlembicObject *object);
@@ -562,6 +583,36 @@ class AlembicProcedural : public Procedural {
 
   void build_caches(Progress &progress);
 
+  /* Load the data of the object for the current frame, or the entire animation when prefetching
+   * is used. */
+  void build_object_cache(AlembicObject *object, Progress &progress);
+
+  /* Set the range of samples to read into the cache for the given frames. */
+  void set_cache_frame_range(CachedData &cached_data, float first_frame, float last_frame) const;
+
+  /* When the entire animation is not prefetched, start reading the data of the next frame in the
+   * background, so that it is ready by the time the next frame is synchronized. */
+  void prefetch_next_frame();
+
+  /* Swap in the data read in the background if it is for the current frame, otherwise tag the
+   * objects to be reloaded. */
+  void use_prefetched_frame();
+
+  void add_read_stats(size_t bytes, double time);
+
+  TaskPool prefetch_pool_;
+  Progress prefetch_progress_;
+  /* Frame for which data was read in the background, if any. */
+  bool has_prefetched_frame_ = false;
+  float prefetched_frame_ = 0.0f;
+
+  /* Statistics about the data read from the archive. */
+  thread_mutex read_stats_mutex_;
+  size_t read_stats_bytes_ = 0;
+  double read_stats_time_ = 0.0;
+  int prefetch_stats_hits_ = 0;
+  int prefetch_stats_misses_ = 0;
+
   size_t get_prefetch_cache_size_in_bytes() const
   {
     /* prefetch_cache_size is in megabytes, so convert to bytes. */
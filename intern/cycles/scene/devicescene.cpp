@@ -35,6 +35,7 @@ DeviceScene::DeviceScene(Device *device)
       object_flag(device, "object_flag", MEM_GLOBAL),
       object_volume_step(device, "object_volume_step", MEM_GLOBAL),
       object_prim_offset(device, "object_prim_offset", MEM_GLOBAL),
+      object_light_link(device, "object_light_link", MEM_GLOBAL),
       camera_motion(device, "camera_motion", MEM_GLOBAL),
       attributes_map(device, "attributes_map", MEM_GLOBAL),
       attributes_float(device, "attributes_float", MEM_GLOBAL),
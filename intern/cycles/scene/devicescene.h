@@ -50,6 +50,7 @@ class DeviceScene {
   device_vector<uint> object_flag;
   device_vector<float> object_volume_step;
   device_vector<uint> object_prim_offset;
+  device_vector<KernelObjectLightLink> object_light_link;
 
   /* cameras */
   device_vector<DecomposedTransform> camera_motion;
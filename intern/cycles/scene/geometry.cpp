@@ -33,6 +33,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time_trace.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -778,6 +779,7 @@ void GeometryManager::device_update(Device *device,
             {"device_update (adaptive subdivision)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "geometry", "Adaptive Subdivision");
 
     Camera *dicing_camera = scene->dicing_camera;
     dicing_camera->set_screen_size(dicing_camera->get_full_width(),
@@ -857,6 +859,7 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (attributes)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "geometry", "Attributes");
     device_update_attributes(device, dscene, scene, progress);
     if (progress.get_cancel()) {
       return;
@@ -877,6 +880,7 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (displacement)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "geometry", "Displacement");
 
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified()) {
@@ -939,14 +943,17 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (build object BVHs)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "bvh", "Object BVHs");
     TaskPool pool;
 
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified() || geom->need_update_bvh_for_offset) {
         need_update_scene_bvh = true;
-        pool.push(function_bind(
-            &Geometry::compute_bvh, geom, device, dscene, &scene->params, &progress, i, num_bvh));
+        pool.push([geom, device, dscene, scene, &progress, i, num_bvh]() {
+          scoped_time_trace geom_trace(scene->time_trace, "bvh", geom->name.string());
+          geom->compute_bvh(device, dscene, &scene->params, &progress, i, num_bvh);
+        });
         if (geom->need_build_bvh(bvh_layout)) {
           i++;
         }
@@ -989,6 +996,7 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (build scene BVH)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "bvh", "Scene BVH");
     device_update_bvh(device, dscene, scene, progress);
     if (progress.get_cancel()) {
       return;
@@ -1007,6 +1015,7 @@ void GeometryManager::device_update(Device *device,
             {"device_update (copy meshes to device)", time});
       }
     });
+    scoped_time_trace trace(scene->time_trace, "geometry", "Copy Meshes to Device");
     device_update_mesh(device, dscene, scene, progress);
     if (progress.get_cancel()) {
       return;
@@ -18,6 +18,7 @@
 #include "util/progress.h"
 #include "util/task.h"
 #include "util/texture.h"
+#include "util/time_trace.h"
 #include "util/unique_ptr.h"
 
 #ifdef WITH_OSL
@@ -685,6 +686,8 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
+  scoped_time_trace trace(scene->time_trace, "image", img->loader->name());
+
   const int texture_limit = scene->params.texture_limit;
 
   load_image_metadata(img);
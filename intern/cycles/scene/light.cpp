@@ -25,6 +25,7 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time_trace.h"
 #include <stack>
 
 CCL_NAMESPACE_BEGIN
@@ -811,6 +812,8 @@ void LightManager::device_update_tree(Device *,
   /* Update light tree. */
   progress.set_status("Updating Lights", "Computing tree");
 
+  scoped_time_trace trace(scene->time_trace, "light", "Light Tree");
+
   /* TODO: For now, we'll start with a smaller number of max lights in a node.
    * More benchmarking is needed to determine what number works best. */
   LightTree light_tree(scene, dscene, progress, 8);
@@ -23,6 +23,7 @@
 #include "util/progress.h"
 #include "util/set.h"
 #include "util/task.h"
+#include "util/time_trace.h"
 #include "util/vector.h"
 
 #include "subd/patch_table.h"
@@ -54,6 +55,8 @@ struct UpdateObjectTransformState {
   Transform *object_motion_pass;
   DecomposedTransform *object_motion;
   float *object_volume_step;
+  /* Only allocated when the scene uses light or shadow linking. */
+  KernelObjectLightLink *object_light_link;
 
   /* Flags which will be synchronized to Integrator. */
   bool have_motion;
@@ -493,14 +496,18 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
   kobject.particle_index = particle_index;
   kobject.motion_offset = 0;
   kobject.ao_distance = ob->ao_distance;
-  kobject.receiver_light_set = ob->receiver_light_set >= LIGHT_LINK_SET_MAX ?
-                                   0 :
-                                   ob->receiver_light_set;
-  kobject.light_set_membership = ob->light_set_membership;
-  kobject.blocker_shadow_set = ob->blocker_shadow_set >= LIGHT_LINK_SET_MAX ?
-                                   0 :
-                                   ob->blocker_shadow_set;
-  kobject.shadow_set_membership = ob->shadow_set_membership;
+
+  if (state->object_light_link) {
+    KernelObjectLightLink &klight_link = state->object_light_link[ob->index];
+    klight_link.receiver_light_set = ob->receiver_light_set >= LIGHT_LINK_SET_MAX ?
+                                         0 :
+                                         ob->receiver_light_set;
+    klight_link.light_set_membership = ob->light_set_membership;
+    klight_link.blocker_shadow_set = ob->blocker_shadow_set >= LIGHT_LINK_SET_MAX ?
+                                         0 :
+                                         ob->blocker_shadow_set;
+    klight_link.shadow_set_membership = ob->shadow_set_membership;
+  }
 
   if (geom->get_use_motion_blur()) {
     state->have_motion = true;
@@ -672,6 +679,8 @@ void ObjectManager::device_update_prim_offsets(Device *device, DeviceScene *dsce
 
 void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene, Progress &progress)
 {
+  scoped_time_trace trace(scene->time_trace, "object", "Transforms");
+
   UpdateObjectTransformState state;
   state.need_motion = scene->need_motion();
   state.have_motion = false;
@@ -686,6 +695,20 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   state.object_volume_step = dscene->object_volume_step.alloc(scene->objects.size());
   state.object_motion = NULL;
   state.object_motion_pass = NULL;
+  state.object_light_link = NULL;
+
+  /* Linking sets are only read by the kernel when the light or shadow linking features are
+   * enabled, skip the memory for scenes with many instances that do not use them. */
+  if (dscene->data.kernel_features & (KERNEL_FEATURE_LIGHT_LINKING | KERNEL_FEATURE_SHADOW_LINKING))
+  {
+    if (dscene->objects.is_modified()) {
+      dscene->object_light_link.tag_modified();
+    }
+    state.object_light_link = dscene->object_light_link.alloc(scene->objects.size());
+  }
+  else if (dscene->object_light_link.size()) {
+    dscene->object_light_link.free();
+  }
 
   if (state.need_motion == Scene::MOTION_PASS) {
     state.object_motion_pass = dscene->object_motion_pass.alloc(OBJECT_MOTION_PASS_SIZE *
@@ -736,6 +759,9 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   }
 
   dscene->objects.copy_to_device_if_modified();
+  if (state.object_light_link) {
+    dscene->object_light_link.copy_to_device_if_modified();
+  }
   if (state.need_motion == Scene::MOTION_PASS) {
     dscene->object_motion_pass.copy_to_device();
   }
@@ -749,6 +775,7 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
   dscene->data.bvh.have_volumes = state.have_volumes;
 
   dscene->objects.clear_modified();
+  dscene->object_light_link.clear_modified();
   dscene->object_motion_pass.clear_modified();
   dscene->object_motion.clear_modified();
 }
@@ -764,6 +791,7 @@ void ObjectManager::device_update(Device *device,
 
   if (update_flags & (OBJECT_ADDED | OBJECT_REMOVED)) {
     dscene->objects.tag_realloc();
+    dscene->object_light_link.tag_realloc();
     dscene->object_motion_pass.tag_realloc();
     dscene->object_motion.tag_realloc();
     dscene->object_flag.tag_realloc();
@@ -1003,6 +1031,7 @@ void ObjectManager::device_free(Device *, DeviceScene *dscene, bool force_free)
   dscene->object_flag.free_if_need_realloc(force_free);
   dscene->object_volume_step.free_if_need_realloc(force_free);
   dscene->object_prim_offset.free_if_need_realloc(force_free);
+  dscene->object_light_link.free_if_need_realloc(force_free);
 }
 
 void ObjectManager::apply_static_transforms(DeviceScene *dscene, Scene *scene, Progress &progress)
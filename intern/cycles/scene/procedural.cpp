@@ -57,6 +57,13 @@ void ProceduralManager::update(Scene *scene, Progress &progress)
   need_update_ = false;
 }
 
+void ProceduralManager::wait_for_background_tasks(Scene *scene)
+{
+  foreach (Procedural *procedural, scene->procedurals) {
+    procedural->wait_for_background_tasks();
+  }
+}
+
 void ProceduralManager::tag_update()
 {
   need_update_ = true;
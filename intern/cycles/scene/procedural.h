@@ -28,6 +28,10 @@ class Procedural : public Node, public NodeOwner {
    * point for the data generated by this Procedural. */
   virtual void generate(Scene *scene, Progress &progress) = 0;
 
+  /* Wait for work done by this Procedural in the background, like reading data for upcoming
+   * frames. Called before the scene is modified by synchronization. */
+  virtual void wait_for_background_tasks() {}
+
   /* Create a node and set this Procedural as the owner. */
   template<typename T> T *create_node()
   {
@@ -53,6 +57,8 @@ class ProceduralManager {
 
   void update(Scene *scene, Progress &progress);
 
+  void wait_for_background_tasks(Scene *scene);
+
   void tag_update();
 
   bool need_update() const;
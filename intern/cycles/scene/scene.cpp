@@ -32,6 +32,7 @@
 #include "util/guarded_allocator.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/time_trace.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -47,6 +48,7 @@ Scene::Scene(const SceneParams &params_, Device *device)
       dscene(device),
       params(params_),
       update_stats(NULL),
+      time_trace(NULL),
       kernels_loaded(false),
       /* TODO(sergey): Check if it's indeed optimal value for the split kernel. */
       max_closure_global(1)
@@ -169,6 +171,7 @@ void Scene::free_memory(bool final)
     delete image_manager;
     delete bake_manager;
     delete update_stats;
+    delete time_trace;
     delete procedural_manager;
   }
 }
@@ -185,6 +188,8 @@ void Scene::device_update(Device *device_, Progress &progress)
     update_stats->clear();
   }
 
+  scoped_time_trace trace(time_trace, "scene", "device_update");
+
   scoped_callback_timer timer([this, print_stats](double time) {
     if (update_stats) {
       update_stats->scene.times.add_entry({"device_update", time});
@@ -215,124 +220,178 @@ void Scene::device_update(Device *device_, Progress &progress)
   }
 
   progress.set_status("Updating Shaders");
-  shader_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Shaders");
+    shader_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
-  procedural_manager->update(this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Procedurals");
+    procedural_manager->update(this, progress);
+  }
 
   if (progress.get_cancel()) {
     return;
   }
 
   progress.set_status("Updating Background");
-  background->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Background");
+    background->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Camera");
-  camera->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Camera");
+    camera->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
-  geometry_manager->device_update_preprocess(device, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Geometry Preprocess");
+    geometry_manager->device_update_preprocess(device, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Objects");
-  object_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Objects");
+    object_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Particle Systems");
-  particle_system_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Particle Systems");
+    particle_system_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Meshes");
-  geometry_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Meshes");
+    geometry_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Objects Flags");
-  object_manager->device_update_flags(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Objects Flags");
+    object_manager->device_update_flags(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Primitive Offsets");
-  object_manager->device_update_prim_offsets(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Primitive Offsets");
+    object_manager->device_update_prim_offsets(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Images");
-  image_manager->device_update(device, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Images");
+    image_manager->device_update(device, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Camera Volume");
-  camera->device_update_volume(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Camera Volume");
+    camera->device_update_volume(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Lookup Tables");
-  lookup_tables->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Lookup Tables");
+    lookup_tables->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Lights");
-  light_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Lights");
+    light_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Integrator");
-  integrator->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Integrator");
+    integrator->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Film");
-  film->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Film");
+    film->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Lookup Tables");
-  lookup_tables->device_update(device, &dscene, this);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Lookup Tables");
+    lookup_tables->device_update(device, &dscene, this);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
   }
 
   progress.set_status("Updating Baking");
-  bake_manager->device_update(device, &dscene, this, progress);
+  {
+    scoped_time_trace stage_trace(time_trace, "scene", "Baking");
+    bake_manager->device_update(device, &dscene, this, progress);
+  }
 
   if (progress.get_cancel() || device->have_error()) {
     return;
@@ -469,6 +528,13 @@ void Scene::enable_update_stats()
   }
 }
 
+void Scene::enable_time_trace()
+{
+  if (!time_trace) {
+    time_trace = new TimeTrace();
+  }
+}
+
 void Scene::update_kernel_features()
 {
   if (!need_update()) {
@@ -563,6 +629,13 @@ void Scene::update_kernel_features()
   kernel_features |= film->get_kernel_features(this);
   kernel_features |= integrator->get_kernel_features();
 
+  /* Object linking sets are only packed when linking is used, make sure they get packed when it
+   * becomes enabled. */
+  const uint linking_features = KERNEL_FEATURE_LIGHT_LINKING | KERNEL_FEATURE_SHADOW_LINKING;
+  if ((kernel_features & linking_features) != (dscene.data.kernel_features & linking_features)) {
+    object_manager->tag_update(this, ObjectManager::OBJECT_MODIFIED);
+  }
+
   dscene.data.kernel_features = kernel_features;
 
   /* Currently viewport render is faster with higher max_closures, needs investigating. */
@@ -48,6 +48,7 @@ class BakeManager;
 class BakeData;
 class RenderStats;
 class SceneUpdateStats;
+class TimeTrace;
 class Volume;
 
 /* Scene Parameters */
@@ -166,6 +167,9 @@ class Scene : public NodeOwner {
   /* scene update statistics */
   SceneUpdateStats *update_stats;
 
+  /* hierarchical timing of scene synchronization and update, NULL when disabled */
+  TimeTrace *time_trace;
+
   Scene(const SceneParams &params, Device *device);
   ~Scene();
 
@@ -187,6 +191,7 @@ class Scene : public NodeOwner {
   void collect_statistics(RenderStats *stats);
 
   void enable_update_stats();
+  void enable_time_trace();
 
   bool load_kernels(Progress &progress);
   bool update(Progress &progress);
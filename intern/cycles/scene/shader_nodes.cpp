@@ -5212,15 +5212,23 @@ void MixColorNode::compile(SVMCompiler &compiler)
   ShaderInput *b_in = input("B");
   ShaderOutput *result_out = output("Result");
 
-  int fac_in_stack_offset = compiler.stack_assign(fac_in);
-  int a_in_stack_offset = compiler.stack_assign(a_in);
-  int b_in_stack_offset = compiler.stack_assign(b_in);
+  int fac_in_stack_offset = compiler.stack_assign_if_linked(fac_in);
+  int a_in_stack_offset = compiler.stack_assign_if_linked(a_in);
+  int b_in_stack_offset = compiler.stack_assign_if_linked(b_in);
 
   compiler.add_node(
       NODE_MIX_COLOR,
       compiler.encode_uchar4(use_clamp, blend_type, use_clamp_result),
       compiler.encode_uchar4(fac_in_stack_offset, a_in_stack_offset, b_in_stack_offset),
       compiler.stack_assign(result_out));
+
+  /* Values of unlinked inputs are stored directly in the node data. */
+  if (fac_in_stack_offset == SVM_STACK_INVALID || a_in_stack_offset == SVM_STACK_INVALID ||
+      b_in_stack_offset == SVM_STACK_INVALID)
+  {
+    compiler.add_node(make_float4(a.x, a.y, a.z, fac));
+    compiler.add_node(make_float4(b.x, b.y, b.z, 0.0f));
+  }
 }
 
 void MixColorNode::compile(OSLCompiler &compiler)
@@ -6674,16 +6682,7 @@ void MathNode::compile(SVMCompiler &compiler)
   ShaderInput *value3_in = input("Value3");
   ShaderOutput *value_out = output("Value");
 
-  int value1_stack_offset = compiler.stack_assign(value1_in);
-  int value2_stack_offset = compiler.stack_assign(value2_in);
-  int value3_stack_offset = compiler.stack_assign(value3_in);
-  int value_stack_offset = compiler.stack_assign(value_out);
-
-  compiler.add_node(
-      NODE_MATH,
-      math_type,
-      compiler.encode_uchar4(value1_stack_offset, value2_stack_offset, value3_stack_offset),
-      value_stack_offset);
+  compiler.add_math_node(math_type, value1_in, value2_in, value3_in, value_out);
 }
 
 void MathNode::compile(OSLCompiler &compiler)
@@ -18,6 +18,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time_trace.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -39,6 +40,8 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   }
   assert(shader->graph);
 
+  scoped_time_trace trace(scene->time_trace, "shader", shader->name.string());
+
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
@@ -409,6 +412,92 @@ void SVMCompiler::add_node(const float4 &f)
       __float_as_int(f.x), __float_as_int(f.y), __float_as_int(f.z), __float_as_int(f.w)));
 }
 
+void SVMCompiler::add_math_node(const uint math_type,
+                                ShaderInput *value1_in,
+                                ShaderInput *value2_in,
+                                ShaderInput *value3_in,
+                                ShaderOutput *value_out)
+{
+  ShaderInput *inputs[3] = {value1_in, value2_in, value3_in};
+
+  /* When this node is the only user of the math node added right before it, fuse both into a
+   * NODE_MATH_CHAIN so the intermediate value does not go through the stack. */
+  int chain_candidate = -1;
+  if (math_chain.output && math_chain.output->links.size() == 1) {
+    for (int i = 0; i < 3; i++) {
+      if (inputs[i]->link == math_chain.output) {
+        chain_candidate = i;
+        break;
+      }
+    }
+  }
+
+  /* Unlinked inputs are stored as constants in an extra node, instead of being loaded to the
+   * stack by separate value nodes. */
+  uint stack_offsets[3] = {SVM_STACK_INVALID, SVM_STACK_INVALID, SVM_STACK_INVALID};
+  for (int i = 0; i < 3; i++) {
+    if (i != chain_candidate) {
+      stack_offsets[i] = stack_assign_if_linked(inputs[i]);
+    }
+  }
+
+  /* Assigning the other inputs may have added nodes, in which case fusing is not possible. */
+  uint chain_input = 0;
+  if (chain_candidate != -1) {
+    if (math_chain.end_index == int(current_svm_nodes.size())) {
+      chain_input = chain_candidate + 1;
+    }
+    else {
+      stack_offsets[chain_candidate] = stack_assign(inputs[chain_candidate]);
+    }
+  }
+
+  bool need_constants = false;
+  for (int i = 0; i < 3; i++) {
+    need_constants |= (stack_offsets[i] == SVM_STACK_INVALID && chain_input != i + 1);
+  }
+
+  const uint inputs_stack_offsets = encode_uchar4(
+      stack_offsets[0], stack_offsets[1], stack_offsets[2], chain_input);
+  const int value_stack_offset = stack_assign(value_out);
+
+  if (chain_input) {
+    const int node_index = math_chain.node_index;
+    if (current_svm_nodes[node_index].x == NODE_MATH) {
+      /* Turn the single math node into the first operation of a chain. */
+      const int4 math_node = current_svm_nodes[node_index];
+      const int num_constant_nodes = current_svm_nodes.size() - node_index - 1;
+      const int4 constant_node = num_constant_nodes ? current_svm_nodes[node_index + 1] :
+                                                      make_int4(0, 0, 0, 0);
+
+      current_svm_nodes.resize(node_index);
+      add_node(NODE_MATH_CHAIN, 1, 0, 0);
+      add_node(math_node.y, math_node.z, 0, 0);
+      if (num_constant_nodes) {
+        add_node(constant_node.x, constant_node.y, constant_node.z, constant_node.w);
+      }
+    }
+
+    current_svm_nodes[node_index].y += 1;
+    current_svm_nodes[node_index].z = value_stack_offset;
+    add_node(math_type, inputs_stack_offsets, 0, 0);
+  }
+  else {
+    math_chain.node_index = current_svm_nodes.size();
+    add_node(NODE_MATH, math_type, inputs_stack_offsets, value_stack_offset);
+  }
+
+  if (need_constants) {
+    add_node(__float_as_int(value1_in->parent->get_float(value1_in->socket_type)),
+             __float_as_int(value2_in->parent->get_float(value2_in->socket_type)),
+             __float_as_int(value3_in->parent->get_float(value3_in->socket_type)),
+             0);
+  }
+
+  math_chain.output = value_out;
+  math_chain.end_index = current_svm_nodes.size();
+}
+
 uint SVMCompiler::attribute(ustring name)
 {
   return scene->shader_manager->get_attribute_id(name);
@@ -694,6 +783,9 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
         /* Fill in jump instruction location to be after closure. */
         current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
                                                     node_jump_skip_index - 1;
+
+        /* Nodes after the jump target must not be fused with nodes before it. */
+        math_chain = MathChain();
       }
 
       /* generate instructions for input closure 2 */
@@ -710,6 +802,8 @@ void SVMCompiler::generate_multi_closure(ShaderNode *root_node,
         /* Fill in jump instruction location to be after closure. */
         current_svm_nodes[node_jump_skip_index].y = current_svm_nodes.size() -
                                                     node_jump_skip_index - 1;
+
+        math_chain = MathChain();
       }
 
       /* unassign */
@@ -781,6 +875,7 @@ void SVMCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType ty
   /* clear all compiler state */
   memset((void *)&active_stack, 0, sizeof(active_stack));
   current_svm_nodes.clear();
+  math_chain = MathChain();
 
   foreach (ShaderNode *node, graph->nodes) {
     foreach (ShaderInput *input, node->inputs)
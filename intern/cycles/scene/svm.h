@@ -99,6 +99,11 @@ class SVMCompiler {
   void add_node(int a = 0, int b = 0, int c = 0, int d = 0);
   void add_node(ShaderNodeType type, const float3 &f);
   void add_node(const float4 &f);
+  void add_math_node(uint math_type,
+                     ShaderInput *value1_in,
+                     ShaderInput *value2_in,
+                     ShaderInput *value3_in,
+                     ShaderOutput *value_out);
   uint attribute(ustring name);
   uint attribute(AttributeStandard std);
   uint attribute_standard(ustring name);
@@ -220,6 +225,17 @@ class SVMCompiler {
   /* compile */
   void compile_type(Shader *shader, ShaderGraph *graph, ShaderType type);
 
+  /* Math node which was added last, and which the next math node can be fused with. */
+  struct MathChain {
+    /* Output of the last operation of the chain. */
+    ShaderOutput *output = NULL;
+    /* Index of the NODE_MATH or NODE_MATH_CHAIN node. */
+    int node_index = -1;
+    /* Number of SVM nodes right after the chain, used to detect other nodes added after it. */
+    int end_index = -1;
+  };
+  MathChain math_chain;
+
   std::atomic_int *svm_node_types_used;
   array<int4> current_svm_nodes;
   ShaderType current_type;
@@ -36,4 +36,44 @@ TEST(tile_calculate_best_size, Extreme)
             TileSize(1, 1, 1024));
 }
 
+TEST(tile_calculate_denoise_size, Basic)
+{
+  /* No memory limit. */
+  EXPECT_EQ(tile_calculate_denoise_size(make_int2(1920, 1080), 128, 48, 0), make_int2(1920, 1080));
+
+  /* Entire image fits into the memory limit. */
+  EXPECT_EQ(tile_calculate_denoise_size(make_int2(1920, 1080), 128, 48, 1024 * 1024 * 1024),
+            make_int2(1920, 1080));
+
+  /* Tiles with overlap fit into the memory limit, aligned to 16 pixels. */
+  EXPECT_EQ(tile_calculate_denoise_size(make_int2(16384, 16384), 128, 48, 128 * 1024 * 1024),
+            make_int2(1408, 1408));
+
+  /* Tiles do not exceed the image size. */
+  EXPECT_EQ(tile_calculate_denoise_size(make_int2(16384, 512), 128, 48, 128 * 1024 * 1024),
+            make_int2(1408, 512));
+}
+
+TEST(tile_calculate_denoise_size, MemoryBound)
+{
+  /* Buffers of a tile including its overlap stay within the memory limit. */
+  const int overlap = 128;
+  const size_t bytes_per_pixel = 48;
+  for (const size_t max_memory_mb : {16, 64, 128, 512, 2048}) {
+    const size_t max_memory = max_memory_mb * 1024 * 1024;
+    const int2 tile_size = tile_calculate_denoise_size(
+        make_int2(32768, 32768), overlap, bytes_per_pixel, max_memory);
+    const size_t tile_memory = size_t(tile_size.x + 2 * overlap) * (tile_size.y + 2 * overlap) *
+                               bytes_per_pixel;
+    EXPECT_LE(tile_memory, max_memory);
+  }
+}
+
+TEST(tile_calculate_denoise_size, Extreme)
+{
+  /* Tile size is clamped when the overlap alone does not fit into the memory limit. */
+  EXPECT_EQ(tile_calculate_denoise_size(make_int2(4096, 4096), 128, 48, 1024 * 1024),
+            make_int2(64, 64));
+}
+
 CCL_NAMESPACE_END
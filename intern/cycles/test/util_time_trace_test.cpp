@@ -0,0 +1,86 @@
+/* SPDX-FileCopyrightText: 2011-2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "util/time_trace.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(util_time_trace, disabled)
+{
+  {
+    scoped_time_trace trace(NULL, "test", "unused");
+  }
+  TimeTrace time_trace;
+  EXPECT_TRUE(time_trace.get_events().empty());
+}
+
+TEST(util_time_trace, nesting)
+{
+  TimeTrace time_trace;
+  {
+    scoped_time_trace outer(&time_trace, "test", "outer");
+    {
+      scoped_time_trace inner(&time_trace, "test", "inner");
+    }
+    {
+      scoped_time_trace inner(&time_trace, "test", "with/slash");
+    }
+  }
+
+  const vector<TimeTrace::Event> events = time_trace.get_events();
+  ASSERT_EQ(events.size(), 3);
+
+  /* Inner events finish first. */
+  EXPECT_EQ(events[0].name, "inner");
+  EXPECT_EQ(events[0].path, "outer/inner");
+  EXPECT_EQ(events[0].depth, 1);
+  EXPECT_EQ(events[1].name, "with/slash");
+  EXPECT_EQ(events[1].path, "outer/with_slash");
+  EXPECT_EQ(events[2].name, "outer");
+  EXPECT_EQ(events[2].path, "outer");
+  EXPECT_EQ(events[2].depth, 0);
+
+  EXPECT_LE(events[2].start_time, events[0].start_time);
+  EXPECT_GE(events[2].duration, events[0].duration);
+  EXPECT_EQ(events[0].thread_index, events[2].thread_index);
+
+  const string report = time_trace.full_report();
+  EXPECT_NE(report.find("outer"), string::npos);
+  EXPECT_NE(report.find("  inner"), string::npos);
+}
+
+TEST(util_time_trace, threads)
+{
+  TimeTrace time_trace;
+  {
+    scoped_time_trace trace(&time_trace, "test", "main");
+  }
+  std::thread worker([&time_trace]() { scoped_time_trace trace(&time_trace, "test", "worker"); });
+  worker.join();
+
+  const vector<TimeTrace::Event> events = time_trace.get_events();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].thread_index, 0);
+  EXPECT_EQ(events[1].thread_index, 1);
+  /* Worker thread does not inherit the path of other threads. */
+  EXPECT_EQ(events[1].path, "worker");
+}
+
+TEST(util_time_trace, chrome_trace)
+{
+  TimeTrace time_trace;
+  {
+    scoped_time_trace trace(&time_trace, "scene", "name \"quoted\"");
+  }
+
+  const string json = time_trace.chrome_trace_json();
+  EXPECT_NE(json.find("\"traceEvents\""), string::npos);
+  EXPECT_NE(json.find("\"name\":\"name \\\"quoted\\\"\""), string::npos);
+  EXPECT_NE(json.find("\"cat\":\"scene\""), string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), string::npos);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,262 @@
+/* SPDX-FileCopyrightText: 2011-2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "util/time_trace.h"
+
+#include <algorithm>
+
+#include "util/foreach.h"
+#include "util/path.h"
+#include "util/time.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Path and depth of the innermost active region of the current thread. */
+static thread_local string thread_trace_path;
+static thread_local int thread_trace_depth = 0;
+
+TimeTrace::TimeTrace()
+{
+  clear();
+}
+
+void TimeTrace::clear()
+{
+  thread_scoped_lock lock(mutex_);
+  events_.clear();
+  thread_indices_.clear();
+  time_origin_ = time_dt();
+}
+
+vector<TimeTrace::Event> TimeTrace::get_events() const
+{
+  thread_scoped_lock lock(mutex_);
+  return events_;
+}
+
+void TimeTrace::add_event(Event &&event)
+{
+  thread_scoped_lock lock(mutex_);
+  event.start_time -= time_origin_;
+  events_.push_back(std::move(event));
+}
+
+int TimeTrace::thread_index_get()
+{
+  const std::thread::id id = std::this_thread::get_id();
+
+  thread_scoped_lock lock(mutex_);
+  auto it = thread_indices_.find(id);
+  if (it != thread_indices_.end()) {
+    return it->second;
+  }
+
+  const int index = thread_indices_.size();
+  thread_indices_[id] = index;
+  return index;
+}
+
+/* Aggregated report. */
+
+namespace {
+
+struct TraceReportNode {
+  string name;
+  double time = 0.0;
+  int count = 0;
+  vector<TraceReportNode> children;
+
+  TraceReportNode &child(const string &child_name)
+  {
+    for (TraceReportNode &node : children) {
+      if (node.name == child_name) {
+        return node;
+      }
+    }
+    children.emplace_back();
+    children.back().name = child_name;
+    return children.back();
+  }
+
+  void report(string &result, const int indent_level, const double parent_time) const
+  {
+    const string indent(indent_level * 2, ' ');
+    if (parent_time > 0.0) {
+      result += string_printf("%s%-40s %10.4fs %6.2f%% (%d)\n",
+                              indent.c_str(),
+                              name.c_str(),
+                              time,
+                              100.0 * time / parent_time,
+                              count);
+    }
+    else {
+      result += string_printf("%s%-40s %10.4fs (%d)\n", indent.c_str(), name.c_str(), time, count);
+    }
+
+    for (const TraceReportNode &node : children) {
+      node.report(result, indent_level + 1, time);
+    }
+  }
+};
+
+}  // namespace
+
+string TimeTrace::full_report(int indent_level) const
+{
+  vector<Event> events = get_events();
+
+  /* Parents finish after their children, sort by start time so that the tree is built in the
+   * order the regions were entered. */
+  std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+    return a.start_time < b.start_time;
+  });
+
+  TraceReportNode root;
+  foreach (const Event &event, events) {
+    TraceReportNode *node = &root;
+    size_t begin = 0;
+    while (true) {
+      const size_t end = event.path.find('/', begin);
+      node = &node->child(event.path.substr(begin, end - begin));
+      if (end == string::npos) {
+        break;
+      }
+      begin = end + 1;
+    }
+    node->time += event.duration;
+    node->count++;
+  }
+
+  string result;
+  for (const TraceReportNode &node : root.children) {
+    node.report(result, indent_level, 0.0);
+  }
+  return result;
+}
+
+/* Chrome trace. */
+
+static string json_escape(const string &str)
+{
+  string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          result += string_printf("\\u%04x", (int)c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+string TimeTrace::chrome_trace_json() const
+{
+  const vector<Event> events = get_events();
+
+  int num_threads;
+  {
+    thread_scoped_lock lock(mutex_);
+    num_threads = thread_indices_.size();
+  }
+
+  string result = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+
+  for (int thread_index = 0; thread_index < num_threads; thread_index++) {
+    result += string_printf(
+        "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+        "\"args\":{\"name\":\"Thread %d\"}}",
+        first ? "" : ",\n",
+        thread_index,
+        thread_index);
+    first = false;
+  }
+
+  foreach (const Event &event, events) {
+    result += string_printf(
+        "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+        "\"ts\":%.3f,\"dur\":%.3f}",
+        first ? "" : ",\n",
+        json_escape(event.name).c_str(),
+        json_escape(event.category).c_str(),
+        event.thread_index,
+        event.start_time * 1e6,
+        event.duration * 1e6);
+    first = false;
+  }
+
+  result += "\n]}\n";
+  return result;
+}
+
+bool TimeTrace::write_chrome_trace(const string &filepath) const
+{
+  string text = chrome_trace_json();
+  return path_write_text(filepath, text);
+}
+
+/* Scoped region. */
+
+scoped_time_trace::scoped_time_trace(TimeTrace *trace, const char *category, const string &name)
+    : trace_(trace), category_(category), parent_path_length_(0), depth_(0), time_start_(0.0)
+{
+  if (trace_ == NULL) {
+    return;
+  }
+
+  name_ = name;
+  parent_path_length_ = thread_trace_path.size();
+  if (parent_path_length_) {
+    thread_trace_path += '/';
+  }
+  /* Names are user data such as object names, keep the path separator unambiguous. */
+  for (const char c : name_) {
+    thread_trace_path += (c == '/') ? '_' : c;
+  }
+  depth_ = thread_trace_depth++;
+  time_start_ = time_dt();
+}
+
+scoped_time_trace::~scoped_time_trace()
+{
+  if (trace_ == NULL) {
+    return;
+  }
+
+  const double time_end = time_dt();
+
+  TimeTrace::Event event;
+  event.name = std::move(name_);
+  event.category = category_;
+  event.path = thread_trace_path;
+  event.thread_index = trace_->thread_index_get();
+  event.depth = depth_;
+  event.start_time = time_start_;
+  event.duration = time_end - time_start_;
+
+  thread_trace_path.resize(parent_path_length_);
+  thread_trace_depth--;
+
+  trace_->add_event(std::move(event));
+}
+
+CCL_NAMESPACE_END
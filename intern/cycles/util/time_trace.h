@@ -0,0 +1,89 @@
+/* SPDX-FileCopyrightText: 2011-2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#ifndef __UTIL_TIME_TRACE_H__
+#define __UTIL_TIME_TRACE_H__
+
+#include "util/map.h"
+#include "util/string.h"
+#include "util/thread.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Hierarchical, thread-aware recording of timed regions.
+ *
+ * Used to find out where time goes while synchronizing and updating the scene, which is not
+ * covered by the sampling Profiler. Regions are recorded with scoped_time_trace, nesting is
+ * tracked per thread, so regions started from worker threads (BVH builds, image loading) end up
+ * on their own timeline.
+ *
+ * The result can be printed as an aggregated report or written as a Chrome trace JSON file which
+ * can be opened in chrome://tracing or https://ui.perfetto.dev. */
+class TimeTrace {
+ public:
+  struct Event {
+    string name;
+    string category;
+    /* Hierarchical path of the event on its thread, names separated by '/'. */
+    string path;
+    /* Sequential index of the thread which recorded the event. */
+    int thread_index;
+    /* Nesting level of the event on its thread. */
+    int depth;
+    /* Start time in seconds relative to the creation of the trace, and duration in seconds. */
+    double start_time;
+    double duration;
+  };
+
+  TimeTrace();
+
+  /* Remove all recorded events and restart the time origin. */
+  void clear();
+
+  /* Copy of all events recorded so far, in the order they were finished. */
+  vector<Event> get_events() const;
+
+  /* Human-readable report with the inclusive time and call count of each event path. */
+  string full_report(int indent_level = 0) const;
+
+  /* Trace in the Chrome trace event format. */
+  string chrome_trace_json() const;
+  bool write_chrome_trace(const string &filepath) const;
+
+ protected:
+  friend class scoped_time_trace;
+
+  void add_event(Event &&event);
+  int thread_index_get();
+
+  double time_origin_;
+
+  mutable thread_mutex mutex_;
+  vector<Event> events_;
+  map<std::thread::id, int> thread_indices_;
+};
+
+/* Record the lifetime of this object as a region in the trace. Does nothing when the trace is
+ * NULL, so it is cheap to leave in place when tracing is disabled. */
+class scoped_time_trace {
+ public:
+  scoped_time_trace(TimeTrace *trace, const char *category, const string &name);
+  ~scoped_time_trace();
+
+  scoped_time_trace(const scoped_time_trace &other) = delete;
+  scoped_time_trace &operator=(const scoped_time_trace &other) = delete;
+
+ protected:
+  TimeTrace *trace_;
+  const char *category_;
+  string name_;
+  size_t parent_path_length_;
+  int depth_;
+  double time_start_;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __UTIL_TIME_TRACE_H__ */
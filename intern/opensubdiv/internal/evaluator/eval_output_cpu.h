@@ -13,19 +13,77 @@
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/cpuVertexBuffer.h>
 
+#ifdef WITH_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 using OpenSubdiv::Far::StencilTable;
+using OpenSubdiv::Osd::BufferDescriptor;
 using OpenSubdiv::Osd::CpuEvaluator;
 using OpenSubdiv::Osd::CpuVertexBuffer;
 
 namespace blender::opensubdiv {
 
+// CPU evaluator which evaluates stencils in parallel.
+//
+// Stencils are factorized down to the control vertices, so every refined vertex only reads from
+// the coarse vertices and the stencils can be evaluated in any order. Patch evaluation is left to
+// the regular CPU evaluator.
+class ParallelCpuEvaluator : public CpuEvaluator {
+ public:
+  // Number of stencils evaluated by a single task.
+  static constexpr int kStencilsGrainSize = 1024;
+
+  template<typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+  static bool EvalStencils(SRC_BUFFER *src_buffer,
+                           const BufferDescriptor &src_desc,
+                           DST_BUFFER *dst_buffer,
+                           const BufferDescriptor &dst_desc,
+                           const STENCIL_TABLE *stencil_table,
+                           const ParallelCpuEvaluator * /*instance*/ = NULL,
+                           void * /*device_context*/ = NULL)
+  {
+    const int num_stencils = stencil_table->GetNumStencils();
+    if (num_stencils == 0) {
+      return false;
+    }
+    const float *src = src_buffer->BindCpuBuffer();
+    float *dst = dst_buffer->BindCpuBuffer();
+    const int *sizes = &stencil_table->GetSizes()[0];
+    const int *offsets = &stencil_table->GetOffsets()[0];
+    const int *indices = &stencil_table->GetControlIndices()[0];
+    const float *weights = &stencil_table->GetWeights()[0];
+#ifdef WITH_TBB
+    // Ranges are never empty, so evaluation of a range can not fail.
+    tbb::parallel_for(tbb::blocked_range<int>(0, num_stencils, kStencilsGrainSize),
+                      [&](const tbb::blocked_range<int> &range) {
+                        CpuEvaluator::EvalStencils(src,
+                                                   src_desc,
+                                                   dst,
+                                                   dst_desc,
+                                                   sizes,
+                                                   offsets,
+                                                   indices,
+                                                   weights,
+                                                   range.begin(),
+                                                   range.end());
+                      });
+    return true;
+#else
+    return CpuEvaluator::EvalStencils(
+        src, src_desc, dst, dst_desc, sizes, offsets, indices, weights, 0, num_stencils);
+#endif
+  }
+};
+
 // NOTE: Define as a class instead of typedef to make it possible
 // to have anonymous class in opensubdiv_evaluator_internal.h
 class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                                                 CpuVertexBuffer,
                                                 StencilTable,
                                                 CpuPatchTable,
-                                                CpuEvaluator> {
+                                                ParallelCpuEvaluator> {
  public:
   CpuEvalOutput(const StencilTable *vertex_stencils,
                 const StencilTable *varying_stencils,
@@ -37,7 +95,7 @@ class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                            CpuVertexBuffer,
                            StencilTable,
                            CpuPatchTable,
-                           CpuEvaluator>(vertex_stencils,
+                           ParallelCpuEvaluator>(vertex_stencils,
                                          varying_stencils,
                                          all_face_varying_stencils,
                                          face_varying_width,
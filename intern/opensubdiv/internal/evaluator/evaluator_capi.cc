@@ -281,6 +281,37 @@ void openSubdiv_deleteEvaluator(OpenSubdiv_Evaluator *evaluator)
   MEM_delete(evaluator);
 }
 
+OpenSubdiv_EvaluatorTables *openSubdiv_createEvaluatorTables(
+    OpenSubdiv_TopologyRefiner *topology_refiner)
+{
+  OpenSubdiv_EvaluatorTables *evaluator_tables = MEM_new<OpenSubdiv_EvaluatorTables>(__func__);
+  evaluator_tables->impl = openSubdiv_createEvaluatorTablesInternal(topology_refiner);
+  return evaluator_tables;
+}
+
+void openSubdiv_deleteEvaluatorTables(OpenSubdiv_EvaluatorTables *evaluator_tables)
+{
+  if (!evaluator_tables) {
+    return;
+  }
+
+  openSubdiv_deleteEvaluatorTablesInternal(evaluator_tables->impl);
+  MEM_delete(evaluator_tables);
+}
+
+OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTables(
+    const OpenSubdiv_EvaluatorTables *evaluator_tables,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCache *evaluator_cache)
+{
+  OpenSubdiv_Evaluator *evaluator = MEM_new<OpenSubdiv_Evaluator>(__func__);
+  assignFunctionPointers(evaluator);
+  evaluator->impl = openSubdiv_createEvaluatorFromTablesInternal(
+      evaluator_tables->impl, evaluator_type, evaluator_cache ? evaluator_cache->impl : nullptr);
+  evaluator->type = evaluator->impl ? evaluator_type : static_cast<eOpenSubdivEvaluator>(0);
+  return evaluator;
+}
+
 OpenSubdiv_EvaluatorCache *openSubdiv_createEvaluatorCache(eOpenSubdivEvaluator evaluator_type)
 {
   OpenSubdiv_EvaluatorCache *evaluator_cache = MEM_new<OpenSubdiv_EvaluatorCache>(__func__);
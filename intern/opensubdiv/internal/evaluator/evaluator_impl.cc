@@ -8,6 +8,7 @@
 
 #include <cassert>
 #include <cstdio>
+#include <utility>
 
 #ifdef _MSC_VER
 #  include <iso646.h>
@@ -408,7 +409,7 @@ bool EvalOutputAPI::hasVertexData() const
 }  // namespace blender::opensubdiv
 
 OpenSubdiv_EvaluatorImpl::OpenSubdiv_EvaluatorImpl()
-    : eval_output(NULL), patch_map(NULL), patch_table(NULL)
+    : eval_output(NULL), patch_map(NULL)
 {
 }
 
@@ -416,13 +417,25 @@ OpenSubdiv_EvaluatorImpl::~OpenSubdiv_EvaluatorImpl()
 {
   delete eval_output;
   delete patch_map;
+}
+
+OpenSubdiv_EvaluatorTablesImpl::OpenSubdiv_EvaluatorTablesImpl()
+    : vertex_stencils(NULL), varying_stencils(NULL), patch_table(NULL)
+{
+}
+
+OpenSubdiv_EvaluatorTablesImpl::~OpenSubdiv_EvaluatorTablesImpl()
+{
+  delete vertex_stencils;
+  delete varying_stencils;
+  for (const StencilTable *table : all_face_varying_stencils) {
+    delete table;
+  }
   delete patch_table;
 }
 
-OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
-    OpenSubdiv_TopologyRefiner *topology_refiner,
-    eOpenSubdivEvaluator evaluator_type,
-    OpenSubdiv_EvaluatorCacheImpl *evaluator_cache_descr)
+OpenSubdiv_EvaluatorTablesImpl *openSubdiv_createEvaluatorTablesInternal(
+    OpenSubdiv_TopologyRefiner *topology_refiner)
 {
   TopologyRefiner *refiner = topology_refiner->impl->topology_refiner;
   if (refiner == NULL) {
@@ -526,7 +539,36 @@ OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
       all_face_varying_stencils[face_varying_channel] = table;
     }
   }
+  // Wrap all tables into an object which we control from our side.
+  OpenSubdiv_EvaluatorTablesImpl *evaluator_tables = new OpenSubdiv_EvaluatorTablesImpl();
+  evaluator_tables->vertex_stencils = vertex_stencils;
+  evaluator_tables->varying_stencils = varying_stencils;
+  evaluator_tables->all_face_varying_stencils = std::move(all_face_varying_stencils);
+  evaluator_tables->patch_table = patch_table;
+  return evaluator_tables;
+}
+
+void openSubdiv_deleteEvaluatorTablesInternal(OpenSubdiv_EvaluatorTablesImpl *evaluator_tables)
+{
+  delete evaluator_tables;
+}
+
+OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorFromTablesInternal(
+    const OpenSubdiv_EvaluatorTablesImpl *evaluator_tables,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCacheImpl *evaluator_cache_descr)
+{
+  if (evaluator_tables == NULL) {
+    return NULL;
+  }
+  const StencilTable *vertex_stencils = evaluator_tables->vertex_stencils;
+  const StencilTable *varying_stencils = evaluator_tables->varying_stencils;
+  const std::vector<const StencilTable *> &all_face_varying_stencils =
+      evaluator_tables->all_face_varying_stencils;
+  const PatchTable *patch_table = evaluator_tables->patch_table;
   // Create OpenSubdiv's CPU side evaluator.
+  // NOTE: Evaluators copy the stencil and patch tables, so they do not depend on the lifetime of
+  // the evaluator tables.
   blender::opensubdiv::EvalOutputAPI::EvalOutput *eval_output = nullptr;
 
   const bool use_gpu_evaluator = evaluator_type == OPENSUBDIV_EVALUATOR_GPU;
@@ -556,13 +598,19 @@ OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
 
   evaluator_descr->eval_output = new blender::opensubdiv::EvalOutputAPI(eval_output, patch_map);
   evaluator_descr->patch_map = patch_map;
-  evaluator_descr->patch_table = patch_table;
-  // TODO(sergey): Look into whether we've got duplicated stencils arrays.
-  delete vertex_stencils;
-  delete varying_stencils;
-  for (const StencilTable *table : all_face_varying_stencils) {
-    delete table;
-  }
+  return evaluator_descr;
+}
+
+OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
+    OpenSubdiv_TopologyRefiner *topology_refiner,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCacheImpl *evaluator_cache_descr)
+{
+  OpenSubdiv_EvaluatorTablesImpl *evaluator_tables = openSubdiv_createEvaluatorTablesInternal(
+      topology_refiner);
+  OpenSubdiv_EvaluatorImpl *evaluator_descr = openSubdiv_createEvaluatorFromTablesInternal(
+      evaluator_tables, evaluator_type, evaluator_cache_descr);
+  openSubdiv_deleteEvaluatorTablesInternal(evaluator_tables);
   return evaluator_descr;
 }
 
@@ -11,8 +11,11 @@
 #  include <iso646.h>
 #endif
 
+#include <vector>
+
 #include <opensubdiv/far/patchMap.h>
 #include <opensubdiv/far/patchTable.h>
+#include <opensubdiv/far/stencilTable.h>
 
 #include "internal/base/memory.h"
 
@@ -191,11 +194,36 @@ struct OpenSubdiv_EvaluatorImpl {
 
   blender::opensubdiv::EvalOutputAPI *eval_output;
   const blender::opensubdiv::PatchMap *patch_map;
-  const OpenSubdiv::Far::PatchTable *patch_table;
 
   MEM_CXX_CLASS_ALLOC_FUNCS("OpenSubdiv_EvaluatorImpl");
 };
 
+// Stencil and patch tables of a refined topology. They are only read when creating evaluators,
+// which copy them into their own buffers, so the same tables can be used to create evaluators
+// for any number of meshes with the same topology, from multiple threads.
+struct OpenSubdiv_EvaluatorTablesImpl {
+ public:
+  OpenSubdiv_EvaluatorTablesImpl();
+  ~OpenSubdiv_EvaluatorTablesImpl();
+
+  const OpenSubdiv::Far::StencilTable *vertex_stencils;
+  const OpenSubdiv::Far::StencilTable *varying_stencils;
+  std::vector<const OpenSubdiv::Far::StencilTable *> all_face_varying_stencils;
+  const OpenSubdiv::Far::PatchTable *patch_table;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("OpenSubdiv_EvaluatorTablesImpl");
+};
+
+OpenSubdiv_EvaluatorTablesImpl *openSubdiv_createEvaluatorTablesInternal(
+    OpenSubdiv_TopologyRefiner *topology_refiner);
+
+void openSubdiv_deleteEvaluatorTablesInternal(OpenSubdiv_EvaluatorTablesImpl *evaluator_tables);
+
+OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorFromTablesInternal(
+    const OpenSubdiv_EvaluatorTablesImpl *evaluator_tables,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCacheImpl *evaluator_cache_descr);
+
 OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
     OpenSubdiv_TopologyRefiner *topology_refiner,
     eOpenSubdivEvaluator evaluator_type,
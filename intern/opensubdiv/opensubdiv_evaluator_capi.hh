@@ -10,6 +10,7 @@
 
 struct OpenSubdiv_EvaluatorCacheImpl;
 struct OpenSubdiv_EvaluatorImpl;
+struct OpenSubdiv_EvaluatorTablesImpl;
 struct OpenSubdiv_EvaluatorInternal;
 struct OpenSubdiv_PatchCoord;
 class OpenSubdiv_TopologyRefiner;
@@ -224,6 +225,12 @@ struct OpenSubdiv_EvaluatorCache {
   OpenSubdiv_EvaluatorCacheImpl *impl;
 };
 
+// Stencil and patch tables of a refined topology, shared by all evaluators created from them.
+struct OpenSubdiv_EvaluatorTables {
+  // Implementation of the evaluator tables.
+  OpenSubdiv_EvaluatorTablesImpl *impl;
+};
+
 OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
     OpenSubdiv_TopologyRefiner *topology_refiner,
     eOpenSubdivEvaluator evaluator_type,
@@ -231,6 +238,22 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
 
 void openSubdiv_deleteEvaluator(OpenSubdiv_Evaluator *evaluator);
 
+// Refine the topology and create the tables needed to create evaluators for it.
+//
+// NOTE: The topology refiner is refined in place, so no evaluator can be created from it with
+// openSubdiv_createEvaluatorFromTopologyRefiner() afterwards.
+OpenSubdiv_EvaluatorTables *openSubdiv_createEvaluatorTables(
+    OpenSubdiv_TopologyRefiner *topology_refiner);
+
+void openSubdiv_deleteEvaluatorTables(OpenSubdiv_EvaluatorTables *evaluator_tables);
+
+// Create an evaluator from tables of the same topology. The tables are only read, so this can
+// be called from multiple threads at once, and they can be deleted while the evaluator is used.
+OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTables(
+    const OpenSubdiv_EvaluatorTables *evaluator_tables,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCache *evaluator_cache);
+
 OpenSubdiv_EvaluatorCache *openSubdiv_createEvaluatorCache(eOpenSubdivEvaluator evaluator_type);
 
 void openSubdiv_deleteEvaluatorCache(OpenSubdiv_EvaluatorCache *evaluator_cache);
@@ -18,6 +18,22 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
 
 void openSubdiv_deleteEvaluator(OpenSubdiv_Evaluator * /*evaluator*/) {}
 
+OpenSubdiv_EvaluatorTables *openSubdiv_createEvaluatorTables(
+    OpenSubdiv_TopologyRefiner * /*topology_refiner*/)
+{
+  return NULL;
+}
+
+void openSubdiv_deleteEvaluatorTables(OpenSubdiv_EvaluatorTables * /*evaluator_tables*/) {}
+
+OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTables(
+    const OpenSubdiv_EvaluatorTables * /*evaluator_tables*/,
+    eOpenSubdivEvaluator /*evaluator_type*/,
+    OpenSubdiv_EvaluatorCache * /*evaluator_cache*/)
+{
+  return NULL;
+}
+
 OpenSubdiv_EvaluatorCache *openSubdiv_createEvaluatorCache(eOpenSubdivEvaluator /*evaluator_type*/)
 {
   return NULL;
@@ -2403,6 +2403,32 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
         col.prop(ed, "use_cache_final", text="Final")
 
 
+class SEQUENCER_PT_cache_statistics(SequencerButtonsPanel, Panel):
+    bl_label = "Statistics"
+    bl_category = "Cache"
+    bl_parent_id = "SEQUENCER_PT_cache_settings"
+    bl_options = {'DEFAULT_CLOSED'}
+
+    @classmethod
+    def poll(cls, context):
+        return cls.has_sequencer(context) and context.scene.sequence_editor
+
+    def draw(self, context):
+        layout = self.layout
+        layout.use_property_split = True
+        layout.use_property_decorate = False
+
+        ed = context.scene.sequence_editor
+
+        col = layout.column()
+        col.prop(ed, "cache_items", text="Images")
+        col.prop(ed, "cache_memory", text="Memory")
+        col.prop(ed, "cache_hit_ratio", text="Hit Ratio")
+        col.prop(ed, "cache_hits", text="Hits")
+        col.prop(ed, "cache_misses", text="Misses")
+        col.prop(ed, "cache_evicted_frames", text="Evicted Frames")
+
+
 class SEQUENCER_PT_cache_view_settings(SequencerButtonsPanel, Panel):
     bl_label = "Display"
     bl_category = "Cache"
@@ -2597,6 +2623,9 @@ class SEQUENCER_PT_view(SequencerButtonsPanel_Output, Panel):
         col = layout.column()
         if ed:
             col.prop(ed, "use_prefetch")
+            sub = col.column()
+            sub.active = ed.use_prefetch
+            sub.prop(ed, "use_prefetch_parallel")
 
         col.prop(st, "display_channel", text="Channel")
 
@@ -3028,6 +3057,7 @@ classes = (
     SEQUENCER_PT_modifiers,
 
     SEQUENCER_PT_cache_settings,
+    SEQUENCER_PT_cache_statistics,
     SEQUENCER_PT_cache_view_settings,
     SEQUENCER_PT_strip_cache,
     SEQUENCER_PT_proxy_settings,
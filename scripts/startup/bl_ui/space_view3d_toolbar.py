@@ -1081,6 +1081,7 @@ class VIEW3D_PT_sculpt_options(Panel, View3DPaintPanel):
         col.prop(sculpt, "show_low_resolution")
         col.prop(sculpt, "use_sculpt_delay_updates")
         col.prop(sculpt, "use_deform_only")
+        col.prop(sculpt, "use_spatial_reorder")
 
 
 class VIEW3D_PT_sculpt_options_gravity(Panel, View3DPaintPanel):
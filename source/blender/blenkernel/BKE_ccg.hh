@@ -9,6 +9,7 @@
  */
 
 #include "BLI_assert.h"
+#include "BLI_index_range.hh"
 #include "BLI_math_vector_types.hh"
 
 struct CCGSubSurf;
@@ -19,6 +20,10 @@ struct CCGSubSurf;
  * this reason, CCGElem is presented as an opaque pointer, and
  * elements should always be accompanied by a CCGKey, which provides
  * the necessary offsets to access components of a CCGElem.
+ *
+ * NOTE: Only the legacy #CCGSubSurf uses this interleaved layout. #SubdivCCG stores every layer
+ * in a separate array, which are accessed with the indices from #blender::bke::ccg::grid_range
+ * and #blender::bke::ccg::grid_xy_to_vert instead.
  */
 struct CCGElem;
 
@@ -119,3 +124,24 @@ inline CCGElem *CCG_elem_next(const CCGKey &key, CCGElem *elem)
 {
   return CCG_elem_offset(key, elem, 1);
 }
+
+namespace blender::bke::ccg {
+
+/** The range of the elements of a grid in the per-element arrays of a #SubdivCCG. */
+inline IndexRange grid_range(const int grid_area, const int grid)
+{
+  return IndexRange(int64_t(grid) * grid_area, grid_area);
+}
+
+inline IndexRange grid_range(const CCGKey &key, const int grid)
+{
+  return grid_range(key.grid_area, grid);
+}
+
+/** The index of a grid element in the per-element arrays of a #SubdivCCG. */
+inline int grid_xy_to_vert(const CCGKey &key, const int grid, const int x, const int y)
+{
+  return key.grid_area * grid + CCG_grid_xy_to_index(key.grid_size, x, y);
+}
+
+}  // namespace blender::bke::ccg
@@ -658,6 +658,11 @@ void BKE_image_partial_update_mark_region(struct Image *image,
                                           const rcti *updated_region);
 /** \brief Mark the whole image to be updated. */
 void BKE_image_partial_update_mark_full_update(struct Image *image);
+/**
+ * \brief Identifier of the last changes of the image. It changes when the whole image is marked
+ * to be updated, and when changes to regions have been collected by a partial update user.
+ */
+int64_t BKE_image_partial_update_changeset_id(const struct Image *image);
 
 #ifdef __cplusplus
 }
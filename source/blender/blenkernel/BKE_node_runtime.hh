@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 
 #include "BLI_cache_mutex.hh"
 #include "BLI_math_vector_types.hh"
@@ -135,6 +136,12 @@ class bNodeTreeRuntime : NonCopyable, NonMovable {
   void (*update_draw)(void *) = nullptr;
   void *tbh = nullptr, *prh = nullptr, *sdh = nullptr, *udh = nullptr;
 
+  /**
+   * Normalized region of the compositor viewer image that is visible in the node editors. When
+   * set, the compositor only computes that region of the viewer output.
+   */
+  std::optional<rctf> viewer_region;
+
   /* End legacy execution data. */
 
   /** Information about how inputs and outputs of the node group interact with fields. */
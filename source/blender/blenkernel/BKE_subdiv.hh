@@ -19,6 +19,8 @@ class OpenSubdiv_TopologyRefiner;
 
 namespace blender::bke::subdiv {
 
+struct SharedTopology;
+
 enum VtxBoundaryInterpolation {
   /* Do not interpolate boundaries. */
   SUBDIV_VTX_BOUNDARY_NONE,
@@ -160,6 +162,9 @@ struct Subdiv {
    * topology to OpenSubdiv. It can be shared by both evaluator and GL mesh
    * drawer. */
   OpenSubdiv_TopologyRefiner *topology_refiner;
+  /* Topology shared with subdivision surfaces of other meshes with the same topology. When set,
+   * the topology refiner belongs to it and is already refined. */
+  SharedTopology *shared_topology;
   /* CPU side evaluator. */
   OpenSubdiv_Evaluator *evaluator;
   /* Optional displacement evaluator. */
@@ -64,7 +64,7 @@ struct SubdivToCCGSettings {
 };
 
 struct SubdivCCGCoord {
-  /* Index of the grid within SubdivCCG::grids array. */
+  /* Index of the grid within the SubdivCCG grids. */
   int grid_index;
 
   /* Coordinate within the grid. */
@@ -122,37 +122,21 @@ struct SubdivCCG : blender::NonCopyable {
   /* Resolution of grid. All grids have matching resolution, and resolution
    * is same as ptex created for non-quad faces. */
   int grid_size = -1;
-  /* Size of a single element of a grid (including coordinate and all the other layers).
-   * Measured in bytes. */
-  int grid_element_size = -1;
+  /* Number of grids, one for every face corner of the coarse mesh. */
+  int grids_num = 0;
   /* Grids represent limit surface, with displacement applied. Grids are
    * corresponding to face-corners of coarse mesh, each grid has
    * grid_size^2 elements.
-   */
-  /* Indexed by a grid index, points to a grid data which is stored in
-   * grids_storage. */
-  blender::Array<CCGElem *> grids;
-  /* Flat array of all grids' data. */
-  blender::Array<uchar> grids_storage;
-  /* Loose edges, each array element contains grid_size elements
-   * corresponding to vertices created by subdividing coarse edges. */
-  CCGElem **edges = nullptr;
-  int num_edges = -1;
-  /* Loose vertices. Every element corresponds to a loose vertex from a coarse
-   * mesh, every coarse loose vertex corresponds to a single subdivided
-   * element. */
-  CCGElem *vertices = nullptr;
-  int num_vertices = -1;
-  /* Denotes which layers present in the elements.
    *
-   * Grids always has coordinates, followed by extra layers which are set to
-   * truth here.
-   */
-  bool has_normal = false;
-  bool has_mask = false;
-  /* Offsets of corresponding data layers in the elements. */
-  int normal_offset = -1;
-  int mask_offset = -1;
+   * Every layer of the grids is stored in its own flat array, so that the data of a single layer
+   * is contiguous. The elements of a grid are stored after each other, so the values of a grid
+   * are in the range returned by #blender::bke::ccg::grid_range, and an element within the grid
+   * is found with #CCG_grid_xy_to_index. */
+  blender::Array<blender::float3> positions;
+  /* Only allocated when #SubdivToCCGSettings::need_normal is set. */
+  blender::Array<blender::float3> normals;
+  /* Only allocated when #SubdivToCCGSettings::need_mask is set. */
+  blender::Array<float> masks;
 
   /* Faces from which grids are emitted. Owned by base mesh. */
   blender::OffsetIndices<int> faces;
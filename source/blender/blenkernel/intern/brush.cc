@@ -11,6 +11,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "DNA_brush_types.h"
+#include "DNA_color_types.h"
 #include "DNA_defaults.h"
 #include "DNA_material_types.h"
 #include "DNA_scene_types.h"
@@ -1498,6 +1499,66 @@ void BKE_brush_randomize_texture_coords(UnifiedPaintSettings *ups, bool mask)
   }
 }
 
+/**
+ * Multiply the factors with the falloff calculated from the normalized inverted distance, and
+ * clear the factors of all elements outside of the brush radius. The inverted distance is
+ * clamped and the factor is chosen without a branch, which allows the loop to be vectorized.
+ */
+template<typename Fn>
+static void calc_curve_factors(const blender::Span<float> distances,
+                               const float brush_radius,
+                               const blender::MutableSpan<float> factors,
+                               const Fn &fn)
+{
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  for (const int i : distances.index_range()) {
+    const float distance = distances[i];
+    const float factor = std::max(1.0f - distance * radius_rcp, 0.0f);
+    factors[i] = distance < brush_radius ? factors[i] * fn(factor) : 0.0f;
+  }
+}
+
+/**
+ * Same as #BKE_curvemapping_evaluateF for the first curve, but with the table lookup inlined,
+ * since the brush falloff is evaluated for every vertex in the brush radius.
+ */
+static void calc_custom_curve_factors(const CurveMapping &cumap,
+                                      const blender::Span<float> distances,
+                                      const float brush_radius,
+                                      const blender::MutableSpan<float> factors)
+{
+  const CurveMap &cuma = cumap.cm[0];
+  const CurveMapPoint *table = cuma.table;
+  const bool do_clip = cumap.flag & CUMA_DO_CLIP;
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  for (const int i : distances.index_range()) {
+    const float distance = distances[i];
+    if (distance >= brush_radius) {
+      factors[i] = 0.0f;
+      continue;
+    }
+    const float x = distance * radius_rcp;
+    const float table_index = (x - cuma.mintable) * cuma.range;
+    if (!(table_index >= 0.0f && table_index < float(CM_TABLE))) {
+      /* Extrapolation and the end of the table are handled by the generic evaluation. */
+      factors[i] *= BKE_curvemapping_evaluateF(&cumap, 0, x);
+      continue;
+    }
+    const int index = int(table_index);
+    const float t = table_index - float(index);
+    float value = (1.0f - t) * table[index].y + t * table[index + 1].y;
+    if (do_clip) {
+      if (value < cumap.clipr.ymin) {
+        value = cumap.clipr.ymin;
+      }
+      else if (value > cumap.clipr.ymax) {
+        value = cumap.clipr.ymax;
+      }
+    }
+    factors[i] *= value;
+  }
+}
+
 void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
                                   const CurveMapping *cumap,
                                   const blender::Span<float> distances,
@@ -1506,116 +1567,57 @@ void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
 {
   BLI_assert(factors.size() == distances.size());
 
-  const float radius_rcp = blender::math::rcp(brush_radius);
   switch (preset) {
     case BRUSH_CURVE_CUSTOM: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        factors[i] *= BKE_curvemapping_evaluateF(cumap, 0, distance * radius_rcp);
-      }
+      calc_custom_curve_factors(*cumap, distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_SHARP: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor;
-      }
+      calc_curve_factors(
+          distances, brush_radius, factors, [](const float factor) { return factor * factor; });
       break;
     }
     case BRUSH_CURVE_SMOOTH: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= 3.0f * factor * factor - 2.0f * factor * factor * factor;
-      }
+      calc_curve_factors(distances, brush_radius, factors, [](const float factor) {
+        return 3.0f * factor * factor - 2.0f * factor * factor * factor;
+      });
       break;
     }
     case BRUSH_CURVE_SMOOTHER: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
-      }
+      calc_curve_factors(distances, brush_radius, factors, [](const float factor) {
+        return pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
+      });
       break;
     }
     case BRUSH_CURVE_ROOT: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(factor);
-      }
+      calc_curve_factors(
+          distances, brush_radius, factors, [](const float factor) { return sqrtf(factor); });
       break;
     }
     case BRUSH_CURVE_LIN: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor;
-      }
+      calc_curve_factors(
+          distances, brush_radius, factors, [](const float factor) { return factor; });
       break;
     }
     case BRUSH_CURVE_CONSTANT: {
       break;
     }
     case BRUSH_CURVE_SPHERE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(2 * factor - factor * factor);
-      }
+      calc_curve_factors(distances, brush_radius, factors, [](const float factor) {
+        return sqrtf(2 * factor - factor * factor);
+      });
       break;
     }
     case BRUSH_CURVE_POW4: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor * factor * factor;
-      }
+      calc_curve_factors(distances, brush_radius, factors, [](const float factor) {
+        return factor * factor * factor * factor;
+      });
       break;
     }
     case BRUSH_CURVE_INVSQUARE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * (2.0f - factor);
-      }
+      calc_curve_factors(distances, brush_radius, factors, [](const float factor) {
+        return factor * (2.0f - factor);
+      });
       break;
     }
   }
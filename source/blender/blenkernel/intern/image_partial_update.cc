@@ -589,4 +589,14 @@ void BKE_image_partial_update_mark_full_update(Image *image)
   PartialUpdateRegisterImpl *partial_updater = unwrap(image_partial_update_register_ensure(image));
   partial_updater->mark_full_update();
 }
+
+int64_t BKE_image_partial_update_changeset_id(const Image *image)
+{
+  const PartialUpdateRegisterImpl *partial_updater = unwrap(
+      image->runtime.partial_update_register);
+  if (partial_updater == nullptr) {
+    return UnknownChangesetID;
+  }
+  return partial_updater->last_changeset_id;
+}
 }
@@ -23,9 +23,13 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
   const int reshape_grid_size = reshape_context->reshape.grid_size;
   const float reshape_grid_size_1_inv = 1.0f / (float(reshape_grid_size) - 1.0f);
 
-  int num_grids = subdiv_ccg->grids.size();
+  const int grid_area = subdiv_ccg->grid_size * subdiv_ccg->grid_size;
+  const blender::Span<blender::float3> positions = subdiv_ccg->positions;
+  const blender::Span<float> masks = subdiv_ccg->masks;
+
+  int num_grids = subdiv_ccg->grids_num;
   for (int grid_index = 0; grid_index < num_grids; ++grid_index) {
-    CCGElem *ccg_grid = subdiv_ccg->grids[grid_index];
+    const blender::IndexRange ccg_grid = blender::bke::ccg::grid_range(grid_area, grid_index);
     for (int y = 0; y < reshape_grid_size; ++y) {
       const float v = float(y) * reshape_grid_size_1_inv;
       for (int x = 0; x < reshape_grid_size; ++x) {
@@ -39,10 +43,10 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
         ReshapeGridElement grid_element = multires_reshape_grid_element_for_grid_coord(
             reshape_context, &grid_coord);
 
+        const int ccg_index = ccg_grid[CCG_grid_xy_to_index(reshape_level_key.grid_size, x, y)];
+
         BLI_assert(grid_element.displacement != nullptr);
-        memcpy(grid_element.displacement,
-               CCG_grid_elem_co(reshape_level_key, ccg_grid, x, y),
-               sizeof(float[3]));
+        memcpy(grid_element.displacement, positions[ccg_index], sizeof(float[3]));
 
         /* NOTE: The sculpt mode might have SubdivCCG's data out of sync from what is stored in
          * the original object. This happens in the following scenario:
@@ -67,7 +71,7 @@ bool multires_reshape_assign_final_coords_from_ccg(const MultiresReshapeContext
          * after a Memfile one to never be undone (see #83806). This might be the root cause of
          * this inconsistency. */
         if (reshape_level_key.has_mask && grid_element.mask != nullptr) {
-          *grid_element.mask = CCG_grid_elem_mask(reshape_level_key, ccg_grid, x, y);
+          *grid_element.mask = masks[ccg_index];
         }
       }
     }
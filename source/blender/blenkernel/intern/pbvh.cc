@@ -423,6 +423,54 @@ std::unique_ptr<Tree> build_mesh(const Mesh &mesh)
   return pbvh;
 }
 
+void calc_leaf_order_mesh(const Mesh &mesh,
+                          const Tree &pbvh,
+                          MutableSpan<int> r_face_order,
+                          MutableSpan<int> r_vert_order)
+{
+  BLI_assert(pbvh.type() == Type::Mesh);
+  BLI_assert(r_face_order.size() == mesh.faces_num);
+  BLI_assert(r_vert_order.size() == mesh.verts_num);
+  const OffsetIndices<int> faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int> tri_faces = mesh.corner_tri_faces();
+
+  /* Leaf nodes reference consecutive ranges of the primitive indices, in the depth-first order of
+   * the tree, so spatially close nodes are also close in that array. Faces are ordered by their
+   * first triangle in it, and vertices by the first face using them. */
+  Array<bool> face_added(faces.size(), false);
+  int faces_added = 0;
+  for (const int tri : pbvh.prim_indices_) {
+    const int face = tri_faces[tri];
+    if (!face_added[face]) {
+      face_added[face] = true;
+      r_face_order[faces_added++] = face;
+    }
+  }
+  for (const int face : faces.index_range()) {
+    if (!face_added[face]) {
+      r_face_order[faces_added++] = face;
+    }
+  }
+
+  Array<bool> vert_added(mesh.verts_num, false);
+  int verts_added = 0;
+  for (const int face : r_face_order) {
+    for (const int vert : corner_verts.slice(faces[face])) {
+      if (!vert_added[vert]) {
+        vert_added[vert] = true;
+        r_vert_order[verts_added++] = vert;
+      }
+    }
+  }
+  /* Loose vertices are not used by any node. */
+  for (const int vert : IndexRange(mesh.verts_num)) {
+    if (!vert_added[vert]) {
+      r_vert_order[verts_added++] = vert;
+    }
+  }
+}
+
 static void build_nodes_recursive_grids(const Span<int> grid_to_face_map,
                                         const Span<int> material_indices,
                                         const Span<bool> sharp_faces,
@@ -531,8 +579,8 @@ std::unique_ptr<Tree> build_grids(const Mesh &base_mesh, const SubdivCCG &subdiv
   }
 
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
-  if (elems.is_empty()) {
+  const Span<float3> positions = subdiv_ccg.positions;
+  if (positions.is_empty()) {
     return pbvh;
   }
 
@@ -543,20 +591,15 @@ std::unique_ptr<Tree> build_grids(const Mesh &base_mesh, const SubdivCCG &subdiv
   const int leaf_limit = max_ii(LEAF_LIMIT / (key.grid_area), max_grids);
 
   /* For each grid, store the AABB and the AABB centroid */
-  Array<Bounds<float3>> prim_bounds(elems.size());
+  Array<Bounds<float3>> prim_bounds(subdiv_ccg.grids_num);
   const Bounds<float3> cb = threading::parallel_reduce(
-      elems.index_range(),
+      prim_bounds.index_range(),
       1024,
       negative_bounds(),
       [&](const IndexRange range, const Bounds<float3> &init) {
         Bounds<float3> current = init;
         for (const int i : range) {
-          CCGElem *grid = elems[i];
-          prim_bounds[i] = negative_bounds();
-          for (const int j : IndexRange(key.grid_area)) {
-            const float3 &position = CCG_elem_offset_co(key, grid, j);
-            math::min_max(position, prim_bounds[i].min, prim_bounds[i].max);
-          }
+          prim_bounds[i] = *bounds::min_max(positions.slice(ccg::grid_range(key, i)));
           const float3 center = math::midpoint(prim_bounds[i].min, prim_bounds[i].max);
           math::min_max(center, current.min, current.max);
         }
@@ -568,7 +611,7 @@ std::unique_ptr<Tree> build_grids(const Mesh &base_mesh, const SubdivCCG &subdiv
   const VArraySpan material_index = *attributes.lookup<int>("material_index", AttrDomain::Face);
   const VArraySpan sharp_face = *attributes.lookup<bool>("sharp_face", AttrDomain::Face);
 
-  pbvh->prim_indices_.reinitialize(elems.size());
+  pbvh->prim_indices_.reinitialize(subdiv_ccg.grids_num);
   array_utils::fill_index_range<int>(pbvh->prim_indices_);
 
   Vector<GridsNode> &nodes = std::get<Vector<GridsNode>>(pbvh->nodes_);
@@ -581,13 +624,13 @@ std::unique_ptr<Tree> build_grids(const Mesh &base_mesh, const SubdivCCG &subdiv
                               &cb,
                               prim_bounds,
                               0,
-                              elems.size(),
+                              subdiv_ccg.grids_num,
                               Array<int>(pbvh->prim_indices_.size()),
                               0,
                               pbvh->prim_indices_,
                               nodes);
 
-  update_bounds_grids(key, elems, *pbvh);
+  update_bounds_grids(key, positions, *pbvh);
   store_bounds_orig(*pbvh);
 
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
@@ -1182,12 +1225,12 @@ void update_node_bounds_mesh(const Span<float3> positions, MeshNode &node)
   node.bounds_ = bounds;
 }
 
-void update_node_bounds_grids(const CCGKey &key, const Span<CCGElem *> grids, GridsNode &node)
+void update_node_bounds_grids(const CCGKey &key, const Span<float3> positions, GridsNode &node)
 {
   Bounds<float3> bounds = negative_bounds();
   for (const int grid : node_grid_indices(node)) {
-    for (const int i : IndexRange(key.grid_area)) {
-      math::min_max(CCG_elem_offset_co(key, grids[grid], i), bounds.min, bounds.max);
+    for (const float3 &position : positions.slice(ccg::grid_range(key, grid))) {
+      math::min_max(position, bounds.min, bounds.max);
     }
   }
   node.bounds_ = bounds;
@@ -1253,7 +1296,7 @@ void update_bounds_mesh(const Span<float3> vert_positions, Tree &pbvh)
   }
 }
 
-void update_bounds_grids(const CCGKey &key, const Span<CCGElem *> elems, Tree &pbvh)
+void update_bounds_grids(const CCGKey &key, const Span<float3> positions, Tree &pbvh)
 {
   IndexMaskMemory memory;
   const IndexMask nodes_to_update = search_nodes(
@@ -1261,7 +1304,7 @@ void update_bounds_grids(const CCGKey &key, const Span<CCGElem *> elems, Tree &p
 
   MutableSpan<GridsNode> nodes = pbvh.nodes<GridsNode>();
   nodes_to_update.foreach_index(
-      GrainSize(1), [&](const int i) { update_node_bounds_grids(key, elems, nodes[i]); });
+      GrainSize(1), [&](const int i) { update_node_bounds_grids(key, positions, nodes[i]); });
   if (!nodes.is_empty()) {
     flush_bounds_to_parents(pbvh);
   }
@@ -1293,8 +1336,7 @@ void update_bounds(const Depsgraph &depsgraph, const Object &object, Tree &pbvh)
       const SculptSession &ss = *object.sculpt;
       const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> elems = subdiv_ccg.grids;
-      update_bounds_grids(key, elems, pbvh);
+      update_bounds_grids(key, subdiv_ccg.positions, pbvh);
       break;
     }
     case Type::BMesh: {
@@ -1349,15 +1391,13 @@ static void update_mask_mesh(const Mesh &mesh,
                                 [&](const int i) { node_update_mask_mesh(mask, nodes[i]); });
 }
 
-void node_update_mask_grids(const CCGKey &key, const Span<CCGElem *> grids, GridsNode &node)
+void node_update_mask_grids(const CCGKey &key, const Span<float> masks, GridsNode &node)
 {
   BLI_assert(key.has_mask);
   bool fully_masked = true;
   bool fully_unmasked = true;
   for (const int grid : node_grid_indices(node)) {
-    CCGElem *elem = grids[grid];
-    for (const int i : IndexRange(key.grid_area)) {
-      const float mask = CCG_elem_offset_mask(key, elem, i);
+    for (const float mask : masks.slice(ccg::grid_range(key, grid))) {
       fully_masked &= mask == 1.0f;
       fully_unmasked &= mask <= 0.0f;
     }
@@ -1382,7 +1422,7 @@ static void update_mask_grids(const SubdivCCG &subdiv_ccg,
   }
 
   nodes_to_update.foreach_index(
-      GrainSize(1), [&](const int i) { node_update_mask_grids(key, subdiv_ccg.grids, nodes[i]); });
+      GrainSize(1), [&](const int i) { node_update_mask_grids(key, subdiv_ccg.masks, nodes[i]); });
 }
 
 void node_update_mask_bmesh(const int mask_offset, BMeshNode &node)
@@ -1645,7 +1685,7 @@ int BKE_pbvh_get_grid_num_verts(const Object &object)
   const SculptSession &ss = *object.sculpt;
   BLI_assert(ss.pbvh->type() == blender::bke::pbvh::Type::Grids);
   const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
-  return ss.subdiv_ccg->grids.size() * key.grid_area;
+  return ss.subdiv_ccg->grids_num * key.grid_area;
 }
 
 int BKE_pbvh_get_grid_num_faces(const Object &object)
@@ -1653,7 +1693,7 @@ int BKE_pbvh_get_grid_num_faces(const Object &object)
   const SculptSession &ss = *object.sculpt;
   BLI_assert(ss.pbvh->type() == blender::bke::pbvh::Type::Grids);
   const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
-  return ss.subdiv_ccg->grids.size() * square_i(key.grid_size - 1);
+  return ss.subdiv_ccg->grids_num * square_i(key.grid_size - 1);
 }
 
 /***************************** Node Access ***********************************/
@@ -2093,10 +2133,10 @@ static bool pbvh_grids_node_raycast(const SubdivCCG &subdiv_ccg,
   bool hit = false;
   float nearest_vertex_co[3] = {0.0};
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   for (const int grid : grids) {
-    CCGElem *elem = elems[grid];
+    const Span<float3> grid_positions = positions.slice(ccg::grid_range(key, grid));
 
     for (int y = 0; y < gridsize - 1; y++) {
       for (int x = 0; x < gridsize - 1; x++) {
@@ -2115,10 +2155,10 @@ static bool pbvh_grids_node_raycast(const SubdivCCG &subdiv_ccg,
           co[3] = origco[y * gridsize + x];
         }
         else {
-          co[0] = CCG_grid_elem_co(key, elem, x, y + 1);
-          co[1] = CCG_grid_elem_co(key, elem, x + 1, y + 1);
-          co[2] = CCG_grid_elem_co(key, elem, x + 1, y);
-          co[3] = CCG_grid_elem_co(key, elem, x, y);
+          co[0] = grid_positions[CCG_grid_xy_to_index(gridsize, x, y + 1)];
+          co[1] = grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y + 1)];
+          co[2] = grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y)];
+          co[3] = grid_positions[CCG_grid_xy_to_index(gridsize, x, y)];
         }
 
         if (ray_face_intersection_quad(
@@ -2423,10 +2463,10 @@ static bool pbvh_grids_node_nearest_to_ray(const SubdivCCG &subdiv_ccg,
   const int gridsize = key.grid_size;
   bool hit = false;
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   for (const int grid : grids) {
-    CCGElem *elem = elems[grid];
+    const Span<float3> grid_positions = positions.slice(ccg::grid_range(key, grid));
 
     for (int y = 0; y < gridsize - 1; y++) {
       for (int x = 0; x < gridsize - 1; x++) {
@@ -2450,10 +2490,10 @@ static bool pbvh_grids_node_nearest_to_ray(const SubdivCCG &subdiv_ccg,
         else {
           hit |= ray_face_nearest_quad(ray_start,
                                        ray_normal,
-                                       CCG_grid_elem_co(key, elem, x, y),
-                                       CCG_grid_elem_co(key, elem, x + 1, y),
-                                       CCG_grid_elem_co(key, elem, x + 1, y + 1),
-                                       CCG_grid_elem_co(key, elem, x, y + 1),
+                                       grid_positions[CCG_grid_xy_to_index(gridsize, x, y)],
+                                       grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y)],
+                                       grid_positions[CCG_grid_xy_to_index(gridsize, x + 1, y + 1)],
+                                       grid_positions[CCG_grid_xy_to_index(gridsize, x, y + 1)],
                                        depth,
                                        dist_sq);
         }
@@ -2624,7 +2664,6 @@ static blender::draw::pbvh::PBVH_GPU_Args pbvh_draw_args_init(const Object &obje
       args.mesh = &mesh_orig;
       args.grid_indices = static_cast<const blender::bke::pbvh::GridsNode &>(node).prim_indices_;
       args.subdiv_ccg = &const_cast<SubdivCCG &>(subdiv_ccg);
-      args.grids = subdiv_ccg.grids;
       break;
     }
     case blender::bke::pbvh::Type::BMesh: {
@@ -6,18 +6,25 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_bounds.hh"
 #include "BLI_ghash.h"
 #include "BLI_heap_simple.h"
+#include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_ccg.hh"
 #include "BKE_pbvh_api.hh"
@@ -682,6 +689,12 @@ struct EdgeQueue {
 #endif
 };
 
+/** An edge found while the queue is created, before it is inserted in the queue. */
+struct QueuedEdge {
+  BMEdge *edge;
+  float priority;
+};
+
 struct EdgeQueueContext {
   EdgeQueue *q;
   BLI_mempool *pool;
@@ -689,8 +702,34 @@ struct EdgeQueueContext {
   int cd_vert_mask_offset;
   int cd_vert_node_offset;
   int cd_face_node_offset;
+  /**
+   * When set, edges are gathered here instead of being inserted in the queue, which allows
+   * finding them in multiple nodes in parallel (see #edge_queue_add_nodes).
+   */
+  Vector<QueuedEdge> *deferred_edges;
+  /**
+   * When the edges of a single node are split while other nodes are modified concurrently, the
+   * index of that node. Only its faces are accessed then (see #subdivide_long_edges_per_node).
+   */
+  int node_index;
+  /** Protects the BMesh element pools and the #BMLog while nodes are modified concurrently. */
+  std::mutex *bm_mutex;
 };
 
+/** Lock the mutex protecting the shared BMesh data when nodes are modified concurrently. */
+static std::unique_lock<std::mutex> edge_queue_bm_lock(const EdgeQueueContext *eq_ctx)
+{
+  return eq_ctx->bm_mutex ? std::unique_lock<std::mutex>(*eq_ctx->bm_mutex) :
+                            std::unique_lock<std::mutex>();
+}
+
+/** Whether the face may be accessed, only faces of the processed node are when there is one. */
+static bool edge_queue_face_in_node(const EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  return eq_ctx->node_index == DYNTOPO_NODE_NONE ||
+         BM_ELEM_CD_GET_INT(f, eq_ctx->cd_face_node_offset) == eq_ctx->node_index;
+}
+
 /* Only tagged edges are in the queue. */
 #ifdef USE_EDGEQUEUE_TAG
 #  define EDGE_QUEUE_TEST(e) BM_elem_flag_test((CHECK_TYPE_INLINE(e, BMEdge *), e), BM_ELEM_TAG)
@@ -769,6 +808,18 @@ static bool check_mask(EdgeQueueContext *eq_ctx, BMVert *v)
   return BM_ELEM_CD_GET_FLOAT(v, eq_ctx->cd_vert_mask_offset) < 1.0f;
 }
 
+static void edge_queue_push(EdgeQueueContext *eq_ctx, BMEdge *e, const float priority)
+{
+  BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
+  pair[0] = e->v1;
+  pair[1] = e->v2;
+  BLI_heapsimple_insert(eq_ctx->q->heap, priority, pair);
+#ifdef USE_EDGEQUEUE_TAG
+  BLI_assert(EDGE_QUEUE_TEST(e) == false);
+  EDGE_QUEUE_ENABLE(e);
+#endif
+}
+
 static void edge_queue_insert(EdgeQueueContext *eq_ctx, BMEdge *e, float priority)
 {
   /* Don't let topology update affect fully masked vertices. This used to
@@ -782,14 +833,11 @@ static void edge_queue_insert(EdgeQueueContext *eq_ctx, BMEdge *e, float priorit
       !(BM_elem_flag_test_bool(e->v1, BM_ELEM_HIDDEN) ||
         BM_elem_flag_test_bool(e->v2, BM_ELEM_HIDDEN)))
   {
-    BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
-    pair[0] = e->v1;
-    pair[1] = e->v2;
-    BLI_heapsimple_insert(eq_ctx->q->heap, priority, pair);
-#ifdef USE_EDGEQUEUE_TAG
-    BLI_assert(EDGE_QUEUE_TEST(e) == false);
-    EDGE_QUEUE_ENABLE(e);
-#endif
+    if (eq_ctx->deferred_edges) {
+      eq_ctx->deferred_edges->append({e, priority});
+      return;
+    }
+    edge_queue_push(eq_ctx, e, priority);
   }
 }
 
@@ -892,6 +940,10 @@ static void long_edge_queue_edge_add_recursive(
 {
   BLI_assert(len_sq > square_f(limit_len));
 
+  if (!edge_queue_face_in_node(eq_ctx, l_edge->f)) {
+    return;
+  }
+
 #  ifdef USE_EDGEQUEUE_FRONTFACE
   if (eq_ctx->q->use_view_normal) {
     if (dot_v3v3(l_edge->f->no, eq_ctx->q->view_normal) < 0.0f) {
@@ -927,6 +979,9 @@ static void long_edge_queue_edge_add_recursive(
 
     BMLoop *l_iter = l_edge;
     do {
+      if (!edge_queue_face_in_node(eq_ctx, l_iter->f)) {
+        continue;
+      }
       BMLoop *l_adjacent[2] = {l_iter->next, l_iter->prev};
       for (int i = 0; i < ARRAY_SIZE(l_adjacent); i++) {
         float len_sq_other = BM_edge_calc_length_squared(l_adjacent[i]->e);
@@ -1007,6 +1062,59 @@ static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
   }
 }
 
+/**
+ * Add the edges of the faces of leaf nodes marked for topology update to the queue.
+ *
+ * Finding the edges only reads the mesh, so it is done for all nodes in parallel, which matters
+ * for large brushes and detail flood fill where most of the faces in range are already at the
+ * right detail. Edge tags are not modified until the edges are inserted in the queue afterwards,
+ * in the order of the nodes, which gives the same queue as processing the nodes one by one.
+ */
+static void edge_queue_add_nodes(EdgeQueueContext *eq_ctx,
+                                 MutableSpan<BMeshNode> nodes,
+                                 void (*face_add)(EdgeQueueContext *eq_ctx, BMFace *f))
+{
+  const double start_time = BLI_time_now_seconds();
+
+  Vector<BMeshNode *> nodes_to_update;
+  for (BMeshNode &node : nodes) {
+    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
+        !(node.flag_ & PBVH_FullyHidden))
+    {
+      nodes_to_update.append(&node);
+    }
+  }
+
+  Array<Vector<QueuedEdge>> node_edges(nodes_to_update.size());
+  threading::parallel_for(nodes_to_update.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      EdgeQueueContext node_ctx = *eq_ctx;
+      node_ctx.deferred_edges = &node_edges[i];
+      for (BMFace *f : nodes_to_update[i]->bm_faces_) {
+        face_add(&node_ctx, f);
+      }
+    }
+  });
+
+  for (const Span<QueuedEdge> edges : node_edges) {
+    for (const QueuedEdge &queued : edges) {
+#ifdef USE_EDGEQUEUE_TAG
+      /* Edges on node boundaries are found once for every node using them. */
+      if (EDGE_QUEUE_TEST(queued.edge)) {
+        continue;
+      }
+#endif
+      edge_queue_push(eq_ctx, queued.edge, queued.priority);
+    }
+  }
+
+  CLOG_INFO(&LOG,
+            2,
+            "Edge queue creation for %d nodes took %f seconds.",
+            int(nodes_to_update.size()),
+            BLI_time_now_seconds() - start_time);
+}
+
 /**
  * Create a priority queue containing vertex pairs connected by a long
  * edge as defined by Tree.bm_max_edge_len.
@@ -1054,16 +1162,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_add_nodes(eq_ctx, nodes, long_edge_queue_face_add);
 }
 
 /**
@@ -1109,16 +1208,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_add_nodes(eq_ctx, nodes, short_edge_queue_face_add);
 }
 
 /*************************** Topology update **************************/
@@ -1167,6 +1257,7 @@ static void pbvh_bmesh_split_edge(EdgeQueueContext *eq_ctx,
   normalize_v3(no_mid);
 
   int node_index = BM_ELEM_CD_GET_INT(e->v1, eq_ctx->cd_vert_node_offset);
+  std::unique_lock<std::mutex> lock = edge_queue_bm_lock(eq_ctx);
   BMVert *v_new = pbvh_bmesh_vert_create(bm,
                                          nodes,
                                          bm_log,
@@ -1177,6 +1268,9 @@ static void pbvh_bmesh_split_edge(EdgeQueueContext *eq_ctx,
                                          no_mid,
                                          cd_vert_node_offset,
                                          eq_ctx->cd_vert_mask_offset);
+  if (lock) {
+    lock.unlock();
+  }
 
   /* For each face, add two new triangles and delete the original. */
   for (const int i : edge_loops.index_range()) {
@@ -1224,15 +1318,20 @@ static void pbvh_bmesh_split_edge(EdgeQueueContext *eq_ctx,
      */
 
     /* Create first face (v1, v_new, v_opp). */
+    lock = edge_queue_bm_lock(eq_ctx);
     const std::array<BMVert *, 3> first_tri({v1, v_new, v_opp});
     const std::array<BMEdge *, 3> first_edges = bm_edges_from_tri(bm, first_tri);
     copy_edge_data(bm, *first_edges[0], *e);
 
     BMFace *f_new_first = pbvh_bmesh_face_create(
         bm, nodes, cd_face_node_offset, bm_log, ni, first_tri, first_edges, f_adj);
+    if (lock) {
+      lock.unlock();
+    }
     long_edge_queue_face_add(eq_ctx, f_new_first);
 
     /* Create second face (v_new, v2, v_opp). */
+    lock = edge_queue_bm_lock(eq_ctx);
     const std::array<BMVert *, 3> second_tri({v_new, v2, v_opp});
     const std::array<BMEdge *, 3> second_edges{
         BM_edge_create(&bm, second_tri[0], second_tri[1], nullptr, BM_CREATE_NO_DOUBLE),
@@ -1243,11 +1342,18 @@ static void pbvh_bmesh_split_edge(EdgeQueueContext *eq_ctx,
 
     BMFace *f_new_second = pbvh_bmesh_face_create(
         bm, nodes, cd_face_node_offset, bm_log, ni, second_tri, second_edges, f_adj);
+    if (lock) {
+      lock.unlock();
+    }
     long_edge_queue_face_add(eq_ctx, f_new_second);
 
     /* Delete original */
+    lock = edge_queue_bm_lock(eq_ctx);
     pbvh_bmesh_face_remove(nodes, cd_vert_node_offset, cd_face_node_offset, bm_log, f_adj);
     BM_face_kill(&bm, f_adj);
+    if (lock) {
+      lock.unlock();
+    }
 
     /* Ensure new vertex is in the node */
     if (!nodes[ni].bm_unique_verts_.contains(v_new)) {
@@ -1263,18 +1369,73 @@ static void pbvh_bmesh_split_edge(EdgeQueueContext *eq_ctx,
     }
   }
 
+  lock = edge_queue_bm_lock(eq_ctx);
   BM_edge_kill(&bm, e);
 }
 
-static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
-                                            BMesh &bm,
-                                            MutableSpan<BMeshNode> nodes,
-                                            const int cd_vert_node_offset,
-                                            const int cd_face_node_offset,
-                                            BMLog &bm_log)
+/** Node of all the faces using the edge, or #DYNTOPO_NODE_NONE when they are in several nodes. */
+static int edge_faces_node_index(const EdgeQueueContext *eq_ctx, BMEdge *e)
 {
-  const double start_time = BLI_time_now_seconds();
+  if (e->l == nullptr) {
+    return DYNTOPO_NODE_NONE;
+  }
+  const int node_index = BM_ELEM_CD_GET_INT(e->l->f, eq_ctx->cd_face_node_offset);
+  BMLoop *l_iter = e->l;
+  do {
+    if (BM_ELEM_CD_GET_INT(l_iter->f, eq_ctx->cd_face_node_offset) != node_index) {
+      return DYNTOPO_NODE_NONE;
+    }
+  } while ((l_iter = l_iter->radial_next) != e->l);
+  return node_index;
+}
+
+/**
+ * Whether splitting the edge only modifies elements that belong to the processed node: all the
+ * faces around the vertices of the faces using the edge are in the node, and the node owns these
+ * vertices. Other nodes never access these elements, so the edge can be split concurrently.
+ */
+static bool edge_is_node_interior(const EdgeQueueContext *eq_ctx, BMEdge *e)
+{
+  /* Check the faces of the edge first, their vertices are only accessed if they are in the node,
+   * as other nodes don't modify them then. */
+  if (edge_faces_node_index(eq_ctx, e) != eq_ctx->node_index) {
+    return false;
+  }
+  BMLoop *l_radial = e->l;
+  do {
+    BMLoop *l_first = BM_FACE_FIRST_LOOP(l_radial->f);
+    BMLoop *l_iter = l_first;
+    do {
+      BMVert *v = l_iter->v;
+      if (BM_ELEM_CD_GET_INT(v, eq_ctx->cd_vert_node_offset) != eq_ctx->node_index) {
+        return false;
+      }
+      BMFace *f;
+      BM_FACES_OF_VERT_ITER_BEGIN (f, v) {
+        if (BM_ELEM_CD_GET_INT(f, eq_ctx->cd_face_node_offset) != eq_ctx->node_index) {
+          return false;
+        }
+      }
+      BM_FACES_OF_VERT_ITER_END;
+    } while ((l_iter = l_iter->next) != l_first);
+  } while ((l_radial = l_radial->radial_next) != e->l);
+  return true;
+}
 
+/**
+ * Split the edges of the queue until it is empty.
+ *
+ * \param r_postponed: When a single node is processed, edges whose split would modify other
+ * nodes are added here instead, to be split once no nodes are modified concurrently anymore.
+ */
+static bool long_edge_queue_subdivide(EdgeQueueContext *eq_ctx,
+                                      BMesh &bm,
+                                      MutableSpan<BMeshNode> nodes,
+                                      const int cd_vert_node_offset,
+                                      const int cd_face_node_offset,
+                                      BMLog &bm_log,
+                                      Vector<std::array<BMVert *, 2>> *r_postponed)
+{
   bool any_subdivided = false;
 
   while (!BLI_heapsimple_is_empty(eq_ctx->q->heap)) {
@@ -1306,11 +1467,148 @@ static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
       continue;
     }
 
+    if (r_postponed && !edge_is_node_interior(eq_ctx, e)) {
+      r_postponed->append({v1, v2});
+      continue;
+    }
+
     any_subdivided = true;
 
     pbvh_bmesh_split_edge(eq_ctx, bm, nodes, cd_vert_node_offset, cd_face_node_offset, bm_log, e);
   }
 
+  return any_subdivided;
+}
+
+/**
+ * Split the queued edges of every node in parallel, for detail flood fill and large brushes.
+ *
+ * Edges used by faces of a single node are moved to a queue for that node, and the nodes are
+ * processed concurrently. Splits that stay within the node only touch vertices, edges and faces
+ * that other nodes never access, see #edge_is_node_interior. Creating and freeing elements and
+ * logging them for undo is done under a lock, as the BMesh element pools and the #BMLog are
+ * shared. Edges on node boundaries are put back in the queue, to be split serially afterwards.
+ */
+static bool subdivide_long_edges_per_node(EdgeQueueContext *eq_ctx,
+                                          BMesh &bm,
+                                          MutableSpan<BMeshNode> nodes,
+                                          const int cd_vert_node_offset,
+                                          const int cd_face_node_offset,
+                                          BMLog &bm_log)
+{
+  Map<int, Vector<std::array<BMVert *, 2>>> node_edges;
+  Vector<std::array<BMVert *, 2>> boundary_edges;
+  while (!BLI_heapsimple_is_empty(eq_ctx->q->heap)) {
+    BMVert **pair = static_cast<BMVert **>(BLI_heapsimple_pop_min(eq_ctx->q->heap));
+    const std::array<BMVert *, 2> verts = {pair[0], pair[1]};
+    BLI_mempool_free(eq_ctx->pool, pair);
+    BMEdge *e = BM_edge_exists(verts[0], verts[1]);
+    if (!e) {
+      continue;
+    }
+#ifdef USE_EDGEQUEUE_TAG
+    EDGE_QUEUE_DISABLE(e);
+#endif
+    const int node_index = edge_faces_node_index(eq_ctx, e);
+    if (node_index == DYNTOPO_NODE_NONE) {
+      boundary_edges.append(verts);
+    }
+    else {
+      node_edges.lookup_or_add_default(node_index).append(verts);
+    }
+  }
+
+  auto queue_edges = [&](const Span<std::array<BMVert *, 2>> edges) {
+    for (const std::array<BMVert *, 2> &verts : edges) {
+      BMEdge *e = BM_edge_exists(verts[0], verts[1]);
+#ifdef USE_EDGEQUEUE_TAG
+      if (!e || EDGE_QUEUE_TEST(e)) {
+        continue;
+      }
+#else
+      if (!e) {
+        continue;
+      }
+#endif
+      edge_queue_push(eq_ctx, e, long_edge_queue_priority(*e));
+    }
+  };
+
+  /* Splitting a single node concurrently with nothing else only adds overhead. */
+  if (node_edges.size() < 2) {
+    for (const Span<std::array<BMVert *, 2>> edges : node_edges.values()) {
+      queue_edges(edges);
+    }
+    queue_edges(boundary_edges);
+    return false;
+  }
+
+  const double start_time = BLI_time_now_seconds();
+
+  /* Sorted, so that postponed edges are queued in the same order every time. */
+  Vector<int> node_indices;
+  node_indices.extend(node_edges.keys().begin(), node_edges.keys().end());
+  std::sort(node_indices.begin(), node_indices.end());
+
+  std::mutex bm_mutex;
+  Array<Vector<std::array<BMVert *, 2>>> postponed_edges(node_indices.size());
+  Array<bool> node_subdivided(node_indices.size(), false);
+  threading::parallel_for(node_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int node_index = node_indices[i];
+      EdgeQueue node_queue = *eq_ctx->q;
+      node_queue.heap = BLI_heapsimple_new();
+      EdgeQueueContext node_ctx = *eq_ctx;
+      node_ctx.q = &node_queue;
+      node_ctx.pool = BLI_mempool_create(sizeof(BMVert *) * 2, 0, 128, BLI_MEMPOOL_NOP);
+      node_ctx.node_index = node_index;
+      node_ctx.bm_mutex = &bm_mutex;
+
+      for (const std::array<BMVert *, 2> &verts : node_edges.lookup(node_index)) {
+        BMEdge *e = BM_edge_exists(verts[0], verts[1]);
+        edge_queue_push(&node_ctx, e, long_edge_queue_priority(*e));
+      }
+      node_subdivided[i] = long_edge_queue_subdivide(&node_ctx,
+                                                     bm,
+                                                     nodes,
+                                                     cd_vert_node_offset,
+                                                     cd_face_node_offset,
+                                                     bm_log,
+                                                     &postponed_edges[i]);
+
+      BLI_heapsimple_free(node_queue.heap, nullptr);
+      BLI_mempool_destroy(node_ctx.pool);
+    }
+  });
+
+  for (const Span<std::array<BMVert *, 2>> edges : postponed_edges) {
+    queue_edges(edges);
+  }
+  queue_edges(boundary_edges);
+
+  CLOG_INFO(&LOG,
+            2,
+            "Long edge subdivision of %d nodes in parallel took %f seconds.",
+            int(node_indices.size()),
+            BLI_time_now_seconds() - start_time);
+
+  return node_subdivided.as_span().contains(true);
+}
+
+static bool pbvh_bmesh_subdivide_long_edges(EdgeQueueContext *eq_ctx,
+                                            BMesh &bm,
+                                            MutableSpan<BMeshNode> nodes,
+                                            const int cd_vert_node_offset,
+                                            const int cd_face_node_offset,
+                                            BMLog &bm_log)
+{
+  const double start_time = BLI_time_now_seconds();
+
+  bool any_subdivided = subdivide_long_edges_per_node(
+      eq_ctx, bm, nodes, cd_vert_node_offset, cd_face_node_offset, bm_log);
+  any_subdivided |= long_edge_queue_subdivide(
+      eq_ctx, bm, nodes, cd_vert_node_offset, cd_face_node_offset, bm_log, nullptr);
+
 #ifdef USE_EDGEQUEUE_TAG_VERIFY
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
@@ -2305,6 +2603,9 @@ bool bmesh_update_topology(BMesh &bm,
         cd_vert_mask_offset,
         cd_vert_node_offset,
         cd_face_node_offset,
+        nullptr,
+        DYNTOPO_NODE_NONE,
+        nullptr,
     };
 
     short_edge_queue_create(
@@ -2325,6 +2626,9 @@ bool bmesh_update_topology(BMesh &bm,
         cd_vert_mask_offset,
         cd_vert_node_offset,
         cd_face_node_offset,
+        nullptr,
+        DYNTOPO_NODE_NONE,
+        nullptr,
     };
 
     long_edge_queue_create(
@@ -18,6 +18,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "subdiv_converter.hh"
+#include "subdiv_topology_cache.hh"
 
 #include "opensubdiv_capi.hh"
 #include "opensubdiv_converter_capi.hh"
@@ -37,6 +38,7 @@ void init()
 
 void exit()
 {
+  topology_cache_clear();
   openSubdiv_cleanup();
 }
 
@@ -116,6 +118,31 @@ Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *conve
   Subdiv *subdiv = MEM_cnew<Subdiv>(__func__);
   subdiv->settings = *settings;
   subdiv->topology_refiner = osd_topology_refiner;
+  subdiv->shared_topology = nullptr;
+  subdiv->evaluator = nullptr;
+  subdiv->displacement_evaluator = nullptr;
+  stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  subdiv->stats = stats;
+  return subdiv;
+}
+
+/* Similar to #new_from_converter, but the topology is shared with all other subdivision
+ * surfaces created from meshes with the same topology. */
+static Subdiv *new_from_mesh_converter(const Settings *settings,
+                                       const Mesh *mesh,
+                                       OpenSubdiv_Converter *converter)
+{
+  SubdivStats stats;
+  stats_init(&stats);
+  stats_begin(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  SharedTopology *shared_topology = nullptr;
+  if (converter->getNumVertices(converter) != 0) {
+    shared_topology = topology_cache_ensure(settings, mesh, converter);
+  }
+  Subdiv *subdiv = MEM_cnew<Subdiv>(__func__);
+  subdiv->settings = *settings;
+  subdiv->topology_refiner = shared_topology ? shared_topology->topology_refiner : nullptr;
+  subdiv->shared_topology = shared_topology;
   subdiv->evaluator = nullptr;
   subdiv->displacement_evaluator = nullptr;
   stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
@@ -130,34 +157,36 @@ Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh)
   }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
-  Subdiv *subdiv = new_from_converter(settings, &converter);
+  Subdiv *subdiv = new_from_mesh_converter(settings, mesh, &converter);
   converter_free(&converter);
   return subdiv;
 }
 
 /* Creation with cached-aware semantic. */
 
+/* Check if the existing descriptor can be re-used. */
+static bool can_reuse_subdiv(Subdiv *subdiv,
+                             const Settings *settings,
+                             OpenSubdiv_Converter *converter)
+{
+  if (subdiv == nullptr || subdiv->topology_refiner == nullptr) {
+    return false;
+  }
+  if (!settings_equal(&subdiv->settings, settings)) {
+    return false;
+  }
+  stats_begin(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  const bool topology_equal = openSubdiv_topologyRefinerCompareWithConverter(
+      subdiv->topology_refiner, converter);
+  stats_end(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  return topology_equal;
+}
+
 Subdiv *update_from_converter(Subdiv *subdiv,
                               const Settings *settings,
                               OpenSubdiv_Converter *converter)
 {
-  /* Check if the existing descriptor can be re-used. */
-  bool can_reuse_subdiv = true;
-  if (subdiv != nullptr && subdiv->topology_refiner != nullptr) {
-    if (!settings_equal(&subdiv->settings, settings)) {
-      can_reuse_subdiv = false;
-    }
-    else {
-      stats_begin(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
-      can_reuse_subdiv = openSubdiv_topologyRefinerCompareWithConverter(subdiv->topology_refiner,
-                                                                        converter);
-      stats_end(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
-    }
-  }
-  else {
-    can_reuse_subdiv = false;
-  }
-  if (can_reuse_subdiv) {
+  if (can_reuse_subdiv(subdiv, settings, converter)) {
     return subdiv;
   }
   /* Create new subdiv. */
@@ -171,7 +200,12 @@ Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *m
 {
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
-  subdiv = update_from_converter(subdiv, settings, &converter);
+  if (!can_reuse_subdiv(subdiv, settings, &converter)) {
+    if (subdiv != nullptr) {
+      free(subdiv);
+    }
+    subdiv = new_from_mesh_converter(settings, mesh, &converter);
+  }
   converter_free(&converter);
   return subdiv;
 }
@@ -189,7 +223,10 @@ void free(Subdiv *subdiv)
     }
     openSubdiv_deleteEvaluator(subdiv->evaluator);
   }
-  if (subdiv->topology_refiner != nullptr) {
+  if (subdiv->shared_topology != nullptr) {
+    topology_cache_release(subdiv->shared_topology);
+  }
+  else if (subdiv->topology_refiner != nullptr) {
     openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
   }
   displacement_detach(subdiv);
@@ -37,6 +37,8 @@ using blender::OffsetIndices;
 using blender::Span;
 using blender::Vector;
 using blender::VectorSet;
+using blender::bke::ccg::grid_range;
+using blender::bke::ccg::grid_xy_to_vert;
 using namespace blender::bke::subdiv;
 
 /* -------------------------------------------------------------------- */
@@ -55,65 +57,10 @@ void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
 
 /** \} */
 
-/* -------------------------------------------------------------------- */
-/** \name Generally useful internal helpers
- * \{ */
-
-/* Number of floats in per-vertex elements. */
-static int num_element_float_get(const SubdivCCG &subdiv_ccg)
-{
-  /* We always have 3 floats for coordinate. */
-  int num_floats = 3;
-  if (subdiv_ccg.has_normal) {
-    num_floats += 3;
-  }
-  if (subdiv_ccg.has_mask) {
-    num_floats += 1;
-  }
-  return num_floats;
-}
-
-/* Per-vertex element size in bytes. */
-static int element_size_bytes_get(const SubdivCCG &subdiv_ccg)
-{
-  return sizeof(float) * num_element_float_get(subdiv_ccg);
-}
-
-/** \} */
-
 /* -------------------------------------------------------------------- */
 /** \name Internal helpers for CCG creation
  * \{ */
 
-static void subdiv_ccg_init_layers(SubdivCCG &subdiv_ccg, const SubdivToCCGSettings &settings)
-{
-  /* CCG always contains coordinates. Rest of layers are coming after them. */
-  int layer_offset = sizeof(float[3]);
-  /* Mask. */
-  if (settings.need_mask) {
-    subdiv_ccg.has_mask = true;
-    subdiv_ccg.mask_offset = layer_offset;
-    layer_offset += sizeof(float);
-  }
-  else {
-    subdiv_ccg.has_mask = false;
-    subdiv_ccg.mask_offset = -1;
-  }
-  /* Normals.
-   *
-   * NOTE: Keep them at the end, matching old CCGDM. Doesn't really matter
-   * here, but some other area might in theory depend memory layout. */
-  if (settings.need_normal) {
-    subdiv_ccg.has_normal = true;
-    subdiv_ccg.normal_offset = layer_offset;
-    layer_offset += sizeof(float[3]);
-  }
-  else {
-    subdiv_ccg.has_normal = false;
-    subdiv_ccg.normal_offset = -1;
-  }
-}
-
 /* TODO(sergey): Make it more accessible function. */
 static int topology_refiner_count_face_corners(const OpenSubdiv_TopologyRefiner *topology_refiner)
 {
@@ -125,23 +72,23 @@ static int topology_refiner_count_face_corners(const OpenSubdiv_TopologyRefiner
   return num_corners;
 }
 
-/* NOTE: Grid size and layer flags are to be filled in before calling this
- * function. */
-static void subdiv_ccg_alloc_elements(SubdivCCG &subdiv_ccg, Subdiv &subdiv)
+/* NOTE: Grid size is to be filled in before calling this function. */
+static void subdiv_ccg_alloc_elements(SubdivCCG &subdiv_ccg,
+                                      Subdiv &subdiv,
+                                      const SubdivToCCGSettings &settings)
 {
   const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv.topology_refiner;
-  const int64_t element_size = element_size_bytes_get(subdiv_ccg);
   /* Allocate memory for surface grids. */
   const int64_t num_grids = topology_refiner_count_face_corners(topology_refiner);
   const int64_t grid_size = grid_size_from_level(subdiv_ccg.level);
   const int64_t grid_area = grid_size * grid_size;
-  subdiv_ccg.grid_element_size = element_size;
-  subdiv_ccg.grids.reinitialize(num_grids);
-  subdiv_ccg.grids_storage.reinitialize(num_grids * grid_area * element_size);
-  const size_t grid_size_in_bytes = size_t(grid_area) * element_size;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    const size_t grid_offset = grid_size_in_bytes * grid_index;
-    subdiv_ccg.grids[grid_index] = (CCGElem *)&subdiv_ccg.grids_storage[grid_offset];
+  subdiv_ccg.grids_num = num_grids;
+  subdiv_ccg.positions.reinitialize(num_grids * grid_area);
+  if (settings.need_normal) {
+    subdiv_ccg.normals.reinitialize(num_grids * grid_area);
+  }
+  if (settings.need_mask) {
+    subdiv_ccg.masks.reinitialize(num_grids * grid_area);
   }
   /* TODO(sergey): Allocate memory for loose elements. */
 }
@@ -157,21 +104,21 @@ static void subdiv_ccg_eval_grid_element_limit(Subdiv &subdiv,
                                                const int ptex_face_index,
                                                const float u,
                                                const float v,
-                                               uchar *element)
+                                               const int element)
 {
   if (subdiv.displacement_evaluator != nullptr) {
-    eval_final_point(&subdiv, ptex_face_index, u, v, (float *)element);
+    eval_final_point(&subdiv, ptex_face_index, u, v, subdiv_ccg.positions[element]);
   }
-  else if (subdiv_ccg.has_normal) {
+  else if (!subdiv_ccg.normals.is_empty()) {
     eval_limit_point_and_normal(&subdiv,
                                 ptex_face_index,
                                 u,
                                 v,
-                                (float *)element,
-                                (float *)(element + subdiv_ccg.normal_offset));
+                                subdiv_ccg.positions[element],
+                                subdiv_ccg.normals[element]);
   }
   else {
-    eval_limit_point(&subdiv, ptex_face_index, u, v, (float *)element);
+    eval_limit_point(&subdiv, ptex_face_index, u, v, subdiv_ccg.positions[element]);
   }
 }
 
@@ -180,17 +127,16 @@ static void subdiv_ccg_eval_grid_element_mask(SubdivCCG &subdiv_ccg,
                                               const int ptex_face_index,
                                               const float u,
                                               const float v,
-                                              uchar *element)
+                                              const int element)
 {
-  if (!subdiv_ccg.has_mask) {
+  if (subdiv_ccg.masks.is_empty()) {
     return;
   }
-  float *mask_value_ptr = (float *)(element + subdiv_ccg.mask_offset);
   if (mask_evaluator != nullptr) {
-    *mask_value_ptr = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, u, v);
+    subdiv_ccg.masks[element] = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, u, v);
   }
   else {
-    *mask_value_ptr = 0.0f;
+    subdiv_ccg.masks[element] = 0.0f;
   }
 }
 
@@ -200,7 +146,7 @@ static void subdiv_ccg_eval_grid_element(Subdiv &subdiv,
                                          const int ptex_face_index,
                                          const float u,
                                          const float v,
-                                         uchar *element)
+                                         const int element)
 {
   subdiv_ccg_eval_grid_element_limit(subdiv, subdiv_ccg, ptex_face_index, u, v, element);
   subdiv_ccg_eval_grid_element_mask(subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
@@ -215,21 +161,19 @@ static void subdiv_ccg_eval_regular_grid(Subdiv &subdiv,
   const int ptex_face_index = face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg.grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   const IndexRange face = subdiv_ccg.faces[face_index];
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
-    uchar *grid = (uchar *)subdiv_ccg.grids[grid_index];
+    const IndexRange grid = grid_range(grid_size * grid_size, grid_index);
     for (int y = 0; y < grid_size; y++) {
       const float grid_v = y * grid_size_1_inv;
       for (int x = 0; x < grid_size; x++) {
         const float grid_u = x * grid_size_1_inv;
         float u, v;
         rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
-        const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
+        const int element = grid[CCG_grid_xy_to_index(grid_size, x, y)];
         subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, &grid[grid_element_offset]);
+            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
       }
     }
   }
@@ -243,20 +187,18 @@ static void subdiv_ccg_eval_special_grid(Subdiv &subdiv,
 {
   const int grid_size = subdiv_ccg.grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   const IndexRange face = subdiv_ccg.faces[face_index];
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
     const int ptex_face_index = face_ptex_offset[face_index] + corner;
-    uchar *grid = (uchar *)subdiv_ccg.grids[grid_index];
+    const IndexRange grid = grid_range(grid_size * grid_size, grid_index);
     for (int y = 0; y < grid_size; y++) {
       const float u = 1.0f - (y * grid_size_1_inv);
       for (int x = 0; x < grid_size; x++) {
         const float v = 1.0f - (x * grid_size_1_inv);
-        const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
+        const int element = grid[CCG_grid_xy_to_index(grid_size, x, y)];
         subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, &grid[grid_element_offset]);
+            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
       }
     }
   }
@@ -304,13 +246,6 @@ static SubdivCCGCoord subdiv_ccg_coord(int grid_index, int x, int y)
   return coord;
 }
 
-static CCGElem *subdiv_ccg_coord_to_elem(const CCGKey &key,
-                                         const SubdivCCG &subdiv_ccg,
-                                         const SubdivCCGCoord &coord)
-{
-  return CCG_grid_elem(key, subdiv_ccg.grids[coord.grid_index], coord.x, coord.y);
-}
-
 /* Returns storage where boundary elements are to be stored. */
 static SubdivCCGCoord *subdiv_ccg_adjacent_edge_add_face(SubdivCCG &subdiv_ccg,
                                                          SubdivCCGAdjacentEdge &adjacent_edge)
@@ -469,10 +404,9 @@ std::unique_ptr<SubdivCCG> BKE_subdiv_to_ccg(Subdiv &subdiv,
   subdiv_ccg->subdiv = &subdiv;
   subdiv_ccg->level = bitscan_forward_i(settings.resolution - 1);
   subdiv_ccg->grid_size = grid_size_from_level(subdiv_ccg->level);
-  subdiv_ccg_init_layers(*subdiv_ccg, settings);
   subdiv_ccg->faces = coarse_mesh.faces();
   subdiv_ccg->grid_to_face_map = coarse_mesh.corner_to_face_map();
-  subdiv_ccg_alloc_elements(*subdiv_ccg, subdiv);
+  subdiv_ccg_alloc_elements(*subdiv_ccg, subdiv, settings);
   subdiv_ccg_init_faces_neighborhood(*subdiv_ccg);
   if (!subdiv_ccg_evaluate_grids(*subdiv_ccg, subdiv, mask_evaluator)) {
     stats_end(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
@@ -538,16 +472,17 @@ CCGKey BKE_subdiv_ccg_key(const SubdivCCG &subdiv_ccg, int level)
 #ifdef WITH_OPENSUBDIV
   CCGKey key;
   key.level = level;
-  key.elem_size = element_size_bytes_get(subdiv_ccg);
   key.grid_size = grid_size_from_level(level);
   key.grid_area = key.grid_size * key.grid_size;
-  key.grid_bytes = key.elem_size * key.grid_area;
 
-  key.normal_offset = subdiv_ccg.normal_offset;
-  key.mask_offset = subdiv_ccg.mask_offset;
+  /* The layers are stored in separate arrays, there is no interleaved element. */
+  key.elem_size = -1;
+  key.grid_bytes = -1;
+  key.normal_offset = -1;
+  key.mask_offset = -1;
 
-  key.has_normals = subdiv_ccg.has_normal;
-  key.has_mask = subdiv_ccg.has_mask;
+  key.has_normals = !subdiv_ccg.normals.is_empty();
+  key.has_mask = !subdiv_ccg.masks.is_empty();
   return key;
 #else
   UNUSED_VARS(subdiv_ccg, level);
@@ -580,35 +515,31 @@ static void subdiv_ccg_recalc_inner_face_normals(const SubdivCCG &subdiv_ccg,
 {
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_size_1 = grid_size - 1;
-  CCGElem *grid = subdiv_ccg.grids[corner];
+  const Span<float3> grid_positions = subdiv_ccg.positions.as_span().slice(
+      grid_range(key, corner));
   for (int y = 0; y < grid_size - 1; y++) {
     for (int x = 0; x < grid_size - 1; x++) {
-      CCGElem *grid_elements[4] = {
-          CCG_grid_elem(key, grid, x, y + 1),
-          CCG_grid_elem(key, grid, x + 1, y + 1),
-          CCG_grid_elem(key, grid, x + 1, y),
-          CCG_grid_elem(key, grid, x, y),
-      };
       const int face_index = y * grid_size_1 + x;
       float *face_normal = face_normals[face_index];
       normal_quad_v3(face_normal,
-                     CCG_elem_co(key, grid_elements[0]),
-                     CCG_elem_co(key, grid_elements[1]),
-                     CCG_elem_co(key, grid_elements[2]),
-                     CCG_elem_co(key, grid_elements[3]));
+                     grid_positions[CCG_grid_xy_to_index(grid_size, x, y + 1)],
+                     grid_positions[CCG_grid_xy_to_index(grid_size, x + 1, y + 1)],
+                     grid_positions[CCG_grid_xy_to_index(grid_size, x + 1, y)],
+                     grid_positions[CCG_grid_xy_to_index(grid_size, x, y)]);
     }
   }
 }
 
 /* Average normals at every grid element, using adjacent faces normals. */
-static void subdiv_ccg_average_inner_face_normals(const SubdivCCG &subdiv_ccg,
+static void subdiv_ccg_average_inner_face_normals(SubdivCCG &subdiv_ccg,
                                                   const CCGKey &key,
                                                   const Span<float3> face_normals,
                                                   const int corner)
 {
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_size_1 = grid_size - 1;
-  CCGElem *grid = subdiv_ccg.grids[corner];
+  MutableSpan<float3> grid_normals = subdiv_ccg.normals.as_mutable_span().slice(
+      grid_range(key, corner));
   for (int y = 0; y < grid_size; y++) {
     for (int x = 0; x < grid_size; x++) {
       float normal_acc[3] = {0.0f, 0.0f, 0.0f};
@@ -633,7 +564,8 @@ static void subdiv_ccg_average_inner_face_normals(const SubdivCCG &subdiv_ccg,
         counter++;
       }
       /* Normalize and store. */
-      mul_v3_v3fl(CCG_grid_elem_no(key, grid, x, y), normal_acc, 1.0f / counter);
+      mul_v3_v3fl(
+          grid_normals[CCG_grid_xy_to_index(grid_size, x, y)], normal_acc, 1.0f / counter);
     }
   }
 }
@@ -667,7 +599,7 @@ static void subdiv_ccg_recalc_inner_grid_normals(SubdivCCG &subdiv_ccg, const In
 void BKE_subdiv_ccg_recalc_normals(SubdivCCG &subdiv_ccg)
 {
 #ifdef WITH_OPENSUBDIV
-  if (!subdiv_ccg.has_normal) {
+  if (subdiv_ccg.normals.is_empty()) {
     /* Grids don't have normals, can do early output. */
     return;
   }
@@ -681,7 +613,7 @@ void BKE_subdiv_ccg_recalc_normals(SubdivCCG &subdiv_ccg)
 void BKE_subdiv_ccg_update_normals(SubdivCCG &subdiv_ccg, const IndexMask &face_mask)
 {
 #ifdef WITH_OPENSUBDIV
-  if (!subdiv_ccg.has_normal) {
+  if (subdiv_ccg.normals.is_empty()) {
     /* Grids don't have normals, can do early output. */
     return;
   }
@@ -713,21 +645,21 @@ static void average_grid_element_value_v3(float a[3], float b[3])
   copy_v3_v3(b, a);
 }
 
-static void average_grid_element(const SubdivCCG &subdiv_ccg,
-                                 const CCGKey &key,
-                                 CCGElem *grid_element_a,
-                                 CCGElem *grid_element_b)
+static void average_grid_element(SubdivCCG &subdiv_ccg,
+                                 const int grid_element_a,
+                                 const int grid_element_b)
 {
-  average_grid_element_value_v3(CCG_elem_co(key, grid_element_a),
-                                CCG_elem_co(key, grid_element_b));
-  if (subdiv_ccg.has_normal) {
-    average_grid_element_value_v3(CCG_elem_no(key, grid_element_a),
-                                  CCG_elem_no(key, grid_element_b));
+  average_grid_element_value_v3(subdiv_ccg.positions[grid_element_a],
+                                subdiv_ccg.positions[grid_element_b]);
+  if (!subdiv_ccg.normals.is_empty()) {
+    average_grid_element_value_v3(subdiv_ccg.normals[grid_element_a],
+                                  subdiv_ccg.normals[grid_element_b]);
   }
-  if (subdiv_ccg.has_mask) {
-    float mask = (CCG_elem_mask(key, grid_element_a) + CCG_elem_mask(key, grid_element_b)) * 0.5f;
-    CCG_elem_mask(key, grid_element_a) = mask;
-    CCG_elem_mask(key, grid_element_b) = mask;
+  if (!subdiv_ccg.masks.is_empty()) {
+    const float mask = (subdiv_ccg.masks[grid_element_a] + subdiv_ccg.masks[grid_element_b]) *
+                       0.5f;
+    subdiv_ccg.masks[grid_element_a] = mask;
+    subdiv_ccg.masks[grid_element_b] = mask;
   }
 }
 
@@ -747,15 +679,14 @@ static void element_accumulator_init(GridElementAccumulator &accumulator)
 
 static void element_accumulator_add(GridElementAccumulator &accumulator,
                                     const SubdivCCG &subdiv_ccg,
-                                    const CCGKey &key,
-                                    /*const*/ CCGElem &grid_element)
+                                    const int grid_element)
 {
-  accumulator.co += CCG_elem_co(key, &grid_element);
-  if (subdiv_ccg.has_normal) {
-    accumulator.no += CCG_elem_no(key, &grid_element);
+  accumulator.co += subdiv_ccg.positions[grid_element];
+  if (!subdiv_ccg.normals.is_empty()) {
+    accumulator.no += subdiv_ccg.normals[grid_element];
   }
-  if (subdiv_ccg.has_mask) {
-    accumulator.mask += CCG_elem_mask(key, &grid_element);
+  if (!subdiv_ccg.masks.is_empty()) {
+    accumulator.mask += subdiv_ccg.masks[grid_element];
   }
 }
 
@@ -766,17 +697,16 @@ static void element_accumulator_mul_fl(GridElementAccumulator &accumulator, cons
   accumulator.mask *= f;
 }
 
-static void element_accumulator_copy(const SubdivCCG &subdiv_ccg,
-                                     const CCGKey &key,
-                                     CCGElem &destination,
+static void element_accumulator_copy(SubdivCCG &subdiv_ccg,
+                                     const int destination,
                                      const GridElementAccumulator &accumulator)
 {
-  CCG_elem_co(key, &destination) = accumulator.co;
-  if (subdiv_ccg.has_normal) {
-    CCG_elem_no(key, &destination) = accumulator.no;
+  subdiv_ccg.positions[destination] = accumulator.co;
+  if (!subdiv_ccg.normals.is_empty()) {
+    subdiv_ccg.normals[destination] = accumulator.no;
   }
-  if (subdiv_ccg.has_mask) {
-    CCG_elem_mask(key, &destination) = accumulator.mask;
+  if (!subdiv_ccg.masks.is_empty()) {
+    subdiv_ccg.masks[destination] = accumulator.mask;
   }
 }
 
@@ -784,17 +714,16 @@ static void subdiv_ccg_average_inner_face_grids(SubdivCCG &subdiv_ccg,
                                                 const CCGKey &key,
                                                 const IndexRange face)
 {
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
   const int num_face_grids = face.size();
   const int grid_size = subdiv_ccg.grid_size;
-  CCGElem *prev_grid = grids[face.start() + num_face_grids - 1];
+  int prev_grid = face.start() + num_face_grids - 1;
   /* Average boundary between neighbor grid. */
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
+    const int grid = face.start() + corner;
     for (int i = 1; i < grid_size; i++) {
-      CCGElem *prev_grid_element = CCG_grid_elem(key, prev_grid, i, 0);
-      CCGElem *grid_element = CCG_grid_elem(key, grid, 0, i);
-      average_grid_element(subdiv_ccg, key, prev_grid_element, grid_element);
+      const int prev_grid_element = grid_xy_to_vert(key, prev_grid, i, 0);
+      const int grid_element = grid_xy_to_vert(key, grid, 0, i);
+      average_grid_element(subdiv_ccg, prev_grid_element, grid_element);
     }
     prev_grid = grid;
   }
@@ -803,15 +732,13 @@ static void subdiv_ccg_average_inner_face_grids(SubdivCCG &subdiv_ccg,
   GridElementAccumulator center_accumulator;
   element_accumulator_init(center_accumulator);
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
-    CCGElem *grid_center_element = CCG_grid_elem(key, grid, 0, 0);
-    element_accumulator_add(center_accumulator, subdiv_ccg, key, *grid_center_element);
+    const int grid_center_element = grid_xy_to_vert(key, face.start() + corner, 0, 0);
+    element_accumulator_add(center_accumulator, subdiv_ccg, grid_center_element);
   }
   element_accumulator_mul_fl(center_accumulator, 1.0f / num_face_grids);
   for (int corner = 0; corner < num_face_grids; corner++) {
-    CCGElem *grid = grids[face.start() + corner];
-    CCGElem *grid_center_element = CCG_grid_elem(key, grid, 0, 0);
-    element_accumulator_copy(subdiv_ccg, key, *grid_center_element, center_accumulator);
+    const int grid_center_element = grid_xy_to_vert(key, face.start() + corner, 0, 0);
+    element_accumulator_copy(subdiv_ccg, grid_center_element, center_accumulator);
   }
 }
 
@@ -831,9 +758,8 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG &subdiv_ccg,
   }
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
     for (int i = 1; i < grid_size2 - 1; i++) {
-      CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-          key, subdiv_ccg, adjacent_edge.boundary_coords[face_index][i]);
-      element_accumulator_add(accumulators[i], subdiv_ccg, key, *grid_element);
+      const int grid_element = adjacent_edge.boundary_coords[face_index][i].to_index(key);
+      element_accumulator_add(accumulators[i], subdiv_ccg, grid_element);
     }
   }
   for (int i = 1; i < grid_size2 - 1; i++) {
@@ -842,9 +768,8 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG &subdiv_ccg,
   /* Copy averaged value to all the other faces. */
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
     for (int i = 1; i < grid_size2 - 1; i++) {
-      CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-          key, subdiv_ccg, adjacent_edge.boundary_coords[face_index][i]);
-      element_accumulator_copy(subdiv_ccg, key, *grid_element, accumulators[i]);
+      const int grid_element = adjacent_edge.boundary_coords[face_index][i].to_index(key);
+      element_accumulator_copy(subdiv_ccg, grid_element, accumulators[i]);
     }
   }
 }
@@ -869,16 +794,14 @@ static void subdiv_ccg_average_grids_corners(SubdivCCG &subdiv_ccg,
   GridElementAccumulator accumulator;
   element_accumulator_init(accumulator);
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
-    CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-        key, subdiv_ccg, adjacent_vertex.corner_coords[face_index]);
-    element_accumulator_add(accumulator, subdiv_ccg, key, *grid_element);
+    const int grid_element = adjacent_vertex.corner_coords[face_index].to_index(key);
+    element_accumulator_add(accumulator, subdiv_ccg, grid_element);
   }
   element_accumulator_mul_fl(accumulator, 1.0f / num_adjacent_faces);
   /* Copy averaged value to all the other faces. */
   for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
-    CCGElem *grid_element = subdiv_ccg_coord_to_elem(
-        key, subdiv_ccg, adjacent_vertex.corner_coords[face_index]);
-    element_accumulator_copy(subdiv_ccg, key, *grid_element, accumulator);
+    const int grid_element = adjacent_vertex.corner_coords[face_index].to_index(key);
+    element_accumulator_copy(subdiv_ccg, grid_element, accumulator);
   }
 }
 
@@ -999,7 +922,7 @@ void BKE_subdiv_ccg_topology_counters(const SubdivCCG &subdiv_ccg,
                                       int &r_num_faces,
                                       int &r_num_loops)
 {
-  const int num_grids = subdiv_ccg.grids.size();
+  const int num_grids = subdiv_ccg.grids_num;
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_area = grid_size * grid_size;
   const int num_edges_per_grid = 2 * (grid_size * (grid_size - 1));
@@ -1022,7 +945,7 @@ void BKE_subdiv_ccg_print_coord(const char *message, const SubdivCCGCoord &coord
 
 bool BKE_subdiv_ccg_check_coord_valid(const SubdivCCG &subdiv_ccg, const SubdivCCGCoord &coord)
 {
-  if (coord.grid_index < 0 || coord.grid_index >= subdiv_ccg.grids.size()) {
+  if (coord.grid_index < 0 || coord.grid_index >= subdiv_ccg.grids_num) {
     return false;
   }
   const int grid_size = subdiv_ccg.grid_size;
@@ -1536,7 +1459,7 @@ void BKE_subdiv_ccg_neighbor_coords_get(const SubdivCCG &subdiv_ccg,
 {
 #ifdef WITH_OPENSUBDIV
   BLI_assert(coord.grid_index >= 0);
-  BLI_assert(coord.grid_index < subdiv_ccg.grids.size());
+  BLI_assert(coord.grid_index < subdiv_ccg.grids_num);
   BLI_assert(coord.x >= 0);
   BLI_assert(coord.x < subdiv_ccg.grid_size);
   BLI_assert(coord.y >= 0);
@@ -1677,7 +1600,7 @@ blender::BitGroupVector<> &BKE_subdiv_ccg_grid_hidden_ensure(SubdivCCG &subdiv_c
 {
   if (subdiv_ccg.grid_hidden.is_empty()) {
     const int grid_area = subdiv_ccg.grid_size * subdiv_ccg.grid_size;
-    subdiv_ccg.grid_hidden = blender::BitGroupVector<>(subdiv_ccg.grids.size(), grid_area, false);
+    subdiv_ccg.grid_hidden = blender::BitGroupVector<>(subdiv_ccg.grids_num, grid_area, false);
   }
   return subdiv_ccg.grid_hidden;
 }
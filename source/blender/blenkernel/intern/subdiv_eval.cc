@@ -18,6 +18,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "subdiv_topology_cache.hh"
+
 #include "opensubdiv_evaluator_capi.hh"
 #include "opensubdiv_topology_refiner_capi.hh"
 
@@ -61,8 +63,14 @@ bool eval_begin(Subdiv *subdiv,
     eOpenSubdivEvaluator opensubdiv_evaluator_type =
         opensubdiv_evalutor_from_subdiv_evaluator_type(evaluator_type);
     stats_begin(&subdiv->stats, SUBDIV_STATS_EVALUATOR_CREATE);
-    subdiv->evaluator = openSubdiv_createEvaluatorFromTopologyRefiner(
-        subdiv->topology_refiner, opensubdiv_evaluator_type, evaluator_cache);
+    if (subdiv->shared_topology != nullptr) {
+      subdiv->evaluator = openSubdiv_createEvaluatorFromTables(
+          subdiv->shared_topology->evaluator_tables, opensubdiv_evaluator_type, evaluator_cache);
+    }
+    else {
+      subdiv->evaluator = openSubdiv_createEvaluatorFromTopologyRefiner(
+          subdiv->topology_refiner, opensubdiv_evaluator_type, evaluator_cache);
+    }
     stats_end(&subdiv->stats, SUBDIV_STATS_EVALUATOR_CREATE);
     if (subdiv->evaluator == nullptr) {
       return false;
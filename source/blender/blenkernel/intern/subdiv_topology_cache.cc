@@ -0,0 +1,180 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <mutex>
+
+#include <xxhash.h>
+
+#include "DNA_mesh_types.h"
+
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_mesh.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "subdiv_topology_cache.hh"
+
+#include "opensubdiv_evaluator_capi.hh"
+#include "opensubdiv_topology_refiner_capi.hh"
+
+namespace blender::bke::subdiv {
+
+/* Number of topologies without users kept in the cache. This allows evaluations which create a
+ * new subdivision surface every time, like geometry nodes, to reuse the topology of the previous
+ * frame. */
+static constexpr int UNUSED_TOPOLOGIES_MAX = 4;
+
+struct TopologyCache {
+  std::mutex mutex;
+  /* All topologies, by hash of the mesh topology. The same key is used by topologies which only
+   * differ in settings, UV maps or creases, and by hash collisions. */
+  Map<uint64_t, Vector<SharedTopology *>> topologies;
+  /* Topologies without users, the least recently used first. */
+  Vector<SharedTopology *> unused;
+};
+
+static TopologyCache &topology_cache()
+{
+  static TopologyCache cache;
+  return cache;
+}
+
+static uint64_t mesh_topology_hash(const Mesh *mesh)
+{
+  const Span<int> face_offsets = mesh->face_offsets();
+  const Span<int> corner_verts = mesh->corner_verts();
+  uint64_t hash = XXH3_64bits_withSeed(
+      face_offsets.data(), face_offsets.size_in_bytes(), uint64_t(mesh->verts_num));
+  hash = XXH3_64bits_withSeed(corner_verts.data(), corner_verts.size_in_bytes(), hash);
+  return hash;
+}
+
+static SharedTopology *find_topology(const TopologyCache &cache,
+                                     const uint64_t hash,
+                                     const Settings *settings,
+                                     const OpenSubdiv_Converter *converter)
+{
+  const Vector<SharedTopology *> *topologies = cache.topologies.lookup_ptr(hash);
+  if (topologies == nullptr) {
+    return nullptr;
+  }
+  for (SharedTopology *topology : *topologies) {
+    if (settings_equal(&topology->settings, settings) &&
+        openSubdiv_topologyRefinerCompareWithConverter(topology->topology_refiner, converter))
+    {
+      return topology;
+    }
+  }
+  return nullptr;
+}
+
+static void add_user(TopologyCache &cache, SharedTopology *topology)
+{
+  if (topology->users == 0) {
+    cache.unused.remove(cache.unused.first_index_of(topology));
+  }
+  topology->users++;
+}
+
+static void remove_topology(TopologyCache &cache, SharedTopology *topology)
+{
+  Vector<SharedTopology *> &topologies = cache.topologies.lookup(topology->hash);
+  topologies.remove_first_occurrence_and_reorder(topology);
+  if (topologies.is_empty()) {
+    cache.topologies.remove(topology->hash);
+  }
+}
+
+static void free_topology(SharedTopology *topology)
+{
+  openSubdiv_deleteEvaluatorTables(topology->evaluator_tables);
+  openSubdiv_deleteTopologyRefiner(topology->topology_refiner);
+  MEM_delete(topology);
+}
+
+SharedTopology *topology_cache_ensure(const Settings *settings,
+                                      const Mesh *mesh,
+                                      OpenSubdiv_Converter *converter)
+{
+  TopologyCache &cache = topology_cache();
+  const uint64_t hash = mesh_topology_hash(mesh);
+  {
+    std::lock_guard lock(cache.mutex);
+    if (SharedTopology *topology = find_topology(cache, hash, settings, converter)) {
+      add_user(cache, topology);
+      return topology;
+    }
+  }
+
+  /* Refining the topology and building its tables takes much longer than the comparisons, so
+   * it is done without holding the lock. */
+  OpenSubdiv_TopologyRefinerSettings topology_refiner_settings;
+  topology_refiner_settings.level = settings->level;
+  topology_refiner_settings.is_adaptive = settings->is_adaptive;
+  OpenSubdiv_TopologyRefiner *topology_refiner = openSubdiv_createTopologyRefinerFromConverter(
+      converter, &topology_refiner_settings);
+  if (topology_refiner == nullptr) {
+    return nullptr;
+  }
+  SharedTopology *new_topology = MEM_new<SharedTopology>(__func__);
+  new_topology->settings = *settings;
+  new_topology->hash = hash;
+  new_topology->topology_refiner = topology_refiner;
+  new_topology->evaluator_tables = openSubdiv_createEvaluatorTables(topology_refiner);
+  new_topology->users = 1;
+
+  std::lock_guard lock(cache.mutex);
+  /* Another thread might have added the same topology in the meantime. */
+  if (SharedTopology *topology = find_topology(cache, hash, settings, converter)) {
+    add_user(cache, topology);
+    free_topology(new_topology);
+    return topology;
+  }
+  cache.topologies.lookup_or_add_default(hash).append(new_topology);
+  return new_topology;
+}
+
+void topology_cache_release(SharedTopology *topology)
+{
+  TopologyCache &cache = topology_cache();
+  SharedTopology *evicted_topology;
+  {
+    std::lock_guard lock(cache.mutex);
+    BLI_assert(topology->users > 0);
+    topology->users--;
+    if (topology->users > 0) {
+      return;
+    }
+    cache.unused.append(topology);
+    if (cache.unused.size() <= UNUSED_TOPOLOGIES_MAX) {
+      return;
+    }
+    evicted_topology = cache.unused.first();
+    cache.unused.remove(0);
+    remove_topology(cache, evicted_topology);
+  }
+  free_topology(evicted_topology);
+}
+
+void topology_cache_clear()
+{
+  TopologyCache &cache = topology_cache();
+  std::lock_guard lock(cache.mutex);
+  for (SharedTopology *topology : cache.unused) {
+    remove_topology(cache, topology);
+    free_topology(topology);
+  }
+  cache.unused.clear_and_shrink();
+  if (cache.topologies.is_empty()) {
+    cache.topologies.clear_and_shrink();
+  }
+}
+
+}  // namespace blender::bke::subdiv
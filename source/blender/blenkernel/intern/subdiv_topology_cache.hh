@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of refined OpenSubdiv topologies, shared by the subdivision surfaces of all meshes with
+ * the same topology and settings, like instances of the same mesh or deformed meshes of
+ * animated characters.
+ */
+
+#include <cstdint>
+
+#include "BKE_subdiv.hh"
+
+struct Mesh;
+struct OpenSubdiv_Converter;
+struct OpenSubdiv_EvaluatorTables;
+class OpenSubdiv_TopologyRefiner;
+
+namespace blender::bke::subdiv {
+
+/* Refined topology and the stencil and patch tables used to create evaluators for it.
+ * It is not modified once added to the cache, so it can be used from any thread. */
+struct SharedTopology {
+  Settings settings;
+  /* Hash of the mesh topology, only used to find candidates for a full comparison. */
+  uint64_t hash;
+  OpenSubdiv_TopologyRefiner *topology_refiner;
+  OpenSubdiv_EvaluatorTables *evaluator_tables;
+  /* Number of subdivision surfaces using the topology, protected by the cache mutex. */
+  int users;
+};
+
+/* Find the topology created for the same settings and mesh topology, or create it.
+ * The topology has a user added, which is to be removed with #topology_cache_release.
+ *
+ * Returns null when OpenSubdiv can not deal with the topology, for example when the mesh has no
+ * faces. */
+SharedTopology *topology_cache_ensure(const Settings *settings,
+                                      const Mesh *mesh,
+                                      OpenSubdiv_Converter *converter);
+
+void topology_cache_release(SharedTopology *topology);
+
+/* Free the topologies which have no users left. */
+void topology_cache_clear();
+
+}  // namespace blender::bke::subdiv
@@ -11,6 +11,7 @@
 #  include <cstdio>
 #  include <cstring>
 
+#  include <atomic>
 #  include <cstdlib>
 
 #  include "MEM_guardedalloc.h"
@@ -26,7 +27,9 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.hh"
 #  include "BLI_threads.h"
+#  include "BLI_time.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_vector.hh"
 
@@ -77,6 +80,34 @@ static ThreadMutex swscale_cache_lock = PTHREAD_MUTEX_INITIALIZER;
 static int64_t swscale_cache_timestamp = 0;
 static blender::Vector<SwscaleContext> *swscale_cache = nullptr;
 
+/* Number of frames which can wait for encoding before appending another frame blocks. */
+#  define FFMPEG_WRITER_QUEUE_SIZE 4
+
+struct FFMpegWriterFrame {
+  /* Image in Blender's own pixel format. */
+  AVFrame *frame;
+  /* Time up to which audio is encoded after this frame, in seconds. */
+  double audio_to_time;
+};
+
+/* Converts and encodes appended frames on a separate thread, so the render loop can continue with
+ * the next frame. Frames cycle between the free and the queued frames, which bounds the number of
+ * frames waiting for the encoder. */
+struct FFMpegWriter {
+  ListBase threads;
+  ThreadQueue *queued_frames;
+  ThreadQueue *free_frames;
+  FFMpegWriterFrame frames[FFMPEG_WRITER_QUEUE_SIZE];
+
+  ReportList *reports;
+  std::atomic<bool> error;
+
+  /* Statistics, printed with `--debug-ffmpeg` when the output is closed. */
+  int frames_written;
+  double wait_time;
+  double encode_time;
+};
+
 struct FFMpegContext {
   int ffmpeg_type;
   AVCodecID ffmpeg_codec;
@@ -104,6 +135,9 @@ struct FFMpegContext {
   AVFrame *img_convert_frame;
   SwsContext *img_convert_ctx;
 
+  /* Only used when writing asynchronously, see #FFMpegWriter. */
+  FFMpegWriter *writer;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -131,6 +165,7 @@ static void ffmpeg_filepath_get(FFMpegContext *context,
                                 const RenderData *rd,
                                 bool preview,
                                 const char *suffix);
+static void ffmpeg_writer_start(FFMpegContext *context, ReportList *reports);
 
 /* Delete a picture buffer */
 
@@ -395,17 +430,65 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
+/* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
+ * the image vertically. */
+static void copy_image_to_frame(const ImBuf *image, AVFrame *rgb_frame)
+{
+  const uint8_t *pixels = image->byte_buffer.data;
+  const int height = rgb_frame->height;
+  const int linesize = rgb_frame->linesize[0];
+  const int linesize_src = rgb_frame->width * 4;
+
+  blender::threading::parallel_for(
+      blender::IndexRange(height), 64, [&](const blender::IndexRange range) {
+        for (const int64_t y : range) {
+          uint8_t *target = rgb_frame->data[0] + linesize * (height - y - 1);
+          const uint8_t *src = pixels + linesize_src * y;
+
+#  if ENDIAN_ORDER == L_ENDIAN
+          memcpy(target, src, linesize_src);
+
+#  elif ENDIAN_ORDER == B_ENDIAN
+          const uint8_t *end = src + linesize_src;
+          while (src != end) {
+            target[3] = src[0];
+            target[2] = src[1];
+            target[1] = src[2];
+            target[0] = src[3];
+
+            target += 4;
+            src += 4;
+          }
+#  else
+#    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
+#  endif
+        }
+      });
+}
+
+/* Convert to the output pixel format, if it's different that Blender's internal one. Returns the
+ * frame to encode. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  if (context->img_convert_ctx == nullptr) {
+    return rgb_frame;
+  }
+
+  /* Ensure the frame we are scaling to is writable as well. */
+  av_frame_make_writable(context->current_frame);
+  BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
+
+  return context->current_frame;
+}
+
 /* read and encode a frame of video from the buffer */
 static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 {
   /* For now only 8-bit/channel images are supported. */
-  const uint8_t *pixels = image->byte_buffer.data;
-  if (pixels == nullptr) {
+  if (image->byte_buffer.data == nullptr) {
     return nullptr;
   }
 
-  AVCodecParameters *codec = context->video_stream->codecpar;
-  int height = codec->height;
   AVFrame *rgb_frame;
 
   if (context->img_convert_frame != nullptr) {
@@ -421,42 +504,9 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
    * shared (i.e. not writable). */
   av_frame_make_writable(rgb_frame);
 
-  /* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
-   * the image vertically. */
-  int linesize = rgb_frame->linesize[0];
-  int linesize_src = rgb_frame->width * 4;
-  for (int y = 0; y < height; y++) {
-    uint8_t *target = rgb_frame->data[0] + linesize * (height - y - 1);
-    const uint8_t *src = pixels + linesize_src * y;
-
-#  if ENDIAN_ORDER == L_ENDIAN
-    memcpy(target, src, linesize_src);
-
-#  elif ENDIAN_ORDER == B_ENDIAN
-    const uint8_t *end = src + linesize_src;
-    while (src != end) {
-      target[3] = src[0];
-      target[2] = src[1];
-      target[1] = src[2];
-      target[0] = src[3];
+  copy_image_to_frame(image, rgb_frame);
 
-      target += 4;
-      src += 4;
-    }
-#  else
-#    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
-#  endif
-  }
-
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != nullptr) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    /* Ensure the frame we are scaling to is writable as well. */
-    av_frame_make_writable(context->current_frame);
-    BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
-  }
-
-  return context->current_frame;
+  return convert_video_frame(context, rgb_frame);
 }
 
 static AVRational calc_time_base(uint den, double num, int codec_id)
@@ -1692,6 +1742,12 @@ bool BKE_ffmpeg_start(void *context_v,
         scene, specs, preview ? rd->psfra : rd->sfra, rd->ffcodecdata.audio_volume);
   }
 #  endif
+
+  /* Splitting the output needs the file size after each frame, write those synchronously. */
+  if (success && context->video_stream && !context->ffmpeg_autosplit) {
+    ffmpeg_writer_start(context, reports);
+  }
+
   return success;
 }
 
@@ -1712,6 +1768,115 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous Writer
+ * \{ */
+
+static void *ffmpeg_writer_thread(void *context_v)
+{
+  FFMpegContext *context = static_cast<FFMpegContext *>(context_v);
+  FFMpegWriter *writer = context->writer;
+
+  /* Returns null once the writer is stopped and all queued frames are written. */
+  while (FFMpegWriterFrame *writer_frame = static_cast<FFMpegWriterFrame *>(
+             BLI_thread_queue_pop(writer->queued_frames)))
+  {
+    const double start_time = BLI_time_now_seconds();
+
+    if (!writer->error) {
+      AVFrame *avframe = convert_video_frame(context, writer_frame->frame);
+      if (!write_video_frame(context, avframe, writer->reports)) {
+        writer->error = true;
+      }
+#  ifdef WITH_AUDASPACE
+      write_audio_frames(context, writer_frame->audio_to_time);
+#  endif
+    }
+
+    writer->encode_time += BLI_time_now_seconds() - start_time;
+    writer->frames_written++;
+
+    BLI_thread_queue_push(writer->free_frames, writer_frame);
+  }
+
+  return nullptr;
+}
+
+static void ffmpeg_writer_start(FFMpegContext *context, ReportList *reports)
+{
+  AVCodecContext *c = context->video_codec;
+  const AVPixelFormat rgb_format = context->img_convert_ctx ? AV_PIX_FMT_RGBA : c->pix_fmt;
+
+  FFMpegWriter *writer = MEM_new<FFMpegWriter>(__func__);
+  writer->queued_frames = BLI_thread_queue_init();
+  writer->free_frames = BLI_thread_queue_init();
+  writer->reports = reports;
+  writer->error = false;
+
+  for (FFMpegWriterFrame &writer_frame : writer->frames) {
+    writer_frame.frame = alloc_picture(rgb_format, c->width, c->height);
+    BLI_thread_queue_push(writer->free_frames, &writer_frame);
+  }
+
+  context->writer = writer;
+
+  BLI_threadpool_init(&writer->threads, ffmpeg_writer_thread, 1);
+  BLI_threadpool_insert(&writer->threads, context);
+}
+
+/* Write all queued frames and stop the writer thread. */
+static void ffmpeg_writer_stop(FFMpegContext *context)
+{
+  FFMpegWriter *writer = context->writer;
+  if (writer == nullptr) {
+    return;
+  }
+
+  BLI_thread_queue_nowait(writer->queued_frames);
+  BLI_threadpool_end(&writer->threads);
+
+  PRINT("Wrote %d frames, %.2f s converting and encoding, %.2f s waiting for the encoder\n",
+        writer->frames_written,
+        writer->encode_time,
+        writer->wait_time);
+
+  for (FFMpegWriterFrame &writer_frame : writer->frames) {
+    delete_picture(writer_frame.frame);
+  }
+  BLI_thread_queue_free(writer->queued_frames);
+  BLI_thread_queue_free(writer->free_frames);
+
+  MEM_delete(writer);
+  context->writer = nullptr;
+}
+
+/* Copy the image and queue it for encoding, blocks while the queue is full. */
+static bool ffmpeg_writer_append(FFMpegContext *context, const ImBuf *image, double audio_to_time)
+{
+  FFMpegWriter *writer = context->writer;
+
+  /* For now only 8-bit/channel images are supported. */
+  if (image->byte_buffer.data == nullptr) {
+    return false;
+  }
+
+  const double start_time = BLI_time_now_seconds();
+  FFMpegWriterFrame *writer_frame = static_cast<FFMpegWriterFrame *>(
+      BLI_thread_queue_pop(writer->free_frames));
+  writer->wait_time += BLI_time_now_seconds() - start_time;
+
+  /* The encoder might still reference the frame when it was encoded without conversion. */
+  av_frame_make_writable(writer_frame->frame);
+  copy_image_to_frame(image, writer_frame->frame);
+  writer_frame->audio_to_time = audio_to_time;
+
+  BLI_thread_queue_push(writer->queued_frames, writer_frame);
+
+  return !writer->error;
+}
+
+/** \} */
+
 bool BKE_ffmpeg_append(void *context_v,
                        RenderData *rd,
                        int start_frame,
@@ -1727,14 +1892,20 @@ bool BKE_ffmpeg_append(void *context_v,
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, image->x, image->y);
 
   if (context->video_stream) {
+    /* Add +1 frame because we want to encode audio up until the next video frame. */
+    const double audio_to_time = (frame - start_frame + 1) /
+                                 (double(rd->frs_sec) / double(rd->frs_sec_base));
+
+    if (context->writer) {
+      return ffmpeg_writer_append(context, image, audio_to_time);
+    }
+
     avframe = generate_video_frame(context, image);
     success = (avframe && write_video_frame(context, avframe, reports));
 #  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (double(rd->frs_sec) / double(rd->frs_sec_base)));
+    write_audio_frames(context, audio_to_time);
 #  else
-    UNUSED_VARS(start_frame);
+    UNUSED_VARS(audio_to_time);
 #  endif
 
     if (context->ffmpeg_autosplit) {
@@ -1838,6 +2009,7 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 void BKE_ffmpeg_end(void *context_v)
 {
   FFMpegContext *context = static_cast<FFMpegContext *>(context_v);
+  ffmpeg_writer_stop(context);
   end_ffmpeg_impl(context, false);
 }
 
@@ -1980,6 +2152,7 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context == nullptr) {
     return;
   }
+  ffmpeg_writer_stop(context);
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
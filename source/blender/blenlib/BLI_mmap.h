@@ -35,6 +35,10 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Whether an IO error occurred while reading the mapped memory, including reads through the
+ * pointer returned by #BLI_mmap_get_pointer. */
+bool BLI_mmap_any_io_error(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
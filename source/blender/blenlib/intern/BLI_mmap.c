@@ -9,6 +9,7 @@
 #include "BLI_mmap.h"
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h"
 
 #include <string.h>
@@ -58,6 +59,9 @@ static struct error_handler_data {
   void (*next_handler)(int, siginfo_t *, void *);
 } error_handler = {0};
 
+/* Files may be opened and closed from multiple threads. */
+static ThreadMutex error_handler_mutex = BLI_MUTEX_INITIALIZER;
+
 static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
 {
   /* We only handle SIGBUS here for now. */
@@ -118,14 +122,19 @@ static bool sigbus_handler_setup(void)
 /* Adds a file to the list that the error handler checks. */
 static void sigbus_handler_add(BLI_mmap_file *file)
 {
-  BLI_addtail(&error_handler.open_mmaps, BLI_genericNodeN(file));
+  LinkData *link = BLI_genericNodeN(file);
+  BLI_mutex_lock(&error_handler_mutex);
+  BLI_addtail(&error_handler.open_mmaps, link);
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 
 /* Removes a file from the list that the error handler checks. */
 static void sigbus_handler_remove(BLI_mmap_file *file)
 {
+  BLI_mutex_lock(&error_handler_mutex);
   LinkData *link = BLI_findptr(&error_handler.open_mmaps, file, offsetof(LinkData, data));
   BLI_freelinkN(&error_handler.open_mmaps, link);
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 #endif
 
@@ -139,7 +148,10 @@ BLI_mmap_file *BLI_mmap_open(int fd)
 
 #ifndef WIN32
   /* Ensure that the SIGBUS handler is configured. */
-  if (!sigbus_handler_setup()) {
+  BLI_mutex_lock(&error_handler_mutex);
+  const bool handler_configured = sigbus_handler_setup();
+  BLI_mutex_unlock(&error_handler_mutex);
+  if (!handler_configured) {
     return NULL;
   }
 
@@ -218,6 +230,11 @@ size_t BLI_mmap_get_length(const BLI_mmap_file *file)
   return file->length;
 }
 
+bool BLI_mmap_any_io_error(const BLI_mmap_file *file)
+{
+  return file->io_error;
+}
+
 void BLI_mmap_free(BLI_mmap_file *file)
 {
 #ifndef WIN32
@@ -43,6 +43,8 @@ struct MemFileChunk {
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
+  /** 128 bit hash of the content, compared instead of the data to detect identical chunks. */
+  uint64_t hash[2];
 };
 
 struct MemFile {
@@ -90,6 +92,15 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add a large block of data as consecutive chunks of at most \a chunk_size bytes, which is the
+ * same as adding each of them with #BLO_memfile_chunk_add. Chunks are hashed and copied in
+ * parallel.
+ */
+void BLO_memfile_chunks_add(MemFileWriteData *mem_data,
+                            const char *buf,
+                            size_t size,
+                            size_t chunk_size);
 
 /* exports */
 
@@ -6,6 +6,8 @@
  * \ingroup blenloader
  */
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -20,12 +22,16 @@
 #  include <io.h>
 #endif
 
+#include <xxhash.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_task.hh"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -128,7 +134,21 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   mem_data->id_session_uid_mapping.clear_and_shrink();
 }
 
-void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
+static void memfile_chunk_hash(const char *buf, const size_t size, uint64_t r_hash[2])
+{
+  const XXH128_hash_t hash = XXH3_128bits(buf, size);
+  r_hash[0] = hash.low64;
+  r_hash[1] = hash.high64;
+}
+
+/**
+ * Append a chunk to the written memfile. When it matches the corresponding chunk of the reference
+ * memfile, the buffer of that chunk is shared, otherwise the buffer of the new chunk is left to be
+ * copied by the caller.
+ */
+static MemFileChunk *memfile_chunk_append(MemFileWriteData *mem_data,
+                                          const size_t size,
+                                          const uint64_t hash[2])
 {
   MemFile *memfile = mem_data->written_memfile;
   MemFileChunk **compchunk_step = &mem_data->reference_current_chunk;
@@ -143,28 +163,84 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
   curchunk->is_identical_future = true;
   curchunk->id_session_uid = mem_data->current_id_session_uid;
+  curchunk->hash[0] = hash[0];
+  curchunk->hash[1] = hash[1];
   BLI_addtail(&memfile->chunks, curchunk);
 
-  /* we compare compchunk with buf */
+  /* We compare compchunk with the new data. Comparing the hashes avoids reading the data of the
+   * previous step, the chance of a collision of 128 bit hashes is negligible. */
   if (*compchunk_step != nullptr) {
     MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
-        curchunk->buf = compchunk->buf;
-        curchunk->is_identical = true;
-        compchunk->is_identical_future = true;
-      }
+    if (compchunk->size == curchunk->size && compchunk->hash[0] == hash[0] &&
+        compchunk->hash[1] == hash[1])
+    {
+      curchunk->buf = compchunk->buf;
+      curchunk->is_identical = true;
+      compchunk->is_identical_future = true;
     }
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  return curchunk;
+}
+
+static void memfile_chunk_copy(MemFileChunk *chunk, const char *buf)
+{
+  char *buf_new = static_cast<char *>(MEM_mallocN(chunk->size, "Chunk buffer"));
+  memcpy(buf_new, buf, chunk->size);
+  chunk->buf = buf_new;
+}
+
+void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
+{
+  uint64_t hash[2];
+  memfile_chunk_hash(buf, size, hash);
+  MemFileChunk *curchunk = memfile_chunk_append(mem_data, size, hash);
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
-    char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
+    memfile_chunk_copy(curchunk, buf);
+    mem_data->written_memfile->size += size;
+  }
+}
+
+void BLO_memfile_chunks_add(MemFileWriteData *mem_data,
+                            const char *buf,
+                            const size_t size,
+                            const size_t chunk_size)
+{
+  using namespace blender;
+  const IndexRange chunks_range(int64_t((size + chunk_size - 1) / chunk_size));
+  const auto chunk_offset = [&](const int64_t i) { return size_t(i) * chunk_size; };
+  const auto chunk_len = [&](const int64_t i) {
+    return std::min(chunk_size, size - chunk_offset(i));
+  };
+
+  Array<std::array<uint64_t, 2>> hashes(chunks_range.size());
+  threading::parallel_for(chunks_range, 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      memfile_chunk_hash(buf + chunk_offset(i), chunk_len(i), hashes[i].data());
+    }
+  });
+
+  /* Matching with the reference chunks depends on the order of the chunks. */
+  Array<MemFileChunk *> chunks(chunks_range.size());
+  size_t copied_size = 0;
+  for (const int64_t i : chunks_range) {
+    chunks[i] = memfile_chunk_append(mem_data, chunk_len(i), hashes[i].data());
+    if (chunks[i]->buf == nullptr) {
+      copied_size += chunks[i]->size;
+    }
   }
+
+  threading::parallel_for(chunks_range, 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (chunks[i]->buf == nullptr) {
+        memfile_chunk_copy(chunks[i], buf + chunk_offset(i));
+      }
+    }
+  });
+  mem_data->written_memfile->size += copied_size;
 }
 
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
@@ -5,6 +5,8 @@
 #include "COM_ExecutionModel.h"
 #include "COM_CompositorContext.h"
 
+#include "BKE_node_runtime.hh"
+
 namespace blender::compositor {
 
 ExecutionModel::ExecutionModel(CompositorContext &context, Span<NodeOperation *> operations)
@@ -18,6 +20,10 @@ ExecutionModel::ExecutionModel(CompositorContext &context, Span<NodeOperation *>
                               viewer_border->ymin < viewer_border->ymax;
   border_.viewer_border = viewer_border;
 
+  border_.use_viewer_region = node_tree->runtime->viewer_region.has_value();
+  border_.viewer_region = border_.use_viewer_region ? &*node_tree->runtime->viewer_region :
+                                                      nullptr;
+
   const RenderData *rd = context_.get_render_data();
   /* Case when cropping to render border happens is handled in
    * compositor output and render layer nodes. */
@@ -32,6 +32,9 @@ class ExecutionModel {
     const rctf *render_border;
     bool use_viewer_border;
     const rctf *viewer_border;
+    /** Region of the viewer visible in the editors, see #bNodeTreeRuntime::viewer_region. */
+    bool use_viewer_region;
+    const rctf *viewer_region;
   } border_;
 
   /**
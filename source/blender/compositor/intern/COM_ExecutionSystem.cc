@@ -25,7 +25,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bool rendering,
                                  const char *view_name,
                                  realtime_compositor::RenderContext *render_context,
-                                 realtime_compositor::Profiler *profiler)
+                                 realtime_compositor::Profiler *profiler,
+                                 ResultCache *result_cache)
 {
   num_work_threads_ = WorkScheduler::get_num_cpu_threads();
   context_.set_render_context(render_context);
@@ -46,7 +47,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
     builder.convert_to_operations(this);
   }
 
-  execution_model_ = new FullFrameExecutionModel(context_, active_buffers_, operations_);
+  execution_model_ = new FullFrameExecutionModel(
+      context_, active_buffers_, operations_, result_cache);
 }
 
 ExecutionSystem::~ExecutionSystem()
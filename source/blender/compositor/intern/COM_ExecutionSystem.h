@@ -86,6 +86,7 @@ namespace blender::compositor {
 /* Forward declarations. */
 class ExecutionModel;
 class NodeOperation;
+class ResultCache;
 
 /**
  * \brief the ExecutionSystem contains the whole compositor tree.
@@ -128,6 +129,7 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param result_cache: Keeps operation results across executions, may be null.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
@@ -135,7 +137,8 @@ class ExecutionSystem {
                   bool rendering,
                   const char *view_name,
                   realtime_compositor::RenderContext *render_context,
-                  realtime_compositor::Profiler *profiler);
+                  realtime_compositor::Profiler *profiler,
+                  ResultCache *result_cache = nullptr);
 
   /**
    * Destructor
@@ -2,13 +2,19 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cmath>
+#include <typeinfo>
+
 #include "COM_FullFrameExecutionModel.h"
 
 #include "BLI_string.h"
 
 #include "BLT_translation.hh"
 
+#include "COM_ConstantOperation.h"
 #include "COM_Debug.h"
+#include "COM_ExecutionSystem.h"
+#include "COM_ResultCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -24,10 +30,12 @@ namespace blender::compositor {
 
 FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  SharedOperationBuffers &shared_buffers,
-                                                 Span<NodeOperation *> operations)
+                                                 Span<NodeOperation *> operations,
+                                                 ResultCache *result_cache)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
-      num_operations_finished_(0)
+      num_operations_finished_(0),
+      result_cache_(result_cache)
 {
   priorities_.append(eCompositorPriority::High);
   priorities_.append(eCompositorPriority::Medium);
@@ -42,8 +50,17 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
 
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
+  if (result_cache_) {
+    result_cache_->begin_execution();
+    compute_result_keys();
+  }
+
   determine_areas_to_render_and_reads();
   render_operations();
+
+  if (result_cache_) {
+    add_pending_results_to_cache(exec_system);
+  }
 }
 
 void FullFrameExecutionModel::determine_areas_to_render_and_reads()
@@ -58,6 +75,17 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         get_output_render_area(op, area);
         determine_areas_to_render(op, area);
+      }
+    }
+  }
+
+  /* Reads are determined once all areas are known, as the inputs of operations found in the
+   * result cache are not read. */
+  find_cached_results();
+
+  for (eCompositorPriority priority : priorities_) {
+    for (NodeOperation *op : operations_) {
+      if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         determine_reads(op);
       }
     }
@@ -103,31 +131,52 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
+  if (const std::shared_ptr<MemoryBuffer> *cached_buffer = cached_buffers_.lookup_ptr(op)) {
+    /* Inputs of cached operations are not read, see #determine_reads. */
+    active_buffers_.set_rendered_buffer(op, *cached_buffer);
+    num_operations_finished_++;
+    update_progress_bar();
+    return;
+  }
+
   const timeit::TimePoint before_time = timeit::Clock::now();
 
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
+  std::shared_ptr<MemoryBuffer> op_buf(
+      has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr);
   if (op->get_width() > 0 && op->get_height() > 0) {
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
     const int op_offset_x = output_x - op->get_canvas().xmin;
     const int op_offset_y = output_y - op->get_canvas().ymin;
     Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
-    op->render(op_buf, areas, input_bufs);
-    DebugInfo::operation_rendered(op, op_buf);
+    op->render(op_buf.get(), areas, input_bufs);
+    DebugInfo::operation_rendered(op, op_buf.get());
 
     for (MemoryBuffer *buf : input_bufs) {
       delete buf;
     }
   }
+
+  const timeit::TimePoint after_time = timeit::Clock::now();
+  if (result_cache_) {
+    double cost = std::chrono::duration<double>(after_time - before_time).count();
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      cost += render_costs_.lookup_default(op->get_input_operation(i), 0.0);
+    }
+    render_costs_.add(op, cost);
+    if (is_result_cacheable(op)) {
+      add_pending_result(op, op_buf, cost);
+    }
+  }
+
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
-  active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+  active_buffers_.set_rendered_buffer(op, std::move(op_buf));
 
   operation_finished(op);
 
   /* The operation may not come from any node. For example, it may have been added to convert data
    * type. Do not accumulate time from its execution. */
-  const timeit::TimePoint after_time = timeit::Clock::now();
   const bNodeInstanceKey node_instance_key = op->get_node_instance_key();
   if (context_.get_profiler() && node_instance_key != bke::NODE_INSTANCE_KEY_NONE) {
     context_.get_profiler()->set_node_evaluation_time(node_instance_key, after_time - before_time);
@@ -188,7 +237,8 @@ void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_o
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
   Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
   for (NodeOperation *op : dependencies) {
-    if (!active_buffers_.is_operation_rendered(op)) {
+    /* Operations without reads are only needed by operations found in the result cache. */
+    if (!active_buffers_.is_operation_rendered(op) && active_buffers_.has_registered_reads(op)) {
       render_operation(op);
     }
   }
@@ -235,6 +285,9 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   stack.append(output_op);
   while (stack.size() > 0) {
     NodeOperation *operation = stack.pop_last();
+    if (cached_buffers_.contains(operation)) {
+      continue;
+    }
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
@@ -270,6 +323,146 @@ void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, r
     r_area.ymin = canvas.ymin + norm_border->ymin * h;
     r_area.ymax = canvas.ymin + norm_border->ymax * h;
   }
+
+  /* Only compute the part of the viewer that can be seen. */
+  if (border_.use_viewer_region && output_op->get_flags().is_viewer_operation) {
+    const rctf *norm_region = border_.viewer_region;
+    const int w = output_op->get_width();
+    const int h = output_op->get_height();
+    rcti region;
+    BLI_rcti_init(&region,
+                  canvas.xmin + int(floorf(norm_region->xmin * w)),
+                  canvas.xmin + int(ceilf(norm_region->xmax * w)),
+                  canvas.ymin + int(floorf(norm_region->ymin * h)),
+                  canvas.ymin + int(ceilf(norm_region->ymax * h)));
+    BLI_rcti_isect(&r_area, &region, &r_area);
+  }
+}
+
+std::optional<uint64_t> FullFrameExecutionModel::compute_result_key(
+    NodeOperation *op, Map<NodeOperation *, std::optional<uint64_t>> &r_keys) const
+{
+  if (const std::optional<uint64_t> *key = r_keys.lookup_ptr(op)) {
+    return *key;
+  }
+
+  std::optional<uint64_t> key;
+  const std::optional<uint64_t> state_hash = op->get_node_state_hash();
+  if (state_hash) {
+    const rcti &canvas = op->get_canvas();
+    key = get_default_hash(typeid(*op).hash_code(),
+                           *state_hash,
+                           get_default_hash(canvas.xmin, canvas.xmax, canvas.ymin, canvas.ymax));
+    if (op->get_number_of_output_sockets() > 0) {
+      key = get_default_hash(*key, int(op->get_output_socket()->get_data_type()));
+    }
+    /* Constants may be added without a node, their value is part of their state. */
+    if (op->get_flags().is_constant_operation) {
+      ConstantOperation *constant_op = static_cast<ConstantOperation *>(op);
+      if (constant_op->can_get_constant_elem()) {
+        const float *elem = constant_op->get_constant_elem();
+        const int num_channels = COM_data_type_num_channels(
+            op->get_output_socket()->get_data_type());
+        for (const int i : IndexRange(num_channels)) {
+          key = get_default_hash(*key, elem[i]);
+        }
+      }
+    }
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      const std::optional<uint64_t> input_key = compute_result_key(op->get_input_operation(i),
+                                                                   r_keys);
+      if (!input_key) {
+        key = std::nullopt;
+        break;
+      }
+      key = get_default_hash(*key, *input_key);
+    }
+  }
+
+  r_keys.add(op, key);
+  return key;
+}
+
+void FullFrameExecutionModel::compute_result_keys()
+{
+  /* Settings of the execution that operations may read. */
+  const RenderData *rd = context_.get_render_data();
+  const char *view_name = context_.get_view_name();
+  const uint64_t context_hash = get_default_hash(
+      get_default_hash(context_.get_framenumber(),
+                       StringRef(view_name ? view_name : ""),
+                       context_.is_rendering()),
+      get_default_hash(rd->xsch, rd->ysch, rd->size),
+      get_default_hash(rd->xasp, rd->yasp));
+
+  Map<NodeOperation *, std::optional<uint64_t>> keys;
+  for (NodeOperation *op : operations_) {
+    if (const std::optional<uint64_t> key = compute_result_key(op, keys)) {
+      result_keys_.add(op, get_default_hash(context_hash, *key));
+    }
+  }
+}
+
+bool FullFrameExecutionModel::is_result_cacheable(NodeOperation *op) const
+{
+  return result_keys_.contains(op) && op->get_number_of_output_sockets() > 0 &&
+         !op->get_flags().is_constant_operation && op->get_width() > 0 && op->get_height() > 0;
+}
+
+void FullFrameExecutionModel::find_cached_results()
+{
+  if (!result_cache_) {
+    return;
+  }
+
+  for (NodeOperation *op : operations_) {
+    if (!is_result_cacheable(op)) {
+      continue;
+    }
+    const rcti &canvas = op->get_canvas();
+    const Vector<rcti> areas = active_buffers_.get_areas_to_render(op, -canvas.xmin, -canvas.ymin);
+    if (areas.is_empty()) {
+      continue;
+    }
+    double cost;
+    std::shared_ptr<MemoryBuffer> buffer = result_cache_->lookup(
+        result_keys_.lookup(op), areas, cost);
+    if (buffer) {
+      cached_buffers_.add(op, std::move(buffer));
+      render_costs_.add(op, cost);
+    }
+  }
+}
+
+void FullFrameExecutionModel::add_pending_result(NodeOperation *op,
+                                                 std::shared_ptr<MemoryBuffer> buffer,
+                                                 const double cost)
+{
+  /* Pending results keep their buffers alive until the end of the execution, so they count
+   * against the cache memory limit from now on. */
+  const int64_t memory = int64_t(buffer->get_num_channels()) * buffer->get_width() *
+                         buffer->get_height() * sizeof(float);
+  if (!result_cache_->reserve(memory)) {
+    return;
+  }
+
+  const rcti &canvas = op->get_canvas();
+  pending_results_.append({result_keys_.lookup(op),
+                           std::move(buffer),
+                           active_buffers_.get_areas_to_render(op, -canvas.xmin, -canvas.ymin),
+                           cost});
+}
+
+void FullFrameExecutionModel::add_pending_results_to_cache(ExecutionSystem &exec_system)
+{
+  /* Results of a cancelled execution may be incomplete. */
+  if (!exec_system.is_breaked()) {
+    for (PendingResult &result : pending_results_) {
+      result_cache_->add(result.key, std::move(result.buffer), result.areas, result.cost);
+    }
+  }
+  pending_results_.clear();
+  result_cache_->end_execution();
 }
 
 void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -20,6 +24,7 @@ class CompositorContext;
 class ExecutionSystem;
 class MemoryBuffer;
 class NodeOperation;
+class ResultCache;
 class SharedOperationBuffers;
 
 /**
@@ -43,10 +48,44 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Results of operations kept across executions. Null when results aren't cached.
+   */
+  ResultCache *result_cache_;
+
+  /**
+   * Keys identifying the results of operations in the result cache. Operations whose result
+   * can't be cached have no key.
+   */
+  Map<NodeOperation *, uint64_t> result_keys_;
+
+  /**
+   * Buffers of operations found in the result cache, these operations are not rendered.
+   */
+  Map<NodeOperation *, std::shared_ptr<MemoryBuffer>> cached_buffers_;
+
+  /**
+   * Time in seconds it took to render operations including their inputs.
+   */
+  Map<NodeOperation *, double> render_costs_;
+
+  /**
+   * Rendered buffers to add to the result cache once the execution finished without being
+   * cancelled, and the memory they use.
+   */
+  struct PendingResult {
+    uint64_t key;
+    std::shared_ptr<MemoryBuffer> buffer;
+    Vector<rcti> areas;
+    double cost;
+  };
+  Vector<PendingResult> pending_results_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
-                          Span<NodeOperation *> operations);
+                          Span<NodeOperation *> operations,
+                          ResultCache *result_cache = nullptr);
 
   void execute(ExecutionSystem &exec_system) override;
 
@@ -82,6 +121,24 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   void determine_reads(NodeOperation *output_op);
 
+  /**
+   * Computes the keys of all operations whose result can be cached.
+   */
+  void compute_result_keys();
+  std::optional<uint64_t> compute_result_key(
+      NodeOperation *op, Map<NodeOperation *, std::optional<uint64_t>> &r_keys) const;
+  /**
+   * Whether the rendered buffer of the operation may be kept in the result cache.
+   */
+  bool is_result_cacheable(NodeOperation *op) const;
+  /**
+   * Finds operations whose registered areas to render are all available in the result cache.
+   * Must be called after the areas of all outputs have been determined and before the reads.
+   */
+  void find_cached_results();
+  void add_pending_result(NodeOperation *op, std::shared_ptr<MemoryBuffer> buffer, double cost);
+  void add_pending_results_to_cache(ExecutionSystem &exec_system);
+
   void update_progress_bar();
 
 #ifdef WITH_CXX_GUARDEDALLOC
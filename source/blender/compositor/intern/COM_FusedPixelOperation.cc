@@ -0,0 +1,142 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "COM_FusedPixelOperation.h"
+
+namespace blender::compositor {
+
+/** Number of pixels of the bands of rows the fused operations are evaluated in. */
+static constexpr int BAND_PIXELS = 4096;
+
+FusedPixelOperation::FusedPixelOperation(Span<NodeOperation *> operations)
+    : operations_(operations)
+{
+  BLI_assert(operations.size() > 1);
+  for (NodeOperation *op : operations_) {
+    BLI_assert(op->get_flags().is_pixel_operation);
+    BLI_assert(BLI_rcti_compare(&op->get_canvas(), &operations.last()->get_canvas()));
+
+    Vector<InputSource> sources;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperationOutput *link = op->get_input_socket(i)->get_link();
+      BLI_assert(link != nullptr);
+      const int fused_index = operations_.first_index_of_try(&link->get_operation());
+      if (fused_index != -1) {
+        BLI_assert(&link->get_operation() != op);
+        sources.append({fused_index, -1});
+        continue;
+      }
+      int input_index = input_links_.first_index_of_try(link);
+      if (input_index == -1) {
+        input_index = input_links_.append_and_get_index(link);
+        this->add_input_socket(link->get_data_type(), ResizeMode::None);
+      }
+      sources.append({-1, input_index});
+    }
+    input_sources_.append(std::move(sources));
+  }
+
+  NodeOperation *output_op = operations_.last();
+  this->add_output_socket(output_op->get_output_socket()->get_data_type());
+  this->set_canvas(output_op->get_canvas());
+  flags_.is_pixel_operation = true;
+
+  /* The result depends on the state of all fused operations and on how they are linked. */
+  std::optional<uint64_t> state_hash = 0;
+  for (const int i : operations_.index_range()) {
+    const std::optional<uint64_t> op_state_hash = operations_[i]->get_node_state_hash();
+    if (!op_state_hash) {
+      state_hash = std::nullopt;
+      break;
+    }
+    state_hash = get_default_hash(
+        *state_hash, typeid(*operations_[i]).hash_code(), *op_state_hash);
+    for (const InputSource &source : input_sources_[i]) {
+      state_hash = get_default_hash(*state_hash, source.operation, source.input);
+    }
+  }
+  this->set_node_state_hash(state_hash);
+}
+
+FusedPixelOperation::~FusedPixelOperation()
+{
+  for (NodeOperation *op : operations_) {
+    delete op;
+  }
+}
+
+void FusedPixelOperation::init_data()
+{
+  for (NodeOperation *op : operations_) {
+    op->init_data();
+  }
+}
+
+void FusedPixelOperation::init_execution()
+{
+  for (NodeOperation *op : operations_) {
+    op->init_execution();
+  }
+}
+
+void FusedPixelOperation::deinit_execution()
+{
+  for (NodeOperation *op : operations_) {
+    op->deinit_execution();
+  }
+}
+
+std::unique_ptr<MetaData> FusedPixelOperation::get_meta_data()
+{
+  return operations_.last()->get_meta_data();
+}
+
+void FusedPixelOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                       const rcti &area,
+                                                       Span<MemoryBuffer *> inputs)
+{
+  const int width = BLI_rcti_size_x(&area);
+  const int height = BLI_rcti_size_y(&area);
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  const int band_height = std::clamp(BAND_PIXELS / width, 1, height);
+
+  /* Intermediate results of all operations but the last, for one band of rows. */
+  const int intermediates_num = operations_.size() - 1;
+  Array<Array<float>> band_data(intermediates_num);
+  Array<int> band_channels(intermediates_num);
+  for (const int i : IndexRange(intermediates_num)) {
+    band_channels[i] = COM_data_type_num_channels(
+        operations_[i]->get_output_socket()->get_data_type());
+    band_data[i].reinitialize(int64_t(band_channels[i]) * width * band_height);
+  }
+
+  Vector<std::unique_ptr<MemoryBuffer>> band_buffers(intermediates_num);
+  Vector<MemoryBuffer *> op_inputs;
+  for (int y = area.ymin; y < area.ymax; y += band_height) {
+    rcti band;
+    BLI_rcti_init(&band, area.xmin, area.xmax, y, std::min(y + band_height, area.ymax));
+    for (const int i : IndexRange(intermediates_num)) {
+      band_buffers[i] = std::make_unique<MemoryBuffer>(
+          band_data[i].data(), band_channels[i], band);
+    }
+
+    for (const int i : operations_.index_range()) {
+      op_inputs.clear();
+      for (const InputSource &source : input_sources_[i]) {
+        op_inputs.append(source.operation == -1 ? inputs[source.input] :
+                                                  band_buffers[source.operation].get());
+      }
+      MemoryBuffer *op_output = i == intermediates_num ? output : band_buffers[i].get();
+      MultiThreadedOperation *op = static_cast<MultiThreadedOperation *>(operations_[i]);
+      op->update_memory_buffer_partial(op_output, band, op_inputs);
+    }
+  }
+}
+
+}  // namespace blender::compositor
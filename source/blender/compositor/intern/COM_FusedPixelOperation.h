@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Executes a chain of pixel operations (see #NodeOperationFlags::is_pixel_operation) as a single
+ * operation.
+ *
+ * Instead of rendering every operation of the chain over the whole image into its own buffer, the
+ * chain is evaluated band by band: each operation renders a few rows into a small intermediate
+ * buffer that is read by the next operation while it is still in the CPU caches. Only the last
+ * operation writes to the output buffer.
+ *
+ * The fused operations keep the links of their input sockets so they can still check for
+ * constant inputs. Inputs linked to operations outside of the chain become inputs of the fused
+ * operation.
+ */
+class FusedPixelOperation : public MultiThreadedOperation {
+ private:
+  /** Where an input of a fused operation reads from. */
+  struct InputSource {
+    /** Index of the fused operation computing the input, or -1 for an external input. */
+    int operation;
+    /** Index of the external input, when it isn't computed by a fused operation. */
+    int input;
+  };
+
+  /** Fused operations in dependency order, the last one computes the output. */
+  Vector<NodeOperation *> operations_;
+  /** Sources of the inputs of each fused operation. */
+  Vector<Vector<InputSource>> input_sources_;
+  /** Outputs of operations outside the chain read by the fused operations, one per input. */
+  Vector<NodeOperationOutput *> input_links_;
+
+ public:
+  /**
+   * \param operations: Pixel operations with equal canvases in dependency order. The output of
+   * each operation but the last may only be read by operations of the chain.
+   */
+  FusedPixelOperation(Span<NodeOperation *> operations);
+  ~FusedPixelOperation();
+
+  /** Operation outputs to link to the inputs of the fused operation. */
+  Span<NodeOperationOutput *> get_input_links() const
+  {
+    return input_links_;
+  }
+
+  Span<NodeOperation *> get_fused_operations() const
+  {
+    return operations_;
+  }
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+  std::unique_ptr<MetaData> get_meta_data() override;
+
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
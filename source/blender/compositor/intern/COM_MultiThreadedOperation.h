@@ -51,6 +51,9 @@ class MultiThreadedOperation : public NodeOperation {
   void update_memory_buffer(MemoryBuffer *output,
                             const rcti &area,
                             Span<MemoryBuffer *> inputs) override;
+
+  /* Renders the areas of fused pixel operations directly. */
+  friend class FusedPixelOperation;
 };
 
 }  // namespace blender::compositor
@@ -2,8 +2,16 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+
+#include "BKE_image.h"
 #include "BKE_node.hh"
 
+#include "DNA_image_types.h"
+
 #include "RNA_access.hh"
 #include "RNA_prototypes.hh"
 
@@ -119,6 +127,174 @@ bNodeSocket *Node::get_editor_output_socket(int editor_node_output_socket_index)
   return nullptr;
 }
 
+/** Nested data of the node like curve mappings is hashed up to this depth. */
+static constexpr int STATE_HASH_MAX_DEPTH = 4;
+
+/**
+ * Images loaded from files or generated keep the same content until they are reloaded or
+ * modified, which is tracked by their partial update changes.
+ */
+static std::optional<uint64_t> hash_id_state(const ID &id)
+{
+  if (GS(id.name) != ID_IM) {
+    return std::nullopt;
+  }
+  const Image &image = reinterpret_cast<const Image &>(id);
+  if (!ELEM(image.source, IMA_SRC_FILE, IMA_SRC_SEQUENCE, IMA_SRC_MOVIE, IMA_SRC_GENERATED) ||
+      BKE_image_is_dirty(const_cast<Image *>(&image)))
+  {
+    return std::nullopt;
+  }
+  return get_default_hash(id.session_uid, BKE_image_partial_update_changeset_id(&image));
+}
+
+static bool hash_rna_struct(PointerRNA &ptr, StructRNA *skipped_base, int depth, uint64_t &hash);
+
+static bool hash_rna_property(PointerRNA &ptr, PropertyRNA *prop, const int depth, uint64_t &hash)
+{
+  const int array_length = RNA_property_array_length(&ptr, prop);
+  switch (RNA_property_type(prop)) {
+    case PROP_BOOLEAN: {
+      Array<bool, 16> values(std::max(array_length, 1));
+      if (array_length > 0) {
+        RNA_property_boolean_get_array(&ptr, prop, values.data());
+      }
+      else {
+        values[0] = RNA_property_boolean_get(&ptr, prop);
+      }
+      for (const bool value : values) {
+        hash = get_default_hash(hash, value);
+      }
+      break;
+    }
+    case PROP_INT: {
+      Array<int, 16> values(std::max(array_length, 1));
+      if (array_length > 0) {
+        RNA_property_int_get_array(&ptr, prop, values.data());
+      }
+      else {
+        values[0] = RNA_property_int_get(&ptr, prop);
+      }
+      for (const int value : values) {
+        hash = get_default_hash(hash, value);
+      }
+      break;
+    }
+    case PROP_FLOAT: {
+      Array<float, 16> values(std::max(array_length, 1));
+      if (array_length > 0) {
+        RNA_property_float_get_array(&ptr, prop, values.data());
+      }
+      else {
+        values[0] = RNA_property_float_get(&ptr, prop);
+      }
+      for (const float value : values) {
+        hash = get_default_hash(hash, value);
+      }
+      break;
+    }
+    case PROP_ENUM:
+      hash = get_default_hash(hash, RNA_property_enum_get(&ptr, prop));
+      break;
+    case PROP_STRING:
+      hash = get_default_hash(hash, RNA_property_string_get(&ptr, prop));
+      break;
+    case PROP_POINTER: {
+      PointerRNA pointer = RNA_property_pointer_get(&ptr, prop);
+      if (pointer.data == nullptr) {
+        hash = get_default_hash(hash, 0);
+        break;
+      }
+      if (RNA_struct_is_ID(pointer.type)) {
+        const std::optional<uint64_t> id_hash = hash_id_state(*static_cast<ID *>(pointer.data));
+        if (!id_hash) {
+          return false;
+        }
+        hash = get_default_hash(hash, *id_hash);
+        break;
+      }
+      if (depth < STATE_HASH_MAX_DEPTH &&
+          !hash_rna_struct(pointer, nullptr, depth + 1, hash))
+      {
+        return false;
+      }
+      break;
+    }
+    case PROP_COLLECTION: {
+      if (depth >= STATE_HASH_MAX_DEPTH) {
+        break;
+      }
+      int items_num = 0;
+      RNA_PROP_BEGIN (&ptr, item, prop) {
+        if (!hash_rna_struct(item, nullptr, depth + 1, hash)) {
+          return false;
+        }
+        items_num++;
+      }
+      RNA_PROP_END;
+      hash = get_default_hash(hash, items_num);
+      break;
+    }
+  }
+  return true;
+}
+
+/**
+ * Hash all properties of the struct, skipping the ones defined by the given base struct.
+ * Returns false if the struct references data that can't be hashed.
+ */
+static bool hash_rna_struct(PointerRNA &ptr,
+                            StructRNA *skipped_base,
+                            const int depth,
+                            uint64_t &hash)
+{
+  bool is_hashable = true;
+  RNA_STRUCT_BEGIN_SKIP_RNA_TYPE (&ptr, prop) {
+    const char *identifier = RNA_property_identifier(prop);
+    if (skipped_base && RNA_struct_type_find_property(skipped_base, identifier)) {
+      continue;
+    }
+    if (!hash_rna_property(ptr, prop, depth, hash)) {
+      is_hashable = false;
+      break;
+    }
+  }
+  RNA_STRUCT_END;
+  return is_hashable;
+}
+
+std::optional<uint64_t> Node::get_state_hash() const
+{
+  const bNode *node = this->get_bnode();
+  if (node == nullptr) {
+    return 0;
+  }
+  /* The defocus node reads the settings of the scene camera. */
+  if (node->type == CMP_NODE_DEFOCUS) {
+    return std::nullopt;
+  }
+
+  bNodeTree *node_tree = this->get_bnodetree();
+  uint64_t hash = get_default_hash(StringRef(node->idname));
+
+  /* Properties of the base node type are generic ones like the location or the name of the node,
+   * they don't affect the result. */
+  PointerRNA node_ptr = RNA_pointer_create(&node_tree->id, &RNA_Node, const_cast<bNode *>(node));
+  if (!hash_rna_struct(node_ptr, &RNA_Node, 0, hash)) {
+    return std::nullopt;
+  }
+
+  LISTBASE_FOREACH (bNodeSocket *, socket, &node->inputs) {
+    PointerRNA socket_ptr = RNA_pointer_create(&node_tree->id, &RNA_NodeSocket, socket);
+    PropertyRNA *prop = RNA_struct_find_property(&socket_ptr, "default_value");
+    if (prop && !hash_rna_property(socket_ptr, prop, 0, hash)) {
+      return std::nullopt;
+    }
+  }
+
+  return hash;
+}
+
 /*******************
  **** NodeInput ****
  *******************/
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
@@ -163,6 +165,13 @@ class Node {
     return instance_key_;
   }
 
+  /**
+   * Hash of the node settings and input values, which identifies the results of the operations
+   * created for the node across compositor executions (see #ResultCache). No value when the
+   * results also depend on data outside of the node tree, like render results or movie clips.
+   */
+  std::optional<uint64_t> get_state_hash() const;
+
  protected:
   /**
    * \brief add an NodeInput to the collection of input-sockets
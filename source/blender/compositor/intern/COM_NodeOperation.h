@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <list>
+#include <optional>
 
 #include "BLI_ghash.h"
 #include "BLI_hash.hh"
@@ -206,6 +207,13 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether every output pixel only depends on the input pixels at the same position, and the
+   * operation renders in a single pass without state shared between areas. Chains of such
+   * operations are fused into a #FusedPixelOperation.
+   */
+  bool is_pixel_operation : 1;
+
   NodeOperationFlags()
   {
     use_render_border = false;
@@ -217,6 +225,7 @@ struct NodeOperationFlags {
     use_datatype_conversion = true;
     is_constant_operation = false;
     can_be_constant = false;
+    is_pixel_operation = false;
   }
 };
 
@@ -268,6 +277,13 @@ class NodeOperation {
   std::string name_;
   bNodeInstanceKey node_instance_key_{bke::NODE_INSTANCE_KEY_NONE};
 
+  /**
+   * Hash of the state of the node the operation was created for, zero for operations that don't
+   * come from a node. No value when the operation result depends on data that isn't part of the
+   * node tree, in which case it can't be cached across executions.
+   */
+  std::optional<uint64_t> node_state_hash_ = 0;
+
   Vector<NodeOperationInput> inputs_;
   Vector<NodeOperationOutput> outputs_;
 
@@ -328,6 +344,15 @@ class NodeOperation {
     return node_instance_key_;
   }
 
+  void set_node_state_hash(const std::optional<uint64_t> node_state_hash)
+  {
+    node_state_hash_ = node_state_hash;
+  }
+  std::optional<uint64_t> get_node_state_hash() const
+  {
+    return node_state_hash_;
+  }
+
   /** Get constant value when operation is constant, otherwise return default_value. */
   float get_constant_value_default(float default_value);
   /** Get constant elem when operation is constant, otherwise return default_elem. */
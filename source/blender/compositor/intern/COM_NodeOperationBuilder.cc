@@ -18,6 +18,7 @@
 #include "COM_ViewerOperation.h"
 
 #include "COM_ConstantFolder.h"
+#include "COM_FusedPixelOperation.h"
 #include "COM_NodeOperationBuilder.h" /* own include */
 
 namespace blender::compositor {
@@ -25,7 +26,11 @@ namespace blender::compositor {
 NodeOperationBuilder::NodeOperationBuilder(const CompositorContext *context,
                                            bNodeTree *b_nodetree,
                                            ExecutionSystem *system)
-    : context_(context), exec_system_(system), current_node_(nullptr), active_viewer_(nullptr)
+    : context_(context),
+      exec_system_(system),
+      current_node_(nullptr),
+      current_node_operations_num_(0),
+      active_viewer_(nullptr)
 {
   graph_.from_bNodeTree(*context, b_nodetree);
 }
@@ -37,6 +42,8 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
 
   for (Node *node : graph_.nodes()) {
     current_node_ = node;
+    current_node_state_hash_ = node->get_state_hash();
+    current_node_operations_num_ = 0;
 
     DebugInfo::node_to_operations(node);
     node->convert_to_operations(converter, *context_);
@@ -90,6 +97,9 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  save_graphviz("compositor_prior_fusing");
+  fuse_pixel_operations();
+
   /* links not available from here on */
   /* XXX make links_ a local variable to avoid confusion! */
   links_.clear();
@@ -110,6 +120,13 @@ void NodeOperationBuilder::add_operation(NodeOperation *operation)
   if (current_node_) {
     operation->set_name(current_node_->get_bnode()->name);
     operation->set_node_instance_key(current_node_->get_instance_key());
+    /* Operations of the same node may have the same type, distinguish them by their order. */
+    operation->set_node_state_hash(
+        current_node_state_hash_ ?
+            std::make_optional(
+                get_default_hash(*current_node_state_hash_, current_node_operations_num_)) :
+            std::nullopt);
+    current_node_operations_num_++;
   }
   operation->set_execution_system(exec_system_);
 }
@@ -493,6 +510,112 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static bool is_fusable_pixel_operation(NodeOperation *op)
+{
+  return op->get_flags().is_pixel_operation && !op->get_flags().is_constant_operation &&
+         op->get_number_of_output_sockets() == 1;
+}
+
+/**
+ * Get the operation the given operation can be fused into, which is the case when it is the only
+ * operation reading its output and both are pixel operations with the same canvas.
+ */
+static NodeOperation *find_fusing_reader(
+    NodeOperation *op, const MultiValueMap<NodeOperation *, NodeOperation *> &readers)
+{
+  if (!is_fusable_pixel_operation(op)) {
+    return nullptr;
+  }
+  const Span<NodeOperation *> op_readers = readers.lookup(op);
+  if (op_readers.is_empty()) {
+    return nullptr;
+  }
+  NodeOperation *reader = op_readers.first();
+  for (NodeOperation *other_reader : op_readers) {
+    if (other_reader != reader) {
+      return nullptr;
+    }
+  }
+  if (!is_fusable_pixel_operation(reader) ||
+      !BLI_rcti_compare(&op->get_canvas(), &reader->get_canvas()))
+  {
+    return nullptr;
+  }
+  return reader;
+}
+
+/* Gather the operations fused into the given operation, inputs before the operations reading
+ * them. */
+static void gather_fused_operations_recursive(
+    NodeOperation *op,
+    const MultiValueMap<NodeOperation *, NodeOperation *> &readers,
+    Vector<NodeOperation *> &r_fused)
+{
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input_op = op->get_input_operation(i);
+    if (input_op && !r_fused.contains(input_op) && find_fusing_reader(input_op, readers) == op) {
+      gather_fused_operations_recursive(input_op, readers, r_fused);
+    }
+  }
+  r_fused.append(op);
+}
+
+void NodeOperationBuilder::fuse_pixel_operations()
+{
+  MultiValueMap<NodeOperation *, NodeOperation *> readers;
+  for (const Link &link : links_) {
+    readers.add(&link.from()->get_operation(), &link.to()->get_operation());
+  }
+
+  /* Start from the last operation of each chain, which can't be fused into its readers. Chains
+   * are replaced right away, so later chains link to the fused operations of earlier ones. */
+  const Vector<NodeOperation *> operations = operations_;
+  for (NodeOperation *op : operations) {
+    if (!is_fusable_pixel_operation(op) || find_fusing_reader(op, readers) != nullptr) {
+      continue;
+    }
+    Vector<NodeOperation *> chain;
+    gather_fused_operations_recursive(op, readers, chain);
+    if (chain.size() > 1) {
+      replace_with_fused_operation(new FusedPixelOperation(chain));
+    }
+  }
+}
+
+void NodeOperationBuilder::replace_with_fused_operation(FusedPixelOperation *fused_op)
+{
+  const Span<NodeOperation *> fused = fused_op->get_fused_operations();
+  NodeOperation *output_op = fused.last();
+
+  /* Links to the fused operations are removed from the builder, but are kept in their input
+   * sockets. Readers of the last operation read the fused operation instead. */
+  int i = 0;
+  while (i < links_.size()) {
+    Link &link = links_[i];
+    if (fused.contains(&link.to()->get_operation())) {
+      links_.remove(i);
+      continue;
+    }
+    if (&link.from()->get_operation() == output_op) {
+      link.to()->set_link(fused_op->get_output_socket());
+      links_[i] = Link(fused_op->get_output_socket(), link.to());
+    }
+    i++;
+  }
+
+  for (NodeOperation *op : fused) {
+    operations_.remove_first_occurrence_and_reorder(op);
+  }
+  add_operation(fused_op);
+  fused_op->set_name(output_op->get_name());
+  fused_op->set_node_instance_key(output_op->get_node_instance_key());
+
+  const Span<NodeOperationOutput *> input_links = fused_op->get_input_links();
+  for (const int input : input_links.index_range()) {
+    add_link(input_links[input], fused_op->get_input_socket(input));
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -25,6 +25,7 @@ class NodeOperationOutput;
 class PreviewOperation;
 class ViewerOperation;
 class ConstantOperation;
+class FusedPixelOperation;
 
 class NodeOperationBuilder {
  public:
@@ -60,6 +61,10 @@ class NodeOperationBuilder {
   Map<NodeOutput *, NodeOperationOutput *> output_map_;
 
   Node *current_node_;
+  /** State hash of the current node, see #Node::get_state_hash. */
+  std::optional<uint64_t> current_node_state_hash_;
+  /** Number of operations added for the current node. */
+  int current_node_operations_num_;
 
   /**
    * Operation that will be writing to the viewer image
@@ -143,6 +148,9 @@ class NodeOperationBuilder {
   /** Merge operations with same type, inputs and parameters that produce the same result. */
   void merge_equal_operations();
   void merge_equal_operations(NodeOperation *from, NodeOperation *into);
+  /** Replace chains of pixel operations with a single operation, see #FusedPixelOperation. */
+  void fuse_pixel_operations();
+  void replace_with_fused_operation(FusedPixelOperation *fused_op);
   void save_graphviz(StringRefNull name = "");
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:NodeCompilerImpl")
@@ -0,0 +1,116 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "BLI_rect.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ResultCache.h"
+
+namespace blender::compositor {
+
+void ResultCache::begin_execution()
+{
+  execution_++;
+}
+
+std::shared_ptr<MemoryBuffer> ResultCache::lookup(const uint64_t key,
+                                                  Span<rcti> areas,
+                                                  double &r_cost)
+{
+  Entry *entry = entries_.lookup_ptr(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  for (const rcti &area : areas) {
+    const bool is_rendered = std::any_of(
+        entry->areas.begin(), entry->areas.end(), [&](const rcti &rendered_area) {
+          return BLI_rcti_inside_rcti(&rendered_area, &area);
+        });
+    if (!is_rendered) {
+      return nullptr;
+    }
+  }
+  entry->last_used = execution_;
+  r_cost = entry->cost;
+  return entry->buffer;
+}
+
+void ResultCache::add(const uint64_t key,
+                      std::shared_ptr<MemoryBuffer> buffer,
+                      Span<rcti> areas,
+                      const double cost)
+{
+  BLI_assert(!buffer->is_a_single_elem());
+  const int64_t memory = int64_t(buffer->get_num_channels()) * buffer->get_width() *
+                         buffer->get_height() * sizeof(float);
+
+  if (const Entry *old_entry = entries_.lookup_ptr(key)) {
+    memory_ -= old_entry->memory;
+  }
+  memory_ += memory;
+  entries_.add_overwrite(key, {std::move(buffer), areas, memory, cost, execution_});
+}
+
+bool ResultCache::reserve(const int64_t memory)
+{
+  if (memory_ + reserved_memory_ + memory > max_memory_) {
+    trim(max_memory_ - reserved_memory_ - memory, true);
+  }
+  if (memory_ + reserved_memory_ + memory > max_memory_) {
+    return false;
+  }
+  reserved_memory_ += memory;
+  return true;
+}
+
+void ResultCache::end_execution()
+{
+  reserved_memory_ = 0;
+  trim(max_memory_, false);
+}
+
+void ResultCache::trim(const int64_t max_memory, const bool keep_current_execution)
+{
+  if (memory_ <= max_memory) {
+    return;
+  }
+
+  Vector<std::pair<uint64_t, const Entry *>> entries;
+  for (const auto item : entries_.items()) {
+    if (keep_current_execution && item.value.last_used == execution_) {
+      continue;
+    }
+    entries.append({item.key, &item.value});
+  }
+  /* Remove buffers not used recently first, then the cheapest ones to render again per byte. */
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+    if (a.second->last_used != b.second->last_used) {
+      return a.second->last_used < b.second->last_used;
+    }
+    return a.second->cost / a.second->memory < b.second->cost / b.second->memory;
+  });
+
+  Vector<uint64_t> removed_keys;
+  for (const auto &[key, entry] : entries) {
+    if (memory_ <= max_memory) {
+      break;
+    }
+    memory_ -= entry->memory;
+    removed_keys.append(key);
+  }
+  for (const uint64_t key : removed_keys) {
+    entries_.remove(key);
+  }
+}
+
+void ResultCache::clear()
+{
+  entries_.clear();
+  memory_ = 0;
+  reserved_memory_ = 0;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,120 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_vec_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Keeps rendered operation buffers across compositor executions, so that operations whose inputs
+ * and parameters did not change since the previous execution don't have to be rendered again.
+ *
+ * Buffers are identified by a key hashing the operation, the state of the node it was created
+ * for and the keys of its inputs (see #FullFrameExecutionModel). Only the areas that were
+ * rendered in the buffer are valid, a cached buffer can only be used when they cover all the
+ * areas needed by the current execution.
+ *
+ * The cache is limited in memory. Buffers that were not used by the last executions and that are
+ * cheap to render compared to their size are removed first.
+ */
+class ResultCache {
+ private:
+  struct Entry {
+    std::shared_ptr<MemoryBuffer> buffer;
+    /** Areas of the buffer with rendered pixels. */
+    Vector<rcti> areas;
+    /** Memory used by the buffer in bytes. */
+    int64_t memory;
+    /** Time in seconds it took to render the buffer and all its inputs. */
+    double cost;
+    /** Last execution the buffer was added or used in. */
+    int64_t last_used;
+  };
+
+  Map<uint64_t, Entry> entries_;
+  int64_t memory_ = 0;
+  /** Memory of buffers rendered by the current execution that will be added at its end. */
+  int64_t reserved_memory_ = 0;
+  int64_t max_memory_ = 0;
+  int64_t execution_ = 0;
+
+ public:
+  /**
+   * Starts a new execution, buffers found or added from now on are considered used by it.
+   */
+  void begin_execution();
+
+  /**
+   * Get the buffer cached for the given key if all the given areas were rendered in it.
+   * \param r_cost: Time in seconds it took to render the buffer including its inputs.
+   */
+  std::shared_ptr<MemoryBuffer> lookup(uint64_t key, Span<rcti> areas, double &r_cost);
+
+  /**
+   * Add a rendered buffer, replacing any buffer previously cached for the same key.
+   * \param areas: Areas with rendered pixels, in the coordinates of the buffer.
+   * \param cost: Time in seconds it took to render the buffer including its inputs.
+   */
+  void add(uint64_t key, std::shared_ptr<MemoryBuffer> buffer, Span<rcti> areas, double cost);
+
+  /**
+   * Reserve memory for a buffer rendered by the current execution before it is added, removing
+   * buffers not used by the execution if needed.
+   * \return False when the buffer doesn't fit in the memory limit and shouldn't be kept.
+   */
+  bool reserve(int64_t memory);
+
+  /**
+   * Release the memory reserved by the execution and remove buffers until the used memory is
+   * within the memory limit.
+   */
+  void end_execution();
+
+  void clear();
+
+  /** Set the maximum memory in bytes used by the cached buffers. */
+  void set_max_memory(const int64_t max_memory)
+  {
+    max_memory_ = max_memory;
+  }
+
+  int64_t max_memory() const
+  {
+    return max_memory_;
+  }
+
+  int64_t memory_usage() const
+  {
+    return memory_ + reserved_memory_;
+  }
+
+  int64_t size() const
+  {
+    return entries_.size();
+  }
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:ResultCache")
+#endif
+
+ private:
+  /** Remove buffers until the used memory is within the given limit. */
+  void trim(int64_t max_memory, bool keep_current_execution);
+};
+
+}  // namespace blender::compositor
@@ -65,7 +65,7 @@ bool SharedOperationBuffers::is_operation_rendered(NodeOperation *op)
 }
 
 void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
-                                                 std::unique_ptr<MemoryBuffer> buffer)
+                                                 std::shared_ptr<MemoryBuffer> buffer)
 {
   BufferData &buf_data = get_buffer_data(op);
   BLI_assert(buf_data.received_reads == 0);
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BLI_map.hh"
 #include "BLI_vector.hh"
 
@@ -20,14 +22,15 @@ class NodeOperation;
 
 /**
  * Stores and shares operations rendered buffers including render data. Buffers are
- * disposed once all dependent operations have finished reading them.
+ * disposed once all dependent operations have finished reading them, unless they are also
+ * referenced elsewhere (see #ResultCache).
  */
 class SharedOperationBuffers {
  private:
   typedef struct BufferData {
    public:
     BufferData();
-    std::unique_ptr<MemoryBuffer> buffer;
+    std::shared_ptr<MemoryBuffer> buffer;
     blender::Vector<rcti> render_areas;
     int registered_reads;
     int received_reads;
@@ -66,7 +69,7 @@ class SharedOperationBuffers {
   /**
    * Stores given operation rendered buffer.
    */
-  void set_rendered_buffer(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
+  void set_rendered_buffer(NodeOperation *op, std::shared_ptr<MemoryBuffer> buffer);
   /**
    * Get given operation rendered buffer.
    */
@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_threads.h"
 
 #include "BLT_translation.hh"
@@ -13,6 +15,7 @@
 #include "BKE_scene.hh"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_ResultCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.hh"
 
@@ -21,8 +24,18 @@
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /** Results of the CPU compositor kept between interactive executions. */
+  blender::compositor::ResultCache *result_cache = nullptr;
+  /** Session UID of the scene the cached results were computed for. */
+  uint32_t result_cache_scene_uid = 0;
 } g_compositor;
 
+static void compositor_result_cache_free()
+{
+  MEM_delete(g_compositor.result_cache);
+  g_compositor.result_cache = nullptr;
+}
+
 /* Make sure node tree has previews.
  * Don't create previews in advance, this is done when adding preview operations.
  * Reserved preview size is determined by render output for now. */
@@ -83,6 +96,7 @@ void COM_execute(Render *render,
       (USER_EXPERIMENTAL_TEST(&U, enable_new_cpu_compositor) && !scene->r.use_old_cpu_compositor))
   {
     /* Realtime compositor. */
+    compositor_result_cache_free();
     RE_compositor_execute(
         *render, *scene, *render_data, *node_tree, view_name, render_context, profiler);
   }
@@ -92,10 +106,31 @@ void COM_execute(Render *render,
     /* Initialize workscheduler. */
     blender::compositor::WorkScheduler::initialize(BKE_render_num_threads(render_data));
 
-    /* Execute. */
+    /* Results of executions from the node editor are kept, as usually only a few nodes change
+     * between them. Renders compute every node once, they don't use the cache. The cache uses the
+     * same memory limit as the other image caches. */
     const bool is_rendering = render_context != nullptr;
-    blender::compositor::ExecutionSystem system(
-        render_data, scene, node_tree, is_rendering, view_name, render_context, profiler);
+    if (!is_rendering) {
+      if (g_compositor.result_cache_scene_uid != scene->id.session_uid) {
+        compositor_result_cache_free();
+        g_compositor.result_cache_scene_uid = scene->id.session_uid;
+      }
+      if (!g_compositor.result_cache) {
+        g_compositor.result_cache = MEM_new<blender::compositor::ResultCache>(__func__);
+      }
+      g_compositor.result_cache->set_max_memory(int64_t(U.memcachelimit) * 1024 * 1024);
+    }
+
+    /* Execute. */
+    blender::compositor::ExecutionSystem system(render_data,
+                                                scene,
+                                                node_tree,
+                                                is_rendering,
+                                                view_name,
+                                                render_context,
+                                                profiler,
+                                                is_rendering ? nullptr :
+                                                               g_compositor.result_cache);
     system.execute();
   }
 
@@ -107,8 +142,18 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    compositor_result_cache_free();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
   }
 }
+
+void COM_clear_caches()
+{
+  if (g_compositor.is_initialized) {
+    BLI_mutex_lock(&g_compositor.mutex);
+    compositor_result_cache_free();
+    BLI_mutex_unlock(&g_compositor.mutex);
+  }
+}
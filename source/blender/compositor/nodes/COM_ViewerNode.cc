@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BKE_node_runtime.hh"
+
 #include "COM_ViewerNode.h"
 
 #include "COM_ViewerOperation.h"
@@ -31,6 +33,8 @@ void ViewerNode::convert_to_operations(NodeConverter &converter,
   viewer_operation->set_image_user(image_user);
   /* alpha socket gives either 1 or a custom alpha value if "use alpha" is enabled */
   viewer_operation->set_use_alpha_input(ignore_alpha || alpha_socket->is_linked());
+  viewer_operation->set_use_viewer_region(
+      context.get_bnodetree()->runtime->viewer_region.has_value());
   viewer_operation->set_render_data(context.get_render_data());
   viewer_operation->set_view_name(context.get_view_name());
 
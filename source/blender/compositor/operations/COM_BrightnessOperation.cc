@@ -16,6 +16,7 @@ BrightnessOperation::BrightnessOperation()
   this->add_output_socket(DataType::Color);
   use_premultiply_ = false;
   flags_.can_be_constant = true;
+  flags_.is_pixel_operation = true;
 }
 
 void BrightnessOperation::set_use_premultiply(bool use_premultiply)
@@ -40,8 +40,8 @@ void MultilayerBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
 
 std::unique_ptr<MetaData> MultilayerColorOperation::get_meta_data()
 {
-  BLI_assert(buffer_);
-
+  /* Only depends on the image, the operation may not have been executed when its result was
+   * found in the result cache. */
   if (!image_) {
     return nullptr;
   }
@@ -13,6 +13,7 @@ SetAlphaReplaceOperation::SetAlphaReplaceOperation()
   this->add_output_socket(DataType::Color);
 
   flags_.can_be_constant = true;
+  flags_.is_pixel_operation = true;
 }
 
 void SetAlphaReplaceOperation::update_memory_buffer_partial(MemoryBuffer *output,
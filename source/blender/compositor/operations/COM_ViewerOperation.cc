@@ -22,6 +22,7 @@ ViewerOperation::ViewerOperation()
   view_settings_ = nullptr;
   display_settings_ = nullptr;
   use_alpha_input_ = false;
+  use_viewer_region_ = false;
 
   this->add_input_socket(DataType::Color);
   this->add_input_socket(DataType::Value);
@@ -141,6 +142,47 @@ eCompositorPriority ViewerOperation::get_render_priority() const
   return eCompositorPriority::Low;
 }
 
+void ViewerOperation::clear_outside_area(const rcti &area)
+{
+  const int width = get_width();
+  const int height = get_height();
+  const int64_t row_stride = int64_t(width) * COM_DATA_TYPE_COLOR_CHANNELS;
+  for (const int y : IndexRange(height)) {
+    float *row = output_buffer_ + y * row_stride;
+    if (y < area.ymin || y >= area.ymax) {
+      memset(row, 0, sizeof(float) * row_stride);
+      continue;
+    }
+    memset(row, 0, sizeof(float) * COM_DATA_TYPE_COLOR_CHANNELS * area.xmin);
+    memset(row + int64_t(area.xmax) * COM_DATA_TYPE_COLOR_CHANNELS,
+           0,
+           sizeof(float) * COM_DATA_TYPE_COLOR_CHANNELS * (width - area.xmax));
+  }
+
+  /* Bands below, above, left and right of the area. */
+  const rcti bands[4] = {{0, width, 0, area.ymin},
+                         {0, width, area.ymax, height},
+                         {0, area.xmin, area.ymin, area.ymax},
+                         {area.xmax, width, area.ymin, area.ymax}};
+  for (const rcti &band : bands) {
+    if (!BLI_rcti_is_empty(&band)) {
+      update_image(&band);
+    }
+  }
+}
+
+void ViewerOperation::update_memory_buffer_started(MemoryBuffer * /*output*/,
+                                                   const rcti &area,
+                                                   Span<MemoryBuffer *> /*inputs*/)
+{
+  /* Pixels outside of the computed region were computed by previous executions and may not match
+   * the current node tree anymore. Clear them, they are computed once they become visible. */
+  if (!output_buffer_ || !use_viewer_region_ || exec_system_->is_breaked()) {
+    return;
+  }
+  clear_outside_area(area);
+}
+
 void ViewerOperation::update_memory_buffer_partial(MemoryBuffer * /*output*/,
                                                    const rcti &area,
                                                    Span<MemoryBuffer *> inputs)
@@ -21,6 +21,8 @@ class ViewerOperation : public MultiThreadedOperation {
   bool active_;
   ImBuf *ibuf_;
   bool use_alpha_input_;
+  /** Only a region of the viewer is computed, see #bNodeTreeRuntime::viewer_region. */
+  bool use_viewer_region_;
   const RenderData *rd_;
   const char *view_name_;
 
@@ -60,6 +62,10 @@ class ViewerOperation : public MultiThreadedOperation {
   {
     use_alpha_input_ = value;
   }
+  void set_use_viewer_region(bool value)
+  {
+    use_viewer_region_ = value;
+  }
   void set_render_data(const RenderData *rd)
   {
     rd_ = rd;
@@ -78,6 +84,10 @@ class ViewerOperation : public MultiThreadedOperation {
     display_settings_ = display_settings;
   }
 
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -91,6 +101,7 @@ class ViewerOperation : public MultiThreadedOperation {
  private:
   void update_image(const rcti *rect);
   void init_image();
+  void clear_outside_area(const rcti &area);
 };
 
 }  // namespace blender::compositor
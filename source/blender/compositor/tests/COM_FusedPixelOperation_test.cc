@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "COM_ConvertOperation.h"
+#include "COM_FusedPixelOperation.h"
+#include "COM_MathBaseOperation.h"
+#include "COM_SetValueOperation.h"
+
+namespace blender::compositor::tests {
+
+class ColorSourceOperation : public NodeOperation {
+ public:
+  ColorSourceOperation(const rcti &canvas)
+  {
+    add_output_socket(DataType::Color);
+    set_canvas(canvas);
+  }
+};
+
+/* Fuse `(color.r + color.g + color.b) / 3 * factor` converted back to a color, and compare it to
+ * the expected result in an area covering several bands of rows. */
+TEST(FusedPixelOperation, ChainMatchesOperations)
+{
+  rcti canvas;
+  BLI_rcti_init(&canvas, 0, 301, 0, 67);
+  rcti area;
+  BLI_rcti_init(&area, 3, 290, 5, 61);
+  const float factor = 2.5f;
+
+  ColorSourceOperation source(canvas);
+  SetValueOperation constant;
+  constant.set_value(factor);
+
+  ConvertColorToValueOperation *to_value = new ConvertColorToValueOperation();
+  MathMultiplyOperation *multiply = new MathMultiplyOperation();
+  ConvertValueToColorOperation *to_color = new ConvertValueToColorOperation();
+  to_value->get_input_socket(0)->set_link(source.get_output_socket());
+  multiply->get_input_socket(0)->set_link(to_value->get_output_socket());
+  multiply->get_input_socket(1)->set_link(constant.get_output_socket());
+  multiply->get_input_socket(2)->set_link(constant.get_output_socket());
+  to_color->get_input_socket(0)->set_link(multiply->get_output_socket());
+  for (NodeOperation *op : Span<NodeOperation *>{to_value, multiply, to_color}) {
+    EXPECT_TRUE(op->get_flags().is_pixel_operation);
+    op->set_canvas(canvas);
+  }
+
+  FusedPixelOperation fused({to_value, multiply, to_color});
+  ASSERT_EQ(fused.get_number_of_input_sockets(), 2);
+  EXPECT_EQ(fused.get_input_links()[0], source.get_output_socket());
+  EXPECT_EQ(fused.get_input_links()[1], constant.get_output_socket());
+  EXPECT_EQ(fused.get_output_socket()->get_data_type(), DataType::Color);
+
+  MemoryBuffer source_buf(DataType::Color, canvas);
+  for (int y = canvas.ymin; y < canvas.ymax; y++) {
+    for (int x = canvas.xmin; x < canvas.xmax; x++) {
+      float *elem = source_buf.get_elem(x, y);
+      elem[0] = x * 0.01f;
+      elem[1] = y * 0.02f;
+      elem[2] = (x + y) * 0.005f;
+      elem[3] = 0.5f;
+    }
+  }
+  MemoryBuffer constant_buf(DataType::Value, canvas, true);
+  constant_buf.get_elem(0, 0)[0] = factor;
+
+  MemoryBuffer output(DataType::Color, canvas);
+  const float unset_value[4] = {-1.0f, -1.0f, -1.0f, -1.0f};
+  output.fill(canvas, unset_value);
+
+  fused.init_execution();
+  fused.update_memory_buffer_partial(&output, area, {&source_buf, &constant_buf});
+  fused.deinit_execution();
+
+  for (int y = canvas.ymin; y < canvas.ymax; y++) {
+    for (int x = canvas.xmin; x < canvas.xmax; x++) {
+      const float *elem = output.get_elem(x, y);
+      if (x < area.xmin || x >= area.xmax || y < area.ymin || y >= area.ymax) {
+        EXPECT_EQ(elem[0], unset_value[0]);
+        continue;
+      }
+      const float *src = source_buf.get_elem(x, y);
+      const float value = (src[0] + src[1] + src[2]) / 3.0f * factor;
+      EXPECT_FLOAT_EQ(elem[0], value);
+      EXPECT_FLOAT_EQ(elem[1], value);
+      EXPECT_FLOAT_EQ(elem[2], value);
+      EXPECT_FLOAT_EQ(elem[3], 1.0f);
+    }
+  }
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,110 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ResultCache.h"
+
+namespace blender::compositor::tests {
+
+static std::shared_ptr<MemoryBuffer> create_buffer(const int width, const int height)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, width, 0, height);
+  return std::make_shared<MemoryBuffer>(DataType::Color, rect);
+}
+
+static constexpr int64_t BUFFER_MEMORY = 64 * 64 * 4 * sizeof(float);
+
+TEST(ResultCache, LookupRenderedAreas)
+{
+  ResultCache cache;
+  cache.set_max_memory(BUFFER_MEMORY * 4);
+  cache.begin_execution();
+
+  rcti left, right, full;
+  BLI_rcti_init(&left, 0, 32, 0, 64);
+  BLI_rcti_init(&right, 32, 64, 0, 64);
+  BLI_rcti_init(&full, 0, 64, 0, 64);
+
+  std::shared_ptr<MemoryBuffer> buffer = create_buffer(64, 64);
+  cache.add(1, buffer, {left}, 1.0);
+  EXPECT_EQ(cache.memory_usage(), BUFFER_MEMORY);
+
+  double cost = 0.0;
+  EXPECT_EQ(cache.lookup(1, {left}, cost), buffer);
+  EXPECT_EQ(cost, 1.0);
+  EXPECT_EQ(cache.lookup(1, {right}, cost), nullptr);
+  EXPECT_EQ(cache.lookup(1, {full}, cost), nullptr);
+  EXPECT_EQ(cache.lookup(2, {left}, cost), nullptr);
+
+  /* Replacing a buffer doesn't count its memory twice. */
+  std::shared_ptr<MemoryBuffer> full_buffer = create_buffer(64, 64);
+  cache.add(1, full_buffer, {full}, 2.0);
+  EXPECT_EQ(cache.memory_usage(), BUFFER_MEMORY);
+  EXPECT_EQ(cache.lookup(1, {left, right}, cost), full_buffer);
+}
+
+TEST(ResultCache, TrimUnusedAndCheapFirst)
+{
+  ResultCache cache;
+  cache.set_max_memory(BUFFER_MEMORY * 2);
+  rcti full;
+  BLI_rcti_init(&full, 0, 64, 0, 64);
+
+  cache.begin_execution();
+  cache.add(1, create_buffer(64, 64), {full}, 10.0);
+  cache.add(2, create_buffer(64, 64), {full}, 1.0);
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 2);
+
+  /* The buffer not used by the last execution is removed first. */
+  cache.begin_execution();
+  double cost;
+  EXPECT_NE(cache.lookup(2, {full}, cost), nullptr);
+  cache.add(3, create_buffer(64, 64), {full}, 5.0);
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.lookup(1, {full}, cost), nullptr);
+
+  /* Between buffers used by the same execution, the cheapest to render again is removed. */
+  cache.set_max_memory(BUFFER_MEMORY);
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.memory_usage(), BUFFER_MEMORY);
+  EXPECT_NE(cache.lookup(3, {full}, cost), nullptr);
+}
+
+TEST(ResultCache, ReserveForPendingBuffers)
+{
+  ResultCache cache;
+  cache.set_max_memory(BUFFER_MEMORY * 2);
+  rcti full;
+  BLI_rcti_init(&full, 0, 64, 0, 64);
+
+  cache.begin_execution();
+  cache.add(1, create_buffer(64, 64), {full}, 1.0);
+  cache.add(2, create_buffer(64, 64), {full}, 1.0);
+  cache.end_execution();
+
+  /* Buffers not used by the current execution make room for the reserved memory. */
+  cache.begin_execution();
+  double cost;
+  EXPECT_NE(cache.lookup(2, {full}, cost), nullptr);
+  EXPECT_TRUE(cache.reserve(BUFFER_MEMORY));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.memory_usage(), BUFFER_MEMORY * 2);
+
+  /* Buffers used by the current execution are kept. */
+  EXPECT_FALSE(cache.reserve(BUFFER_MEMORY));
+  EXPECT_EQ(cache.size(), 1);
+
+  cache.add(3, create_buffer(64, 64), {full}, 1.0);
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.memory_usage(), BUFFER_MEMORY * 2);
+}
+
+}  // namespace blender::compositor::tests
@@ -72,6 +72,15 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations of the given ID for update, for changes which only affect the relations added by
+ * the ID itself, like adding or removing its modifiers, constraints or drivers.
+ *
+ * Only the nodes and relations of the ID are built again when possible, instead of the whole
+ * graph.
+ */
+void DEG_id_relations_tag_update(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
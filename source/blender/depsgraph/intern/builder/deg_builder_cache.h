@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 #include "intern/depsgraph_type.hh"
@@ -81,9 +83,12 @@ class DepsgraphBuilderCache {
    * the storage.
    *
    * TODO(sergey): Technically, this makes this class something else than just a cache, but what is
-   * the better name? */
+   * the better name?
+   *
+   * The shortcuts are safe to use from builders running on multiple threads. */
   template<typename... Args> bool isPropertyAnimated(const ID *id, Args... args)
   {
+    std::scoped_lock lock(mutex_);
     AnimatedPropertyStorage *animated_property_storage = ensureInitializedAnimatedPropertyStorage(
         id);
     return animated_property_storage->isPropertyAnimated(args...);
@@ -91,12 +96,15 @@ class DepsgraphBuilderCache {
 
   bool isAnyPropertyAnimated(const PointerRNA *ptr)
   {
+    std::scoped_lock lock(mutex_);
     AnimatedPropertyStorage *animated_property_storage = ensureInitializedAnimatedPropertyStorage(
         ptr->owner_id);
     return animated_property_storage->isAnyPropertyAnimated(ptr);
   }
 
   Map<const ID *, AnimatedPropertyStorage *> animated_property_storage_map_;
+  /* Guards the storages in the shortcuts above. */
+  std::mutex mutex_;
 
   MEM_CXX_CLASS_ALLOC_FUNCS("DepsgraphBuilderCache");
 };
@@ -0,0 +1,350 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/builder/deg_builder_incremental.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "BKE_collision.h"
+#include "BKE_effect.h"
+
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+static bool is_in_physics_relations(const Depsgraph *graph, const Object *object)
+{
+  for (int i = 0; i < DEG_PHYSICS_RELATIONS_NUM; i++) {
+    const Map<const ID *, ListBase *> *relations = graph->physics_relations[i];
+    if (relations == nullptr) {
+      continue;
+    }
+    for (const ListBase *list : relations->values()) {
+      if (list == nullptr) {
+        continue;
+      }
+      if (i == DEG_PHYSICS_EFFECTOR) {
+        LISTBASE_FOREACH (const EffectorRelation *, relation, list) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+      else {
+        LISTBASE_FOREACH (const CollisionRelation *, relation, list) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool deg_incremental_rebuild_supported(const Depsgraph *graph, const IDNode *id_node)
+{
+  if (id_node->id_type != ID_OB || id_node->linked_state == DEG_ID_LINKED_VIA_SET) {
+    return false;
+  }
+  const Object *object = reinterpret_cast<const Object *>(id_node->id_orig);
+  /* Pose channels of armatures are built on demand by the objects using them. */
+  if (object->type == OB_ARMATURE) {
+    return false;
+  }
+  /* Instanced collections are built again by every user. */
+  if (object->instance_collection != nullptr) {
+    return false;
+  }
+  /* Light linking is cached for the whole graph. */
+  if (object->light_linking != nullptr) {
+    return false;
+  }
+  /* Effectors and colliders are cached for the whole graph and used by all simulations. */
+  if (object->pd != nullptr || object->soft != nullptr || object->rigidbody_object != nullptr ||
+      object->rigidbody_constraint != nullptr || !BLI_listbase_is_empty(&object->particlesystem))
+  {
+    return false;
+  }
+  LISTBASE_FOREACH (const ModifierData *, md, &object->modifiers) {
+    if (ELEM(md->type,
+             eModifierType_Collision,
+             eModifierType_Fluid,
+             eModifierType_DynamicPaint,
+             eModifierType_Cloth,
+             eModifierType_Softbody,
+             eModifierType_ParticleSystem,
+             eModifierType_Surface))
+    {
+      return false;
+    }
+  }
+  if (is_in_physics_relations(graph, object)) {
+    return false;
+  }
+  return true;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Incremental rebuild
+ * \{ */
+
+IncrementalRebuild::IncrementalRebuild(Depsgraph *graph, Span<IDNode *> id_nodes) : graph_(graph)
+{
+  for (const IDNode *id_node : id_nodes) {
+    rebuilt_id_nodes_.add(id_node);
+    rebuilt_ids_.add(id_node->id_orig);
+  }
+}
+
+bool IncrementalRebuild::is_rebuilt_operation(const Node *node) const
+{
+  if (node->type != NodeType::OPERATION) {
+    return false;
+  }
+  const OperationNode *op_node = static_cast<const OperationNode *>(node);
+  return rebuilt_id_nodes_.contains(op_node->owner->owner);
+}
+
+IncrementalRebuild::SavedRelationNode IncrementalRebuild::save_relation_node(Node *node) const
+{
+  SavedRelationNode saved_node;
+  if (is_rebuilt_operation(node)) {
+    const OperationNode *op_node = static_cast<const OperationNode *>(node);
+    saved_node.key.emplace(op_node);
+    saved_node.is_noop = op_node->is_noop();
+  }
+  else {
+    saved_node.node = node;
+  }
+  return saved_node;
+}
+
+void IncrementalRebuild::remove_operations()
+{
+  Vector<Relation *> removed_relations;
+  for (OperationNode *op_node : graph_->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      if (rebuilt_ids_.contains(rel->builder_id)) {
+        for (Node *node : {rel->from, rel->to}) {
+          if (node->type == NodeType::OPERATION && !is_rebuilt_operation(node)) {
+            removed_dependencies_.add(static_cast<OperationNode *>(node)->owner->owner);
+          }
+        }
+        removed_relations.append(rel);
+      }
+      else if (is_rebuilt_operation(rel->from) || is_rebuilt_operation(rel->to)) {
+        saved_relations_.append({save_relation_node(rel->from),
+                                 save_relation_node(rel->to),
+                                 rel->name,
+                                 rel->flag & ~RELATION_FLAG_CYCLIC,
+                                 rel->builder_id});
+        removed_relations.append(rel);
+      }
+    }
+  }
+  for (Relation *rel : removed_relations) {
+    rel->unlink();
+    delete rel;
+  }
+
+  graph_->operations.remove_if(
+      [&](const OperationNode *op_node) { return is_rebuilt_operation(op_node); });
+  for (const IDNode *id_node : rebuilt_id_nodes_) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        graph_->entry_tags.remove(op_node);
+      }
+    }
+    const_cast<IDNode *>(id_node)->clear_components();
+  }
+}
+
+Node *IncrementalRebuild::restore_relation_node(const SavedRelationNode &saved_node)
+{
+  if (!saved_node.key) {
+    return saved_node.node;
+  }
+  const PersistentOperationKey &key = *saved_node.key;
+  IDNode *id_node = graph_->find_id_node(key.id);
+  ComponentNode *comp_node = id_node->find_component(key.component_type, key.component_name);
+  if (comp_node != nullptr) {
+    if (OperationNode *op_node = comp_node->find_operation(key.opcode, key.name, key.name_tag)) {
+      return op_node;
+    }
+  }
+  if (!saved_node.is_noop) {
+    return nullptr;
+  }
+  /* No-op operations are also created by the builders of other IDs, to route their relations
+   * through, for example ID properties used by drivers. */
+  comp_node = id_node->add_component(key.component_type, key.component_name);
+  OperationNode *op_node = comp_node->add_operation(nullptr, key.opcode, key.name, key.name_tag);
+  graph_->operations.append(op_node);
+  return op_node;
+}
+
+bool IncrementalRebuild::restore_relations()
+{
+  for (const SavedRelation &saved_relation : saved_relations_) {
+    Node *from = restore_relation_node(saved_relation.from);
+    Node *to = restore_relation_node(saved_relation.to);
+    if (from == nullptr || to == nullptr) {
+      return false;
+    }
+    graph_->add_new_relation(
+        from, to, saved_relation.name, saved_relation.flag, saved_relation.builder_id);
+  }
+  return true;
+}
+
+static bool has_relation_of_other_builder(const IDNode *id_node)
+{
+  for (const ComponentNode *comp_node : id_node->components.values()) {
+    BLI_assert(comp_node->operations_map == nullptr);
+    for (const OperationNode *op_node : comp_node->operations) {
+      for (const Relation *rel : op_node->inlinks) {
+        if (rel->builder_id != id_node->id_orig) {
+          return true;
+        }
+      }
+      for (const Relation *rel : op_node->outlinks) {
+        if (rel->builder_id != id_node->id_orig) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool IncrementalRebuild::check_removed_dependencies() const
+{
+  for (const IDNode *id_node : removed_dependencies_) {
+    /* Objects with a base are built by the view layer. */
+    if (id_node->id_type == ID_OB && id_node->has_base) {
+      continue;
+    }
+    if (!has_relation_of_other_builder(id_node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool has_evaluation_requests(const uint32_t eval_flags,
+                                    const DEGCustomDataMeshMasks &customdata_masks)
+{
+  return eval_flags != 0 || customdata_masks != DEGCustomDataMeshMasks();
+}
+
+bool IncrementalRebuild::check_evaluation_requests() const
+{
+  for (const IDNode *id_node : removed_dependencies_) {
+    if (has_evaluation_requests(id_node->previous_eval_flags, id_node->previous_customdata_masks))
+    {
+      return false;
+    }
+  }
+  for (const IDNode *id_node : rebuilt_id_nodes_) {
+    /* Requests which are gone might have been added by the builders of the kept IDs. */
+    if ((id_node->eval_flags | id_node->previous_eval_flags) != id_node->eval_flags) {
+      return false;
+    }
+    if ((id_node->customdata_masks | id_node->previous_customdata_masks) !=
+        id_node->customdata_masks)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Validation
+ * \{ */
+
+#ifndef NDEBUG
+
+static string node_identifier(const Node *node)
+{
+  if (node->type == NodeType::OPERATION) {
+    return static_cast<const OperationNode *>(node)->full_identifier();
+  }
+  return node->identifier();
+}
+
+static Vector<string> graph_description(const Depsgraph *graph)
+{
+  Vector<string> description;
+  for (const IDNode *id_node : graph->id_nodes) {
+    const DEGCustomDataMeshMasks &masks = id_node->customdata_masks;
+    char requests[256];
+    SNPRINTF(requests,
+             " eval_flags %u masks %" PRIx64 " %" PRIx64 " %" PRIx64 " %" PRIx64 " %" PRIx64,
+             id_node->eval_flags,
+             masks.vert_mask,
+             masks.edge_mask,
+             masks.face_mask,
+             masks.loop_mask,
+             masks.poly_mask);
+    description.append("ID " + string(id_node->id_orig->name) + requests);
+  }
+  for (const OperationNode *op_node : graph->operations) {
+    const string op_identifier = op_node->full_identifier();
+    description.append("Operation " + op_identifier);
+    for (const Relation *rel : op_node->inlinks) {
+      description.append(node_identifier(rel->from) + " -> " + op_identifier + " (" + rel->name +
+                         ")");
+    }
+  }
+  std::sort(description.begin(), description.end());
+  return description;
+}
+
+static void print_difference(const char *message, Span<string> a, Span<string> b)
+{
+  for (const string &line : a) {
+    if (!std::binary_search(b.begin(), b.end(), line)) {
+      fprintf(stderr, "%s: %s\n", message, line.c_str());
+    }
+  }
+}
+
+bool deg_graph_relations_equal(const Depsgraph *graph_a, const Depsgraph *graph_b)
+{
+  const Vector<string> description_a = graph_description(graph_a);
+  const Vector<string> description_b = graph_description(graph_b);
+  if (description_a == description_b) {
+    return true;
+  }
+  print_difference("Only in the first graph", description_a, description_b);
+  print_difference("Only in the second graph", description_b, description_a);
+  return false;
+}
+
+#endif
+
+/** \} */
+
+}  // namespace blender::deg
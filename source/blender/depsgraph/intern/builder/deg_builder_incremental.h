@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Utilities to rebuild the nodes and relations of some IDs of an already built graph, keeping
+ * the nodes and relations of all the other IDs.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "BLI_set.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include "intern/builder/deg_builder_key.h"
+
+struct ID;
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct IDNode;
+struct Node;
+struct OperationNode;
+
+/* Check whether the nodes and relations of the ID can be rebuilt without building the whole
+ * graph. This is only the case for IDs whose relations are not cached or used by other parts of
+ * the graph outside of the relations added by their own builder: objects which are not armatures,
+ * physics colliders or effectors, instancers or light linking emitters. */
+bool deg_incremental_rebuild_supported(const Depsgraph *graph, const IDNode *id_node);
+
+/* Removes the operations of the rebuilt IDs from the graph, and adds the relations of other IDs
+ * to them back once the builders created the operations again.
+ *
+ * The ownership of relations comes from #Relation::builder_id: the relations added by the
+ * builders of the rebuilt IDs are removed and built again, the relations added by other builders
+ * between operations of the rebuilt IDs and other nodes are kept. */
+class IncrementalRebuild {
+ public:
+  IncrementalRebuild(Depsgraph *graph, Span<IDNode *> id_nodes);
+
+  const Set<const IDNode *> &rebuilt_id_nodes() const
+  {
+    return rebuilt_id_nodes_;
+  }
+
+  /* Remove all relations of the rebuilt IDs and free their operations, the ID nodes and their
+   * evaluated copies are kept. */
+  void remove_operations();
+
+  /* Add the relations of other builders back, to the operations created again by the builders.
+   * Returns false when an operation which is not a no-op does not exist anymore. */
+  bool restore_relations();
+
+  /* Check that IDs which had relations to the rebuilt IDs removed are still used in the graph.
+   * Returns false when an ID might have only been needed by the rebuilt IDs, in which case the
+   * whole graph is to be built to remove it. */
+  bool check_removed_dependencies() const;
+
+  /* Check that the evaluation flags and custom data masks are the same as after a full build.
+   * Requests from the rebuilt IDs to other IDs can not be removed, as they are merged with the
+   * requests of all other builders: returns false when an ID which had relations added by the
+   * rebuilt IDs has any flags or masks, or when a rebuilt ID lost requests which might have come
+   * from the kept IDs. */
+  bool check_evaluation_requests() const;
+
+ private:
+  struct SavedRelationNode {
+    /* Node which is kept in the graph. */
+    Node *node = nullptr;
+    /* Operation of a rebuilt ID, which is looked up again after it is created. */
+    std::optional<PersistentOperationKey> key;
+    bool is_noop = false;
+  };
+
+  struct SavedRelation {
+    SavedRelationNode from;
+    SavedRelationNode to;
+    const char *name;
+    int flag;
+    const ID *builder_id;
+  };
+
+  bool is_rebuilt_operation(const Node *node) const;
+  SavedRelationNode save_relation_node(Node *node) const;
+  Node *restore_relation_node(const SavedRelationNode &saved_node);
+
+  Depsgraph *graph_;
+  Set<const IDNode *> rebuilt_id_nodes_;
+  Set<const ID *> rebuilt_ids_;
+  Vector<SavedRelation> saved_relations_;
+  /* IDs which had relations added by builders of the rebuilt IDs. */
+  Set<IDNode *> removed_dependencies_;
+};
+
+#ifndef NDEBUG
+/* Compare operations, relations, evaluation flags and custom data masks of two graphs built for
+ * the same data, printing the differences. Flags of the relations are ignored, as the cycle
+ * solver might mark different relations of the same cycle. */
+bool deg_graph_relations_equal(const Depsgraph *graph_a, const Depsgraph *graph_b);
+#endif
+
+}  // namespace blender::deg
@@ -12,6 +12,8 @@
 
 namespace blender::deg {
 
+BuilderMap::BuilderMap(const BuilderMap *parent) : parent_(parent) {}
+
 bool BuilderMap::checkIsBuilt(ID *id, int tag) const
 {
   return (getIDTag(id) & tag) == tag;
@@ -24,15 +26,20 @@ void BuilderMap::tagBuild(ID *id, int tag)
 
 bool BuilderMap::checkIsBuiltAndTag(ID *id, int tag)
 {
+  const int parent_tag = (parent_ != nullptr) ? parent_->getIDTag(id) : 0;
   int &id_tag = id_tags_.lookup_or_add(id, 0);
-  const bool result = (id_tag & tag) == tag;
+  const bool result = ((id_tag | parent_tag) & tag) == tag;
   id_tag |= tag;
   return result;
 }
 
 int BuilderMap::getIDTag(ID *id) const
 {
-  return id_tags_.lookup_default(id, 0);
+  const int id_tag = id_tags_.lookup_default(id, 0);
+  if (parent_ != nullptr) {
+    return id_tag | parent_->getIDTag(id);
+  }
+  return id_tag;
 }
 
 }  // namespace blender::deg
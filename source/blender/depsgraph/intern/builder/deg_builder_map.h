@@ -31,6 +31,11 @@ class BuilderMap {
                     TAG_SCENE_COMPOSITOR | TAG_SCENE_SEQUENCER | TAG_SCENE_AUDIO),
   };
 
+  BuilderMap() = default;
+  /* Map which sees the IDs tagged in the parent map as built, without copying them. The parent
+   * map is not to be modified while this map is used. */
+  explicit BuilderMap(const BuilderMap *parent);
+
   /* Check whether given ID is already handled by builder (or if it's being handled). */
   bool checkIsBuilt(ID *id, int tag = TAG_COMPLETE) const;
 
@@ -54,10 +59,17 @@ class BuilderMap {
     return checkIsBuiltAndTag(&datablock->id, tag);
   }
 
+  /* Tags of the IDs tagged in this map, not including the tags of the parent map. */
+  const Map<ID *, int> &id_tags() const
+  {
+    return id_tags_;
+  }
+
  protected:
   int getIDTag(ID *id) const;
 
   Map<ID *, int> id_tags_;
+  const BuilderMap *parent_ = nullptr;
 };
 
 }  // namespace blender::deg
@@ -15,9 +15,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -428,41 +430,28 @@ void DepsgraphNodeBuilder::begin_build()
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
  * the code to access the builder's data more easily. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::cow_pointer_needs_update(ID *id_pointer)
 {
   if (id_pointer->orig_id == nullptr) {
-    /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
-     * owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    IDNode *id_node = find_id_node(id_pointer);
-    if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
-  }
-  else {
-    /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
+    /* The evaluated ID uses a non-cow ID, if that ID has an evaluated copy in current depsgraph
      * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
-     * of evaluated depsgraph are still valid pointers, they are freed later (typically during
-     * destruction of the builder itself). */
-    IDNode *id_node = find_id_node(id_pointer->orig_id);
-    if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
+    IDNode *id_node = find_id_node(id_pointer);
+    return id_node != nullptr && id_node->id_cow != nullptr;
   }
-  return IDWALK_RET_NOP;
+  /* The evaluated ID uses an evaluated ID, if that evaluated copy is removed from current
+   * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+  /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
+   * of evaluated depsgraph are still valid pointers, they are freed later (typically during
+   * destruction of the builder itself). */
+  IDNode *id_node = find_id_node(id_pointer->orig_id);
+  return id_node == nullptr;
 }
 
+struct CowDetectNeedForUpdateData {
+  DepsgraphNodeBuilder *builder;
+  bool needs_update = false;
+};
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +464,13 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
-
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+  CowDetectNeedForUpdateData *data = static_cast<CowDetectNeedForUpdateData *>(
+      cb_data->user_data);
+  if (data->builder->cow_pointer_needs_update(id)) {
+    data->needs_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -493,44 +485,66 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
-    if (id_node->previously_visible_components_mask == 0) {
-      /* Newly added node/ID, no need to check it. */
-      continue;
+  /* The IDs are checked in parallel, as the check only reads the graph. Tagging modifies the
+   * graph, so it is done afterwards. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<bool> needs_update(id_nodes.size(), false);
+  threading::parallel_for(id_nodes.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      needs_update[i] = id_cow_pointers_need_update(id_nodes[i]);
     }
-    if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
-      /* Node/ID with no copy-on-eval data, no need to check it. */
-      continue;
-    }
-    if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
-      /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
-      continue;
-    }
-    if ((id_node->id_cow->flag & ID_FLAG_EMBEDDED_DATA) != 0) {
-      /* For now, we assume embedded data are managed by their owner IDs and do not need to be
-       * checked here.
-       *
-       * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
-       * embedded data are handled as full local (private) data of their owner IDs in part of
-       * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
-       * as regular independent IDs. This leads to inconsistencies that can lead to bad level
-       * memory accesses.
-       *
-       * E.g. when undoing creation/deletion of a collection directly child of a scene's master
-       * collection, the scene itself is re-read in place, but its master collection becomes a
-       * completely new different pointer, and the existing copy-on-eval of the old master
-       * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
-       */
-      continue;
+  });
+  for (const int64_t i : id_nodes.index_range()) {
+    if (needs_update[i]) {
+      graph_id_tag_update(bmain_,
+                          graph_,
+                          id_nodes[i]->id_orig,
+                          ID_RECALC_SYNC_TO_EVAL,
+                          DEG_UPDATE_SOURCE_RELATIONS);
     }
-    BKE_library_foreach_ID_link(nullptr,
-                                id_node->id_cow,
-                                deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
-                                IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
   }
 }
 
+bool DepsgraphNodeBuilder::id_cow_pointers_need_update(const IDNode *id_node)
+{
+  if (id_node->previously_visible_components_mask == 0) {
+    /* Newly added node/ID, no need to check it. */
+    return false;
+  }
+  if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
+    /* Node/ID with no copy-on-eval data, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
+    /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->flag & ID_FLAG_EMBEDDED_DATA) != 0) {
+    /* For now, we assume embedded data are managed by their owner IDs and do not need to be
+     * checked here.
+     *
+     * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
+     * embedded data are handled as full local (private) data of their owner IDs in part of
+     * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
+     * as regular independent IDs. This leads to inconsistencies that can lead to bad level
+     * memory accesses.
+     *
+     * E.g. when undoing creation/deletion of a collection directly child of a scene's master
+     * collection, the scene itself is re-read in place, but its master collection becomes a
+     * completely new different pointer, and the existing copy-on-eval of the old master
+     * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
+     */
+    return false;
+  }
+  CowDetectNeedForUpdateData data{this};
+  BKE_library_foreach_ID_link(nullptr,
+                              id_node->id_cow,
+                              deg::foreach_id_cow_detect_need_for_update_callback,
+                              &data,
+                              IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+  return data.needs_update;
+}
+
 void DepsgraphNodeBuilder::tag_previously_tagged_nodes()
 {
   for (const OperationKey &operation_key : saved_entry_tags_) {
@@ -562,6 +576,62 @@ void DepsgraphNodeBuilder::end_build()
   update_invalid_cow_pointers();
 }
 
+void DepsgraphNodeBuilder::begin_incremental_build(Scene *scene,
+                                                   ViewLayer *view_layer,
+                                                   const Set<const IDNode *> &rebuilt_id_nodes)
+{
+  scene_ = scene;
+  view_layer_ = view_layer;
+  view_layer_index_ = 0;
+
+  for (IDNode *id_node : graph_->id_nodes) {
+    /* The evaluated copies stay owned by the ID nodes, only the previous state is stored so that
+     * nodes which are added again do not appear as new ones. */
+    IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+    id_info->id_cow = nullptr;
+    id_info->previously_visible_components_mask = id_node->visible_components_mask;
+    id_info->previous_eval_flags = id_node->eval_flags;
+    id_info->previous_customdata_masks = id_node->customdata_masks;
+    id_info_hash_.add_new(id_node->id_orig_session_uid, id_info);
+
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+
+    if (rebuilt_id_nodes.contains(id_node)) {
+      /* Requested evaluation flags and masks are gathered again by the relation builder, the
+       * incremental rebuild checks that none of the requests of the kept IDs got lost. */
+      id_node->eval_flags = 0;
+      id_node->customdata_masks = DEGCustomDataMeshMasks();
+    }
+    else {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  for (const OperationNode *op_node : graph_->entry_tags) {
+    if (rebuilt_id_nodes.contains(op_node->owner->owner)) {
+      saved_entry_tags_.append_as(op_node);
+    }
+  }
+
+  for (const IDNode *id_node : rebuilt_id_nodes) {
+    for (const ComponentNode *comp_node : id_node->components.values()) {
+      for (const OperationNode *op_node : comp_node->operations) {
+        if (op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) {
+          needs_update_operations_.append_as(op_node);
+        }
+      }
+    }
+  }
+}
+
+void DepsgraphNodeBuilder::end_incremental_build()
+{
+  tag_previously_tagged_nodes();
+  update_invalid_cow_pointers();
+}
+
 void DepsgraphNodeBuilder::build_id(ID *id, const bool force_be_visible)
 {
   if (id == nullptr) {
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "BLI_set.hh"
 #include "BLI_span.hh"
 
 #include "intern/builder/deg_builder.h"
@@ -89,11 +90,19 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Build nodes of some of the IDs of an already built graph, keeping the nodes of all the other
+   * IDs. The operations of the rebuilt IDs are to be removed from the graph after the begin call,
+   * their ID nodes and evaluated copies are kept. */
+  virtual void begin_incremental_build(Scene *scene,
+                                       ViewLayer *view_layer,
+                                       const Set<const IDNode *> &rebuilt_id_nodes);
+  virtual void end_incremental_build();
+
   /**
-   * `id_cow_self` is the user of `id_pointer`,
-   * see also `LibraryIDLinkCallbackData` struct definition.
+   * Check whether an evaluated ID using `id_pointer` needs to be flushed, see also
+   * `LibraryIDLinkCallbackData` struct definition.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool cow_pointer_needs_update(ID *id_pointer);
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
@@ -316,6 +325,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
    * because the depsgraph itself created or removed some of their evaluated dependencies.
    */
   void update_invalid_cow_pointers();
+  bool id_cow_pointers_need_update(const IDNode *id_node);
 
   /* State which demotes currently built entities. */
   Scene *scene_;
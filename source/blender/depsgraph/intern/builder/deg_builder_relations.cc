@@ -18,8 +18,12 @@
 #include "DNA_modifier_types.h"
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
+#include "BLI_math_base.h"
+#include "BLI_set.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -352,6 +356,9 @@ void DepsgraphRelationBuilder::add_customdata_mask(Object *object,
     if (id_node == nullptr) {
       BLI_assert_msg(0, "ID should always be valid");
     }
+    else if (relation_buffer_ != nullptr) {
+      relation_buffer_->customdata_masks.append({id_node, customdata_masks});
+    }
     else {
       id_node->customdata_masks |= customdata_masks;
     }
@@ -364,6 +371,9 @@ void DepsgraphRelationBuilder::add_special_eval_flag(ID *id, uint32_t flag)
   if (id_node == nullptr) {
     BLI_assert_msg(0, "ID should always be valid");
   }
+  else if (relation_buffer_ != nullptr) {
+    relation_buffer_->eval_flags.append({id_node, flag});
+  }
   else {
     id_node->eval_flags |= flag;
   }
@@ -375,7 +385,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return add_new_relation(timesrc, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -390,6 +400,19 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
   return nullptr;
 }
 
+Relation *DepsgraphRelationBuilder::add_new_relation(Node *node_from,
+                                                     Node *node_to,
+                                                     const char *description,
+                                                     int flags)
+{
+  if (relation_buffer_ != nullptr) {
+    relation_buffer_->relations.append(
+        {node_from, node_to, description, flags, stack_.current_id()});
+    return nullptr;
+  }
+  return graph_->add_new_relation(node_from, node_to, description, flags, stack_.current_id());
+}
+
 void DepsgraphRelationBuilder::add_visibility_relation(ID *id_from, ID *id_to)
 {
   ComponentKey from_key(id_from, NodeType::VISIBILITY);
@@ -403,7 +426,7 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return add_new_relation(node_from, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -517,6 +540,20 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+void DepsgraphRelationBuilder::set_worker_constructor(WorkerConstructor worker_constructor)
+{
+  worker_constructor_ = std::move(worker_constructor);
+}
+
+void DepsgraphRelationBuilder::begin_incremental_build(Scene *scene,
+                                                       Span<const IDNode *> kept_id_nodes)
+{
+  scene_ = scene;
+  for (const IDNode *id_node : kept_id_nodes) {
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -674,11 +711,11 @@ void DepsgraphRelationBuilder::build_collection(LayerCollection *from_layer_coll
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(collection->id);
+
   build_idproperties(collection->id.properties);
   build_parameters(&collection->id);
 
-  const BuilderStack::ScopedEntry stack_entry = stack_.trace(collection->id);
-
   const OperationKey collection_geometry_key{
       &collection->id, NodeType::GEOMETRY, OperationCode::GEOMETRY_EVAL_DONE};
 
@@ -967,6 +1004,7 @@ void DepsgraphRelationBuilder::build_object_data(Object *object)
   ID *obdata_id = (ID *)object->data;
   /* Object data animation. */
   if (!built_map_.checkIsBuilt(obdata_id)) {
+    const BuilderStack::ScopedEntry stack_entry = stack_.trace(*obdata_id);
     build_animdata(obdata_id);
   }
   /* type-specific data. */
@@ -1652,8 +1690,7 @@ void DepsgraphRelationBuilder::build_animdata_fcurve_target(
     add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     return;
   }
-  graph_->add_new_relation(
-      operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
+  add_new_relation(operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
   /* It is possible that animation is writing to a nested ID data-block,
    * need to make sure animation is evaluated after target ID is copied. */
   const IDNode *id_node_from = operation_from->owner->owner;
@@ -3417,6 +3454,7 @@ void DepsgraphRelationBuilder::build_scene_sequencer(Scene *scene)
   }
 
   /* TODO(sergey): Trace as a scene sequencer. */
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(scene->id);
 
   build_scene_audio(scene);
   ComponentKey scene_audio_key(&scene->id, NodeType::AUDIO);
@@ -3471,8 +3509,93 @@ void DepsgraphRelationBuilder::build_vfont(VFont *vfont)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  /* Number of IDs handled by one worker. */
+  const int64_t grain_size = 1024;
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  if (!worker_constructor_ || id_nodes.size() <= grain_size) {
+    for (IDNode *id_node : id_nodes) {
+      build_copy_on_write_relations(id_node);
+    }
+    return;
+  }
+  /* The relations only depend on the nodes of the ID itself, so they are built in parallel and
+   * added in the order of the ID nodes. */
+  Array<DepsgraphRelationBuffer> buffers(divide_ceil_ul(id_nodes.size(), grain_size));
+  Vector<std::unique_ptr<DepsgraphRelationBuilder>> workers = construct_workers(buffers);
+  threading::parallel_for(workers.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      for (IDNode *id_node : id_nodes.slice_safe(i * grain_size, grain_size)) {
+        workers[i]->build_copy_on_write_relations(id_node);
+      }
+    }
+  });
+  flush_worker_buffers(workers, buffers);
+}
+
+Vector<std::unique_ptr<DepsgraphRelationBuilder>> DepsgraphRelationBuilder::construct_workers(
+    MutableSpan<DepsgraphRelationBuffer> buffers)
+{
+  /* Components cache their entry and exit operations when they are first looked up, which is
+   * not safe to do from multiple workers, so look them all up before the workers start. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  threading::parallel_for(id_nodes.index_range(), 256, [&](const IndexRange range) {
+    for (IDNode *id_node : id_nodes.slice(range)) {
+      for (ComponentNode *comp_node : id_node->components.values()) {
+        comp_node->get_entry_operation();
+        comp_node->get_exit_operation();
+      }
+    }
+  });
+
+  Vector<std::unique_ptr<DepsgraphRelationBuilder>> workers;
+  for (DepsgraphRelationBuffer &buffer : buffers) {
+    std::unique_ptr<DepsgraphRelationBuilder> worker = worker_constructor_();
+    worker->scene_ = scene_;
+    worker->built_map_ = BuilderMap(&built_map_);
+    worker->relation_buffer_ = &buffer;
+    workers.append(std::move(worker));
+  }
+  return workers;
+}
+
+void DepsgraphRelationBuilder::flush_worker_buffers(
+    Span<std::unique_ptr<DepsgraphRelationBuilder>> workers,
+    Span<DepsgraphRelationBuffer> buffers)
+{
+  for (const int64_t i : workers.index_range()) {
+    /* An ID reached by several workers is owned by the first one in order, only the relations
+     * it added on behalf of the ID are kept, which are the same as the ones of a single-threaded
+     * build. Relations added by builders which do not trace the ID might have been added by a
+     * previous worker already, those are merged the same way as with #RELATION_CHECK_BEFORE_ADD,
+     * as a single-threaded build only adds them once. */
+    Set<const ID *> ids_built_before;
+    for (const auto item : workers[i]->built_map_.id_tags().items()) {
+      if (built_map_.checkIsBuiltAndTag(item.key, item.value)) {
+        ids_built_before.add(item.key);
+      }
+    }
+    for (const DepsgraphRelationBuffer::BufferedRelation &relation : buffers[i].relations) {
+      if (relation.builder_id != nullptr && ids_built_before.contains(relation.builder_id)) {
+        continue;
+      }
+      if (i > 0 && relation.builder_id == nullptr) {
+        if (Relation *rel = graph_->check_nodes_connected(
+                relation.from, relation.to, relation.description))
+        {
+          rel->flag |= relation.flags;
+          rel->builder_id = nullptr;
+          continue;
+        }
+      }
+      graph_->add_new_relation(
+          relation.from, relation.to, relation.description, relation.flags, relation.builder_id);
+    }
+    for (const auto &[id_node, customdata_masks] : buffers[i].customdata_masks) {
+      id_node->customdata_masks |= customdata_masks;
+    }
+    for (const auto &[id_node, eval_flags] : buffers[i].eval_flags) {
+      id_node->eval_flags |= eval_flags;
+    }
   }
 }
 
@@ -3516,6 +3639,8 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
 {
   ID *id_orig = id_node->id_orig;
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(*id_orig);
+
   const ID_Type id_type = GS(id_orig->name);
 
   if (!deg_eval_copy_is_needed(id_type)) {
@@ -3576,8 +3701,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
-      rel->flag |= rel_flag;
+      add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency", rel_flag);
     }
     /* All dangling operations should also be executed after copy-on-evaluation. */
     for (OperationNode *op_node : comp_node->operations_map->values()) {
@@ -3585,8 +3709,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-        rel->flag |= rel_flag;
+        add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency", rel_flag);
       }
       else {
         bool has_same_comp_dependency = false;
@@ -3601,8 +3724,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-          rel->flag |= rel_flag;
+          add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency", rel_flag);
         }
       }
     }
@@ -10,6 +10,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <functional>
 
 #include "intern/depsgraph_type.hh"
 
@@ -20,6 +21,7 @@
 #include "BLI_span.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "intern/builder/deg_builder.h"
 #include "intern/builder/deg_builder_key.h"
@@ -81,11 +83,36 @@ struct Relation;
 struct RootPChanMap;
 struct TimeSourceNode;
 
+/* Relations and flags collected by a builder running on a worker thread. They are added to the
+ * graph once all workers are finished, as the graph is not to be modified from multiple
+ * threads. */
+struct DepsgraphRelationBuffer {
+  struct BufferedRelation {
+    Node *from;
+    Node *to;
+    const char *description;
+    int flags;
+    const ID *builder_id;
+  };
+
+  Vector<BufferedRelation> relations;
+  Vector<std::pair<IDNode *, DEGCustomDataMeshMasks>> customdata_masks;
+  Vector<std::pair<IDNode *, uint32_t>> eval_flags;
+};
+
 class DepsgraphRelationBuilder : public DepsgraphBuilder {
  public:
+  using WorkerConstructor = std::function<std::unique_ptr<DepsgraphRelationBuilder>()>;
+
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /* Allow building relations of independent IDs on multiple threads, using builders created by
+   * the given constructor. Without it, all relations are built on the calling thread. */
+  void set_worker_constructor(WorkerConstructor worker_constructor);
+  /* Build relations of some of the IDs of an already built graph, the relations of the given
+   * IDs are kept and they are not built again. */
+  void begin_incremental_build(Scene *scene, Span<const IDNode *> kept_id_nodes);
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -140,6 +167,7 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   virtual void build_collection(LayerCollection *from_layer_collection, Collection *collection);
   virtual void build_object(Object *object);
   virtual void build_object_from_view_layer_base(Object *object);
+  virtual void build_view_layer_objects(Span<Object *> objects);
   virtual void build_object_layer_component_relations(Object *object);
   virtual void build_object_modifiers(Object *object);
   virtual void build_object_data(Object *object);
@@ -340,12 +368,30 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   static void constraint_walk(bConstraint *con, ID **idpoin, bool is_reference, void *user_data);
 
+  /* Add relation to the graph, or to the relation buffer of a worker. The relation is not
+   * returned when it is buffered. */
+  Relation *add_new_relation(Node *node_from, Node *node_to, const char *description, int flags);
+
+  /* Create builders for worker threads which collect relations to the given buffers. The IDs
+   * built by this builder are seen as built by the workers. */
+  Vector<std::unique_ptr<DepsgraphRelationBuilder>> construct_workers(
+      MutableSpan<DepsgraphRelationBuffer> buffers);
+
+  /* Add relations and flags collected by the workers to the graph, in the order of the workers,
+   * and tag the IDs built by the workers as built by this builder. */
+  void flush_worker_buffers(Span<std::unique_ptr<DepsgraphRelationBuilder>> workers,
+                            Span<DepsgraphRelationBuffer> buffers);
+
   /* State which demotes currently built entities. */
   Scene *scene_;
 
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
   BuilderStack stack_;
+
+  WorkerConstructor worker_constructor_;
+  /* Set for builders running on worker threads. */
+  DepsgraphRelationBuffer *relation_buffer_ = nullptr;
 };
 
 struct DepsNodeHandle {
@@ -190,7 +190,6 @@ void DepsgraphRelationBuilder::build_ik_pose(Object *object,
           &object->id, NodeType::BONE, parchan->name, OperationCode::BONE_DONE);
       add_relation(solver_key, final_transforms_key, "IK Solver Result");
     }
-    parchan->flag |= POSE_DONE;
     root_map->add_bone(parchan->name, rootchan->name);
     /* continue up chain, until we reach target number of items. */
     DEG_DEBUG_PRINTF((::Depsgraph *)graph_, BUILD, "  %d = %s\n", segcount, parchan->name);
@@ -236,7 +235,6 @@ void DepsgraphRelationBuilder::build_splineik_pose(Object *object,
     add_relation(target_transform_key, solver_key, "Curve.Transform -> Spline IK");
     add_special_eval_flag(&data->tar->id, DAG_EVAL_NEED_CURVE_PATH);
   }
-  pchan->flag |= POSE_DONE;
   OperationKey final_transforms_key(
       &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
   add_relation(solver_key, final_transforms_key, "Spline IK Result");
@@ -255,7 +253,6 @@ void DepsgraphRelationBuilder::build_splineik_pose(Object *object,
     OperationKey bone_done_key(
         &object->id, NodeType::BONE, parchan->name, OperationCode::BONE_DONE);
     add_relation(solver_key, bone_done_key, "Spline IK Solver Result");
-    parchan->flag |= POSE_DONE;
     root_map->add_bone(parchan->name, rootchan->name);
   }
   OperationKey pose_done_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_DONE);
@@ -381,7 +378,6 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
     OperationKey bone_ready_key(
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
     OperationKey bone_done_key(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
-    pchan->flag &= ~POSE_DONE;
     /* Pose init to bone local. */
     add_relation(pose_init_key, bone_local_key, "Pose Init - Bone Local", RELATION_FLAG_GODMODE);
     /* Local to pose parenting operation. */
@@ -16,8 +16,12 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_collection_types.h"
 #include "DNA_linestyle_types.h"
@@ -100,6 +104,32 @@ void DepsgraphRelationBuilder::build_freestyle_lineset(FreestyleLineSet *fls)
   }
 }
 
+void DepsgraphRelationBuilder::build_view_layer_objects(Span<Object *> objects)
+{
+  /* Number of objects built by one worker. It does not depend on the number of threads, so that
+   * the relations are always added in the same order. */
+  const int64_t grain_size = 512;
+  if (!worker_constructor_ || objects.size() <= grain_size) {
+    for (Object *object : objects) {
+      build_object_from_view_layer_base(object);
+    }
+    return;
+  }
+  /* Objects are mostly independent, the dependencies shared between them (for example parents,
+   * constraint targets or materials) are built by every worker which reaches them, and only kept
+   * once when flushing the buffers of the workers. */
+  Array<DepsgraphRelationBuffer> buffers(divide_ceil_ul(objects.size(), grain_size));
+  Vector<std::unique_ptr<DepsgraphRelationBuilder>> workers = construct_workers(buffers);
+  threading::parallel_for(workers.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      for (Object *object : objects.slice_safe(i * grain_size, grain_size)) {
+        workers[i]->build_object_from_view_layer_base(object);
+      }
+    }
+  });
+  flush_worker_buffers(workers, buffers);
+}
+
 void DepsgraphRelationBuilder::build_view_layer(Scene *scene,
                                                 ViewLayer *view_layer,
                                                 eDepsNode_LinkedState_Type linked_state)
@@ -111,11 +141,13 @@ void DepsgraphRelationBuilder::build_view_layer(Scene *scene,
   /* NOTE: Nodes builder requires us to pass evaluated base because it's being
    * passed to the evaluation functions. During relations builder we only
    * do nullptr-pointer check of the base, so it's fine to pass original one. */
+  Vector<Object *> objects;
   LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
     if (need_pull_base_into_graph(base)) {
-      build_object_from_view_layer_base(base->object);
+      objects.append(base->object);
     }
   }
+  build_view_layer_objects(objects);
 
   build_view_layer_collections(view_layer);
 
@@ -92,4 +92,14 @@ void BuilderStack::print_backtrace(std::ostream &stream)
   stream.flags(old_flags);
 }
 
+const ID *BuilderStack::current_id() const
+{
+  for (int i = stack_.size() - 1; i >= 0; i--) {
+    if (stack_[i].id_ != nullptr) {
+      return stack_[i].id_;
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace blender::deg
@@ -117,6 +117,9 @@ class BuilderStack {
 
   void print_backtrace(std::ostream &stream);
 
+  /* Innermost ID which is being built, or null when no ID is being built. */
+  const ID *current_id() const;
+
   template<class... Args> ScopedEntry trace(const Args &...args)
   {
     stack_.append_as(args...);
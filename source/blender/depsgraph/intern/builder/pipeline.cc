@@ -62,6 +62,7 @@ void AbstractBuilderPipeline::build_step_relations()
 {
   /* Hook up relationships between operations - to determine evaluation order. */
   unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->set_worker_constructor([this]() { return construct_relation_builder(); });
   relation_builder->begin_build();
   build_relations(*relation_builder);
   relation_builder->build_copy_on_write_relations();
@@ -92,6 +93,13 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->relations_update_ids.clear();
+  deg_graph_->supports_incremental_relations_update = supports_incremental_build();
+}
+
+bool AbstractBuilderPipeline::supports_incremental_build() const
+{
+  return false;
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
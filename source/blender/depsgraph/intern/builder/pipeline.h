@@ -48,6 +48,9 @@ class AbstractBuilderPipeline {
   virtual unique_ptr<DepsgraphNodeBuilder> construct_node_builder();
   virtual unique_ptr<DepsgraphRelationBuilder> construct_relation_builder();
 
+  /* Whether the graph built by the pipeline supports updating relations of single IDs. */
+  virtual bool supports_incremental_build() const;
+
   virtual void build_step_sanity_check();
   void build_step_nodes();
   void build_step_relations();
@@ -57,4 +57,10 @@ unique_ptr<DepsgraphRelationBuilder> AllObjectsBuilderPipeline::construct_relati
   return std::make_unique<AllObjectsRelationBuilder>(bmain_, deg_graph_, &builder_cache_);
 }
 
+bool AllObjectsBuilderPipeline::supports_incremental_build() const
+{
+  /* Relations updates always use the regular view layer builders. */
+  return false;
+}
+
 }  // namespace blender::deg
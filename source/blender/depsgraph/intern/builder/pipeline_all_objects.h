@@ -22,6 +22,7 @@ class AllObjectsBuilderPipeline : public ViewLayerBuilderPipeline {
  protected:
   virtual unique_ptr<DepsgraphNodeBuilder> construct_node_builder() override;
   virtual unique_ptr<DepsgraphRelationBuilder> construct_relation_builder() override;
+  virtual bool supports_incremental_build() const override;
 };
 
 }  // namespace blender::deg
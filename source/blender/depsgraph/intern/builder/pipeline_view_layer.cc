@@ -4,9 +4,26 @@
 
 #include "pipeline_view_layer.h"
 
+#include "BLI_assert.h"
+#include "BLI_listbase.h"
+#include "BLI_time.h"
+
+#include "BKE_global.hh"
+#include "BKE_layer.hh"
+
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
+
+#include "intern/builder/deg_builder_cycle.h"
+#include "intern/builder/deg_builder_incremental.h"
 #include "intern/builder/deg_builder_nodes.h"
 #include "intern/builder/deg_builder_relations.h"
+#include "intern/builder/deg_builder_remove_noop.h"
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
 
 namespace blender::deg {
 
@@ -15,6 +32,11 @@ ViewLayerBuilderPipeline::ViewLayerBuilderPipeline(::Depsgraph *graph)
 {
 }
 
+bool ViewLayerBuilderPipeline::supports_incremental_build() const
+{
+  return true;
+}
+
 void ViewLayerBuilderPipeline::build_nodes(DepsgraphNodeBuilder &node_builder)
 {
   node_builder.build_view_layer(scene_, view_layer_, DEG_ID_LINKED_DIRECTLY);
@@ -25,4 +47,159 @@ void ViewLayerBuilderPipeline::build_relations(DepsgraphRelationBuilder &relatio
   relation_builder.build_view_layer(scene_, view_layer_, DEG_ID_LINKED_DIRECTLY);
 }
 
+/* Index of the object base among the bases pulled into the graph, matching the index used when
+ * the view layer was built. */
+static int object_base_index(DepsgraphNodeBuilder &node_builder,
+                             const Scene *scene,
+                             ViewLayer *view_layer,
+                             const Object *object)
+{
+  int base_index = 0;
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
+    if (!node_builder.need_pull_base_into_graph(base)) {
+      continue;
+    }
+    if (base->object == object) {
+      return base_index;
+    }
+    base_index++;
+  }
+  return -1;
+}
+
+bool ViewLayerBuilderPipeline::build_incremental()
+{
+  if (!deg_graph_->supports_incremental_relations_update) {
+    return false;
+  }
+  /* The relations removed by the transitive reduction can not be told apart from the ones which
+   * are not needed anymore. */
+  if (G.debug_value == 799) {
+    return false;
+  }
+
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = BLI_time_now_seconds();
+  }
+
+  Vector<IDNode *> id_nodes;
+  for (ID *id : deg_graph_->relations_update_ids) {
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr) {
+      /* The ID is not evaluated by this graph, its relations do not affect it. */
+      continue;
+    }
+    if (!deg_incremental_rebuild_supported(deg_graph_, id_node)) {
+      return false;
+    }
+    id_nodes.append(id_node);
+  }
+  if (id_nodes.is_empty()) {
+    deg_graph_->relations_update_ids.clear();
+    return true;
+  }
+
+  IncrementalRebuild rebuild(deg_graph_, id_nodes);
+  const Set<const IDNode *> &rebuilt_id_nodes = rebuild.rebuilt_id_nodes();
+  Vector<const IDNode *> kept_id_nodes;
+  for (const IDNode *id_node : deg_graph_->id_nodes) {
+    if (!rebuilt_id_nodes.contains(id_node)) {
+      kept_id_nodes.append(id_node);
+    }
+  }
+  const int64_t old_id_nodes_num = deg_graph_->id_nodes.size();
+
+  /* Nodes. */
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  node_builder->begin_incremental_build(scene_, view_layer_, rebuilt_id_nodes);
+  rebuild.remove_operations();
+  const int64_t old_operations_num = deg_graph_->operations.size();
+  for (IDNode *id_node : id_nodes) {
+    Object *object = reinterpret_cast<Object *>(id_node->id_orig);
+    node_builder->build_object(object_base_index(*node_builder, scene_, view_layer_, object),
+                               object,
+                               id_node->linked_state,
+                               id_node->is_visible_on_build);
+    deg_graph_->has_animated_visibility |= node_builder->is_object_visibility_animated(object);
+  }
+  node_builder->end_incremental_build();
+
+  const Span<IDNode *> new_id_nodes = deg_graph_->id_nodes.as_span().drop_front(old_id_nodes_num);
+  for (OperationNode *op_node : deg_graph_->operations.as_span().drop_front(old_operations_num)) {
+    /* Operations added to other IDs would need their copy-on-evaluation relations to be built
+     * again too. */
+    IDNode *id_node = op_node->owner->owner;
+    if (!rebuilt_id_nodes.contains(id_node) && !new_id_nodes.contains(id_node)) {
+      return false;
+    }
+  }
+
+  /* Relations. */
+  unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->begin_incremental_build(scene_, kept_id_nodes);
+  for (IDNode *id_node : id_nodes) {
+    relation_builder->build_object(reinterpret_cast<Object *>(id_node->id_orig));
+  }
+  if (!rebuild.restore_relations()) {
+    return false;
+  }
+  for (IDNode *id_node : id_nodes) {
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  for (IDNode *id_node : new_id_nodes) {
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  if (!rebuild.check_removed_dependencies()) {
+    return false;
+  }
+  if (!rebuild.check_evaluation_requests()) {
+    return false;
+  }
+
+  /* Cycles are detected again for the whole graph, the relations which were cyclic might not be
+   * anymore. */
+  for (OperationNode *op_node : deg_graph_->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+    }
+  }
+  build_step_finalize();
+
+#ifndef NDEBUG
+  if (!validate_incremental_build()) {
+    return false;
+  }
+#endif
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph relations of %d IDs updated in %f seconds.\n",
+           int(id_nodes.size()),
+           BLI_time_now_seconds() - start_time);
+  }
+  return true;
+}
+
+#ifndef NDEBUG
+bool ViewLayerBuilderPipeline::validate_incremental_build()
+{
+  Depsgraph *reference_graph = new Depsgraph(bmain_, scene_, view_layer_, deg_graph_->mode);
+  bool is_valid;
+  {
+    ViewLayerBuilderPipeline reference_builder(reinterpret_cast<::Depsgraph *>(reference_graph));
+    reference_builder.build_step_nodes();
+    reference_builder.build_step_relations();
+    deg_graph_detect_cycles(reference_graph);
+    deg_graph_remove_unused_noops(reference_graph);
+    is_valid = deg_graph_relations_equal(deg_graph_, reference_graph);
+  }
+  delete reference_graph;
+  BLI_assert_msg(is_valid, "Incremental relations update differs from a full build");
+  return is_valid;
+}
+#endif
+
 }  // namespace blender::deg
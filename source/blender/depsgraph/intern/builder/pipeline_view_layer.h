@@ -16,9 +16,21 @@ class ViewLayerBuilderPipeline : public AbstractBuilderPipeline {
  public:
   ViewLayerBuilderPipeline(::Depsgraph *graph);
 
+  /* Rebuild the nodes and relations of the IDs tagged for a relations update only, keeping the
+   * rest of the graph. Returns false when this is not possible for some of the IDs, in which case
+   * the whole graph is to be built. */
+  bool build_incremental();
+
  protected:
+  virtual bool supports_incremental_build() const override;
+
   virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
   virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+#ifndef NDEBUG
+  /* Compare the graph with a graph built from scratch. */
+  bool validate_incremental_build();
+#endif
 };
 
 }  // namespace blender::deg
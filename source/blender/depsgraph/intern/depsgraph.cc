@@ -48,6 +48,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
     : time_source(nullptr),
       has_animated_visibility(false),
       need_update_relations(true),
+      supports_incremental_relations_update(false),
       need_update_nodes_visibility(true),
       need_tag_id_on_graph_visibility_update(true),
       need_tag_id_on_graph_visibility_time_update(false),
@@ -174,7 +175,8 @@ void Depsgraph::clear_id_nodes()
   light_linking_cache.clear();
 }
 
-Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
+Relation *Depsgraph::add_new_relation(
+    Node *from, Node *to, const char *description, int flags, const ID *builder_id)
 {
   Relation *rel = nullptr;
   if (flags & RELATION_CHECK_BEFORE_ADD) {
@@ -182,6 +184,10 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   }
   if (rel != nullptr) {
     rel->flag |= flags;
+    if (rel->builder_id != builder_id) {
+      /* The relation is needed by multiple IDs, so it is kept when rebuilding any of them. */
+      rel->builder_id = nullptr;
+    }
     return rel;
   }
 
@@ -197,6 +203,7 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   /* Create new relation, and add it to the graph. */
   rel = new Relation(from, to, description);
   rel->flag |= flags;
+  rel->builder_id = builder_id;
   return rel;
 }
 
@@ -59,8 +59,16 @@ struct Depsgraph {
   IDNode *add_id_node(ID *id, ID *id_cow_hint = nullptr);
   void clear_id_nodes();
 
-  /** Add new relationship between two nodes. */
-  Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
+  /**
+   * Add new relationship between two nodes.
+   *
+   * \param builder_id: ID which was being built when the relation was added.
+   */
+  Relation *add_new_relation(Node *from,
+                             Node *to,
+                             const char *description,
+                             int flags = 0,
+                             const ID *builder_id = nullptr);
 
   /* Check whether two nodes are connected by relation with given
    * description. Description might be nullptr to check ANY relation between
@@ -98,6 +106,14 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
 
+  /* IDs whose own nodes and relations are to be rebuilt, when the rest of the relations is still
+   * valid. Ignored when all relations need to be updated. */
+  Set<ID *> relations_update_ids;
+
+  /* The graph was built for a view layer, so the relations of single IDs can be rebuilt without
+   * building the whole graph. */
+  bool supports_incremental_relations_update;
+
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
 
@@ -172,6 +188,9 @@ struct Depsgraph {
   /* Cached list of colliders/effectors for collections and the scene
    * created along with relations, for fast lookup during evaluation. */
   Map<const ID *, ListBase *> *physics_relations[DEG_PHYSICS_RELATIONS_NUM];
+  /** Needs to be locked when creating physics relations, as relations are built from multiple
+   * threads. */
+  std::mutex physics_relations_mutex;
 
   light_linking::Cache light_linking_cache;
 
@@ -194,13 +194,8 @@ void DEG_add_object_pointcache_relation(DepsNodeHandle *node_handle,
   /* Node deduct point cache component and connect source to it. */
   ID *id = DEG_get_id_from_handle(node_handle);
   deg::ComponentKey point_cache_key(id, deg::NodeType::POINT_CACHE);
-  deg::Relation *rel = relation_builder->add_relation(comp_key, point_cache_key, "Point Cache");
-  if (rel != nullptr) {
-    rel->flag |= deg::RELATION_FLAG_FLUSH_USER_EDIT_ONLY;
-  }
-  else {
-    fprintf(stderr, "Error in point cache relation from %s to ^%s.\n", object->id.name, id->name);
-  }
+  relation_builder->add_relation(
+      comp_key, point_cache_key, "Point Cache", deg::RELATION_FLAG_FLUSH_USER_EDIT_ONLY);
 }
 
 void DEG_add_generic_id_relation(DepsNodeHandle *node_handle, ID *id, const char *description)
@@ -307,11 +302,18 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
 void DEG_graph_relations_update(Depsgraph *graph)
 {
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
-  if (!deg_graph->need_update_relations) {
+  if (deg_graph->need_update_relations) {
+    DEG_graph_build_from_view_layer(graph);
+    return;
+  }
+  if (deg_graph->relations_update_ids.is_empty()) {
     /* Graph is up to date, nothing to do. */
     return;
   }
-  DEG_graph_build_from_view_layer(graph);
+  deg::ViewLayerBuilderPipeline builder(graph);
+  if (!builder.build_incremental()) {
+    DEG_graph_build_from_view_layer(graph);
+  }
 }
 
 void DEG_relations_tag_update(Main *bmain)
@@ -321,3 +323,18 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    if (depsgraph->need_update_relations) {
+      continue;
+    }
+    if (!depsgraph->supports_incremental_relations_update) {
+      DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
+      continue;
+    }
+    depsgraph->relations_update_ids.add(id);
+  }
+}
@@ -165,6 +165,7 @@ namespace blender::deg {
 
 ListBase *build_effector_relations(Depsgraph *graph, Collection *collection)
 {
+  std::scoped_lock lock(graph->physics_relations_mutex);
   Map<const ID *, ListBase *> *hash = graph->physics_relations[DEG_PHYSICS_EFFECTOR];
   if (hash == nullptr) {
     graph->physics_relations[DEG_PHYSICS_EFFECTOR] = new Map<const ID *, ListBase *>();
@@ -183,6 +184,7 @@ ListBase *build_effector_relations(Depsgraph *graph, Collection *collection)
 
 ListBase *build_collision_relations(Depsgraph *graph, Collection *collection, uint modifier_type)
 {
+  std::scoped_lock lock(graph->physics_relations_mutex);
   const ePhysicsRelationType type = modifier_to_relation_type(modifier_type);
   Map<const ID *, ListBase *> *hash = graph->physics_relations[type];
   if (hash == nullptr) {
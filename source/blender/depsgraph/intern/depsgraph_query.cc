@@ -336,7 +336,7 @@ bool DEG_is_fully_evaluated(const Depsgraph *depsgraph)
 {
   const deg::Depsgraph *deg_graph = (const deg::Depsgraph *)depsgraph;
   /* Check whether relations are up to date. */
-  if (deg_graph->need_update_relations) {
+  if (deg_graph->need_update_relations || !deg_graph->relations_update_ids.is_empty()) {
     return false;
   }
   /* Check whether IDs are up to date. */
@@ -10,6 +10,8 @@
 
 #include "MEM_guardedalloc.h"
 
+struct ID;
+
 namespace blender::deg {
 
 struct Node;
@@ -48,6 +50,11 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* ID which was being built when the relation was added, null for relations added outside of
+   * any ID builder. Used to know which relations are to be rebuilt when only the relations of
+   * some IDs are updated. */
+  const ID *builder_id;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
@@ -165,6 +165,18 @@ OperationNode *ComponentNode::add_operation(const DepsEvalOperationCb &op,
 {
   OperationNode *op_node = find_operation(opcode, name, name_tag);
   if (!op_node) {
+    if (operations_map == nullptr) {
+      /* The component was finalized already, which happens when nodes of another ID are rebuilt
+       * on an existing graph. Bring the operations back to the map. */
+      operations_map = new Map<ComponentNode::OperationIDKey, OperationNode *>();
+      for (OperationNode *existing_op_node : operations) {
+        operations_map->add_new(OperationIDKey(existing_op_node->opcode,
+                                               existing_op_node->name.c_str(),
+                                               existing_op_node->name_tag),
+                                existing_op_node);
+      }
+      operations.clear();
+    }
     DepsNodeFactory *factory = type_get_factory(NodeType::OPERATION);
     op_node = (OperationNode *)factory->create_node(this->owner->id_orig, "", name);
 
@@ -279,6 +291,10 @@ OperationNode *ComponentNode::get_exit_operation()
 
 void ComponentNode::finalize_build(Depsgraph * /*graph*/)
 {
+  if (operations_map == nullptr) {
+    /* Already finalized, graph is finalized again after rebuilding nodes of some of its IDs. */
+    return;
+  }
   operations.reserve(operations_map->size());
   for (OperationNode *op_node : operations_map->values()) {
     operations.append(op_node);
@@ -133,6 +133,14 @@ void IDNode::destroy()
   id_orig = nullptr;
 }
 
+void IDNode::clear_components()
+{
+  for (ComponentNode *comp_node : components.values()) {
+    delete comp_node;
+  }
+  components.clear();
+}
+
 string IDNode::identifier() const
 {
   char orig_ptr[24], cow_ptr[24];
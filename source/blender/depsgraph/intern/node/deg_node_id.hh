@@ -47,6 +47,9 @@ struct IDNode : public Node {
   void init_copy_on_write(Depsgraph &depsgraph, ID *id_cow_hint = nullptr);
   ~IDNode();
   void destroy();
+  /* Free all components and their operations, keeping the evaluated copy of the ID.
+   * The operations are expected to have no relations left. */
+  void clear_components();
 
   virtual string identifier() const override;
 
@@ -8,11 +8,17 @@
 
 #pragma once
 
+#include <memory>
+
+#include "BLI_math_vector_types.hh"
 #include "BLI_vector.hh"
 
 #include "IMB_colormanagement.hh"
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
+#include "IMB_tiled.hh"
+
+struct Image;
 
 namespace blender::draw::image_engine {
 
@@ -130,4 +136,116 @@ struct FloatBufferCache {
   }
 };
 
+/**
+ * \brief Multi-resolution tiled versions of float buffers.
+ *
+ * Zoomed out views are filled from a lower resolution level of the tiled image, which only reads
+ * a fraction of the pixels of large images and doesn't alias. The full resolution level is the
+ * float buffer itself.
+ *
+ * Entries are identified by the image tile and the float buffer. The float buffer is referenced
+ * by the entry, so its address can't be reused by another buffer while the entry exists. When
+ * the pixel storage of the buffer is reallocated or resized the tiled image is recreated.
+ */
+struct TiledImageCache {
+ private:
+  struct TiledImageBuffer {
+    const Image *image = nullptr;
+    int tile_number = 0;
+    ImBuf *float_buffer = nullptr;
+    /** Pixel storage and size of the float buffer when the tiled image was created. */
+    const float *pixels = nullptr;
+    int2 size = int2(0);
+    std::unique_ptr<imbuf::TiledImage> tiled_image;
+    bool is_used = true;
+
+    TiledImageBuffer(const Image *image, int tile_number, ImBuf *float_buffer)
+        : image(image),
+          tile_number(tile_number),
+          float_buffer(float_buffer),
+          pixels(float_buffer->float_buffer.data),
+          size(float_buffer->x, float_buffer->y),
+          tiled_image(imbuf::TiledImage::from_imbuf(float_buffer))
+    {
+      IMB_refImBuf(float_buffer);
+    }
+
+    TiledImageBuffer(const TiledImageBuffer &other) = delete;
+    TiledImageBuffer &operator=(const TiledImageBuffer &other) = delete;
+
+    ~TiledImageBuffer()
+    {
+      /* Free the tiles before releasing the buffer they can point into. */
+      tiled_image.reset();
+      IMB_freeImBuf(float_buffer);
+    }
+
+    bool matches(const Image *image, int tile_number, const ImBuf *float_buffer) const
+    {
+      return this->image == image && this->tile_number == tile_number &&
+             this->float_buffer == float_buffer;
+    }
+
+    bool is_outdated() const
+    {
+      return pixels != float_buffer->float_buffer.data ||
+             size != int2(float_buffer->x, float_buffer->y);
+    }
+  };
+  Vector<std::unique_ptr<TiledImageBuffer>> cache_;
+
+ public:
+  imbuf::TiledImage &ensure(const Image *image, int tile_number, ImBuf *float_buffer)
+  {
+    for (const int64_t i : cache_.index_range()) {
+      TiledImageBuffer &item = *cache_[i];
+      if (!item.matches(image, tile_number, float_buffer)) {
+        continue;
+      }
+      if (item.is_outdated()) {
+        cache_.remove_and_reorder(i);
+        break;
+      }
+      item.is_used = true;
+      return *item.tiled_image;
+    }
+    cache_.append(std::make_unique<TiledImageBuffer>(image, tile_number, float_buffer));
+    return *cache_.last()->tiled_image;
+  }
+
+  /** Pass on changes to the pixels of a float buffer. */
+  void tag_dirty(const Image *image,
+                 int tile_number,
+                 const ImBuf *float_buffer,
+                 const rcti &region)
+  {
+    for (std::unique_ptr<TiledImageBuffer> &item : cache_) {
+      if (item->matches(image, tile_number, float_buffer)) {
+        item->tiled_image->tag_dirty(region);
+      }
+    }
+  }
+
+  void reset_usage_flags()
+  {
+    for (std::unique_ptr<TiledImageBuffer> &item : cache_) {
+      item->is_used = false;
+    }
+  }
+
+  void remove_unused_buffers()
+  {
+    for (int64_t i = cache_.size() - 1; i >= 0; i--) {
+      if (!cache_[i]->is_used) {
+        cache_.remove_and_reorder(i);
+      }
+    }
+  }
+
+  void clear()
+  {
+    cache_.clear();
+  }
+};
+
 }  // namespace blender::draw::image_engine
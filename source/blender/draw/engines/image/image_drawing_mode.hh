@@ -13,6 +13,7 @@
 #include "IMB_imbuf_types.hh"
 #include "IMB_interp.hh"
 
+#include "BLI_math_base.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
 
@@ -367,6 +368,7 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
       case ePartialUpdateCollectResult::FullUpdateNeeded:
         instance_data.mark_all_texture_slots_dirty();
         instance_data.float_buffers.clear();
+        instance_data.tiled_images.clear();
         break;
       case ePartialUpdateCollectResult::NoChangesDetected:
         break;
@@ -374,6 +376,7 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
         /* Partial update when wrap repeat is enabled is not supported. */
         if (instance_data.flags.do_tile_drawing) {
           instance_data.float_buffers.clear();
+          instance_data.tiled_images.clear();
           instance_data.mark_all_texture_slots_dirty();
         }
         else {
@@ -412,6 +415,33 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
     IMB_float_from_rect_ex(float_buffer, src, &clipped_update_region);
   }
 
+  /** Nearest sampling of the full resolution tile buffer for a region of a texture slot. */
+  void extract_region_nearest(const TextureInfo &info,
+                              ImBuf &tile_buffer,
+                              const rcti &gpu_texture_region_to_update,
+                              const float2 &tile_offset,
+                              const float2 &texture_size,
+                              ImBuf &extracted_buffer) const
+  {
+    int offset = 0;
+    for (int y = gpu_texture_region_to_update.ymin; y < gpu_texture_region_to_update.ymax; y++) {
+      float yf = y / texture_size.y;
+      float v = info.clipping_uv_bounds.ymax * yf + info.clipping_uv_bounds.ymin * (1.0 - yf) -
+                tile_offset.y;
+      for (int x = gpu_texture_region_to_update.xmin; x < gpu_texture_region_to_update.xmax; x++)
+      {
+        float xf = x / texture_size.x;
+        float u = info.clipping_uv_bounds.xmax * xf + info.clipping_uv_bounds.xmin * (1.0 - xf) -
+                  tile_offset.x;
+        imbuf::interpolate_nearest_border_fl(&tile_buffer,
+                                             &extracted_buffer.float_buffer.data[offset * 4],
+                                             u * tile_buffer.x,
+                                             v * tile_buffer.y);
+        offset++;
+      }
+    }
+  }
+
   void do_partial_update(PartialUpdateChecker<ImageTileData>::CollectResult &iterator,
                          IMAGE_InstanceData &instance_data) const
   {
@@ -425,6 +455,9 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
       if (tile_buffer != iterator.tile_data.tile_buffer) {
         do_partial_update_float_buffer(tile_buffer, iterator);
       }
+      const int tile_number = iterator.tile_data.tile->tile_number;
+      instance_data.tiled_images.tag_dirty(
+          instance_data.image, tile_number, tile_buffer, iterator.changed_region.region);
 
       const float tile_width = float(iterator.tile_data.tile_buffer->x);
       const float tile_height = float(iterator.tile_data.tile_buffer->y);
@@ -492,24 +525,34 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
         IMB_initImBuf(
             &extracted_buffer, texture_region_width, texture_region_height, 32, IB_rectfloat);
 
-        int offset = 0;
-        for (int y = gpu_texture_region_to_update.ymin; y < gpu_texture_region_to_update.ymax; y++)
-        {
-          float yf = y / (float)texture_height;
-          float v = info.clipping_uv_bounds.ymax * yf + info.clipping_uv_bounds.ymin * (1.0 - yf) -
-                    tile_offset_y;
-          for (int x = gpu_texture_region_to_update.xmin; x < gpu_texture_region_to_update.xmax;
-               x++)
-          {
-            float xf = x / (float)texture_width;
-            float u = info.clipping_uv_bounds.xmax * xf +
-                      info.clipping_uv_bounds.xmin * (1.0 - xf) - tile_offset_x;
-            imbuf::interpolate_nearest_border_fl(tile_buffer,
-                                                 &extracted_buffer.float_buffer.data[offset * 4],
-                                                 u * tile_buffer->x,
-                                                 v * tile_buffer->y);
-            offset++;
-          }
+        /* When zoomed out, sample a lower resolution level of the image. */
+        const float2 step = float2(BLI_rctf_size_x(&info.clipping_uv_bounds) * tile_width /
+                                       texture_width,
+                                   BLI_rctf_size_y(&info.clipping_uv_bounds) * tile_height /
+                                       texture_height);
+        imbuf::TiledImage &tiled_image = instance_data.tiled_images.ensure(
+            instance_data.image, tile_number, tile_buffer);
+        const int level = tiled_image.level_for_scale(math::min(step.x, step.y));
+        if (level > 0) {
+          const float2 origin = float2(
+              (info.clipping_uv_bounds.xmin - tile_offset_x) * tile_width +
+                  gpu_texture_region_to_update.xmin * step.x,
+              (info.clipping_uv_bounds.ymin - tile_offset_y) * tile_height +
+                  gpu_texture_region_to_update.ymin * step.y);
+          tiled_image.sample_nearest(level,
+                                     origin,
+                                     step,
+                                     int2(texture_region_width, texture_region_height),
+                                     extracted_buffer.float_buffer.data,
+                                     texture_region_width);
+        }
+        else {
+          extract_region_nearest(info,
+                                 *tile_buffer,
+                                 gpu_texture_region_to_update,
+                                 float2(tile_offset_x, tile_offset_y),
+                                 float2(texture_width, texture_height),
+                                 extracted_buffer);
         }
         IMB_gpu_clamp_half_float(&extracted_buffer);
 
@@ -612,6 +655,25 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
       transform_mode = IMB_TRANSFORM_MODE_CROP_SRC;
     }
 
+    /* When zoomed out, sample a lower resolution level of the image. This only reads the
+     * pixels of a smaller level instead of the full resolution buffer. */
+    if (!instance_data.flags.do_tile_drawing) {
+      const float2 step = float2(BLI_rctf_size_x(&tile_area) / texture_width,
+                                 BLI_rctf_size_y(&tile_area) / texture_height);
+      imbuf::TiledImage &tiled_image = instance_data.tiled_images.ensure(
+          instance_data.image, image_tile.get_tile_number(), float_tile_buffer);
+      const int level = tiled_image.level_for_scale(math::min(step.x, step.y));
+      if (level > 0) {
+        tiled_image.sample_nearest(level,
+                                   float2(tile_area.xmin, tile_area.ymin),
+                                   step,
+                                   int2(texture_width, texture_height),
+                                   texture_buffer.float_buffer.data,
+                                   texture_width);
+        return;
+      }
+    }
+
     IMB_transform(float_tile_buffer,
                   &texture_buffer,
                   transform_mode,
@@ -639,6 +701,7 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
     instance_data->partial_update.ensure_image(image);
     instance_data->clear_need_full_update_flag();
     instance_data->float_buffers.reset_usage_flags();
+    instance_data->tiled_images.reset_usage_flags();
 
     /* Step: Find out which screen space textures are needed to draw on the screen. Recycle
      * textures that are not on screen anymore. */
@@ -664,6 +727,7 @@ template<typename TextureMethod> class ScreenSpaceDrawingMode : public AbstractD
   {
     IMAGE_InstanceData *instance_data = vedata->instance_data;
     instance_data->float_buffers.remove_unused_buffers();
+    instance_data->tiled_images.remove_unused_buffers();
   }
 
   void draw_viewport(IMAGE_Data *vedata) const override
@@ -50,6 +50,10 @@ struct IMAGE_InstanceData {
    * Cache containing the float buffers when drawing byte images.
    */
   FloatBufferCache float_buffers;
+  /**
+   * Cache containing multi-resolution tiled versions of the (float) image buffers.
+   */
+  TiledImageCache tiled_images;
 
   /** \brief Transform matrix to convert a normalized screen space coordinates to texture space. */
   float ss_to_texture[4][4];
@@ -83,6 +87,7 @@ struct IMAGE_InstanceData {
       last_usage = usage;
       reset_need_full_update(true);
       float_buffers.clear();
+      tiled_images.clear();
     }
   }
 
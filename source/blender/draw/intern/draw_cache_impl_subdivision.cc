@@ -844,11 +844,12 @@ static void draw_subdiv_invalidate_evaluator_for_orco(bke::subdiv::Subdiv *subdi
   if (has_orco && !subdiv->evaluator->hasVertexData(subdiv->evaluator)) {
     /* If we suddenly have/need original coordinates, recreate the evaluator if the extra
      * source was not created yet. The refiner also has to be recreated as refinement for source
-     * and vertex data is done only once. */
+     * and vertex data is done only once, unless the topology is shared, in which case the
+     * evaluator is created from the tables of the already refined topology. */
     openSubdiv_deleteEvaluator(subdiv->evaluator);
     subdiv->evaluator = nullptr;
 
-    if (subdiv->topology_refiner != nullptr) {
+    if (subdiv->topology_refiner != nullptr && subdiv->shared_topology == nullptr) {
       openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
       subdiv->topology_refiner = nullptr;
     }
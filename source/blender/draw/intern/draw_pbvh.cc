@@ -656,7 +656,7 @@ static void fill_vbo_attribute_mesh(const Span<int> corner_verts,
 }
 
 static void fill_vbo_position_grids(const CCGKey &key,
-                                    const Span<CCGElem *> grids,
+                                    const Span<float3> positions,
                                     const bool use_flat_layout,
                                     const Span<int> grid_indices,
                                     gpu::VertBuf &vert_buf)
@@ -665,16 +665,17 @@ static void fill_vbo_position_grids(const CCGKey &key,
   if (use_flat_layout) {
     const int grid_size_1 = key.grid_size - 1;
     for (const int i : grid_indices.index_range()) {
-      CCGElem *grid = grids[grid_indices[i]];
+      const Span<float3> grid_positions = positions.slice(
+          bke::ccg::grid_range(key, grid_indices[i]));
       for (int y = 0; y < grid_size_1; y++) {
         for (int x = 0; x < grid_size_1; x++) {
-          *data = CCG_grid_elem_co(key, grid, x, y);
+          *data = grid_positions[CCG_grid_xy_to_index(key.grid_size, x, y)];
           data++;
-          *data = CCG_grid_elem_co(key, grid, x + 1, y);
+          *data = grid_positions[CCG_grid_xy_to_index(key.grid_size, x + 1, y)];
           data++;
-          *data = CCG_grid_elem_co(key, grid, x + 1, y + 1);
+          *data = grid_positions[CCG_grid_xy_to_index(key.grid_size, x + 1, y + 1)];
           data++;
-          *data = CCG_grid_elem_co(key, grid, x, y + 1);
+          *data = grid_positions[CCG_grid_xy_to_index(key.grid_size, x, y + 1)];
           data++;
         }
       }
@@ -682,17 +683,16 @@ static void fill_vbo_position_grids(const CCGKey &key,
   }
   else {
     for (const int i : grid_indices.index_range()) {
-      CCGElem *grid = grids[grid_indices[i]];
-      for (const int offset : IndexRange(key.grid_area)) {
-        *data = CCG_elem_offset_co(key, grid, offset);
-        data++;
-      }
+      const Span<float3> grid_positions = positions.slice(
+          bke::ccg::grid_range(key, grid_indices[i]));
+      data = std::copy(grid_positions.begin(), grid_positions.end(), data);
     }
   }
 }
 
 static void fill_vbo_normal_grids(const CCGKey &key,
-                                  const Span<CCGElem *> grids,
+                                  const Span<float3> positions,
+                                  const Span<float3> normals,
                                   const Span<int> grid_to_face_map,
                                   const Span<bool> sharp_faces,
                                   const bool use_flat_layout,
@@ -706,25 +706,30 @@ static void fill_vbo_normal_grids(const CCGKey &key,
     const int grid_size_1 = key.grid_size - 1;
     for (const int i : grid_indices.index_range()) {
       const int grid_index = grid_indices[i];
-      CCGElem *grid = grids[grid_index];
+      const IndexRange grid_range = bke::ccg::grid_range(key, grid_index);
       if (!sharp_faces.is_empty() && sharp_faces[grid_to_face_map[grid_index]]) {
+        const Span<float3> grid_positions = positions.slice(grid_range);
         for (int y = 0; y < grid_size_1; y++) {
           for (int x = 0; x < grid_size_1; x++) {
             float3 no;
             normal_quad_v3(no,
-                           CCG_grid_elem_co(key, grid, x, y + 1),
-                           CCG_grid_elem_co(key, grid, x + 1, y + 1),
-                           CCG_grid_elem_co(key, grid, x + 1, y),
-                           CCG_grid_elem_co(key, grid, x, y));
+                           grid_positions[CCG_grid_xy_to_index(key.grid_size, x, y + 1)],
+                           grid_positions[CCG_grid_xy_to_index(key.grid_size, x + 1, y + 1)],
+                           grid_positions[CCG_grid_xy_to_index(key.grid_size, x + 1, y)],
+                           grid_positions[CCG_grid_xy_to_index(key.grid_size, x, y)]);
             std::fill_n(data, 4, normal_float_to_short(no));
             data += 4;
           }
         }
       }
       else {
+        const Span<float3> grid_normals = normals.slice(grid_range);
         for (int y = 0; y < grid_size_1; y++) {
           for (int x = 0; x < grid_size_1; x++) {
-            std::fill_n(data, 4, normal_float_to_short(CCG_grid_elem_no(key, grid, x, y)));
+            std::fill_n(data,
+                        4,
+                        normal_float_to_short(
+                            grid_normals[CCG_grid_xy_to_index(key.grid_size, x, y)]));
             data += 4;
           }
         }
@@ -734,9 +739,8 @@ static void fill_vbo_normal_grids(const CCGKey &key,
   else {
     /* The non-flat VBO layout does not support sharp faces. */
     for (const int i : grid_indices.index_range()) {
-      CCGElem *grid = grids[grid_indices[i]];
-      for (const int offset : IndexRange(key.grid_area)) {
-        *data = normal_float_to_short(CCG_elem_offset_no(key, grid, offset));
+      for (const float3 &normal : normals.slice(bke::ccg::grid_range(key, grid_indices[i]))) {
+        *data = normal_float_to_short(normal);
         data++;
       }
     }
@@ -744,7 +748,7 @@ static void fill_vbo_normal_grids(const CCGKey &key,
 }
 
 static void fill_vbo_mask_grids(const CCGKey &key,
-                                const Span<CCGElem *> grids,
+                                const Span<float> masks,
                                 const bool use_flat_layout,
                                 const Span<int> grid_indices,
                                 gpu::VertBuf &vert_buf)
@@ -754,16 +758,16 @@ static void fill_vbo_mask_grids(const CCGKey &key,
     if (use_flat_layout) {
       const int grid_size_1 = key.grid_size - 1;
       for (const int i : grid_indices.index_range()) {
-        CCGElem *grid = grids[grid_indices[i]];
+        const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grid_indices[i]));
         for (int y = 0; y < grid_size_1; y++) {
           for (int x = 0; x < grid_size_1; x++) {
-            *data = CCG_grid_elem_mask(key, grid, x, y);
+            *data = grid_masks[CCG_grid_xy_to_index(key.grid_size, x, y)];
             data++;
-            *data = CCG_grid_elem_mask(key, grid, x + 1, y);
+            *data = grid_masks[CCG_grid_xy_to_index(key.grid_size, x + 1, y)];
             data++;
-            *data = CCG_grid_elem_mask(key, grid, x + 1, y + 1);
+            *data = grid_masks[CCG_grid_xy_to_index(key.grid_size, x + 1, y + 1)];
             data++;
-            *data = CCG_grid_elem_mask(key, grid, x, y + 1);
+            *data = grid_masks[CCG_grid_xy_to_index(key.grid_size, x, y + 1)];
             data++;
           }
         }
@@ -771,11 +775,8 @@ static void fill_vbo_mask_grids(const CCGKey &key,
     }
     else {
       for (const int i : grid_indices.index_range()) {
-        CCGElem *grid = grids[grid_indices[i]];
-        for (const int offset : IndexRange(key.grid_area)) {
-          *data = CCG_elem_offset_mask(key, grid, offset);
-          data++;
-        }
+        const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grid_indices[i]));
+        data = std::copy(grid_masks.begin(), grid_masks.end(), data);
       }
     }
   }
@@ -812,7 +813,6 @@ static void fill_vbo_grids(PBVHVbo &vbo, const PBVH_GPU_Args &args, const bool u
 {
   const SubdivCCG &subdiv_ccg = *args.subdiv_ccg;
   const Span<int> grid_indices = args.grid_indices;
-  const Span<CCGElem *> grids = args.grids;
   const CCGKey key = args.ccg_key;
   const int gridsize = key.grid_size;
 
@@ -829,7 +829,8 @@ static void fill_vbo_grids(PBVHVbo &vbo, const PBVH_GPU_Args &args, const bool u
   if (const CustomRequest *request_type = std::get_if<CustomRequest>(&vbo.request)) {
     switch (*request_type) {
       case CustomRequest::Position: {
-        fill_vbo_position_grids(key, grids, use_flat_layout, grid_indices, *vbo.vert_buf);
+        fill_vbo_position_grids(
+            key, subdiv_ccg.positions, use_flat_layout, grid_indices, *vbo.vert_buf);
         break;
       }
       case CustomRequest::Normal: {
@@ -839,7 +840,8 @@ static void fill_vbo_grids(PBVHVbo &vbo, const PBVH_GPU_Args &args, const bool u
         const VArraySpan sharp_faces = *attributes.lookup<bool>("sharp_face",
                                                                 bke::AttrDomain::Face);
         fill_vbo_normal_grids(key,
-                              grids,
+                              subdiv_ccg.positions,
+                              subdiv_ccg.normals,
                               grid_to_face_map,
                               sharp_faces,
                               use_flat_layout,
@@ -848,7 +850,7 @@ static void fill_vbo_grids(PBVHVbo &vbo, const PBVH_GPU_Args &args, const bool u
         break;
       }
       case CustomRequest::Mask: {
-        fill_vbo_mask_grids(key, grids, use_flat_layout, grid_indices, *vbo.vert_buf);
+        fill_vbo_mask_grids(key, subdiv_ccg.masks, use_flat_layout, grid_indices, *vbo.vert_buf);
         break;
       }
       case CustomRequest::FaceSet: {
@@ -92,8 +92,7 @@ void transform_positions(const float4x4 &transform, MutableSpan<float3> position
  */
 
 /** Fill the output array with all positions in the geometry referenced by the indices. */
-void gather_grids_positions(const CCGKey &key,
-                            Span<CCGElem *> elems,
+void gather_grids_positions(const SubdivCCG &subdiv_ccg,
                             Span<int> grids,
                             MutableSpan<float3> positions);
 inline MutableSpan<float3> gather_grids_positions(const SubdivCCG &subdiv_ccg,
@@ -102,7 +101,7 @@ inline MutableSpan<float3> gather_grids_positions(const SubdivCCG &subdiv_ccg,
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
   positions.resize(key.grid_area * grids.size());
-  gather_grids_positions(key, subdiv_ccg.grids, grids, positions);
+  gather_grids_positions(subdiv_ccg, grids, positions.as_mutable_span());
   return positions;
 }
 void gather_bmesh_positions(const Set<BMVert *, 0> &verts, MutableSpan<float3> positions);
@@ -175,11 +175,7 @@ const float *SCULPT_vertex_co_get(const Depsgraph &depsgraph,
     case blender::bke::pbvh::Type::BMesh:
       return ((BMVert *)vertex.i)->co;
     case blender::bke::pbvh::Type::Grids: {
-      const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
-      const int grid_index = vertex.i / key.grid_area;
-      const int index_in_grid = vertex.i - grid_index * key.grid_area;
-      CCGElem *elem = ss.subdiv_ccg->grids[grid_index];
-      return CCG_elem_co(key, CCG_elem_offset(key, elem, index_in_grid));
+      return ss.subdiv_ccg->positions[vertex.i];
     }
   }
   return nullptr;
@@ -200,11 +196,7 @@ const blender::float3 SCULPT_vertex_normal_get(const Depsgraph &depsgraph,
       return v->no;
     }
     case blender::bke::pbvh::Type::Grids: {
-      const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
-      const int grid_index = vertex.i / key.grid_area;
-      const int index_in_grid = vertex.i - grid_index * key.grid_area;
-      CCGElem *elem = ss.subdiv_ccg->grids[grid_index];
-      return CCG_elem_no(key, CCG_elem_offset(key, elem, index_in_grid));
+      return ss.subdiv_ccg->normals[vertex.i];
     }
   }
   BLI_assert_unreachable();
@@ -630,7 +622,7 @@ static void vertex_neighbors_get_grids(const SculptSession &ss,
 {
   /* TODO: optimize this. We could fill #SculptVertexNeighborIter directly,
    * maybe provide coordinate and mask pointers directly rather than converting
-   * back and forth between #CCGElem and global index. */
+   * back and forth between #SubdivCCGCoord and global index. */
   const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
   SubdivCCGCoord coord = SubdivCCGCoord::from_index(key, vertex.i);
 
@@ -904,7 +896,7 @@ std::optional<SubdivCCGCoord> nearest_vert_calc_grids(const bke::pbvh::Tree &pbv
 
   const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   const Span<bke::pbvh::GridsNode> nodes = pbvh.nodes<bke::pbvh::GridsNode>();
   const NearestData nearest = threading::parallel_reduce(
@@ -914,10 +906,9 @@ std::optional<SubdivCCGCoord> nearest_vert_calc_grids(const bke::pbvh::Tree &pbv
       [&](const IndexRange range, NearestData nearest) {
         nodes_in_sphere.slice(range).foreach_index([&](const int i) {
           for (const int grid : bke::pbvh::node_grid_indices(nodes[i])) {
-            CCGElem *elem = elems[grid];
+            const Span<float3> grid_positions = positions.slice(bke::ccg::grid_range(key, grid));
             BKE_subdiv_ccg_foreach_visible_grid_vert(key, grid_hidden, grid, [&](const int i) {
-              const float distance_sq = math::distance_squared(CCG_elem_offset_co(key, elem, i),
-                                                               location);
+              const float distance_sq = math::distance_squared(grid_positions[i], location);
               if (distance_sq < nearest.distance_sq) {
                 SubdivCCGCoord coord{};
                 coord.grid_index = grid;
@@ -1209,15 +1200,15 @@ static void restore_mask_from_undo_step(Object &object)
       SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
+      MutableSpan<float> masks = subdiv_ccg.masks;
       node_mask.foreach_index(GrainSize(1), [&](const int i) {
         if (const undo::Node *unode = undo::get_node(&nodes[i], undo::Type::Mask)) {
           int index = 0;
           for (const int grid : unode->grids) {
-            CCGElem *elem = grids[grid];
+            const IndexRange grid_range = bke::ccg::grid_range(key, grid);
             for (const int i : IndexRange(key.grid_area)) {
               if (grid_hidden.is_empty() || !grid_hidden[grid][i]) {
-                CCG_elem_offset_mask(key, elem, i) = unode->mask[index];
+                masks[grid_range[i]] = unode->mask[index];
               }
               index++;
             }
@@ -1385,15 +1376,15 @@ void restore_position_from_undo_step(const Depsgraph &depsgraph, Object &object)
       SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
+      MutableSpan<float3> positions = subdiv_ccg.positions;
       node_mask.foreach_index(GrainSize(1), [&](const int i) {
         if (const undo::Node *unode = undo::get_node(&nodes[i], undo::Type::Position)) {
           int index = 0;
           for (const int grid : unode->grids) {
-            CCGElem *elem = grids[grid];
+            const IndexRange grid_range = bke::ccg::grid_range(key, grid);
             for (const int i : IndexRange(key.grid_area)) {
               if (grid_hidden.is_empty() || !grid_hidden[grid][i]) {
-                CCG_elem_offset_co(key, elem, i) = unode->position[index];
+                positions[grid_range[i]] = unode->position[index];
               }
               index++;
             }
@@ -1774,7 +1765,7 @@ static void calc_area_normal_and_center_node_grids(const Object &object,
 
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(*ss.subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> normals = subdiv_ccg.normals;
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
   const Span<int> grids = bke::pbvh::node_grid_indices(node);
 
@@ -1827,7 +1818,7 @@ static void calc_area_normal_and_center_node_grids(const Object &object,
   for (const int i : grids.index_range()) {
     const int node_verts_start = i * key.grid_area;
     const int grid = grids[i];
-    CCGElem *elem = elems[grid];
+    const Span<float3> grid_normals = normals.slice(bke::ccg::grid_range(key, grid));
     for (const int offset : IndexRange(key.grid_area)) {
       if (!grid_hidden.is_empty() && grid_hidden[grid][offset]) {
         continue;
@@ -1839,16 +1830,12 @@ static void calc_area_normal_and_center_node_grids(const Object &object,
       if (!normal_test_r && !area_test_r) {
         continue;
       }
-      const float3 &normal = CCG_elem_offset_no(key, elem, offset);
+      const float3 &normal = grid_normals[offset];
       const float distance = std::sqrt(distances_sq[vert]);
       const int flip_index = math::dot(view_normal, normal) <= 0.0f;
       if (area_test_r) {
-        accumulate_area_center(location,
-                               CCG_elem_offset_co(key, elem, offset),
-                               distance,
-                               position_radius_inv,
-                               flip_index,
-                               anctd);
+        accumulate_area_center(
+            location, positions[vert], distance, position_radius_inv, flip_index, anctd);
       }
       if (normal_test_r) {
         accumulate_area_normal(normal, distance, normal_radius_inv, flip_index, anctd);
@@ -5886,7 +5873,7 @@ static void fake_neighbor_search_mesh(const SculptSession &ss,
 
 static void fake_neighbor_search_grids(const SculptSession &ss,
                                        const CCGKey &key,
-                                       const Span<CCGElem *> elems,
+                                       const Span<float3> positions,
                                        const BitGroupVector<> &grid_hidden,
                                        const float3 &location,
                                        const float max_distance_sq,
@@ -5896,7 +5883,6 @@ static void fake_neighbor_search_grids(const SculptSession &ss,
 {
   for (const int grid : bke::pbvh::node_grid_indices(node)) {
     const int verts_start = grid * key.grid_area;
-    CCGElem *elem = elems[grid];
     BKE_subdiv_ccg_foreach_visible_grid_vert(key, grid_hidden, grid, [&](const int offset) {
       const int vert = verts_start + offset;
       if (ss.fake_neighbors.fake_neighbor_index[vert] != FAKE_NEIGHBOR_NONE) {
@@ -5905,11 +5891,10 @@ static void fake_neighbor_search_grids(const SculptSession &ss,
       if (islands::vert_id_get(ss, vert) == island_id) {
         return;
       }
-      const float distance_sq = math::distance_squared(CCG_elem_offset_co(key, elem, offset),
-                                                       location);
+      const float distance_sq = math::distance_squared(positions[vert], location);
       if (distance_sq < max_distance_sq && distance_sq < nvtd.distance_sq) {
         nvtd.vert = vert;
-        BLI_assert(nvtd.vert < key.grid_area * elems.size());
+        BLI_assert(nvtd.vert < positions.size());
         nvtd.distance_sq = distance_sq;
       }
     });
@@ -6005,15 +5990,14 @@ static void fake_neighbor_search(const Depsgraph &depsgraph,
     case bke::pbvh::Type::Grids: {
       const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> elems = subdiv_ccg.grids;
+      const Span<float3> positions = subdiv_ccg.positions;
       const BitGroupVector<> grid_hidden = subdiv_ccg.grid_hidden;
-      for (const int vert : IndexRange(elems.size() * key.grid_area)) {
+      for (const int vert : positions.index_range()) {
         if (fake_neighbors[vert] != FAKE_NEIGHBOR_NONE) {
           continue;
         }
         const int island_id = islands::vert_id_get(ss, vert);
-        const SubdivCCGCoord coord = SubdivCCGCoord::from_index(key, vert);
-        const float3 &location = CCG_grid_elem_co(key, elems[coord.grid_index], coord.x, coord.y);
+        const float3 &location = positions[vert];
         IndexMaskMemory memory;
         const IndexMask nodes_in_sphere = bke::pbvh::search_nodes(
             *ss.pbvh, memory, [&](const bke::pbvh::Node &node) {
@@ -6031,7 +6015,7 @@ static void fake_neighbor_search(const Depsgraph &depsgraph,
               nodes_in_sphere.slice(range).foreach_index([&](const int i) {
                 fake_neighbor_search_grids(ss,
                                            key,
-                                           elems,
+                                           positions,
                                            grid_hidden,
                                            location,
                                            max_distance_sq,
@@ -6307,9 +6291,9 @@ static SculptTopologyIslandCache calc_topology_islands_grids(const Object &objec
   const SculptSession &ss = *object.sculpt;
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const int verts_num = subdiv_ccg.grids.size() * key.grid_area;
+  const int verts_num = subdiv_ccg.positions.size();
   AtomicDisjointSet disjoint_set(verts_num);
-  threading::parallel_for(subdiv_ccg.grids.index_range(), 512, [&](const IndexRange range) {
+  threading::parallel_for(IndexRange(subdiv_ccg.grids_num), 512, [&](const IndexRange range) {
     for (const int grid : range) {
       SubdivCCGNeighbors neighbors;
       for (const short y : IndexRange(key.grid_size)) {
@@ -6410,20 +6394,11 @@ void SCULPT_cube_tip_init(const Sculpt & /*sd*/,
 
 namespace blender::ed::sculpt_paint {
 
-void gather_grids_positions(const CCGKey &key,
-                            const Span<CCGElem *> elems,
+void gather_grids_positions(const SubdivCCG &subdiv_ccg,
                             const Span<int> grids,
                             const MutableSpan<float3> positions)
 {
-  BLI_assert(grids.size() * key.grid_area == positions.size());
-
-  for (const int i : grids.index_range()) {
-    CCGElem *elem = elems[grids[i]];
-    const int start = i * key.grid_area;
-    for (const int offset : IndexRange(key.grid_area)) {
-      positions[start + offset] = CCG_elem_offset_co(key, elem, offset);
-    }
-  }
+  gather_data_grids(subdiv_ccg, subdiv_ccg.positions.as_span(), grids, positions);
 }
 
 void gather_bmesh_positions(const Set<BMVert *, 0> &verts, const MutableSpan<float3> positions)
@@ -6441,17 +6416,7 @@ void gather_grids_normals(const SubdivCCG &subdiv_ccg,
                           const Span<int> grids,
                           const MutableSpan<float3> normals)
 {
-  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
-  BLI_assert(grids.size() * key.grid_area == normals.size());
-
-  for (const int i : grids.index_range()) {
-    CCGElem *elem = elems[grids[i]];
-    const int start = i * key.grid_area;
-    for (const int offset : IndexRange(key.grid_area)) {
-      normals[start + offset] = CCG_elem_offset_no(key, elem, offset);
-    }
-  }
+  gather_data_grids(subdiv_ccg, subdiv_ccg.normals.as_span(), grids, normals);
 }
 
 void gather_bmesh_normals(const Set<BMVert *, 0> &verts, const MutableSpan<float3> normals)
@@ -6656,9 +6621,7 @@ void fill_factor_from_hide_and_mask(const Mesh &mesh,
   if (const VArray hide_vert = *attributes.lookup<bool>(".hide_vert", bke::AttrDomain::Point)) {
     const VArraySpan span(hide_vert);
     for (const int i : verts.index_range()) {
-      if (span[verts[i]]) {
-        r_factors[i] = 0.0f;
-      }
+      r_factors[i] = span[verts[i]] ? 0.0f : r_factors[i];
     }
   }
 }
@@ -6686,15 +6649,15 @@ void fill_factor_from_hide_and_mask(const SubdivCCG &subdiv_ccg,
                                     const MutableSpan<float> r_factors)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
   BLI_assert(grids.size() * key.grid_area == r_factors.size());
 
   if (key.has_mask) {
     for (const int i : grids.index_range()) {
-      CCGElem *elem = elems[grids[i]];
-      const int start = i * key.grid_area;
+      const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grids[i]));
+      MutableSpan<float> grid_factors = r_factors.slice(bke::ccg::grid_range(key, i));
       for (const int offset : IndexRange(key.grid_area)) {
-        r_factors[start + offset] = 1.0f - CCG_elem_offset_mask(key, elem, offset);
+        grid_factors[offset] = 1.0f - grid_masks[offset];
       }
     }
   }
@@ -6708,9 +6671,7 @@ void fill_factor_from_hide_and_mask(const SubdivCCG &subdiv_ccg,
       const BitSpan hidden = grid_hidden[grids[i]];
       const int start = i * key.grid_area;
       for (const int offset : IndexRange(key.grid_area)) {
-        if (hidden[offset]) {
-          r_factors[start + offset] = 0.0f;
-        }
+        r_factors[start + offset] = hidden[offset] ? 0.0f : r_factors[start + offset];
       }
     }
   }
@@ -6746,15 +6707,15 @@ void calc_front_face(const float3 &view_normal,
                      const MutableSpan<float> factors)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> normals = subdiv_ccg.normals;
   BLI_assert(grids.size() * key.grid_area == factors.size());
 
   for (const int i : grids.index_range()) {
-    CCGElem *elem = elems[grids[i]];
-    const int start = i * key.grid_area;
+    const Span<float3> grid_normals = normals.slice(bke::ccg::grid_range(key, grids[i]));
+    MutableSpan<float> grid_factors = factors.slice(bke::ccg::grid_range(key, i));
     for (const int offset : IndexRange(key.grid_area)) {
-      const float dot = math::dot(view_normal, CCG_elem_offset_no(key, elem, offset));
-      factors[start + offset] *= std::max(dot, 0.0f);
+      const float dot = math::dot(view_normal, grid_normals[offset]);
+      grid_factors[offset] *= std::max(dot, 0.0f);
     }
   }
 }
@@ -6924,10 +6885,9 @@ void filter_distances_with_radius(const float radius,
                                   const Span<float> distances,
                                   const MutableSpan<float> factors)
 {
+  /* Always write the factor instead of branching, so the loop can be vectorized. */
   for (const int i : distances.index_range()) {
-    if (distances[i] > radius) {
-      factors[i] = 0.0f;
-    }
+    factors[i] = distances[i] > radius ? 0.0f : factors[i];
   }
 }
 
@@ -7029,13 +6989,8 @@ void apply_hardness_to_distances(const float radius,
   const float radius_inv = math::rcp(radius);
   const float hardness_inv_rcp = math::rcp(1.0f - hardness);
   for (const int i : distances.index_range()) {
-    if (distances[i] < threshold) {
-      distances[i] = 0.0f;
-    }
-    else {
-      const float radius_factor = (distances[i] * radius_inv - hardness) * hardness_inv_rcp;
-      distances[i] = radius_factor * radius;
-    }
+    const float radius_factor = (distances[i] * radius_inv - hardness) * hardness_inv_rcp;
+    distances[i] = distances[i] < threshold ? 0.0f : radius_factor * radius;
   }
 }
 
@@ -7063,6 +7018,10 @@ void calc_brush_texture_factors(const SculptSession &ss,
   }
 
   for (const int i : verts.index_range()) {
+    if (factors[i] == 0.0f) {
+      /* Texture sampling is expensive, skip vertices that aren't affected anyway. */
+      continue;
+    }
     float texture_value;
     float4 texture_rgba;
     /* NOTE: This is not a thread-safe call. */
@@ -7087,6 +7046,10 @@ void calc_brush_texture_factors(const SculptSession &ss,
   }
 
   for (const int i : positions.index_range()) {
+    if (factors[i] == 0.0f) {
+      /* Texture sampling is expensive, skip vertices that aren't affected anyway. */
+      continue;
+    }
     float texture_value;
     float4 texture_rgba;
     /* NOTE: This is not a thread-safe call. */
@@ -7125,14 +7088,14 @@ void apply_translations(const Span<float3> translations,
                         SubdivCCG &subdiv_ccg)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  MutableSpan<float3> positions = subdiv_ccg.positions;
   BLI_assert(grids.size() * key.grid_area == translations.size());
 
   for (const int i : grids.index_range()) {
-    CCGElem *elem = elems[grids[i]];
-    const int start = i * key.grid_area;
+    MutableSpan<float3> grid_positions = positions.slice(bke::ccg::grid_range(key, grids[i]));
+    const Span<float3> grid_translations = translations.slice(bke::ccg::grid_range(key, i));
     for (const int offset : IndexRange(key.grid_area)) {
-      CCG_elem_offset_co(key, elem, offset) += translations[start + offset];
+      grid_positions[offset] += grid_translations[offset];
     }
   }
 }
@@ -626,7 +626,13 @@ void calc_vert_factors(const Depsgraph &depsgraph,
     }
   }
 
+  /* Vertices with a zero factor are skipped, since the factor calculation can be expensive and
+   * the brush usually already filtered most vertices of the node. The per-stroke cached values
+   * for those vertices are calculated when they are first affected. */
   for (const int i : verts.index_range()) {
+    if (factors[i] == 0.0f) {
+      continue;
+    }
     factors[i] *= factor_get(depsgraph,
                              &cache,
                              object,
@@ -646,6 +652,9 @@ void calc_face_factors(const Depsgraph &depsgraph,
                        const MutableSpan<float> factors)
 {
   for (const int i : face_indices.index_range()) {
+    if (factors[i] == 0.0f) {
+      continue;
+    }
     const Span<int> face_verts = corner_verts.slice(faces[face_indices[i]]);
     float sum = 0.0f;
     for (const int vert : face_verts) {
@@ -677,6 +686,9 @@ void calc_grids_factors(const Depsgraph &depsgraph,
     const int node_start = i * key.grid_area;
     const int grids_start = grids[i] * key.grid_area;
     for (const int offset : IndexRange(key.grid_area)) {
+      if (factors[node_start + offset] == 0.0f) {
+        continue;
+      }
       factors[node_start + offset] *= factor_get(
           depsgraph,
           &cache,
@@ -704,6 +716,10 @@ void calc_vert_factors(const Depsgraph &depsgraph,
 
   int i = 0;
   for (BMVert *vert : verts) {
+    if (factors[i] == 0.0f) {
+      i++;
+      continue;
+    }
     factors[i] *= factor_get(depsgraph,
                              &cache,
                              object,
@@ -752,9 +768,9 @@ static void fill_topology_automasking_factors_grids(const Sculpt &sd,
   const float radius = ss.cache ? ss.cache->radius : std::numeric_limits<float>::max();
   const SubdivCCGCoord active_vert = std::get<SubdivCCGCoord>(ss.active_vert());
 
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const int grid_verts_num = subdiv_ccg.grids.size() * key.grid_area;
+  const int grid_verts_num = positions.size();
 
   flood_fill::FillDataGrids flood = flood_fill::FillDataGrids(grid_verts_num);
 
@@ -763,15 +779,14 @@ static void fill_topology_automasking_factors_grids(const Sculpt &sd,
   const bool use_radius = ss.cache && is_constrained_by_radius(brush);
   const ePaintSymmetryFlags symm = SCULPT_mesh_symmetry_xyz_get(ob);
 
-  float3 location = CCG_grid_elem_co(
-      key, grids[active_vert.grid_index], active_vert.x, active_vert.y);
+  float3 location = positions[active_vert.to_index(key)];
 
   flood.execute(
       ob, subdiv_ccg, [&](SubdivCCGCoord from_v, SubdivCCGCoord to_v, bool /*is_duplicate*/) {
         *(float *)SCULPT_vertex_attr_get(key, to_v, ss.attrs.automasking_factor) = 1.0f;
         *(float *)SCULPT_vertex_attr_get(key, from_v, ss.attrs.automasking_factor) = 1.0f;
         return (use_radius || SCULPT_is_vertex_inside_brush_radius_symm(
-                                  CCG_grid_elem_co(key, grids[to_v.grid_index], to_v.x, to_v.y),
+                                  positions[to_v.to_index(key)],
                                   location,
                                   radius,
                                   symm));
@@ -204,15 +204,14 @@ static std::optional<SubdivCCGCoord> get_closest_boundary_vert_grids(
     return initial_vert;
   }
 
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const int num_grids = key.grid_area * grids.size();
+  const int num_grids = positions.size();
 
   flood_fill::FillDataGrids flood_fill(num_grids);
   flood_fill.add_initial(initial_vert);
 
-  const float3 initial_vert_position = CCG_grid_elem_co(
-      key, grids[initial_vert.grid_index], initial_vert.x, initial_vert.y);
+  const float3 initial_vert_position = positions[initial_vert.to_index(key)];
   const float radius_sq = radius * radius;
 
   int boundary_initial_vert_steps = std::numeric_limits<int>::max();
@@ -242,8 +241,8 @@ static std::optional<SubdivCCGCoord> get_closest_boundary_vert_grids(
           }
         }
 
-        const float len_sq = math::distance_squared(
-            initial_vert_position, CCG_grid_elem_co(key, grids[to_v.grid_index], to_v.x, to_v.y));
+        const float len_sq = math::distance_squared(initial_vert_position,
+                                                    positions[to_v.to_index(key)]);
         return len_sq < radius_sq;
       });
 
@@ -361,9 +360,9 @@ static void indices_init_grids(Object &object,
                                const SubdivCCGCoord initial_vert,
                                SculptBoundary &boundary)
 {
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const int num_grids = key.grid_area * grids.size();
+  const int num_grids = positions.size();
   flood_fill::FillDataGrids flood_fill(num_grids);
 
   const int initial_boundary_index = initial_vert.to_index(key);
@@ -378,12 +377,8 @@ static void indices_init_grids(Object &object,
         const int from_v_i = from_v.to_index(key);
         const int to_v_i = to_v.to_index(key);
 
-        const float3 from_v_co = CCG_elem_offset_co(
-            key,
-            grids[from_v.grid_index],
-            CCG_grid_xy_to_index(key.grid_size, from_v.x, from_v.y));
-        const float3 to_v_co = CCG_elem_offset_co(
-            key, grids[to_v.grid_index], CCG_grid_xy_to_index(key.grid_size, to_v.x, to_v.y));
+        const float3 from_v_co = positions[from_v.to_index(key)];
+        const float3 to_v_co = positions[to_v.to_index(key)];
 
         if (!boundary::vert_is_boundary(subdiv_ccg, corner_verts, faces, boundary_verts, to_v)) {
           return false;
@@ -534,9 +529,9 @@ static void edit_data_init_grids(const SubdivCCG &subdiv_ccg,
                                  const float radius,
                                  SculptBoundary &boundary)
 {
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const int num_grids = key.grid_area * grids.size();
+  const int num_grids = positions.size();
 
   boundary.edit_info.original_vertex_i = Array<int>(num_grids, BOUNDARY_VERTEX_NONE);
   boundary.edit_info.propagation_steps_num = Array<int>(num_grids, BOUNDARY_STEPS_NONE);
@@ -639,11 +634,8 @@ static void edit_data_init_grids(const SubdivCCG &subdiv_ccg,
         /* Check the distance using the vertex that was propagated from the initial vertex that
          * was used to initialize the boundary. */
         if (boundary.edit_info.original_vertex_i[from_v_i] == initial_vert_i) {
-          boundary.pivot_position = CCG_elem_offset_co(
-              key, grids[neighbor.grid_index], index_in_grid);
-          accum_distance += math::distance(
-              CCG_grid_elem_co(key, grids[from_v.grid_index], from_v.x, from_v.y),
-              boundary.pivot_position);
+          boundary.pivot_position = positions[neighbor_idx];
+          accum_distance += math::distance(positions[from_v_i], boundary.pivot_position);
         }
       }
     }
@@ -798,8 +790,8 @@ static void bend_data_init_grids(const SubdivCCG &subdiv_ccg, SculptBoundary &bo
 
   const int num_elements = boundary.edit_info.strength_factor.size();
 
-  const CCGKey &key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
+  const Span<float3> normals = subdiv_ccg.normals;
 
   boundary.bend.pivot_rotation_axis = Array<float3>(num_elements, float3(0));
   boundary.bend.pivot_positions = Array<float3>(num_elements, float3(0));
@@ -809,17 +801,12 @@ static void bend_data_init_grids(const SubdivCCG &subdiv_ccg, SculptBoundary &bo
       continue;
     }
 
-    const SubdivCCGCoord vert = SubdivCCGCoord::from_index(key, i);
     const int orig_vert_i = boundary.edit_info.original_vertex_i[i];
-    const SubdivCCGCoord orig_vert = SubdivCCGCoord::from_index(key, orig_vert_i);
 
-    const float3 normal = CCG_grid_elem_no(key, grids[vert.grid_index], vert.x, vert.y);
-    const float3 dir = CCG_grid_elem_co(
-                           key, grids[orig_vert.grid_index], orig_vert.x, orig_vert.y) -
-                       CCG_grid_elem_co(key, grids[vert.grid_index], vert.x, vert.y);
+    const float3 normal = normals[i];
+    const float3 dir = positions[orig_vert_i] - positions[i];
     boundary.bend.pivot_rotation_axis[orig_vert_i] = math::normalize(math::cross(dir, normal));
-    boundary.bend.pivot_positions[orig_vert_i] = CCG_grid_elem_co(
-        key, grids[vert.grid_index], vert.x, vert.y);
+    boundary.bend.pivot_positions[orig_vert_i] = positions[i];
   }
 
   for (const int i : IndexRange(num_elements)) {
@@ -906,8 +893,7 @@ static void slide_data_init_grids(const SubdivCCG &subdiv_ccg, SculptBoundary &b
              boundary.edit_info.strength_factor.size());
 
   const int num_elements = boundary.edit_info.strength_factor.size();
-  const CCGKey &key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   boundary.slide.directions = Array<float3>(num_elements, float3(0));
 
@@ -915,13 +901,10 @@ static void slide_data_init_grids(const SubdivCCG &subdiv_ccg, SculptBoundary &b
     if (boundary.edit_info.propagation_steps_num[i] != boundary.max_propagation_steps) {
       continue;
     }
-    const SubdivCCGCoord vert = SubdivCCGCoord::from_index(key, i);
     const int orig_vert_i = boundary.edit_info.original_vertex_i[i];
-    const SubdivCCGCoord orig_vert = SubdivCCGCoord::from_index(key, orig_vert_i);
 
-    boundary.slide.directions[orig_vert_i] = math::normalize(
-        CCG_grid_elem_co(key, grids[orig_vert.grid_index], orig_vert.x, orig_vert.y) -
-        CCG_grid_elem_co(key, grids[vert.grid_index], vert.x, vert.y));
+    boundary.slide.directions[orig_vert_i] = math::normalize(positions[orig_vert_i] -
+                                                             positions[i]);
   }
 
   for (const int i : IndexRange(num_elements)) {
@@ -983,15 +966,7 @@ static void twist_data_init_mesh(const Span<float3> vert_positions, SculptBounda
 
 static void twist_data_init_grids(const SubdivCCG &subdiv_ccg, SculptBoundary &boundary)
 {
-  const CCGKey &key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
-
-  Array<float3> positions(boundary.verts.size());
-  for (const int i : positions.index_range()) {
-    const SubdivCCGCoord vert = SubdivCCGCoord::from_index(key, boundary.verts[i]);
-    positions[i] = CCG_grid_elem_co(key, grids[vert.grid_index], vert.x, vert.y);
-  }
-  populate_twist_data(positions, boundary);
+  twist_data_init_mesh(subdiv_ccg.positions, boundary);
 }
 
 static void twist_data_init_bmesh(BMesh *bm, SculptBoundary &boundary)
@@ -2566,7 +2541,7 @@ BLI_NOINLINE static void calc_average_position(const SubdivCCG &subdiv_ccg,
                                                const MutableSpan<float3> average_positions)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   BLI_assert(neighbors.size() == propagation_steps.size());
   BLI_assert(neighbors.size() == factors.size());
@@ -2577,8 +2552,7 @@ BLI_NOINLINE static void calc_average_position(const SubdivCCG &subdiv_ccg,
     int valid_neighbors = 0;
     for (const SubdivCCGCoord neighbor : neighbors[i]) {
       if (propagation_steps[i] == vert_propagation_steps[neighbor.to_index(key)]) {
-        average_positions[i] += CCG_grid_elem_co(
-            key, grids[neighbor.grid_index], neighbor.x, neighbor.y);
+        average_positions[i] += positions[neighbor.to_index(key)];
         valid_neighbors++;
       }
     }
@@ -3021,18 +2995,16 @@ static void init_falloff_grids(const SubdivCCG &subdiv_ccg,
              boundary.edit_info.strength_factor.size());
 
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
 
   BKE_curvemapping_init(brush.curve);
 
-  for (const int i : grids.index_range()) {
+  for (const int i : IndexRange(subdiv_ccg.grids_num)) {
     const int start = i * key.grid_area;
     for (const int offset : IndexRange(key.grid_area)) {
       const int index = start + offset;
       if (boundary.edit_info.propagation_steps_num[index] != BOUNDARY_STEPS_NONE) {
-        const float mask_factor = key.has_mask ?
-                                      1.0f - CCG_elem_offset_mask(key, grids[i], offset) :
-                                      1.0f;
+        const float mask_factor = key.has_mask ? 1.0f - masks[index] : 1.0f;
         boundary.edit_info.strength_factor[index] =
             mask_factor * BKE_brush_curve_strength(&brush,
                                                    boundary.edit_info.propagation_steps_num[index],
@@ -3182,7 +3154,7 @@ static void init_boundary_grids(Object &object,
 
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
   const CCGKey &key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   ActiveVert initial_vert_ref = ss.active_vert();
   if (std::holds_alternative<std::monostate>(initial_vert_ref)) {
@@ -3195,9 +3167,7 @@ static void init_boundary_grids(Object &object,
   }
   else {
     const SubdivCCGCoord active_vert = std::get<SubdivCCGCoord>(initial_vert_ref);
-    float3 location = symmetry_flip(
-        CCG_grid_elem_co(key, grids[active_vert.grid_index], active_vert.x, active_vert.y),
-        symm_area);
+    float3 location = symmetry_flip(positions[active_vert.to_index(key)], symm_area);
     initial_vert = nearest_vert_calc_grids(
         pbvh, subdiv_ccg, location, ss.cache->radius_squared, false);
   }
@@ -3544,7 +3514,7 @@ std::unique_ptr<SculptBoundary> data_init_grids(Object &object,
   const OffsetIndices faces = mesh.faces();
   const Span<int> corner_verts = mesh.corner_verts();
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey &key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
 
   const std::optional<SubdivCCGCoord> boundary_initial_vert = get_closest_boundary_vert_grids(
@@ -3568,8 +3538,7 @@ std::unique_ptr<SculptBoundary> data_init_grids(Object &object,
   SubdivCCGCoord boundary_vert = *boundary_initial_vert;
   const int boundary_initial_vert_index = boundary_vert.to_index(key);
   boundary->initial_vert_i = boundary_initial_vert_index;
-  boundary->initial_vert_position = CCG_grid_elem_co(
-      key, grids[boundary_vert.grid_index], boundary_vert.x, boundary_vert.y);
+  boundary->initial_vert_position = positions[boundary_vert.to_index(key)];
 
   indices_init_grids(
       object, faces, corner_verts, subdiv_ccg, ss.vertex_info.boundary, boundary_vert, *boundary);
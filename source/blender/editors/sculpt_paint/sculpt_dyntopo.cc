@@ -12,6 +12,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_string.h"
+
 #include "BLT_translation.hh"
 
 #include "DNA_modifier_types.h"
@@ -259,6 +261,15 @@ static bool dyntopo_supports_layer(const CustomDataLayer &layer)
   if (layer.type == CD_PROP_FLOAT && STREQ(layer.name, ".sculpt_mask")) {
     return true;
   }
+  /* Element orders of spatially reordered meshes, they are discarded when the topology changes. */
+  if (layer.type == CD_PROP_INT32 && STR_ELEM(layer.name,
+                                              ".sculpt_orig_vert_index",
+                                              ".sculpt_orig_face_index",
+                                              ".sculpt_vert_index",
+                                              ".sculpt_face_index"))
+  {
+    return true;
+  }
   if (CD_TYPE_AS_MASK(layer.type) & CD_MASK_PROP_ALL) {
     return BM_attribute_stored_in_bmesh_builtin(layer.name);
   }
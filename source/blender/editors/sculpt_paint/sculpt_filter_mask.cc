@@ -274,12 +274,12 @@ BLI_NOINLINE static void copy_old_hidden_mask_grids(const SubdivCCG &subdiv_ccg,
     return;
   }
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
   for (const int i : grids.index_range()) {
     const int node_verts_start = i * key.grid_area;
-    CCGElem *elem = elems[grids[i]];
+    const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grids[i]));
     bits::foreach_1_index(grid_hidden[grids[i]], [&](const int offset) {
-      new_mask[node_verts_start + offset] = CCG_elem_offset_mask(key, elem, offset);
+      new_mask[node_verts_start + offset] = grid_masks[offset];
     });
   }
 }
@@ -298,7 +298,7 @@ static void apply_new_mask_grids(const Depsgraph &depsgraph,
   node_mask.foreach_index(GrainSize(1), [&](const int i, const int pos) {
     const Span<int> grids = bke::pbvh::node_grid_indices(nodes[i]);
     const Span<float> new_node_mask = new_mask.slice(node_verts[pos]);
-    if (mask_equals_array_grids(subdiv_ccg.grids, key, grids, new_node_mask)) {
+    if (mask_equals_array_grids(subdiv_ccg.masks, key, grids, new_node_mask)) {
       return;
     }
     undo::push_node(depsgraph, object, &nodes[i], undo::Type::Mask);
@@ -345,13 +345,13 @@ static void grow_mask_grids(const SubdivCCG &subdiv_ccg,
                             MutableSpan<float> new_mask)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
 
   const Span<int> grids = bke::pbvh::node_grid_indices(node);
 
   for (const int i : grids.index_range()) {
     const int grid = grids[i];
-    CCGElem *elem = elems[grid];
+    const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grid));
     const int node_verts_start = i * key.grid_area;
 
     for (const short y : IndexRange(key.grid_size)) {
@@ -363,10 +363,10 @@ static void grow_mask_grids(const SubdivCCG &subdiv_ccg,
         SubdivCCGCoord coord{grid, x, y};
         BKE_subdiv_ccg_neighbor_coords_get(subdiv_ccg, coord, false, neighbors);
 
-        new_mask[node_vert_index] = CCG_elem_offset_mask(key, elem, offset);
+        new_mask[node_vert_index] = grid_masks[offset];
         for (const SubdivCCGCoord neighbor : neighbors.coords) {
-          new_mask[node_vert_index] = std::max(
-              CCG_grid_elem_mask(key, elem, neighbor.x, neighbor.y), new_mask[node_vert_index]);
+          new_mask[node_vert_index] = std::max(masks[neighbor.to_index(key)],
+                                               new_mask[node_vert_index]);
         }
       }
     }
@@ -380,13 +380,13 @@ static void shrink_mask_grids(const SubdivCCG &subdiv_ccg,
                               MutableSpan<float> new_mask)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float> masks = subdiv_ccg.masks;
 
   const Span<int> grids = bke::pbvh::node_grid_indices(node);
 
   for (const int i : grids.index_range()) {
     const int grid = grids[i];
-    CCGElem *elem = elems[grid];
+    const Span<float> grid_masks = masks.slice(bke::ccg::grid_range(key, grid));
     const int node_verts_start = i * key.grid_area;
 
     for (const short y : IndexRange(key.grid_size)) {
@@ -398,10 +398,10 @@ static void shrink_mask_grids(const SubdivCCG &subdiv_ccg,
         SubdivCCGCoord coord{grid, x, y};
         BKE_subdiv_ccg_neighbor_coords_get(subdiv_ccg, coord, false, neighbors);
 
-        new_mask[node_vert_index] = CCG_elem_offset_mask(key, elem, offset);
+        new_mask[node_vert_index] = grid_masks[offset];
         for (const SubdivCCGCoord neighbor : neighbors.coords) {
-          new_mask[node_vert_index] = std::min(
-              CCG_grid_elem_mask(key, elem, neighbor.x, neighbor.y), new_mask[node_vert_index]);
+          new_mask[node_vert_index] = std::min(masks[neighbor.to_index(key)],
+                                               new_mask[node_vert_index]);
         }
       }
     }
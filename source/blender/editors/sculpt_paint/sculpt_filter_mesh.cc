@@ -1722,7 +1722,6 @@ static void calc_sharpen_filter(const Depsgraph &depsgraph,
     case bke::pbvh::Type::Grids: {
       SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
       const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-      const Span<CCGElem *> elems = subdiv_ccg.grids;
 
       threading::EnumerableThreadSpecific<LocalData> all_tls;
       MutableSpan<bke::pbvh::GridsNode> nodes = ss.pbvh->nodes<bke::pbvh::GridsNode>();
@@ -1773,10 +1772,9 @@ static void calc_sharpen_filter(const Depsgraph &depsgraph,
                 BKE_subdiv_ccg_neighbor_coords_get(
                     subdiv_ccg, SubdivCCGCoord{grid, x, y}, false, neighbors);
                 for (const SubdivCCGCoord neighbor : neighbors.coords) {
-                  float3 disp_n = CCG_grid_elem_co(
-                                      key, elems[neighbor.grid_index], neighbor.x, neighbor.y) -
-                                  position;
-                  disp_n *= ss.filter_cache->sharpen_factor[neighbor.to_index(key)];
+                  const int neighbor_vert = neighbor.to_index(key);
+                  float3 disp_n = subdiv_ccg.positions[neighbor_vert] - position;
+                  disp_n *= ss.filter_cache->sharpen_factor[neighbor_vert];
                   disp_sharpen += disp_n;
                 }
 
@@ -2069,13 +2067,11 @@ static void calc_limit_surface_positions(const Object &object, MutableSpan<float
   const SculptSession &ss = *object.sculpt;
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
 
-  threading::parallel_for(elems.index_range(), 512, [&](const IndexRange range) {
+  threading::parallel_for(IndexRange(subdiv_ccg.grids_num), 512, [&](const IndexRange range) {
     for (const int grid : range) {
-      const int start = grid * key.grid_area;
       BKE_subdiv_ccg_eval_limit_positions(
-          subdiv_ccg, key, grid, limit_positions.slice(start, key.grid_area));
+          subdiv_ccg, key, grid, limit_positions.slice(bke::ccg::grid_range(key, grid)));
     }
   });
 }
@@ -82,7 +82,7 @@ static void init_mask_grids(Main &bmain,
                             Depsgraph &depsgraph,
                             Object &object,
                             const IndexMask &node_mask,
-                            FunctionRef<void(const BitGroupVector<> &, int, CCGElem *)> write_fn)
+                            FunctionRef<void(const BitGroupVector<> &, int, MutableSpan<float>)> write_fn)
 {
   MultiresModifierData *mmd = BKE_sculpt_multires_active(&scene, &object);
   BKE_sculpt_mask_layers_ensure(&depsgraph, &bmain, &object, mmd);
@@ -90,14 +90,15 @@ static void init_mask_grids(Main &bmain,
   SculptSession &ss = *object.sculpt;
   MutableSpan<bke::pbvh::GridsNode> nodes = ss.pbvh->nodes<bke::pbvh::GridsNode>();
   SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-  const Span<CCGElem *> grids = subdiv_ccg.grids;
+  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
+  const MutableSpan<float> masks = subdiv_ccg.masks;
   const BitGroupVector<> &grid_hidden = subdiv_ccg.grid_hidden;
 
   undo::push_nodes(depsgraph, object, node_mask, undo::Type::Mask);
 
   node_mask.foreach_index(GrainSize(1), [&](const int i) {
     for (const int grid : bke::pbvh::node_grid_indices(nodes[i])) {
-      write_fn(grid_hidden, grid, grids[grid]);
+      write_fn(grid_hidden, grid, masks.slice(bke::ccg::grid_range(key, grid)));
     }
     BKE_pbvh_node_mark_update_mask(nodes[i]);
   });
@@ -173,11 +174,13 @@ static int sculpt_mask_init_exec(bContext *C, wmOperator *op)
               depsgraph,
               ob,
               node_mask,
-              [&](const BitGroupVector<> &grid_hidden, const int grid_index, CCGElem *grid) {
+              [&](const BitGroupVector<> &grid_hidden,
+                  const int grid_index,
+                  MutableSpan<float> grid_masks) {
                 const int verts_start = grid_index * key.grid_area;
                 BKE_subdiv_ccg_foreach_visible_grid_vert(
                     key, grid_hidden, grid_index, [&](const int i) {
-                      CCG_elem_offset_mask(key, grid, i) = BLI_hash_int_01(verts_start + i + seed);
+                      grid_masks[i] = BLI_hash_int_01(verts_start + i + seed);
                     });
               });
           break;
@@ -194,12 +197,14 @@ static int sculpt_mask_init_exec(bContext *C, wmOperator *op)
               depsgraph,
               ob,
               node_mask,
-              [&](const BitGroupVector<> &grid_hidden, const int grid_index, CCGElem *grid) {
+              [&](const BitGroupVector<> &grid_hidden,
+                  const int grid_index,
+                  MutableSpan<float> grid_masks) {
                 const int face_set = face_sets[grid_to_face[grid_index]];
                 const float value = BLI_hash_int_01(face_set + seed);
                 BKE_subdiv_ccg_foreach_visible_grid_vert(
                     key, grid_hidden, grid_index, [&](const int i) {
-                      CCG_elem_offset_mask(key, grid, i) = value;
+                      grid_masks[i] = value;
                     });
               });
           break;
@@ -212,12 +217,14 @@ static int sculpt_mask_init_exec(bContext *C, wmOperator *op)
               depsgraph,
               ob,
               node_mask,
-              [&](const BitGroupVector<> &grid_hidden, const int grid_index, CCGElem *grid) {
+              [&](const BitGroupVector<> &grid_hidden,
+                  const int grid_index,
+                  MutableSpan<float> grid_masks) {
                 const int verts_start = grid_index * key.grid_area;
                 BKE_subdiv_ccg_foreach_visible_grid_vert(
                     key, grid_hidden, grid_index, [&](const int i) {
                       const int island = islands::vert_id_get(ss, verts_start + i);
-                      CCG_elem_offset_mask(key, grid, i) = BLI_hash_int_01(island + seed);
+                      grid_masks[i] = BLI_hash_int_01(island + seed);
                     });
               });
           break;
@@ -21,6 +21,7 @@
 
 #include "DNA_brush_types.h"
 #include "DNA_listBase.h"
+#include "DNA_modifier_types.h"
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
@@ -30,9 +31,11 @@
 #include "BKE_ccg.hh"
 #include "BKE_context.hh"
 #include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_mirror.hh"
+#include "BKE_modifier.hh"
 #include "BKE_multires.hh"
 #include "BKE_object.hh"
 #include "BKE_paint.hh"
@@ -50,6 +53,8 @@
 #include "WM_toolsystem.hh"
 #include "WM_types.hh"
 
+#include "GEO_reorder.hh"
+
 #include "ED_image.hh"
 #include "ED_object.hh"
 #include "ED_screen.hh"
@@ -286,6 +291,217 @@ static void SCULPT_OT_symmetrize(wmOperatorType *ot)
   RNA_def_property_ui_range(prop, 0.0, FLT_MAX, 0.001, 5);
 }
 
+/**** Spatial reordering of the mesh in sculpt mode ****/
+
+/* While in sculpt mode, vertices and faces can be reordered to match the order of the leaf nodes
+ * of the PBVH, so brushes processing a node access memory close together. The index of every
+ * element in the other order is stored in an attribute, to restore the original order when
+ * leaving sculpt mode and to use the same order again when entering it later, which keeps the
+ * indices stored in sculpt undo steps valid. */
+
+/** Original index of every element, only exists while the mesh is in sculpt order. */
+static constexpr const char *orig_vert_index_name = ".sculpt_orig_vert_index";
+static constexpr const char *orig_face_index_name = ".sculpt_orig_face_index";
+/** Index of every element in sculpt order, stored on the mesh in its original order. */
+static constexpr const char *sculpt_vert_index_name = ".sculpt_vert_index";
+static constexpr const char *sculpt_face_index_name = ".sculpt_face_index";
+
+struct MeshReferenceSearch {
+  const Object *object;
+  bool found;
+};
+
+static void mesh_reference_search_cb(void *user_data,
+                                     Object * /*ob*/,
+                                     ID **idpoin,
+                                     int /*cb_flag*/)
+{
+  MeshReferenceSearch &search = *static_cast<MeshReferenceSearch *>(user_data);
+  if (*idpoin != nullptr &&
+      ELEM(*idpoin, &search.object->id, static_cast<const ID *>(search.object->data)))
+  {
+    search.found = true;
+  }
+}
+
+static bool mesh_reorder_supported(Main &bmain, Scene &scene, Object &ob)
+{
+  const Mesh &mesh = *static_cast<const Mesh *>(ob.data);
+  if (mesh.flag & ME_SCULPT_DYNAMIC_TOPOLOGY) {
+    return false;
+  }
+  if (BKE_sculpt_multires_active(&scene, &ob)) {
+    return false;
+  }
+  /* Shape keys and other users of the mesh may reference vertices by index. */
+  if (mesh.key != nullptr || ID_REAL_USERS(&mesh.id) > 1) {
+    return false;
+  }
+  LISTBASE_FOREACH (const ModifierData *, md, &ob.modifiers) {
+    if (!ELEM(md->type,
+              eModifierType_Armature,
+              eModifierType_Mirror,
+              eModifierType_Solidify,
+              eModifierType_Subsurf))
+    {
+      return false;
+    }
+  }
+  LISTBASE_FOREACH (Object *, other, &bmain.objects) {
+    if (other == &ob) {
+      continue;
+    }
+    if (other->parent == &ob && ELEM(other->partype, PARVERT1, PARVERT3)) {
+      return false;
+    }
+    /* Modifiers of other objects, like Surface Deform, Mesh Deform and Data Transfer, may bind to
+     * element indices of the mesh. */
+    MeshReferenceSearch search = {&ob, false};
+    BKE_modifiers_foreach_ID_link(other, mesh_reference_search_cb, &search);
+    if (search.found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Read a stored element order. It's empty when it doesn't exist or when the topology changed since
+ * it was stored, and it isn't a permutation of the elements anymore.
+ */
+static Array<int> read_element_order(const bke::AttributeAccessor attributes,
+                                     const StringRef name,
+                                     const bke::AttrDomain domain)
+{
+  const VArraySpan<int> order = *attributes.lookup<int>(name, domain);
+  if (order.is_empty()) {
+    return {};
+  }
+  Array<bool> found(order.size(), false);
+  for (const int i : order) {
+    if (i < 0 || i >= order.size() || found[i]) {
+      return {};
+    }
+    found[i] = true;
+  }
+  return Array<int>(Span<int>(order));
+}
+
+static Array<int> invert_element_order(const Span<int> order)
+{
+  Array<int> inverted(order.size());
+  threading::parallel_for(order.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      inverted[order[i]] = i;
+    }
+  });
+  return inverted;
+}
+
+static void remove_element_orders(bke::MutableAttributeAccessor attributes)
+{
+  for (const char *name :
+       {orig_vert_index_name, orig_face_index_name, sculpt_vert_index_name, sculpt_face_index_name})
+  {
+    attributes.remove(name);
+  }
+}
+
+/**
+ * Replace the mesh geometry with a copy using the given orders, and store the previous index of
+ * every element in the given attributes.
+ */
+static void reorder_mesh_elements(Object &ob,
+                                  const Span<int> face_order,
+                                  const Span<int> vert_order,
+                                  const StringRef face_index_name,
+                                  const StringRef vert_index_name)
+{
+  Mesh &mesh = *static_cast<Mesh *>(ob.data);
+  Mesh *faces_reordered = geometry::reorder_mesh(mesh, face_order, bke::AttrDomain::Face, {});
+  Mesh *result = geometry::reorder_mesh(*faces_reordered, vert_order, bke::AttrDomain::Point, {});
+  BKE_id_free(nullptr, faces_reordered);
+
+  bke::MutableAttributeAccessor attributes = result->attributes_for_write();
+  remove_element_orders(attributes);
+  attributes.add<int>(face_index_name,
+                      bke::AttrDomain::Face,
+                      bke::AttributeInitVArray(VArray<int>::ForSpan(face_order)));
+  attributes.add<int>(vert_index_name,
+                      bke::AttrDomain::Point,
+                      bke::AttributeInitVArray(VArray<int>::ForSpan(vert_order)));
+
+  BKE_mesh_nomain_to_mesh(result, &mesh, &ob);
+  DEG_id_tag_update(&mesh.id, ID_RECALC_GEOMETRY);
+}
+
+static void mesh_reorder_for_sculpt(Main &bmain, Scene &scene, Object &ob)
+{
+  Mesh &mesh = *static_cast<Mesh *>(ob.data);
+  if (!mesh_reorder_supported(bmain, scene, ob)) {
+    return;
+  }
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  if (attributes.contains(orig_vert_index_name)) {
+    /* Already in sculpt order, when the file was saved in sculpt mode. */
+    return;
+  }
+  const Sculpt *sd = scene.toolsettings->sculpt;
+  if (sd == nullptr || !(sd->flags & SCULPT_SPATIAL_REORDER)) {
+    /* The order stored by a previous sculpt session is not used anymore. */
+    if (attributes.contains(sculpt_vert_index_name) || attributes.contains(sculpt_face_index_name))
+    {
+      remove_element_orders(mesh.attributes_for_write());
+    }
+    return;
+  }
+
+  Array<int> face_order;
+  Array<int> vert_order;
+  const Array<int> sculpt_face_index = read_element_order(
+      attributes, sculpt_face_index_name, bke::AttrDomain::Face);
+  const Array<int> sculpt_vert_index = read_element_order(
+      attributes, sculpt_vert_index_name, bke::AttrDomain::Point);
+  if (!sculpt_face_index.is_empty() && !sculpt_vert_index.is_empty()) {
+    face_order = invert_element_order(sculpt_face_index);
+    vert_order = invert_element_order(sculpt_vert_index);
+  }
+  else {
+    if (mesh.faces_num == 0) {
+      return;
+    }
+    const std::unique_ptr<bke::pbvh::Tree> pbvh = bke::pbvh::build_mesh(mesh);
+    face_order.reinitialize(mesh.faces_num);
+    vert_order.reinitialize(mesh.verts_num);
+    bke::pbvh::calc_leaf_order_mesh(mesh, *pbvh, face_order, vert_order);
+  }
+
+  reorder_mesh_elements(ob, face_order, vert_order, orig_face_index_name, orig_vert_index_name);
+}
+
+static void mesh_restore_order(Object &ob)
+{
+  Mesh &mesh = *static_cast<Mesh *>(ob.data);
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  if (!attributes.contains(orig_vert_index_name) && !attributes.contains(orig_face_index_name)) {
+    return;
+  }
+  const Array<int> orig_face_index = read_element_order(
+      attributes, orig_face_index_name, bke::AttrDomain::Face);
+  const Array<int> orig_vert_index = read_element_order(
+      attributes, orig_vert_index_name, bke::AttrDomain::Point);
+  if (orig_face_index.is_empty() || orig_vert_index.is_empty()) {
+    /* The topology changed in sculpt mode, the original order doesn't exist anymore. */
+    remove_element_orders(mesh.attributes_for_write());
+    return;
+  }
+  reorder_mesh_elements(ob,
+                        invert_element_order(orig_face_index),
+                        invert_element_order(orig_vert_index),
+                        sculpt_face_index_name,
+                        sculpt_vert_index_name);
+}
+
 /**** Toggle operator for turning sculpt mode on or off ****/
 
 static void sculpt_init_session(Main &bmain, Depsgraph &depsgraph, Scene &scene, Object &ob)
@@ -362,6 +578,9 @@ void object_sculpt_mode_enter(Main &bmain,
   const int mode_flag = OB_MODE_SCULPT;
   Mesh *mesh = BKE_mesh_from_object(&ob);
 
+  /* Replaces the mesh geometry and its caches, so it must happen first. */
+  mesh_reorder_for_sculpt(bmain, scene, ob);
+
   /* Re-triangulating the mesh for position changes in sculpt mode isn't worth the performance
    * impact, so delay triangulation updates until the user exits sculpt mode. */
   mesh->runtime->corner_tris_cache.freeze();
@@ -491,6 +710,8 @@ void object_sculpt_mode_exit(Main &bmain, Depsgraph &depsgraph, Scene &scene, Ob
 
   BKE_sculptsession_free(&ob);
 
+  mesh_restore_order(ob);
+
   paint_cursor_delete_textures();
 
   /* Never leave derived meshes behind. */
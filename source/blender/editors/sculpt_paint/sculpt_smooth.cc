@@ -96,13 +96,13 @@ template void neighbor_data_average_mesh<float4>(Span<float4>,
                                                  MutableSpan<float4>);
 
 static float3 average_positions(const CCGKey &key,
-                                const Span<CCGElem *> elems,
+                                const Span<float3> positions,
                                 const Span<SubdivCCGCoord> coords)
 {
   const float factor = math::rcp(float(coords.size()));
   float3 result(0);
   for (const SubdivCCGCoord coord : coords) {
-    result += CCG_grid_elem_co(key, elems[coord.grid_index], coord.x, coord.y) * factor;
+    result += positions[coord.to_index(key)] * factor;
   }
   return result;
 }
@@ -112,7 +112,7 @@ void neighbor_position_average_grids(const SubdivCCG &subdiv_ccg,
                                      const MutableSpan<float3> new_positions)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   BLI_assert(grids.size() * key.grid_area == new_positions.size());
 
@@ -135,7 +135,7 @@ void neighbor_position_average_grids(const SubdivCCG &subdiv_ccg,
         SubdivCCGNeighbors neighbors;
         BKE_subdiv_ccg_neighbor_coords_get(subdiv_ccg, coord, false, neighbors);
 
-        new_positions[node_vert_index] = average_positions(key, elems, neighbors.coords);
+        new_positions[node_vert_index] = average_positions(key, positions, neighbors.coords);
       }
     }
   }
@@ -149,13 +149,12 @@ void neighbor_position_average_interior_grids(const OffsetIndices<int> faces,
                                               const MutableSpan<float3> new_positions)
 {
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
+  const Span<float3> positions = subdiv_ccg.positions;
 
   BLI_assert(grids.size() * key.grid_area == new_positions.size());
 
   for (const int i : grids.index_range()) {
     const int grid = grids[i];
-    CCGElem *elem = elems[grid];
     const int node_verts_start = i * key.grid_area;
 
     /* TODO: This loop could be optimized in the future by skipping unnecessary logic for
@@ -190,10 +189,10 @@ void neighbor_position_average_interior_grids(const OffsetIndices<int> faces,
         }
 
         if (neighbors.coords.is_empty()) {
-          new_positions[node_vert_index] = CCG_elem_offset_co(key, elem, offset);
+          new_positions[node_vert_index] = positions[coord.to_index(key)];
         }
         else {
-          new_positions[node_vert_index] = average_positions(key, elems, neighbors.coords);
+          new_positions[node_vert_index] = average_positions(key, positions, neighbors.coords);
         }
       }
     }
@@ -449,21 +448,20 @@ static float3 calc_boundary_normal_corner(const float3 &current_position,
 }
 
 static float3 calc_boundary_normal_corner(const CCGKey &key,
-                                          const Span<CCGElem *> elems,
+                                          const Span<float3> positions,
                                           const float3 &current_position,
                                           const Span<SubdivCCGCoord> neighbors)
 {
   float3 normal(0);
   for (const SubdivCCGCoord &coord : neighbors) {
-    const float3 to_neighbor = CCG_grid_elem_co(key, elems[coord.grid_index], coord.x, coord.y) -
-                               current_position;
+    const float3 to_neighbor = positions[coord.to_index(key)] - current_position;
     normal += math::normalize(to_neighbor);
   }
   return math::normalize(normal);
 }
 
-static float3 average_positions(const CCGKey &key,
-                                const Span<CCGElem *> elems,
+static float3 average_positions(const SubdivCCG &subdiv_ccg,
+                                const CCGKey &key,
                                 const Span<float3> positions,
                                 const Span<SubdivCCGCoord> neighbors,
                                 const int current_grid,
@@ -477,7 +475,7 @@ static float3 average_positions(const CCGKey &key,
       result += positions[current_grid_start + offset] * factor;
     }
     else {
-      result += CCG_grid_elem_co(key, elems[coord.grid_index], coord.x, coord.y) * factor;
+      result += subdiv_ccg.positions[coord.to_index(key)] * factor;
     }
   }
   return result;
@@ -579,7 +577,6 @@ void calc_relaxed_translations_grids(const SubdivCCG &subdiv_ccg,
                                      Vector<Vector<SubdivCCGCoord>> &neighbors,
                                      const MutableSpan<float3> translations)
 {
-  const Span<CCGElem *> elems = subdiv_ccg.grids;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
 
   const int grid_verts_num = grids.size() * key.grid_area;
@@ -590,7 +587,6 @@ void calc_relaxed_translations_grids(const SubdivCCG &subdiv_ccg,
   calc_vert_neighbors_interior(faces, corner_verts, boundary_verts, subdiv_ccg, grids, neighbors);
 
   for (const int i : grids.index_range()) {
-    CCGElem *elem = elems[grids[i]];
     const int node_start = i * key.grid_area;
     for (const int y : IndexRange(key.grid_size)) {
       for (const int x : IndexRange(key.grid_size)) {
@@ -635,20 +631,20 @@ void calc_relaxed_translations_grids(const SubdivCCG &subdiv_ccg,
         }
 
         const float3 smoothed_position = average_positions(
-            key, elems, positions, neighbors[node_vert], grids[i], node_start);
+            subdiv_ccg, key, positions, neighbors[node_vert], grids[i], node_start);
 
         /* Normal Calculation */
         float3 normal;
         if (is_boundary && neighbors[i].size() == 2) {
           normal = calc_boundary_normal_corner(
-              key, elems, positions[node_vert], neighbors[node_vert]);
+              key, subdiv_ccg.positions, positions[node_vert], neighbors[node_vert]);
           if (math::is_zero(normal)) {
             translations[node_vert] = float3(0);
             continue;
           }
         }
         else {
-          normal = CCG_elem_offset_no(key, elem, offset);
+          normal = subdiv_ccg.normals[coord.to_index(key)];
         }
 
         const float3 translation = translation_to_plane(
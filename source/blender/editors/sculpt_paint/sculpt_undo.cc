@@ -32,11 +32,22 @@
 #include "sculpt_undo.hh"
 
 #include <cstddef>
+#include <fcntl.h>
+#include <zstd.h>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_fileops.h"
+#include "BLI_hash_mm2a.hh"
 #include "BLI_listbase.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -44,7 +55,9 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
+#include "BKE_appdir.hh"
 #include "BKE_attribute.hh"
 #include "BKE_ccg.hh"
 #include "BKE_context.hh"
@@ -76,6 +89,7 @@
 #include "ED_undo.hh"
 
 #include "bmesh.hh"
+#include "mesh_brush_common.hh"
 #include "paint_hide.hh"
 #include "paint_intern.hh"
 #include "sculpt_color.hh"
@@ -292,7 +306,7 @@ static bool topology_matches(const StepData &step_data, const Object &object)
   const SculptSession &ss = *object.sculpt;
   if (use_multires_undo(step_data, ss)) {
     const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-    return subdiv_ccg.grids.size() == step_data.mesh_grids_num &&
+    return subdiv_ccg.grids_num == step_data.mesh_grids_num &&
            subdiv_ccg.grid_size == step_data.grid_size;
   }
   Mesh &mesh = *static_cast<Mesh *>(object.data);
@@ -421,7 +435,7 @@ static void restore_position_mesh(Object &object,
   }
 }
 
-static void restore_position_grids(MutableSpan<CCGElem *> grids,
+static void restore_position_grids(MutableSpan<float3> positions,
                                    const CCGKey &key,
                                    Node &unode,
                                    MutableSpan<bool> modified_grids)
@@ -431,9 +445,8 @@ static void restore_position_grids(MutableSpan<CCGElem *> grids,
 
   int index = 0;
   for (const int i : grid_indices.index_range()) {
-    CCGElem *grid = grids[grid_indices[i]];
-    for (const int j : IndexRange(key.grid_area)) {
-      std::swap(CCG_elem_offset_co(key, grid, j), position[index]);
+    for (const int vert : bke::ccg::grid_range(key, grid_indices[i])) {
+      std::swap(positions[vert], position[index]);
       index++;
     }
   }
@@ -558,13 +571,12 @@ static void restore_mask_grids(Object &object, Node &unode, MutableSpan<bool> mo
   const CCGKey key = BKE_subdiv_ccg_key_top_level(*subdiv_ccg);
 
   MutableSpan<float> mask = unode.mask;
-  MutableSpan<CCGElem *> grids = subdiv_ccg->grids;
+  MutableSpan<float> masks = subdiv_ccg->masks;
 
   int index = 0;
   for (const int grid : unode.grids) {
-    CCGElem *elem = grids[grid];
-    for (const int j : IndexRange(key.grid_area)) {
-      std::swap(CCG_elem_offset_mask(key, elem, j), mask[index]);
+    for (const int vert : bke::ccg::grid_range(key, grid)) {
+      std::swap(masks[vert], mask[index]);
       index++;
     }
   }
@@ -795,6 +807,543 @@ BMLogEntry *get_bmesh_log_entry()
   return get_step_data()->bm_entry;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Once an undo step is finished, the arrays of its nodes are encoded and compressed (see
+ * #NodeCompressedData). They are only decompressed while the step is restored. With the
+ * experimental "Sculpt Undo Disk Spill" option, the compressed data of steps far from the active
+ * step is moved to a temporary file, and read back when the step is restored.
+ * \{ */
+
+/** Low levels compress fast enough to not delay the end of strokes noticeably. */
+static constexpr int compression_level = 1;
+/** Number of steps before and after the active step whose data is never moved to disk. */
+static constexpr int spill_keep_steps_num = 4;
+
+static MutableSpan<uint32_t> node_array_words(Node &unode, const NodeArray array)
+{
+  switch (array) {
+    case NodeArray::VertIndices:
+      return unode.vert_indices.as_mutable_span().cast<uint32_t>();
+    case NodeArray::CornerIndices:
+      return unode.corner_indices.as_mutable_span().cast<uint32_t>();
+    case NodeArray::FaceIndices:
+      return MutableSpan<int>(unode.face_indices).cast<uint32_t>();
+    case NodeArray::Grids:
+      return unode.grids.as_mutable_span().cast<uint32_t>();
+    case NodeArray::Position:
+      return unode.position.as_mutable_span().cast<uint32_t>();
+    case NodeArray::OrigPosition:
+      return unode.orig_position.as_mutable_span().cast<uint32_t>();
+    case NodeArray::Color:
+      return unode.col.as_mutable_span().cast<uint32_t>();
+    case NodeArray::LoopColor:
+      return unode.loop_col.as_mutable_span().cast<uint32_t>();
+    case NodeArray::Mask:
+      return unode.mask.as_mutable_span().cast<uint32_t>();
+    case NodeArray::FaceSets:
+      return unode.face_sets.as_mutable_span().cast<uint32_t>();
+  }
+  BLI_assert_unreachable();
+  return {};
+}
+
+/**
+ * The part of an array used when the step is restored. For meshes, the values of the vertices
+ * owned by other nodes are only used for original data lookups while the step is created.
+ */
+static Span<uint32_t> node_array_restored_words(Node &unode, const NodeArray array)
+{
+  const Span<uint32_t> words = node_array_words(unode, array);
+  if (words.is_empty() || !unode.grids.is_empty()) {
+    return words;
+  }
+  switch (array) {
+    case NodeArray::Position:
+    case NodeArray::OrigPosition:
+      return words.take_front(unode.unique_verts_num * 3);
+    case NodeArray::Mask:
+      return words.take_front(unode.unique_verts_num);
+    default:
+      return words;
+  }
+}
+
+static void node_array_reinitialize(Node &unode, const NodeArray array, const int words_num)
+{
+  switch (array) {
+    case NodeArray::VertIndices:
+      unode.vert_indices.reinitialize(words_num);
+      break;
+    case NodeArray::CornerIndices:
+      unode.corner_indices.reinitialize(words_num);
+      break;
+    case NodeArray::FaceIndices:
+      unode.face_indices.resize(words_num);
+      break;
+    case NodeArray::Grids:
+      unode.grids.reinitialize(words_num);
+      break;
+    case NodeArray::Position:
+      unode.position.reinitialize(words_num / 3);
+      break;
+    case NodeArray::OrigPosition:
+      unode.orig_position.reinitialize(words_num / 3);
+      break;
+    case NodeArray::Color:
+      unode.col.reinitialize(words_num / 4);
+      break;
+    case NodeArray::LoopColor:
+      unode.loop_col.reinitialize(words_num / 4);
+      break;
+    case NodeArray::Mask:
+      unode.mask.reinitialize(words_num);
+      break;
+    case NodeArray::FaceSets:
+      unode.face_sets.reinitialize(words_num);
+      break;
+  }
+}
+
+static void node_arrays_free(Node &unode)
+{
+  unode.vert_indices = {};
+  unode.corner_indices = {};
+  unode.face_indices.clear_and_shrink();
+  unode.grids = {};
+  unode.position = {};
+  unode.orig_position = {};
+  unode.col = {};
+  unode.loop_col = {};
+  unode.mask = {};
+  unode.face_sets = {};
+}
+
+/**
+ * Gather the current values of the object corresponding to an array encoded with
+ * #ArrayEncoding::XorMesh. The indices of the node must already be available.
+ */
+static void gather_reference_words(const Object &object,
+                                   const Node &unode,
+                                   const NodeArray array,
+                                   MutableSpan<uint32_t> r_words)
+{
+  BLI_assert(unode.grids.is_empty());
+  const Mesh &mesh = *static_cast<const Mesh *>(object.data);
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const Span<int> verts = unode.vert_indices.as_span().take_front(unode.unique_verts_num);
+  switch (array) {
+    case NodeArray::Position:
+      array_utils::gather(mesh.vert_positions(), verts, r_words.cast<float3>());
+      break;
+    case NodeArray::Mask:
+      array_utils::gather(
+          *attributes.lookup_or_default<float>(".sculpt_mask", bke::AttrDomain::Point, 0.0f),
+          verts,
+          r_words.cast<float>());
+      break;
+    case NodeArray::FaceSets:
+      array_utils::gather(
+          *attributes.lookup_or_default<int>(".sculpt_face_set", bke::AttrDomain::Face, 1),
+          unode.face_indices.as_span(),
+          r_words.cast<int>());
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+static uint32_t words_hash(const Span<uint32_t> words)
+{
+  return BLI_hash_mm2(reinterpret_cast<const uchar *>(words.data()), words.size_in_bytes(), 0);
+}
+
+static ArrayEncoding choose_encoding(const Object &object,
+                                     const StepData &step_data,
+                                     const Node &unode,
+                                     const NodeArray array)
+{
+  const SculptSession &ss = *object.sculpt;
+  switch (array) {
+    case NodeArray::VertIndices:
+    case NodeArray::CornerIndices:
+    case NodeArray::FaceIndices:
+    case NodeArray::Grids:
+      return ArrayEncoding::Delta;
+    default:
+      break;
+  }
+  /* The nodes of geometry steps are never restored, and the grids may not match them anymore. */
+  if (step_data.type == Type::Geometry) {
+    return ArrayEncoding::Raw;
+  }
+  /* Grids are recreated when the subdivision is refined, there is no stable reference. */
+  if (!unode.grids.is_empty()) {
+    return ArrayEncoding::Raw;
+  }
+  switch (array) {
+    case NodeArray::Position:
+      /* Deformed and shape key positions are not swapped with the mesh positions. */
+      if (!unode.orig_position.is_empty() || ss.shapekey_active) {
+        return ArrayEncoding::Raw;
+      }
+      return ArrayEncoding::XorMesh;
+    case NodeArray::Mask:
+    case NodeArray::FaceSets:
+      return ArrayEncoding::XorMesh;
+    default:
+      return ArrayEncoding::Raw;
+  }
+}
+
+/** Group the bytes of the words by significance, which makes them compress much better. */
+static void byte_shuffle(const Span<uint32_t> words, MutableSpan<std::byte> r_bytes)
+{
+  const int64_t words_num = words.size();
+  for (const int64_t i : words.index_range()) {
+    for (const int byte : IndexRange(4)) {
+      r_bytes[byte * words_num + i] = std::byte((words[i] >> (byte * 8)) & 0xff);
+    }
+  }
+}
+
+static void byte_unshuffle(const Span<std::byte> bytes, MutableSpan<uint32_t> r_words)
+{
+  const int64_t words_num = r_words.size();
+  for (const int64_t i : r_words.index_range()) {
+    uint32_t word = 0;
+    for (const int byte : IndexRange(4)) {
+      word |= uint32_t(bytes[byte * words_num + i]) << (byte * 8);
+    }
+    r_words[i] = word;
+  }
+}
+
+static void compress_node(const Object &object, const StepData &step_data, Node &unode)
+{
+  NodeCompressedData compressed;
+  int64_t words_num = 0;
+  for (const int i : IndexRange(node_arrays_num)) {
+    compressed.sizes[i] = node_array_restored_words(unode, NodeArray(i)).size();
+    words_num += compressed.sizes[i];
+  }
+  if (words_num == 0) {
+    return;
+  }
+
+  Array<uint32_t> words(words_num);
+  int64_t offset = 0;
+  for (const int i : IndexRange(node_arrays_num)) {
+    const NodeArray array = NodeArray(i);
+    const Span<uint32_t> src = node_array_restored_words(unode, array);
+    MutableSpan<uint32_t> dst = words.as_mutable_span().slice(offset, src.size());
+    offset += src.size();
+    if (src.is_empty()) {
+      continue;
+    }
+    compressed.encodings[i] = choose_encoding(object, step_data, unode, array);
+    switch (compressed.encodings[i]) {
+      case ArrayEncoding::Raw:
+        dst.copy_from(src);
+        break;
+      case ArrayEncoding::Delta:
+        dst[0] = src[0];
+        for (const int64_t j : src.index_range().drop_front(1)) {
+          dst[j] = src[j] - src[j - 1];
+        }
+        break;
+      case ArrayEncoding::XorMesh:
+        gather_reference_words(object, unode, array, dst);
+        compressed.reference_hashes[i] = words_hash(dst);
+        for (const int64_t j : src.index_range()) {
+          dst[j] ^= src[j];
+        }
+        break;
+    }
+  }
+
+  Array<std::byte> shuffled(words.as_span().size_in_bytes());
+  byte_shuffle(words, shuffled);
+  words = {};
+
+  Array<std::byte> buffer(ZSTD_compressBound(shuffled.size()));
+  const size_t size = ZSTD_compress(
+      buffer.data(), buffer.size(), shuffled.data(), shuffled.size(), compression_level);
+  if (ZSTD_isError(size)) {
+    /* Keep the uncompressed arrays. */
+    return;
+  }
+  compressed.data = Array<std::byte, 0>(buffer.as_span().take_front(size));
+
+  node_arrays_free(unode);
+  unode.compressed = std::move(compressed);
+}
+
+static bool decompress_node(const Object &object, Node &unode)
+{
+  NodeCompressedData &compressed = *unode.compressed;
+  int64_t words_num = 0;
+  for (const int size : compressed.sizes) {
+    words_num += size;
+  }
+
+  Array<std::byte> shuffled(words_num * sizeof(uint32_t), NoInitialization());
+  const size_t size = ZSTD_decompress(
+      shuffled.data(), shuffled.size(), compressed.data.data(), compressed.data.size());
+  if (ZSTD_isError(size) || size != shuffled.size()) {
+    return false;
+  }
+  Array<uint32_t> words(words_num, NoInitialization());
+  byte_unshuffle(shuffled, words);
+  shuffled = {};
+
+  /* Arrays are decoded in order, so the indices needed to gather the values used as reference
+   * for the XOR encoding are available before them. */
+  int64_t offset = 0;
+  for (const int i : IndexRange(node_arrays_num)) {
+    const NodeArray array = NodeArray(i);
+    const Span<uint32_t> src = words.as_span().slice(offset, compressed.sizes[i]);
+    offset += src.size();
+    node_array_reinitialize(unode, array, src.size());
+    if (src.is_empty()) {
+      continue;
+    }
+    MutableSpan<uint32_t> dst = node_array_words(unode, array);
+    switch (compressed.encodings[i]) {
+      case ArrayEncoding::Raw:
+        dst.copy_from(src);
+        break;
+      case ArrayEncoding::Delta:
+        dst[0] = src[0];
+        for (const int64_t j : src.index_range().drop_front(1)) {
+          dst[j] = dst[j - 1] + src[j];
+        }
+        break;
+      case ArrayEncoding::XorMesh:
+        gather_reference_words(object, unode, array, dst);
+        if (words_hash(dst) != compressed.reference_hashes[i]) {
+          /* The mesh was changed outside of sculpt undo, the values can't be decoded. */
+          return false;
+        }
+        for (const int64_t j : src.index_range()) {
+          dst[j] ^= src[j];
+        }
+        compressed.restored_reference_hashes[i] = words_hash(dst);
+        break;
+    }
+  }
+  return true;
+}
+
+struct SpillFile {
+  std::mutex mutex;
+  int file = -1;
+  char filepath[FILE_MAX];
+  int64_t size = 0;
+  /** Number of blocks of node data stored in the file, it's removed when there are none. */
+  int64_t blocks_num = 0;
+  /** Released ranges before the end of the file, sorted and never adjacent to each other. */
+  Vector<IndexRange> free_ranges;
+};
+
+static SpillFile &spill_file()
+{
+  static SpillFile spill;
+  return spill;
+}
+
+static bool spill_write(NodeCompressedData &compressed)
+{
+  SpillFile &spill = spill_file();
+  std::scoped_lock lock(spill.mutex);
+  if (spill.file == -1) {
+    BLI_path_join(
+        spill.filepath, sizeof(spill.filepath), BKE_tempdir_session(), "sculpt_undo.bin");
+    spill.file = BLI_open(spill.filepath, O_BINARY | O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (spill.file == -1) {
+      return false;
+    }
+    spill.size = 0;
+  }
+  const int64_t size = compressed.data.size();
+  /* Reuse the first released range that is large enough, to avoid growing the file forever. */
+  int free_index = -1;
+  for (const int i : spill.free_ranges.index_range()) {
+    if (spill.free_ranges[i].size() >= size) {
+      free_index = i;
+      break;
+    }
+  }
+  const int64_t offset = free_index == -1 ? spill.size : spill.free_ranges[free_index].start();
+  if (BLI_lseek(spill.file, offset, SEEK_SET) == -1) {
+    return false;
+  }
+  if (::write(spill.file, compressed.data.data(), size) != size) {
+    return false;
+  }
+  if (free_index == -1) {
+    spill.size += size;
+  }
+  else if (spill.free_ranges[free_index].size() == size) {
+    spill.free_ranges.remove(free_index);
+  }
+  else {
+    spill.free_ranges[free_index] = spill.free_ranges[free_index].drop_front(size);
+  }
+  compressed.spill_offset = offset;
+  compressed.spill_size = size;
+  spill.blocks_num++;
+  return true;
+}
+
+static bool spill_read(NodeCompressedData &compressed)
+{
+  SpillFile &spill = spill_file();
+  std::scoped_lock lock(spill.mutex);
+  if (spill.file == -1 || BLI_lseek(spill.file, compressed.spill_offset, SEEK_SET) == -1) {
+    return false;
+  }
+  Array<std::byte, 0> data(compressed.spill_size, NoInitialization());
+  if (BLI_read(spill.file, data.data(), data.size()) != data.size()) {
+    return false;
+  }
+  compressed.data = std::move(data);
+  return true;
+}
+
+/** Add a range to the free ranges of the file, merging it with its neighbors. */
+static void spill_free_range_add(SpillFile &spill, IndexRange range)
+{
+  Vector<IndexRange> &ranges = spill.free_ranges;
+  int index = 0;
+  while (index < ranges.size() && ranges[index].start() < range.start()) {
+    index++;
+  }
+  if (index < ranges.size() && ranges[index].start() == range.one_after_last()) {
+    range = IndexRange::from_begin_end(range.start(), ranges[index].one_after_last());
+    ranges.remove(index);
+  }
+  if (index > 0 && ranges[index - 1].one_after_last() == range.start()) {
+    range = IndexRange::from_begin_end(ranges[index - 1].start(), range.one_after_last());
+    ranges.remove(index - 1);
+    index--;
+  }
+  if (range.one_after_last() == spill.size) {
+    /* Shrink the used part of the file instead, the next writes append at its end. */
+    spill.size = range.start();
+    return;
+  }
+  ranges.insert(index, range);
+}
+
+static void spill_release(NodeCompressedData &compressed)
+{
+  if (compressed.spill_offset < 0) {
+    return;
+  }
+  const IndexRange range(compressed.spill_offset, compressed.spill_size);
+  compressed.spill_offset = -1;
+  compressed.spill_size = 0;
+
+  SpillFile &spill = spill_file();
+  std::scoped_lock lock(spill.mutex);
+  spill.blocks_num--;
+  if (spill.blocks_num == 0) {
+    close(spill.file);
+    BLI_delete(spill.filepath, false, false);
+    spill.file = -1;
+    spill.size = 0;
+    spill.free_ranges.clear();
+    return;
+  }
+  spill_free_range_add(spill, range);
+}
+
+/**
+ * Restoring a step swaps the values of its nodes with the mesh, so the XOR of both stays the same
+ * and the compressed data can be kept. Other arrays change and have to be compressed again.
+ */
+static void finish_node_restore(const Object &object, const StepData &step_data, Node &unode)
+{
+  NodeCompressedData &compressed = *unode.compressed;
+  bool values_changed = false;
+  for (const int i : IndexRange(node_arrays_num)) {
+    if (compressed.sizes[i] > 0 && compressed.encodings[i] == ArrayEncoding::Raw) {
+      values_changed = true;
+    }
+  }
+  if (!values_changed) {
+    compressed.reference_hashes = compressed.restored_reference_hashes;
+    node_arrays_free(unode);
+    return;
+  }
+  spill_release(compressed);
+  unode.compressed.reset();
+  compress_node(object, step_data, unode);
+}
+
+/**
+ * Decompresses the nodes of a step for the duration of its restore, and compresses them again
+ * afterwards. Nodes stored on disk are read back first.
+ */
+class DecompressedNodes : NonCopyable, NonMovable {
+  const Object &object_;
+  StepData &step_data_;
+  bool is_valid_ = true;
+
+ public:
+  DecompressedNodes(const Object &object, StepData &step_data)
+      : object_(object), step_data_(step_data)
+  {
+    for (std::unique_ptr<Node> &unode : step_data.nodes) {
+      if (unode->compressed && unode->compressed->data.is_empty()) {
+        if (!spill_read(*unode->compressed)) {
+          is_valid_ = false;
+          return;
+        }
+      }
+    }
+    Array<bool> success(step_data.nodes.size(), true);
+    threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        Node &unode = *step_data.nodes[i];
+        if (unode.compressed) {
+          success[i] = decompress_node(object, unode);
+        }
+      }
+    });
+    is_valid_ = !success.as_span().contains(false);
+  }
+
+  ~DecompressedNodes()
+  {
+    threading::parallel_for(step_data_.nodes.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        Node &unode = *step_data_.nodes[i];
+        if (!unode.compressed) {
+          continue;
+        }
+        if (is_valid_) {
+          finish_node_restore(object_, step_data_, unode);
+        }
+        else {
+          node_arrays_free(unode);
+        }
+      }
+    });
+  }
+
+  /** False when the data of some nodes couldn't be read, the step must not be restored. */
+  bool is_valid() const
+  {
+    return is_valid_;
+  }
+};
+
+/** \} */
+
 /* Geometry updates (such as Apply Base, for example) will re-evaluate the object and refine its
  * Subdiv descriptor. Upon undo it is required that mesh, grids, and subdiv all stay consistent
  * with each other. This means that when geometry coordinate changes the undo should refine the
@@ -870,16 +1419,19 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       if (use_multires_undo(step_data, ss)) {
         MutableSpan<bke::pbvh::GridsNode> nodes = ss.pbvh->nodes<bke::pbvh::GridsNode>();
         SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-        MutableSpan<CCGElem *> grids = subdiv_ccg.grids;
         const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
 
-        Array<bool> modified_grids(grids.size(), false);
+        Array<bool> modified_grids(subdiv_ccg.grids_num, false);
         for (std::unique_ptr<Node> &unode : step_data.nodes) {
-          restore_position_grids(grids, key, *unode, modified_grids);
+          restore_position_grids(subdiv_ccg.positions, key, *unode, modified_grids);
         }
         node_mask.foreach_index([&](const int i) {
           const Span<int> grids = bke::pbvh::node_grid_indices(nodes[i]);
@@ -920,11 +1472,15 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       if (use_multires_undo(step_data, ss)) {
         MutableSpan<bke::pbvh::GridsNode> nodes = ss.pbvh->nodes<bke::pbvh::GridsNode>();
         SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-        Array<bool> modified_grids(subdiv_ccg.grids.size(), false);
+        Array<bool> modified_grids(subdiv_ccg.grids_num, false);
         for (std::unique_ptr<Node> &unode : step_data.nodes) {
           restore_vert_visibility_grids(subdiv_ccg, *unode, modified_grids);
         }
@@ -962,6 +1518,10 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       Array<bool> modified_faces(ss.totfaces, false);
       for (std::unique_ptr<Node> &unode : step_data.nodes) {
@@ -1007,10 +1567,14 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       if (use_multires_undo(step_data, ss)) {
         MutableSpan<bke::pbvh::GridsNode> nodes = ss.pbvh->nodes<bke::pbvh::GridsNode>();
-        Array<bool> modified_grids(ss.subdiv_ccg->grids.size(), false);
+        Array<bool> modified_grids(ss.subdiv_ccg->grids_num, false);
         for (std::unique_ptr<Node> &unode : step_data.nodes) {
           restore_mask_grids(object, *unode, modified_grids);
         }
@@ -1044,6 +1608,10 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       Array<bool> modified_faces(ss.totfaces, false);
       for (std::unique_ptr<Node> &unode : step_data.nodes) {
@@ -1085,6 +1653,10 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
       if (!topology_matches(step_data, object)) {
         return;
       }
+      const DecompressedNodes decompressed(object, step_data);
+      if (!decompressed.is_valid()) {
+        return;
+      }
 
       MutableSpan<bke::pbvh::MeshNode> nodes = ss.pbvh->nodes<bke::pbvh::MeshNode>();
       Array<bool> modified_verts(ss.totvert, false);
@@ -1126,6 +1698,11 @@ static void free_step_data(StepData &step_data)
   if (step_data.bm_entry) {
     BM_log_entry_drop(step_data.bm_entry);
   }
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    if (unode->compressed) {
+      spill_release(*unode->compressed);
+    }
+  }
   step_data.~StepData();
 }
 
@@ -1173,27 +1750,11 @@ static void store_coords(const Depsgraph &depsgraph, const Object &object, Node
 
   if (!unode.grids.is_empty()) {
     const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-    const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-    const Span<CCGElem *> grids = subdiv_ccg.grids;
-    {
-      int index = 0;
-      for (const int grid : unode.grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode.position[index] = CCG_elem_offset_co(key, elem, i);
-          index++;
-        }
-      }
-    }
-    if (key.has_normals) {
-      int index = 0;
-      for (const int grid : unode.grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode.normal[index] = CCG_elem_offset_no(key, elem, i);
-          index++;
-        }
-      }
+    gather_data_grids(
+        subdiv_ccg, subdiv_ccg.positions.as_span(), unode.grids, unode.position.as_mutable_span());
+    if (!subdiv_ccg.normals.is_empty()) {
+      gather_data_grids(
+          subdiv_ccg, subdiv_ccg.normals.as_span(), unode.grids, unode.normal.as_mutable_span());
     }
   }
   else {
@@ -1252,17 +1813,9 @@ static void store_mask(const Object &object, Node &unode)
 
   if (!unode.grids.is_empty()) {
     const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-    const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
-    if (key.has_mask) {
-      const Span<CCGElem *> grids = subdiv_ccg.grids;
-      int index = 0;
-      for (const int grid : unode.grids) {
-        CCGElem *elem = grids[grid];
-        for (const int i : IndexRange(key.grid_area)) {
-          unode.mask[index] = CCG_elem_offset_mask(key, elem, i);
-          index++;
-        }
-      }
+    if (!subdiv_ccg.masks.is_empty()) {
+      gather_data_grids(
+          subdiv_ccg, subdiv_ccg.masks.as_span(), unode.grids, unode.mask.as_mutable_span());
     }
     else {
       unode.mask.fill(0.0f);
@@ -1697,7 +2250,7 @@ void push_begin_ex(Object &ob, const char *name)
       break;
     }
     case bke::pbvh::Type::Grids: {
-      us->data.mesh_grids_num = ss.subdiv_ccg->grids.size();
+      us->data.mesh_grids_num = ss.subdiv_ccg->grids_num;
       us->data.grid_size = ss.subdiv_ccg->grid_size;
       break;
     }
@@ -1737,9 +2290,67 @@ static size_t node_size_in_bytes(const Node &node)
   size += node.grid_hidden.all_bits().size() / 8;
   size += node.face_sets.as_span().size_in_bytes();
   size += node.face_indices.as_span().size_in_bytes();
+  if (node.compressed) {
+    size += node.compressed->data.as_span().size_in_bytes();
+  }
   return size;
 }
 
+static size_t step_data_size_in_bytes(const StepData &step_data)
+{
+  return threading::parallel_reduce(
+      step_data.nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*step_data.nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+/**
+ * Move the compressed data of the sculpt steps far from the given step to the spill file. Steps
+ * whose data is already stored there only free their copy in memory.
+ */
+static void spill_distant_steps(UndoStack &ustack, const UndoStep *us_active)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_sculpt_undo_disk_spill)) {
+    return;
+  }
+  const int active_index = BLI_findindex(&ustack.steps, us_active);
+  if (active_index == -1) {
+    return;
+  }
+  int i;
+  LISTBASE_FOREACH_INDEX (UndoStep *, us_iter, &ustack.steps, i) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT ||
+        std::abs(i - active_index) <= spill_keep_steps_num)
+    {
+      continue;
+    }
+    StepData &step_data = reinterpret_cast<SculptUndoStep *>(us_iter)->data;
+    bool size_changed = false;
+    for (std::unique_ptr<Node> &unode : step_data.nodes) {
+      if (!unode->compressed || unode->compressed->data.is_empty()) {
+        continue;
+      }
+      NodeCompressedData &compressed = *unode->compressed;
+      if (compressed.spill_offset < 0 && !spill_write(compressed)) {
+        return;
+      }
+      compressed.data = {};
+      size_changed = true;
+    }
+    if (size_changed) {
+      step_data.undo_size = step_data_size_in_bytes(step_data);
+      us_iter->data_size = step_data.undo_size;
+    }
+  }
+}
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1756,23 +2367,20 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
     unode->normal = {};
   }
 
-  step_data->undo_size = threading::parallel_reduce(
-      step_data->nodes.index_range(),
-      16,
-      0,
-      [&](const IndexRange range, size_t size) {
-        for (const int i : range) {
-          size += node_size_in_bytes(*step_data->nodes[i]);
-        }
-        return size;
-      },
-      std::plus<size_t>());
+  threading::parallel_for(step_data->nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      compress_node(ob, *step_data, *step_data->nodes[i]);
+    }
+  });
+
+  step_data->undo_size = step_data_size_in_bytes(*step_data);
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
   if (wm->op_undo_depth == 0 || use_nested_undo) {
     UndoStack *ustack = ED_undo_stack_get();
     BKE_undosys_step_push(ustack, nullptr, nullptr);
+    spill_distant_steps(*ustack, ustack->step_active);
     if (wm->op_undo_depth == 0) {
       BKE_undosys_stack_limit_steps_and_memory_defaults(ustack);
     }
@@ -1871,6 +2479,9 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 
   restore_list(C, depsgraph, us->data);
   us->step.is_applied = false;
+  /* Nodes whose values changed are compressed again. */
+  us->data.undo_size = step_data_size_in_bytes(us->data);
+  us->step.data_size = us->data.undo_size;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
 }
@@ -1881,6 +2492,9 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 
   restore_list(C, depsgraph, us->data);
   us->step.is_applied = true;
+  /* Nodes whose values changed are compressed again. */
+  us->data.undo_size = step_data_size_in_bytes(us->data);
+  us->step.data_size = us->data.undo_size;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
 }
@@ -1989,6 +2603,8 @@ static void step_decode(
   else if (dir == STEP_REDO) {
     step_decode_redo(C, depsgraph, us);
   }
+
+  spill_distant_steps(*ED_undo_stack_get(), us_p);
 }
 
 static void step_free(UndoStep *us_p)
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
+#include <optional>
 
 #include "BLI_array.hh"
 #include "BLI_bit_group_vector.hh"
@@ -45,6 +47,59 @@ enum class Type : int8_t {
   Color,
 };
 
+/** Arrays of #Node stored in #NodeCompressedData, in the order they are stored in. */
+enum class NodeArray : int8_t {
+  VertIndices,
+  CornerIndices,
+  FaceIndices,
+  Grids,
+  Position,
+  OrigPosition,
+  Color,
+  LoopColor,
+  Mask,
+  FaceSets,
+};
+constexpr int node_arrays_num = int(NodeArray::FaceSets) + 1;
+
+/** How the values of a #Node array are transformed before they are compressed. */
+enum class ArrayEncoding : int8_t {
+  /** The values are stored as they are. */
+  Raw,
+  /** Difference with the previous value, for indices that mostly increase. */
+  Delta,
+  /** XOR with the corresponding values of the mesh, see #NodeCompressedData. */
+  XorMesh,
+};
+
+/**
+ * Compressed storage of the arrays of a #Node once its undo step is finished.
+ *
+ * Positions, masks and face sets of regular meshes are stored as the XOR of the values stored in
+ * the node with the current values of the mesh. When the step is undone the mesh contains the
+ * values after the step, and when it's redone it contains the values before it. Since restoring
+ * swaps the node and mesh values, the XOR stays the same for undo and redo, and unchanged values
+ * become zeros which compress very well. Multires grids are stored as they are, since they are
+ * rebuilt outside of the undo system (when the subdivision is refined for example).
+ *
+ * The mesh values can also be changed by operations that aren't sculpt undo steps, so a hash of
+ * the values used as reference is stored, and the step isn't restored when it doesn't match.
+ */
+struct NodeCompressedData {
+  /** Number of 32 bit words stored for every #NodeArray. */
+  std::array<int, node_arrays_num> sizes = {};
+  std::array<ArrayEncoding, node_arrays_num> encodings = {};
+  /** Hash of the mesh values used by #ArrayEncoding::XorMesh arrays when they were encoded. */
+  std::array<uint32_t, node_arrays_num> reference_hashes = {};
+  /** Hash of the decoded values, which are in the mesh once the step has been restored. */
+  std::array<uint32_t, node_arrays_num> restored_reference_hashes = {};
+  /** Byte shuffled and ZSTD compressed words, empty when the data is in the spill file. */
+  Array<std::byte, 0> data;
+  /** Location of the data in the spill file, negative when it isn't stored there. */
+  int64_t spill_offset = -1;
+  int64_t spill_size = 0;
+};
+
 struct Node {
   Array<float3, 0> position;
   Array<float3, 0> orig_position;
@@ -74,6 +129,12 @@ struct Node {
   Array<int, 0> face_sets;
 
   Vector<int> face_indices;
+
+  /**
+   * The arrays above once the undo step is finished. They are decompressed temporarily while the
+   * step is restored.
+   */
+  std::optional<NodeCompressedData> compressed;
 };
 
 /* Storage of geometry for the undo node.
@@ -8,6 +8,7 @@
  */
 
 #include "BLI_color.hh"
+#include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_system.h"
 #include "BLI_threads.h"
@@ -51,6 +52,7 @@
 #include "RNA_prototypes.hh"
 
 #include "ED_node.hh"
+#include "ED_screen.hh"
 #include "ED_space_api.hh"
 
 #include "WM_api.hh"
@@ -1704,6 +1706,44 @@ namespace blender::ed::space_node {
 
 /* ************** Generic drawing ************** */
 
+/**
+ * Remember the part of the viewer image that is visible in the backdrop, and compute the viewer
+ * again when parts that were not computed become visible, after panning or zooming out.
+ */
+static void node_backdrop_region_update(const bContext &C,
+                                        const ARegion &region,
+                                        SpaceNode &snode,
+                                        const ImBuf &ibuf,
+                                        const float x,
+                                        const float y)
+{
+  const float width = snode.zoom * ibuf.x;
+  const float height = snode.zoom * ibuf.y;
+  if (width <= 0.0f || height <= 0.0f) {
+    snode.runtime->backdrop_region.reset();
+    return;
+  }
+
+  rctf visible_region;
+  BLI_rctf_init(&visible_region,
+                -x / width,
+                (region.winx - x) / width,
+                -y / height,
+                (region.winy - y) / height);
+  rctf image_region;
+  BLI_rctf_init(&image_region, 0.0f, 1.0f, 0.0f, 1.0f);
+  BLI_rctf_isect(&visible_region, &image_region, &visible_region);
+  snode.runtime->backdrop_region = visible_region;
+
+  const std::optional<rctf> &computed_region = snode.nodetree->runtime->viewer_region;
+  if (computed_region && !BLI_rctf_is_empty(&visible_region) &&
+      !BLI_rctf_inside_rctf(&*computed_region, &visible_region))
+  {
+    snode.runtime->recalc_regular_compositing = true;
+    ED_area_tag_refresh(CTX_wm_area(&C));
+  }
+}
+
 void draw_nodespace_back_pix(const bContext &C,
                              ARegion &region,
                              SpaceNode &snode,
@@ -1753,6 +1793,8 @@ void draw_nodespace_back_pix(const bContext &C,
     const float x = (region.winx - snode.zoom * ibuf->x) / 2 + offset_x;
     const float y = (region.winy - snode.zoom * ibuf->y) / 2 + offset_y;
 
+    node_backdrop_region_update(C, region, snode, *ibuf, x, y);
+
     /** \note draw selected info on backdrop
      */
     if (snode.edittree) {
@@ -7,6 +7,7 @@
  */
 
 #include <algorithm>
+#include <optional>
 
 #include "MEM_guardedalloc.h"
 
@@ -29,6 +30,7 @@
 #include "BKE_scene.hh"
 #include "BKE_scene_runtime.hh"
 
+#include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 
@@ -91,6 +93,8 @@ struct CompoJob {
   ViewLayer *view_layer;
   bNodeTree *ntree;
   int recalc_flags;
+  /* Normalized region of the viewer to compute, or the whole viewer when unset. */
+  std::optional<rctf> viewer_region;
   /* Evaluated state/ */
   Depsgraph *compositor_depsgraph;
   bNodeTree *localtree;
@@ -177,6 +181,66 @@ static int compo_get_recalc_flags(const bContext *C)
   return recalc_flags;
 }
 
+/**
+ * Extra space computed around the visible viewer region relative to its size, so that small pans
+ * and zooms don't need to compute the viewer again.
+ */
+static constexpr float COMPO_VIEWER_REGION_MARGIN = 0.25f;
+
+/* Returns the region of the viewer visible in node editor backdrops, or nothing when the whole
+ * viewer is needed. */
+static std::optional<rctf> compo_get_viewer_region(const bContext *C)
+{
+  wmWindowManager *wm = CTX_wm_manager(C);
+  std::optional<rctf> viewer_region;
+
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+
+    LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+      if (area->spacetype == SPACE_IMAGE) {
+        const SpaceImage *sima = (const SpaceImage *)area->spacedata.first;
+        if (sima->image && sima->image->type == IMA_TYPE_COMPOSITE) {
+          return std::nullopt;
+        }
+      }
+      else if (area->spacetype == SPACE_NODE) {
+        const SpaceNode *snode = (const SpaceNode *)area->spacedata.first;
+        if (!(snode->flag & SNODE_BACKDRAW) || !ED_node_is_compositor(snode)) {
+          continue;
+        }
+        /* The backdrop was not drawn yet. */
+        if (!snode->runtime->backdrop_region) {
+          return std::nullopt;
+        }
+        if (BLI_rctf_is_empty(&*snode->runtime->backdrop_region)) {
+          continue;
+        }
+        if (viewer_region) {
+          BLI_rctf_union(&*viewer_region, &*snode->runtime->backdrop_region);
+        }
+        else {
+          viewer_region = snode->runtime->backdrop_region;
+        }
+      }
+    }
+  }
+
+  if (!viewer_region) {
+    return std::nullopt;
+  }
+  BLI_rctf_pad(&*viewer_region,
+               BLI_rctf_size_x(&*viewer_region) * COMPO_VIEWER_REGION_MARGIN,
+               BLI_rctf_size_y(&*viewer_region) * COMPO_VIEWER_REGION_MARGIN);
+  rctf image_region;
+  BLI_rctf_init(&image_region, 0.0f, 1.0f, 0.0f, 1.0f);
+  if (BLI_rctf_inside_rctf(&*viewer_region, &image_region)) {
+    return std::nullopt;
+  }
+  BLI_rctf_isect(&*viewer_region, &image_region, &*viewer_region);
+  return viewer_region;
+}
+
 /* Called by compositor, only to check job 'stop' value. */
 static bool compo_breakjob(void *cjv)
 {
@@ -252,6 +316,10 @@ static void compo_initjob(void *cjv)
 
   cj->localtree = bke::node_tree_localize(ntree_eval, nullptr);
 
+  /* Also store the region in the original tree, so the backdrop drawing knows what is computed. */
+  cj->localtree->runtime->viewer_region = cj->viewer_region;
+  cj->ntree->runtime->viewer_region = cj->viewer_region;
+
   if (cj->recalc_flags) {
     compo_tag_output_nodes(cj->localtree, cj->recalc_flags);
   }
@@ -410,6 +478,7 @@ void ED_node_composite_job(const bContext *C, bNodeTree *nodetree, Scene *scene_
   cj->view_layer = view_layer;
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
+  cj->viewer_region = compo_get_viewer_region(C);
 
   /* Set up job. */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "BLI_compute_context.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
@@ -95,6 +97,12 @@ struct SpaceNode_Runtime {
    */
   bool recalc_regular_compositing;
 
+  /**
+   * Normalized region of the compositor viewer image visible in the backdrop when it was last
+   * drawn, used to only compute the visible part of the viewer (see #bNodeTreeRuntime).
+   */
+  std::optional<rctf> backdrop_region;
+
   /** Temporary data for modal linking operator. */
   std::unique_ptr<bNodeLinkDrag> linkdrag;
 
@@ -812,7 +812,9 @@ static void seq_build_proxy(bContext *C, blender::Span<Sequence *> movie_strips)
     SEQ_proxy_set(seq, true);
     seq->strip->proxy->build_size_flags = seq_get_proxy_size_flags(C);
     seq->strip->proxy->build_flags |= SEQ_PROXY_SKIP_EXISTING;
-    SEQ_proxy_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, nullptr, &pj->queue, true);
+    ListBase queue = {nullptr, nullptr};
+    SEQ_proxy_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, nullptr, &queue, true);
+    ED_seq_proxy_job_queue_append(pj, &queue);
   }
 
   if (!WM_jobs_is_running(wm_job)) {
@@ -68,8 +68,10 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
       continue;
     }
 
+    ListBase queue = {nullptr, nullptr};
     bool success = SEQ_proxy_rebuild_context(
-        pj->main, pj->depsgraph, pj->scene, seq, file_list, &pj->queue, false);
+        pj->main, pj->depsgraph, pj->scene, seq, file_list, &queue, false);
+    ED_seq_proxy_job_queue_append(pj, &queue);
 
     if (!success && (seq->strip->proxy->build_flags & SEQ_PROXY_SKIP_EXISTING) != 0) {
       BKE_reportf(reports, RPT_WARNING, "Overwrite is not checked for %s, skipping", seq->name);
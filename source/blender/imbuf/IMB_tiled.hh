@@ -0,0 +1,193 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ *
+ * Tiled, multi-resolution access to large images.
+ *
+ * A #TiledImage splits an image into square tiles and a pyramid of levels, each level half the
+ * resolution of the previous one. Tiles of the lower resolution levels are computed on first
+ * access and kept in a cache with a memory limit, so drawing a zoomed out view of a huge image
+ * only touches the tiles of a small level instead of the whole full resolution buffer.
+ *
+ * The full resolution level is either an #ImBuf or a file. Tiles of RGBA float buffers point into
+ * the buffer, only byte buffers and float buffers with other channel counts are converted per
+ * tile. Files are never loaded as a whole: tiles are read on first access, using the tiles and
+ * mip-map levels stored in tiled EXR and TIFF files.
+ *
+ * Tile pixels are always scene linear, premultiplied RGBA floats.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_vector.hh"
+
+struct ImBuf;
+struct rcti;
+
+namespace blender::imbuf {
+
+struct TiledImageFile;
+
+/** Size of the tiles in pixels, the same as the tiles of the image partial update. */
+constexpr int TILED_IMAGE_TILE_SIZE = 256;
+
+struct TiledImageTile {
+  /** First pixel of the tile, either in #storage or in the full resolution image buffer. */
+  const float4 *pixels = nullptr;
+  /** Number of pixels between the start of two rows of #pixels. */
+  int64_t stride = 0;
+  /** Used size of the tile, smaller than the tile size for tiles at the right and top border. */
+  int2 size;
+  /** Pixels of tiles which are computed or converted, #TILED_IMAGE_TILE_SIZE pixels per row. */
+  Array<float4> storage;
+
+  const float4 &pixel(const int x, const int y) const
+  {
+    return pixels[y * stride + x];
+  }
+};
+
+struct TiledImageStats {
+  /** Number of tiles converted from the image buffer or read from the file. */
+  int64_t tiles_loaded = 0;
+  /** Number of tiles computed from the level below. */
+  int64_t tiles_computed = 0;
+  int64_t tiles_evicted = 0;
+  /** Memory used by the cached tiles, and its maximum since creation. */
+  int64_t memory_used = 0;
+  int64_t memory_peak = 0;
+  /** Time in seconds spent reading, converting and computing tiles. */
+  double load_time = 0.0;
+};
+
+class TiledImage {
+ public:
+  /** Default memory limit of the tile cache. */
+  static constexpr int64_t default_memory_limit = int64_t(512) * 1024 * 1024;
+
+ private:
+  struct TileKey {
+    int level;
+    int2 tile;
+
+    uint64_t hash() const
+    {
+      return get_default_hash(level, tile);
+    }
+    friend bool operator==(const TileKey &a, const TileKey &b)
+    {
+      return a.level == b.level && a.tile == b.tile;
+    }
+  };
+
+  struct CachedTile {
+    std::shared_ptr<const TiledImageTile> tile;
+    uint64_t last_used;
+  };
+
+  /** Source of the tiles, either an image buffer or a file. */
+  const ImBuf *ibuf_ = nullptr;
+  std::unique_ptr<TiledImageFile> file_;
+  /** Full resolution RGBA float pixels of #ibuf_, null when its pixels have to be converted. */
+  const float4 *float4_pixels_ = nullptr;
+  Vector<int2> level_sizes_;
+  /** Number of levels read from the source, the following levels are computed. */
+  int native_levels_num_ = 1;
+  int64_t memory_limit_;
+
+  mutable std::mutex mutex_;
+  Map<TileKey, CachedTile> tiles_;
+  uint64_t use_clock_ = 0;
+  TiledImageStats stats_;
+
+  TiledImage(const ImBuf *ibuf, int64_t memory_limit);
+  TiledImage(std::unique_ptr<TiledImageFile> file, int64_t memory_limit);
+
+ public:
+  ~TiledImage();
+
+  /**
+   * Tiled access to an existing image buffer. The buffer is not copied, it has to outlive the
+   * tiled image, its pixel buffers must not be reallocated and changes to its pixels have to be
+   * passed on with #tag_dirty. Byte buffers are converted to scene linear float per tile.
+   */
+  static std::unique_ptr<TiledImage> from_imbuf(const ImBuf *ibuf,
+                                                int64_t memory_limit = default_memory_limit);
+
+  /**
+   * Tiled access to an image file, without loading it. Tiles are read from the file when first
+   * accessed and converted to scene linear, so only the viewed tiles use memory. Mip-map levels
+   * stored in the file are used, the remaining levels are computed.
+   * Returns null when the file can't be opened.
+   */
+  static std::unique_ptr<TiledImage> from_file(const char *filepath,
+                                               int64_t memory_limit = default_memory_limit);
+
+  /** Number of levels, the last level fits in a single tile. */
+  int levels_num() const
+  {
+    return level_sizes_.size();
+  }
+
+  int2 size(int level = 0) const
+  {
+    return level_sizes_[level];
+  }
+
+  int2 tiles_num(int level) const
+  {
+    const int2 size = level_sizes_[level];
+    return (size + (TILED_IMAGE_TILE_SIZE - 1)) / TILED_IMAGE_TILE_SIZE;
+  }
+
+  /**
+   * Level to sample from when `texels_per_pixel` full resolution pixels map to a single pixel
+   * of the output, which is the most detailed level that isn't finer than the output.
+   */
+  int level_for_scale(float texels_per_pixel) const;
+
+  /**
+   * Get a tile, loading or computing it when it isn't cached. The tile stays valid as long as
+   * the returned pointer is kept, also when it gets evicted from the cache. Tiles pointing into
+   * the image buffer are valid as long as the buffer.
+   */
+  std::shared_ptr<const TiledImageTile> acquire_tile(int level, int2 tile);
+
+  /**
+   * Nearest sampling of the given level into a float RGBA buffer of `dst_size` pixels, with rows
+   * that are `dst_stride` pixels apart. Pixel (x, y) of `dst` samples the full resolution
+   * position `origin + (x, y) * step`, scaled to the level. Pixels that sample outside of the
+   * image are left unchanged.
+   */
+  void sample_nearest(int level,
+                      const float2 &origin,
+                      const float2 &step,
+                      const int2 &dst_size,
+                      float *dst,
+                      int dst_stride);
+
+  /**
+   * Remove the cached tiles of all levels which overlap the given full resolution region, after
+   * the pixels of the image buffer changed.
+   */
+  void tag_dirty(const rcti &region);
+
+  TiledImageStats stats() const;
+
+ private:
+  std::shared_ptr<const TiledImageTile> load_tile(int level, int2 tile);
+  std::shared_ptr<const TiledImageTile> compute_tile(int level, int2 tile);
+  void add_to_cache(const TileKey &key, std::shared_ptr<const TiledImageTile> tile);
+  void evict_tiles();
+};
+
+}  // namespace blender::imbuf
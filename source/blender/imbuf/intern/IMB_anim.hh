@@ -22,6 +22,7 @@ struct SwsContext;
 #endif
 
 struct IDProperty;
+struct ImBufAnimFrameCache;
 struct ImBufAnimIndex;
 
 struct ImBufAnim {
@@ -59,6 +60,9 @@ struct ImBufAnim {
   AVPacket *cur_packet;
 
   bool seek_before_decode;
+
+  /* Recently decoded frames, see #ImBufAnimFrameCache. */
+  ImBufAnimFrameCache *frame_cache;
 #endif
 
   char index_dir[768];
@@ -75,3 +79,9 @@ struct ImBufAnim {
 
   IDProperty *metadata;
 };
+
+/**
+ * Stop decoding frames ahead in the background, needed before changing state which the decoder
+ * uses, such as the time-code indices.
+ */
+void IMB_anim_decode_ahead_stop(ImBufAnim *anim);
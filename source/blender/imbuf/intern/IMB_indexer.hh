@@ -101,6 +101,11 @@ void IMB_free_indices(ImBufAnim *anim);
 
 ImBufAnim *IMB_anim_open_proxy(ImBufAnim *anim, IMB_Proxy_Size preview_size);
 ImBufAnimIndex *IMB_anim_open_index(ImBufAnim *anim, IMB_Timecode_Type tc);
+/**
+ * Same as #IMB_anim_open_index, for callers which don't hold the frame cache lock of the movie.
+ * Frames decoded ahead in the background open the index lazily with that lock held.
+ */
+ImBufAnimIndex *IMB_anim_open_index_threadsafe(ImBufAnim *anim, IMB_Timecode_Type tc);
 
 int IMB_proxy_size_to_array_index(IMB_Proxy_Size pr_size);
 int IMB_timecode_to_array_index(IMB_Timecode_Type tc);
@@ -6,6 +6,8 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
@@ -21,10 +23,13 @@
 #include "BLI_math_base.hh"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -56,6 +61,8 @@ extern "C" {
 
 #ifdef WITH_FFMPEG
 static void free_anim_ffmpeg(ImBufAnim *anim);
+static ImBufAnimFrameCache *ffmpeg_frame_cache_create(const AVCodecContext *codec_ctx);
+static void ffmpeg_decode_ahead_stop(ImBufAnimFrameCache *cache);
 #endif
 
 void IMB_free_anim(ImBufAnim *anim)
@@ -92,6 +99,17 @@ void IMB_close_anim_proxies(ImBufAnim *anim)
   IMB_free_indices(anim);
 }
 
+void IMB_anim_decode_ahead_stop(ImBufAnim *anim)
+{
+#ifdef WITH_FFMPEG
+  if (anim->frame_cache) {
+    ffmpeg_decode_ahead_stop(anim->frame_cache);
+  }
+#else
+  UNUSED_VARS(anim);
+#endif
+}
+
 IDProperty *IMB_anim_load_metadata(ImBufAnim *anim)
 {
   if (anim->state == ImBufAnim::State::Valid) {
@@ -465,6 +483,8 @@ static int startffmpeg(ImBufAnim *anim)
     fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
   }
 
+  anim->frame_cache = ffmpeg_frame_cache_create(anim->pCodecCtx);
+
   return 0;
 }
 
@@ -841,6 +861,198 @@ static int64_t ffmpeg_get_pts_to_search(ImBufAnim *anim, ImBufAnimIndex *tc_inde
   return pts_to_search;
 }
 
+static ImBuf *ffmpeg_ibuf_alloc(ImBufAnim *anim)
+{
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
+
+  int planes = R_IMF_PLANES_RGBA;
+  if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
+    planes = R_IMF_PLANES_RGB;
+  }
+
+  ImBuf *ibuf = IMB_allocImBuf(anim->x, anim->y, planes, 0);
+
+  /* Allocate the storage explicitly to ensure the memory is aligned. */
+  const size_t align = av_cpu_max_align();
+  uint8_t *buffer_data = static_cast<uint8_t *>(
+      MEM_mallocN_aligned(size_t(4) * anim->x * anim->y, align, "ffmpeg ibuf"));
+  IMB_assign_byte_buffer(ibuf, buffer_data, IB_TAKE_OWNERSHIP);
+
+  ibuf->byte_buffer.colorspace = colormanage_colorspace_get_named(anim->colorspace);
+
+  return ibuf;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Decoded Frame Cache
+ *
+ * Seeking in long-GOP footage means decoding all frames from the previous key frame up to the
+ * requested one. When a frame is requested out of playback order, as happens when scrubbing or
+ * in reverse playback, the last frames decoded on the way are kept, so stepping backwards through
+ * a GOP does not seek and decode the GOP again for every frame. During forward playback the
+ * following frames are decoded ahead on a background thread.
+ *
+ * All movies, including proxies, share a memory budget which is a part of the memory cache limit
+ * of the preferences, also used by the sequencer cache.
+ *
+ * A cached frame is handed over to the caller when it is requested, the caller owns the returned
+ * image buffer like any other decoded frame.
+ * \{ */
+
+/* Upper limit of the number of frames kept per movie. */
+#  define FRAME_CACHE_MAX_FRAMES 64
+/* Part of the memory cache limit used by the cached frames of all movies. */
+#  define FRAME_CACHE_MEMORY_LIMIT_FACTOR 8
+/* Number of frames decoded ahead of the last requested one during forward playback. */
+#  define FRAME_CACHE_DECODE_AHEAD 8
+
+/* Memory used by the cached frames of all movies. */
+static std::atomic<size_t> frame_cache_memory_used = 0;
+
+struct ImBufAnimCachedFrame {
+  int64_t pts_start;
+  int64_t pts_end;
+  ImBuf *ibuf;
+  size_t memory;
+};
+
+struct ImBufAnimFrameCache {
+  /* Guards the decoder state of the movie and the cached frames. */
+  ThreadMutex mutex;
+  /* Cached frames, oldest first. */
+  blender::Vector<ImBufAnimCachedFrame, FRAME_CACHE_MAX_FRAMES> frames;
+
+  /* Last requested frame, to detect forward playback. */
+  int last_position = -1;
+  IMB_Timecode_Type last_tc = IMB_TC_NONE;
+  /* Keep frames decoded while seeking to the requested one. Only done when frames are requested
+   * out of playback order and when the codec has frames which depend on other frames. */
+  bool store_scanned_frames = false;
+  bool is_intra_only = false;
+
+  TaskPool *decode_ahead_pool = nullptr;
+  bool decode_ahead_running = false;
+  bool decode_ahead_stop = false;
+  /* Last frame to decode ahead. */
+  int decode_ahead_end = -1;
+};
+
+static ImBufAnimFrameCache *ffmpeg_frame_cache_create(const AVCodecContext *codec_ctx)
+{
+  ImBufAnimFrameCache *cache = MEM_new<ImBufAnimFrameCache>(__func__);
+  BLI_mutex_init(&cache->mutex);
+  const AVCodecDescriptor *descriptor = avcodec_descriptor_get(codec_ctx->codec_id);
+  cache->is_intra_only = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+  return cache;
+}
+
+static size_t ffmpeg_frame_cache_memory_limit()
+{
+  return size_t(U.memcachelimit) * 1024 * 1024 / FRAME_CACHE_MEMORY_LIMIT_FACTOR;
+}
+
+/* Remove the frame at `index` from the cache, without freeing its image buffer. */
+static ImBuf *ffmpeg_frame_cache_remove(ImBufAnimFrameCache *cache, const int index)
+{
+  const ImBufAnimCachedFrame frame = cache->frames[index];
+  frame_cache_memory_used -= frame.memory;
+  cache->frames.remove(index);
+  return frame.ibuf;
+}
+
+static void ffmpeg_frame_cache_clear(ImBufAnimFrameCache *cache)
+{
+  while (!cache->frames.is_empty()) {
+    IMB_freeImBuf(ffmpeg_frame_cache_remove(cache, 0));
+  }
+}
+
+static void ffmpeg_frame_cache_free(ImBufAnimFrameCache *cache)
+{
+  ffmpeg_decode_ahead_stop(cache);
+  ffmpeg_frame_cache_clear(cache);
+  BLI_mutex_end(&cache->mutex);
+  MEM_delete(cache);
+}
+
+static size_t ffmpeg_frame_cache_frame_memory(const ImBufAnim *anim)
+{
+  return std::max(size_t(4) * anim->x * anim->y, size_t(1));
+}
+
+/* Number of frames of this movie that fit in the cache. */
+static int ffmpeg_frame_cache_capacity(const ImBufAnim *anim)
+{
+  const size_t frames_num = ffmpeg_frame_cache_memory_limit() /
+                            ffmpeg_frame_cache_frame_memory(anim);
+  return int(std::min(frames_num, size_t(FRAME_CACHE_MAX_FRAMES)));
+}
+
+/* Remove the frame that contains `pts_to_search` from the cache and return it. */
+static ImBuf *ffmpeg_frame_cache_pop(ImBufAnim *anim, int64_t pts_to_search)
+{
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  for (const int i : cache->frames.index_range()) {
+    const ImBufAnimCachedFrame &frame = cache->frames[i];
+    if (ffmpeg_pts_isect(frame.pts_start, frame.pts_end, pts_to_search)) {
+      final_frame_log(anim, frame.pts_start, frame.pts_end, "Cached");
+      return ffmpeg_frame_cache_remove(cache, i);
+    }
+  }
+  return nullptr;
+}
+
+/* Free cached frames which end before `pts`. */
+static void ffmpeg_frame_cache_remove_before(ImBufAnim *anim, int64_t pts)
+{
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  for (int i = cache->frames.size() - 1; i >= 0; i--) {
+    if (cache->frames[i].pts_end <= pts) {
+      IMB_freeImBuf(ffmpeg_frame_cache_remove(cache, i));
+    }
+  }
+}
+
+/* Convert a decoded frame and add it to the cache, removing the oldest frames of this movie to
+ * stay within the limits. Returns false when the frame does not fit in the memory budget. */
+static bool ffmpeg_frame_cache_store(ImBufAnim *anim, AVFrame *frame)
+{
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  const int64_t pts_start = av_get_pts_from_frame(frame);
+  const int64_t pts_end = pts_start + av_get_frame_duration_in_pts_units(frame);
+  for (const ImBufAnimCachedFrame &cached_frame : cache->frames) {
+    if (cached_frame.pts_start == pts_start) {
+      return true;
+    }
+  }
+
+  anim->x = anim->pCodecCtx->width;
+  anim->y = anim->pCodecCtx->height;
+
+  const size_t memory = ffmpeg_frame_cache_frame_memory(anim);
+  const size_t memory_limit = ffmpeg_frame_cache_memory_limit();
+  while (!cache->frames.is_empty() && (cache->frames.size() >= FRAME_CACHE_MAX_FRAMES ||
+                                       frame_cache_memory_used + memory > memory_limit))
+  {
+    IMB_freeImBuf(ffmpeg_frame_cache_remove(cache, 0));
+  }
+  /* Frames of other movies are not freed, they might still be needed by them. */
+  if (frame_cache_memory_used + memory > memory_limit) {
+    return false;
+  }
+
+  ImBuf *ibuf = ffmpeg_ibuf_alloc(anim);
+  ffmpeg_postprocess(anim, frame, ibuf);
+  frame_cache_memory_used += memory;
+  cache->frames.append({pts_start, pts_end, ibuf, memory});
+  return true;
+}
+
+/** \} */
+
 static bool ffmpeg_is_first_frame_decode(ImBufAnim *anim)
 {
   return anim->pFrame_complete == false;
@@ -864,11 +1076,22 @@ static void ffmpeg_decode_video_frame_scan(ImBufAnim *anim, int64_t pts_to_searc
   const int64_t start_gop_frame = anim->cur_key_frame_pts;
   bool decode_error = false;
 
+  /* Frames this close before the searched one are cached, they are likely to be requested next
+   * when stepping backwards. */
+  const int64_t cache_pts_range = int64_t(ffmpeg_frame_cache_capacity(anim) *
+                                          ffmpeg_steps_per_frame_get(anim));
+
   while (!decode_error && anim->cur_pts < pts_to_search) {
     ffmpeg_scan_log(anim, pts_to_search);
     ffmpeg_double_buffer_backup_frame_store(anim, pts_to_search);
     decode_error = ffmpeg_decode_video_frame(anim) < 1;
 
+    if (!decode_error && anim->frame_cache->store_scanned_frames &&
+        anim->cur_pts < pts_to_search && pts_to_search - anim->cur_pts <= cache_pts_range)
+    {
+      ffmpeg_frame_cache_store(anim, anim->pFrame);
+    }
+
     /* We should not get a new GOP keyframe while scanning if seeking is working as intended.
      * If this condition triggers, there may be and error in our seeking code.
      * NOTE: This seems to happen if DTS value is used for seeking in ffmpeg internally. There
@@ -1094,6 +1317,21 @@ static bool ffmpeg_must_seek(ImBufAnim *anim, int position)
   return must_seek;
 }
 
+/* Decode the frame at `position`, seeking to its key frame first when needed. */
+static void ffmpeg_decode_frame_at(ImBufAnim *anim,
+                                   int position,
+                                   ImBufAnimIndex *tc_index,
+                                   int64_t pts_to_search)
+{
+  if (ffmpeg_must_decode(anim, position)) {
+    if (ffmpeg_must_seek(anim, position)) {
+      ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
+    }
+
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  }
+}
+
 static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type tc)
 {
   if (anim == nullptr) {
@@ -1118,34 +1356,25 @@ static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type
          frame_rate,
          start_pts);
 
-  if (ffmpeg_must_decode(anim, position)) {
-    if (ffmpeg_must_seek(anim, position)) {
-      ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
-    }
-
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  /* The decoder state is left as is, it stays at the last decoded frame. */
+  ImBuf *cached_frame = ffmpeg_frame_cache_pop(anim, pts_to_search);
+  if (cached_frame) {
+    return cached_frame;
   }
 
+  /* Frames requested in playback order are decoded ahead, frames decoded on the way to the
+   * requested one are only needed when stepping backwards or scrubbing. */
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+  cache->store_scanned_frames = !cache->is_intra_only &&
+                                !(position == cache->last_position + 1 && tc == cache->last_tc);
+
+  ffmpeg_decode_frame_at(anim, position, tc_index, pts_to_search);
+
   /* Update resolution as it can change per-frame with WebM. See #100741 & #100081. */
   anim->x = anim->pCodecCtx->width;
   anim->y = anim->pCodecCtx->height;
 
-  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
-
-  int planes = R_IMF_PLANES_RGBA;
-  if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
-    planes = R_IMF_PLANES_RGB;
-  }
-
-  ImBuf *cur_frame_final = IMB_allocImBuf(anim->x, anim->y, planes, 0);
-
-  /* Allocate the storage explicitly to ensure the memory is aligned. */
-  const size_t align = av_cpu_max_align();
-  uint8_t *buffer_data = static_cast<uint8_t *>(
-      MEM_mallocN_aligned(size_t(4) * anim->x * anim->y, align, "ffmpeg ibuf"));
-  IMB_assign_byte_buffer(cur_frame_final, buffer_data, IB_TAKE_OWNERSHIP);
-
-  cur_frame_final->byte_buffer.colorspace = colormanage_colorspace_get_named(anim->colorspace);
+  ImBuf *cur_frame_final = ffmpeg_ibuf_alloc(anim);
 
   AVFrame *final_frame = ffmpeg_frame_by_pts_get(anim, pts_to_search);
   if (final_frame == nullptr) {
@@ -1165,12 +1394,116 @@ static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type
   return cur_frame_final;
 }
 
+/* Decode frames ahead of the last requested frame, until enough frames are cached or the
+ * foreground requests a frame which breaks forward playback. */
+static void ffmpeg_decode_ahead_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  ImBufAnim *anim = static_cast<ImBufAnim *>(BLI_task_pool_user_data(pool));
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  while (!BLI_task_pool_current_canceled(pool)) {
+    BLI_mutex_lock(&cache->mutex);
+
+    const int position = anim->cur_position + 1;
+    if (cache->decode_ahead_stop || position > cache->decode_ahead_end ||
+        position >= anim->duration_in_frames ||
+        cache->frames.size() >= ffmpeg_frame_cache_capacity(anim))
+    {
+      cache->decode_ahead_running = false;
+      BLI_mutex_unlock(&cache->mutex);
+      break;
+    }
+
+    ImBufAnimIndex *tc_index = IMB_anim_open_index(anim, cache->last_tc);
+    const int64_t pts_to_search = ffmpeg_get_pts_to_search(anim, tc_index, position);
+    ffmpeg_decode_frame_at(anim, position, tc_index, pts_to_search);
+
+    AVFrame *frame = ffmpeg_frame_by_pts_get(anim, pts_to_search);
+    if (frame == nullptr) {
+      /* Let the foreground deal with decoding problems. */
+      cache->decode_ahead_running = false;
+      BLI_mutex_unlock(&cache->mutex);
+      break;
+    }
+
+    const bool is_stored = ffmpeg_frame_cache_store(anim, frame);
+    anim->cur_position = position;
+    if (!is_stored) {
+      cache->decode_ahead_running = false;
+      BLI_mutex_unlock(&cache->mutex);
+      break;
+    }
+
+    BLI_mutex_unlock(&cache->mutex);
+  }
+}
+
+/* Start or extend decoding ahead of `position`. Must be called with the cache mutex locked. */
+static void ffmpeg_decode_ahead_start(ImBufAnim *anim, int position, IMB_Timecode_Type tc)
+{
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  /* Frames cached while stepping backwards are not needed for forward playback, make room for
+   * the frames decoded ahead. */
+  ImBufAnimIndex *tc_index = IMB_anim_open_index(anim, tc);
+  ffmpeg_frame_cache_remove_before(anim, ffmpeg_get_pts_to_search(anim, tc_index, position));
+
+  cache->decode_ahead_stop = false;
+  cache->decode_ahead_end = position + FRAME_CACHE_DECODE_AHEAD;
+  if (cache->decode_ahead_running) {
+    return;
+  }
+
+  if (cache->decode_ahead_pool == nullptr) {
+    cache->decode_ahead_pool = BLI_task_pool_create_background(anim, TASK_PRIORITY_LOW);
+  }
+  cache->decode_ahead_running = true;
+  BLI_task_pool_push(cache->decode_ahead_pool, ffmpeg_decode_ahead_task, nullptr, false, nullptr);
+}
+
+/* Stop decoding ahead and wait for the background task. Must be called without holding the cache
+ * mutex. */
+static void ffmpeg_decode_ahead_stop(ImBufAnimFrameCache *cache)
+{
+  if (cache->decode_ahead_pool == nullptr) {
+    return;
+  }
+
+  BLI_task_pool_cancel(cache->decode_ahead_pool);
+  BLI_task_pool_free(cache->decode_ahead_pool);
+  cache->decode_ahead_pool = nullptr;
+  cache->decode_ahead_running = false;
+}
+
+/* Decode ahead during forward playback, stop as soon as any other frame is requested.
+ * Must be called with the cache mutex locked. */
+static void ffmpeg_decode_ahead_update(ImBufAnim *anim, int position, IMB_Timecode_Type tc)
+{
+  ImBufAnimFrameCache *cache = anim->frame_cache;
+
+  const bool is_forward_playback = position == cache->last_position + 1 && tc == cache->last_tc;
+  cache->last_position = position;
+  cache->last_tc = tc;
+
+  if (is_forward_playback) {
+    ffmpeg_decode_ahead_start(anim, position, tc);
+  }
+  else {
+    cache->decode_ahead_stop = true;
+  }
+}
+
 static void free_anim_ffmpeg(ImBufAnim *anim)
 {
   if (anim == nullptr) {
     return;
   }
 
+  if (anim->frame_cache) {
+    ffmpeg_frame_cache_free(anim->frame_cache);
+    anim->frame_cache = nullptr;
+  }
+
   if (anim->pCodecCtx) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1249,6 +1582,19 @@ ImBuf *IMB_anim_previewframe(ImBufAnim *anim)
   return ibuf;
 }
 
+ImBufAnimIndex *IMB_anim_open_index_threadsafe(ImBufAnim *anim, IMB_Timecode_Type tc)
+{
+#ifdef WITH_FFMPEG
+  if (anim->frame_cache) {
+    BLI_mutex_lock(&anim->frame_cache->mutex);
+    ImBufAnimIndex *index = IMB_anim_open_index(anim, tc);
+    BLI_mutex_unlock(&anim->frame_cache->mutex);
+    return index;
+  }
+#endif
+  return IMB_anim_open_index(anim, tc);
+}
+
 ImBuf *IMB_anim_absolute(ImBufAnim *anim,
                          int position,
                          IMB_Timecode_Type tc,
@@ -1285,15 +1631,15 @@ ImBuf *IMB_anim_absolute(ImBufAnim *anim,
 
 #ifdef WITH_FFMPEG
   if (anim->state == ImBufAnim::State::Valid) {
+    BLI_mutex_lock(&anim->frame_cache->mutex);
     ibuf = ffmpeg_fetchibuf(anim, position, tc);
-    if (ibuf) {
-      anim->cur_position = position;
-    }
+    ffmpeg_decode_ahead_update(anim, position, tc);
+    BLI_mutex_unlock(&anim->frame_cache->mutex);
   }
 #endif
 
   if (ibuf) {
-    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, anim->cur_position + 1);
+    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, position + 1);
   }
   return ibuf;
 }
@@ -1307,7 +1653,7 @@ int IMB_anim_get_duration(ImBufAnim *anim, IMB_Timecode_Type tc)
     return anim->duration_in_frames;
   }
 
-  idx = IMB_anim_open_index(anim, tc);
+  idx = IMB_anim_open_index_threadsafe(anim, tc);
   if (!idx) {
     return anim->duration_in_frames;
   }
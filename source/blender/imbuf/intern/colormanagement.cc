@@ -11,6 +11,8 @@
 
 #include <cmath>
 #include <cstring>
+#include <memory>
+#include <string>
 
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
@@ -28,14 +30,20 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
 #include "BLI_math_color.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BKE_appdir.hh"
 #include "BKE_colortools.hh"
@@ -96,12 +104,18 @@ float imbuf_aces_to_scene_linear[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+struct ColormanageBakedLUT;
+
 struct ColormanageProcessor {
-  OCIO_ConstCPUProcessorRcPtr *cpu_processor;
-  CurveMapping *curve_mapping;
-  bool is_data_result;
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = nullptr;
+  CurveMapping *curve_mapping = nullptr;
+  bool is_data_result = false;
+  /* Approximation of the CPU processor, applied instead of it when set. */
+  std::shared_ptr<const ColormanageBakedLUT> baked_lut;
 };
 
+static void display_lut_cache_free();
+
 static struct global_gpu_state {
   /* GPU shader currently bound. */
   bool gpu_shader_bound;
@@ -613,6 +627,8 @@ static void colormanage_free_config()
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  display_lut_cache_free();
+
   /* free color spaces */
   colorspace = static_cast<ColorSpace *>(global_colorspaces.first);
   while (colorspace) {
@@ -3965,6 +3981,311 @@ void IMB_partial_display_buffer_update_delayed(ImBuf *ibuf, int xmin, int ymin,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Baked Display Transform
+ *
+ * Evaluating the OCIO processor for every pixel is expensive for complex view transforms such as
+ * AgX or ACES. The display transform can instead be baked into a 3D lookup table and applied with
+ * tetrahedral interpolation, which is much faster at the cost of small errors. The table is
+ * indexed through a logarithmic shaper, because scene linear input is not limited to 0..1.
+ *
+ * Baked tables are shared between processors with the same settings, so changing frames during
+ * playback does not bake again.
+ * \{ */
+
+/* Number of entries along each axis of the table. */
+#define DISPLAY_LUT_SIZE 65
+/* Range of the shaper in stops, inputs outside of it are clamped. */
+#define DISPLAY_LUT_SHAPER_MIN_STOP -12.0f
+#define DISPLAY_LUT_SHAPER_MAX_STOP 10.0f
+/* Number of tables kept for reuse. */
+#define DISPLAY_LUT_CACHE_SIZE 4
+/* Number of samples used to estimate the error of a baked table. */
+#define DISPLAY_LUT_ERROR_SAMPLES 4096
+
+struct ColormanageBakedLUT {
+  /* Settings the table was baked for. */
+  std::string look;
+  std::string view_transform;
+  std::string display_device;
+  float exposure;
+  float gamma;
+  float temperature;
+  float tint;
+  bool use_white_balance;
+
+  /* Display values, red varies fastest. */
+  blender::Array<blender::float3> table;
+
+  /* Difference to the exact transform, estimated when baking. */
+  float max_error;
+  float mean_error;
+};
+
+static ThreadMutex display_lut_cache_lock = BLI_MUTEX_INITIALIZER;
+/* Baked tables, least recently used first. */
+static blender::Vector<std::shared_ptr<const ColormanageBakedLUT>> display_lut_cache;
+
+BLI_INLINE float display_lut_shaper(const float value)
+{
+  const float min_value = exp2f(DISPLAY_LUT_SHAPER_MIN_STOP);
+  const float stop = log2f(max_ff(value, 0.0f) + min_value);
+  return clamp_f((stop - DISPLAY_LUT_SHAPER_MIN_STOP) /
+                     (DISPLAY_LUT_SHAPER_MAX_STOP - DISPLAY_LUT_SHAPER_MIN_STOP),
+                 0.0f,
+                 1.0f);
+}
+
+static float display_lut_shaper_inverse(const float shaped)
+{
+  const float stop = DISPLAY_LUT_SHAPER_MIN_STOP +
+                     shaped * (DISPLAY_LUT_SHAPER_MAX_STOP - DISPLAY_LUT_SHAPER_MIN_STOP);
+  return exp2f(stop) - exp2f(DISPLAY_LUT_SHAPER_MIN_STOP);
+}
+
+static blender::float3 display_lut_evaluate(const ColormanageBakedLUT &lut,
+                                            const blender::float3 &rgb)
+{
+  using namespace blender;
+
+  const int size = DISPLAY_LUT_SIZE;
+  const float3 position = float3(display_lut_shaper(rgb.x),
+                                 display_lut_shaper(rgb.y),
+                                 display_lut_shaper(rgb.z)) *
+                          float(size - 1);
+  const int r = min_ii(int(position.x), size - 2);
+  const int g = min_ii(int(position.y), size - 2);
+  const int b = min_ii(int(position.z), size - 2);
+  const float3 f = position - float3(r, g, b);
+
+  const float3 *cell = &lut.table[(size_t(b) * size + g) * size + r];
+  const int step_r = 1;
+  const int step_g = size;
+  const int step_b = size * size;
+
+  const float3 &c000 = cell[0];
+  const float3 &c111 = cell[step_r + step_g + step_b];
+
+  /* Tetrahedral interpolation, pick the tetrahedron of the cell which contains the position. */
+  if (f.x > f.y) {
+    if (f.y > f.z) {
+      return c000 * (1.0f - f.x) + cell[step_r] * (f.x - f.y) + cell[step_r + step_g] * (f.y - f.z) +
+             c111 * f.z;
+    }
+    if (f.x > f.z) {
+      return c000 * (1.0f - f.x) + cell[step_r] * (f.x - f.z) + cell[step_r + step_b] * (f.z - f.y) +
+             c111 * f.y;
+    }
+    return c000 * (1.0f - f.z) + cell[step_b] * (f.z - f.x) + cell[step_r + step_b] * (f.x - f.y) +
+           c111 * f.y;
+  }
+  if (f.z > f.y) {
+    return c000 * (1.0f - f.z) + cell[step_b] * (f.z - f.y) + cell[step_g + step_b] * (f.y - f.x) +
+           c111 * f.x;
+  }
+  if (f.z > f.x) {
+    return c000 * (1.0f - f.y) + cell[step_g] * (f.y - f.z) + cell[step_g + step_b] * (f.z - f.x) +
+           c111 * f.x;
+  }
+  return c000 * (1.0f - f.y) + cell[step_g] * (f.y - f.x) + cell[step_r + step_g] * (f.x - f.z) +
+         c111 * f.z;
+}
+
+static void display_lut_apply_pixel(const ColormanageBakedLUT &lut,
+                                    float *pixel,
+                                    const int channels,
+                                    const bool predivide)
+{
+  using namespace blender;
+
+  const float alpha = (channels == 4) ? pixel[3] : 1.0f;
+  if (predivide && !ELEM(alpha, 0.0f, 1.0f)) {
+    const float3 rgb = display_lut_evaluate(lut, float3(pixel) / alpha) * alpha;
+    copy_v3_v3(pixel, rgb);
+  }
+  else {
+    copy_v3_v3(pixel, display_lut_evaluate(lut, float3(pixel)));
+  }
+}
+
+static void display_lut_apply(const ColormanageBakedLUT &lut,
+                              float *buffer,
+                              const int64_t pixels_num,
+                              const int channels,
+                              const bool predivide)
+{
+  for (int64_t i = 0; i < pixels_num; i++) {
+    display_lut_apply_pixel(lut, buffer + i * channels, channels, predivide);
+  }
+}
+
+/* Compare the table against the exact transform for random inputs, spread evenly in the shaper
+ * domain. */
+static void display_lut_estimate_error(ColormanageBakedLUT &lut,
+                                       OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  using namespace blender;
+
+  RandomNumberGenerator rng(0);
+  double error_sum = 0.0;
+  lut.max_error = 0.0f;
+
+  for (int i = 0; i < DISPLAY_LUT_ERROR_SAMPLES; i++) {
+    float3 exact = float3(display_lut_shaper_inverse(rng.get_float()),
+                          display_lut_shaper_inverse(rng.get_float()),
+                          display_lut_shaper_inverse(rng.get_float()));
+    const float3 approximation = display_lut_evaluate(lut, exact);
+    OCIO_cpuProcessorApplyRGB(cpu_processor, exact);
+
+    const float error = math::reduce_max(math::abs(exact - approximation));
+    lut.max_error = max_ff(lut.max_error, error);
+    error_sum += error;
+  }
+
+  lut.mean_error = float(error_sum / DISPLAY_LUT_ERROR_SAMPLES);
+}
+
+static std::shared_ptr<const ColormanageBakedLUT> display_lut_bake(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings,
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  using namespace blender;
+
+  const double start_time = BLI_time_now_seconds();
+
+  std::shared_ptr<ColormanageBakedLUT> lut = std::make_shared<ColormanageBakedLUT>();
+  lut->look = view_settings->look;
+  lut->view_transform = view_settings->view_transform;
+  lut->display_device = display_settings->display_device;
+  lut->exposure = view_settings->exposure;
+  lut->gamma = view_settings->gamma;
+  lut->temperature = view_settings->temperature;
+  lut->tint = view_settings->tint;
+  lut->use_white_balance = (view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE) != 0;
+
+  const int size = DISPLAY_LUT_SIZE;
+  lut->table.reinitialize(size * size * size);
+
+  float shaper_inverse[DISPLAY_LUT_SIZE];
+  for (const int i : IndexRange(size)) {
+    shaper_inverse[i] = display_lut_shaper_inverse(float(i) / (size - 1));
+  }
+
+  /* Each blue slice is a size by size image transformed by OCIO at once. */
+  threading::parallel_for(IndexRange(size), 1, [&](const IndexRange range) {
+    for (const int b : range) {
+      float3 *slice = &lut->table[size_t(b) * size * size];
+      for (const int g : IndexRange(size)) {
+        for (const int r : IndexRange(size)) {
+          slice[g * size + r] = float3(shaper_inverse[r], shaper_inverse[g], shaper_inverse[b]);
+        }
+      }
+
+      OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(reinterpret_cast<float *>(slice),
+                                                                  size,
+                                                                  size,
+                                                                  3,
+                                                                  sizeof(float),
+                                                                  sizeof(float3),
+                                                                  sizeof(float3) * size);
+      OCIO_cpuProcessorApply(cpu_processor, img);
+      OCIO_PackedImageDescRelease(img);
+    }
+  });
+
+  display_lut_estimate_error(*lut, cpu_processor);
+
+  if (G.debug & G_DEBUG) {
+    printf(
+        "Color management: Baked %dx%dx%d LUT for view \"%s\" on display \"%s\" in %.2f ms, "
+        "max error %f, mean error %f\n",
+        size,
+        size,
+        size,
+        lut->view_transform.c_str(),
+        lut->display_device.c_str(),
+        (BLI_time_now_seconds() - start_time) * 1000.0,
+        lut->max_error,
+        lut->mean_error);
+  }
+
+  return lut;
+}
+
+static bool display_lut_matches(const ColormanageBakedLUT &lut,
+                                const ColorManagedViewSettings *view_settings,
+                                const ColorManagedDisplaySettings *display_settings)
+{
+  return lut.look == view_settings->look && lut.view_transform == view_settings->view_transform &&
+         lut.display_device == display_settings->display_device &&
+         lut.exposure == view_settings->exposure && lut.gamma == view_settings->gamma &&
+         lut.temperature == view_settings->temperature && lut.tint == view_settings->tint &&
+         lut.use_white_balance ==
+             ((view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE) != 0);
+}
+
+/* Find the cached table for the given settings and move it to the end of the cache, as the most
+ * recently used one. Must be called with #display_lut_cache_lock locked. */
+static std::shared_ptr<const ColormanageBakedLUT> display_lut_cache_find(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  for (const int i : display_lut_cache.index_range()) {
+    if (display_lut_matches(*display_lut_cache[i], view_settings, display_settings)) {
+      std::shared_ptr<const ColormanageBakedLUT> lut = display_lut_cache[i];
+      display_lut_cache.remove(i);
+      display_lut_cache.append(lut);
+      return lut;
+    }
+  }
+  return nullptr;
+}
+
+/* Get the baked table for the given settings, baking it from the CPU processor created for the
+ * same settings if it is not cached yet. */
+static std::shared_ptr<const ColormanageBakedLUT> display_lut_ensure(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings,
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  BLI_mutex_lock(&display_lut_cache_lock);
+  std::shared_ptr<const ColormanageBakedLUT> lut = display_lut_cache_find(view_settings,
+                                                                          display_settings);
+  BLI_mutex_unlock(&display_lut_cache_lock);
+  if (lut) {
+    return lut;
+  }
+
+  /* Bake without holding the lock: baking runs a parallel loop, and this is called from tasks of
+   * other parallel loops, like the compositor previews. Threads that miss the cache at the same
+   * time may bake the same table, only the first one is kept. */
+  std::shared_ptr<const ColormanageBakedLUT> baked_lut = display_lut_bake(
+      view_settings, display_settings, cpu_processor);
+
+  BLI_mutex_lock(&display_lut_cache_lock);
+  lut = display_lut_cache_find(view_settings, display_settings);
+  if (!lut) {
+    if (display_lut_cache.size() >= DISPLAY_LUT_CACHE_SIZE) {
+      display_lut_cache.remove(0);
+    }
+    display_lut_cache.append(baked_lut);
+    lut = baked_lut;
+  }
+  BLI_mutex_unlock(&display_lut_cache_lock);
+
+  return lut;
+}
+
+static void display_lut_cache_free()
+{
+  BLI_mutex_lock(&display_lut_cache_lock);
+  display_lut_cache.clear_and_shrink();
+  BLI_mutex_unlock(&display_lut_cache_lock);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Pixel Processor Functions
  * \{ */
@@ -3978,7 +4299,7 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
   const ColorManagedViewSettings *applied_view_settings;
   ColorSpace *display_space;
 
-  cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
+  cm_processor = MEM_new<ColormanageProcessor>("colormanagement processor");
 
   if (view_settings) {
     applied_view_settings = view_settings;
@@ -4005,6 +4326,13 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
       use_white_balance,
       global_role_scene_linear);
 
+  if ((applied_view_settings->flag & COLORMANAGE_VIEW_USE_BAKED_LUT) &&
+      cm_processor->cpu_processor && !OCIO_cpuProcessorIsNoOp(cm_processor->cpu_processor))
+  {
+    cm_processor->baked_lut = display_lut_ensure(
+        applied_view_settings, display_settings, cm_processor->cpu_processor);
+  }
+
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
     BKE_curvemapping_premultiply(cm_processor->curve_mapping, false);
@@ -4018,7 +4346,7 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
 {
   ColormanageProcessor *cm_processor;
 
-  cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
+  cm_processor = MEM_new<ColormanageProcessor>("colormanagement processor");
   cm_processor->is_data_result = IMB_colormanagement_space_name_is_data(to_colorspace);
 
   OCIO_ConstProcessorRcPtr *processor = create_colorspace_transform_processor(from_colorspace,
@@ -4062,7 +4390,10 @@ void IMB_colormanagement_processor_apply_v4(ColormanageProcessor *cm_processor,
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->baked_lut) {
+    display_lut_apply_pixel(*cm_processor->baked_lut, pixel, 4, false);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGBA(cm_processor->cpu_processor, pixel);
   }
 }
@@ -4074,7 +4405,10 @@ void IMB_colormanagement_processor_apply_v4_predivide(ColormanageProcessor *cm_p
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->baked_lut) {
+    display_lut_apply_pixel(*cm_processor->baked_lut, pixel, 4, true);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGBA_predivide(cm_processor->cpu_processor, pixel);
   }
 }
@@ -4085,7 +4419,10 @@ void IMB_colormanagement_processor_apply_v3(ColormanageProcessor *cm_processor,
     BKE_curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
   }
 
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->baked_lut) {
+    display_lut_apply_pixel(*cm_processor->baked_lut, pixel, 3, false);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorApplyRGB(cm_processor->cpu_processor, pixel);
   }
 }
@@ -4131,7 +4468,11 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
     }
   }
 
-  if (cm_processor->cpu_processor && channels >= 3) {
+  if (cm_processor->baked_lut && channels >= 3) {
+    display_lut_apply(
+        *cm_processor->baked_lut, buffer, int64_t(width) * height, channels, predivide);
+  }
+  else if (cm_processor->cpu_processor && channels >= 3) {
     OCIO_PackedImageDesc *img;
 
     /* apply OCIO processor */
@@ -4181,7 +4522,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
-  MEM_freeN(cm_processor);
+  MEM_delete(cm_processor);
 }
 
 /* **** OpenGL drawing routines using GLSL for color space transform ***** */
@@ -19,6 +19,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
@@ -965,9 +966,14 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *c
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(in_frame);
 
-  for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
-  }
+  /* Every proxy size has its own scaler and encoder, scale and encode them in parallel from the
+   * same decoded frame. */
+  blender::threading::parallel_for(
+      blender::IndexRange(context->num_proxy_sizes), 1, [&](const blender::IndexRange range) {
+        for (const int64_t proxy_index : range) {
+          add_to_proxy_output_ffmpeg(context->proxy_ctx[proxy_index], in_frame);
+        }
+      });
 
   if (!context->start_pts_set) {
     context->start_pts = pts;
@@ -1328,6 +1334,8 @@ void IMB_free_indices(ImBufAnim *anim)
 {
   int i;
 
+  IMB_anim_decode_ahead_stop(anim);
+
   for (i = 0; i < IMB_PROXY_MAX_SLOT; i++) {
     if (anim->proxy_anim[i]) {
       IMB_close_anim(anim->proxy_anim[i]);
@@ -1416,7 +1424,7 @@ ImBufAnimIndex *IMB_anim_open_index(ImBufAnim *anim, IMB_Timecode_Type tc)
 
 int IMB_anim_index_get_frame_index(ImBufAnim *anim, IMB_Timecode_Type tc, int position)
 {
-  ImBufAnimIndex *idx = IMB_anim_open_index(anim, tc);
+  ImBufAnimIndex *idx = IMB_anim_open_index_threadsafe(anim, tc);
 
   if (!idx) {
     return position;
@@ -0,0 +1,496 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ */
+
+#include <algorithm>
+
+/* Include our own math header first to avoid warnings about M_PI
+ * redefinition between OpenImageIO and Windows headers. */
+#include "BLI_math_base.h"
+
+#include <OpenImageIO/imagecache.h>
+
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
+
+#include "IMB_colormanagement.hh"
+#include "IMB_colormanagement_intern.hh"
+#include "IMB_filter.hh"
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+#include "IMB_tiled.hh"
+
+namespace blender::imbuf {
+
+static constexpr int TILE_SIZE = TILED_IMAGE_TILE_SIZE;
+
+/* -------------------------------------------------------------------- */
+/** \name Pixel Conversion
+ * \{ */
+
+/* Convert a region of a float buffer with 1 to 3 channels to RGBA. */
+static void read_float(
+    const ImBuf *ibuf, const int2 &offset, const int2 &size, float4 *dst, int dst_stride)
+{
+  const int channels = ibuf->channels;
+  for (int y = 0; y < size.y; y++) {
+    const float *src = ibuf->float_buffer.data +
+                       (int64_t(offset.y + y) * ibuf->x + offset.x) * channels;
+    float4 *dst_row = dst + int64_t(y) * dst_stride;
+    for (int x = 0; x < size.x; x++, src += channels) {
+      if (channels == 1) {
+        dst_row[x] = float4(src[0], src[0], src[0], 1.0f);
+      }
+      else if (channels == 2) {
+        dst_row[x] = float4(src[0], src[0], src[0], src[1]);
+      }
+      else {
+        dst_row[x] = float4(src[0], src[1], src[2], 1.0f);
+      }
+    }
+  }
+}
+
+/* Same conversion as #IMB_float_from_rect_ex, for a single tile. */
+static void read_byte(
+    const ImBuf *ibuf, const int2 &offset, const int2 &size, float4 *dst, int dst_stride)
+{
+  const uchar *src = ibuf->byte_buffer.data + (int64_t(offset.y) * ibuf->x + offset.x) * 4;
+  IMB_buffer_float_from_byte(reinterpret_cast<float *>(dst),
+                             src,
+                             IB_PROFILE_SRGB,
+                             IB_PROFILE_SRGB,
+                             false,
+                             size.x,
+                             size.y,
+                             dst_stride,
+                             ibuf->x);
+
+  ColorSpace *colorspace = ibuf->byte_buffer.colorspace;
+  if (colorspace == nullptr) {
+    colorspace = colormanage_colorspace_get_named(
+        IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DEFAULT_BYTE));
+  }
+  const bool premultiply = IMB_alpha_affects_rgb(ibuf);
+  for (int y = 0; y < size.y; y++) {
+    float *dst_row = reinterpret_cast<float *>(dst + int64_t(y) * dst_stride);
+    IMB_colormanagement_colorspace_to_scene_linear(dst_row, size.x, 1, 4, colorspace, false);
+    if (premultiply) {
+      IMB_premultiply_rect_float(dst_row, 4, size.x, 1);
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Image Files
+ * \{ */
+
+/**
+ * Reads tiles through a private OpenImageIO image cache, which reads only the file tiles that
+ * are needed, and splits scanline files into strips of tile height.
+ */
+struct TiledImageFile {
+  OIIO::ImageCache *cache = nullptr;
+  OIIO::ustring filepath;
+  /** Specification of every mip-map level stored in the file. */
+  Vector<OIIO::ImageSpec> level_specs;
+  /** Color space of the file pixels, null when the pixels are already scene linear. */
+  ColorSpace *colorspace = nullptr;
+
+  ~TiledImageFile()
+  {
+    if (cache) {
+      OIIO::ImageCache::destroy(cache);
+    }
+  }
+
+  static std::unique_ptr<TiledImageFile> open(const char *filepath)
+  {
+    std::unique_ptr<TiledImageFile> file = std::make_unique<TiledImageFile>();
+    file->cache = OIIO::ImageCache::create(false);
+    file->filepath = OIIO::ustring(filepath);
+    /* The cache only has to hold the file tiles of a few of our tiles at a time, the converted
+     * tiles are kept in the #TiledImage cache. */
+    file->cache->attribute("max_memory_MB", 64.0f);
+    file->cache->attribute("autotile", TILE_SIZE);
+    file->cache->attribute("autoscanline", 1);
+    file->cache->attribute("max_open_files", 4);
+
+    for (int level = 0;; level++) {
+      OIIO::ImageSpec spec;
+      if (!file->cache->get_imagespec(file->filepath, spec, 0, level)) {
+        break;
+      }
+      file->level_specs.append(spec);
+    }
+    /* Clear the error of the last, non existing level. */
+    file->cache->geterror();
+
+    if (file->level_specs.is_empty() || file->level_specs.first().width <= 0 ||
+        file->level_specs.first().height <= 0)
+    {
+      return nullptr;
+    }
+
+    const OIIO::ImageSpec &spec = file->level_specs.first();
+    const std::string file_colorspace = spec.get_string_attribute("oiio:ColorSpace");
+    if (!file_colorspace.empty()) {
+      file->colorspace = colormanage_colorspace_get_named(file_colorspace.c_str());
+    }
+    if (file->colorspace == nullptr) {
+      /* Same defaults as when loading the whole image. */
+      const bool is_float = spec.format.basetype == OIIO::TypeDesc::FLOAT ||
+                            spec.format.basetype == OIIO::TypeDesc::HALF;
+      file->colorspace = colormanage_colorspace_get_named(
+          IMB_colormanagement_role_colorspace_name_get(is_float ? COLOR_ROLE_DEFAULT_FLOAT :
+                                                                  COLOR_ROLE_DEFAULT_BYTE));
+    }
+    if (file->colorspace && IMB_colormanagement_space_is_scene_linear(file->colorspace)) {
+      file->colorspace = nullptr;
+    }
+    return file;
+  }
+
+  void read(int level, const int2 &offset, const int2 &size, float4 *dst, int dst_stride)
+  {
+    const OIIO::ImageSpec &spec = level_specs[level];
+    const int channels = std::min(spec.nchannels, 4);
+
+    /* Files are stored top to bottom, write the rows in reverse order with a negative stride. */
+    const int file_ybegin = spec.y + spec.height - (offset.y + size.y);
+    float4 *dst_last_row = dst + int64_t(size.y - 1) * dst_stride;
+    const bool ok = cache->get_pixels(filepath,
+                                      0,
+                                      level,
+                                      spec.x + offset.x,
+                                      spec.x + offset.x + size.x,
+                                      file_ybegin,
+                                      file_ybegin + size.y,
+                                      0,
+                                      1,
+                                      0,
+                                      channels,
+                                      OIIO::TypeDesc::FLOAT,
+                                      dst_last_row,
+                                      sizeof(float4),
+                                      -OIIO::stride_t(sizeof(float4)) * dst_stride);
+    if (!ok) {
+      cache->geterror();
+      for (int y = 0; y < size.y; y++) {
+        std::fill_n(dst + int64_t(y) * dst_stride, size.x, float4(0.0f));
+      }
+      return;
+    }
+
+    for (int y = 0; y < size.y; y++) {
+      float4 *dst_row = dst + int64_t(y) * dst_stride;
+      if (channels < 4) {
+        for (int x = 0; x < size.x; x++) {
+          float4 &pixel = dst_row[x];
+          if (channels == 1) {
+            pixel = float4(pixel.x, pixel.x, pixel.x, 1.0f);
+          }
+          else if (channels == 2) {
+            pixel = float4(pixel.x, pixel.x, pixel.x, pixel.y);
+          }
+          else {
+            pixel.w = 1.0f;
+          }
+        }
+      }
+      if (colorspace) {
+        IMB_colormanagement_colorspace_to_scene_linear(
+            reinterpret_cast<float *>(dst_row), size.x, 1, 4, colorspace, true);
+      }
+    }
+  }
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Tiled Image
+ * \{ */
+
+TiledImage::TiledImage(const ImBuf *ibuf, int64_t memory_limit)
+    : ibuf_(ibuf), memory_limit_(memory_limit)
+{
+  float4_pixels_ = (ibuf->float_buffer.data && ibuf->channels == 4) ?
+                       reinterpret_cast<const float4 *>(ibuf->float_buffer.data) :
+                       nullptr;
+
+  /* Add half resolution levels until the image fits in a single tile. */
+  level_sizes_.append(int2(ibuf->x, ibuf->y));
+  while (math::reduce_max(level_sizes_.last()) > TILE_SIZE) {
+    level_sizes_.append(math::max((level_sizes_.last() + 1) / 2, int2(1)));
+  }
+}
+
+TiledImage::TiledImage(std::unique_ptr<TiledImageFile> file, int64_t memory_limit)
+    : file_(std::move(file)), memory_limit_(memory_limit)
+{
+  /* Use the mip-map levels of the file, and add half resolution levels until the image fits in
+   * a single tile. */
+  for (const OIIO::ImageSpec &spec : file_->level_specs) {
+    level_sizes_.append(int2(spec.width, spec.height));
+  }
+  native_levels_num_ = level_sizes_.size();
+  while (math::reduce_max(level_sizes_.last()) > TILE_SIZE) {
+    level_sizes_.append(math::max((level_sizes_.last() + 1) / 2, int2(1)));
+  }
+}
+
+TiledImage::~TiledImage() = default;
+
+std::unique_ptr<TiledImage> TiledImage::from_imbuf(const ImBuf *ibuf, int64_t memory_limit)
+{
+  return std::unique_ptr<TiledImage>(new TiledImage(ibuf, memory_limit));
+}
+
+std::unique_ptr<TiledImage> TiledImage::from_file(const char *filepath, int64_t memory_limit)
+{
+  std::unique_ptr<TiledImageFile> file = TiledImageFile::open(filepath);
+  if (!file) {
+    return nullptr;
+  }
+  return std::unique_ptr<TiledImage>(new TiledImage(std::move(file), memory_limit));
+}
+
+int TiledImage::level_for_scale(float texels_per_pixel) const
+{
+  int level = 0;
+  while (level + 1 < level_sizes_.size() &&
+         float(level_sizes_[0].x) / float(level_sizes_[level + 1].x) <= texels_per_pixel)
+  {
+    level++;
+  }
+  return level;
+}
+
+std::shared_ptr<const TiledImageTile> TiledImage::acquire_tile(int level, int2 tile)
+{
+  const int2 offset = tile * TILE_SIZE;
+  if (level == 0 && float4_pixels_) {
+    /* Full resolution tiles of RGBA float buffers point into the buffer, they are not cached. */
+    std::shared_ptr<TiledImageTile> result = std::make_shared<TiledImageTile>();
+    result->pixels = float4_pixels_ + int64_t(offset.y) * ibuf_->x + offset.x;
+    result->stride = ibuf_->x;
+    result->size = math::min(level_sizes_[0] - offset, int2(TILE_SIZE));
+    return result;
+  }
+
+  const TileKey key = {level, tile};
+  {
+    std::lock_guard lock(mutex_);
+    if (CachedTile *cached = tiles_.lookup_ptr(key)) {
+      cached->last_used = ++use_clock_;
+      return cached->tile;
+    }
+  }
+
+  /* Create the tile without holding the lock, other threads can use cached tiles meanwhile. */
+  const double start_time = BLI_time_now_seconds();
+  const bool is_native = level < native_levels_num_;
+  std::shared_ptr<const TiledImageTile> result = is_native ? load_tile(level, tile) :
+                                                             compute_tile(level, tile);
+  const double load_time = BLI_time_now_seconds() - start_time;
+
+  std::lock_guard lock(mutex_);
+  if (is_native) {
+    stats_.tiles_loaded++;
+  }
+  else {
+    stats_.tiles_computed++;
+  }
+  stats_.load_time += load_time;
+  add_to_cache(key, result);
+  return result;
+}
+
+std::shared_ptr<const TiledImageTile> TiledImage::load_tile(int level, int2 tile)
+{
+  std::shared_ptr<TiledImageTile> result = std::make_shared<TiledImageTile>();
+  const int2 offset = tile * TILE_SIZE;
+  result->size = math::min(level_sizes_[level] - offset, int2(TILE_SIZE));
+  result->storage.reinitialize(TILE_SIZE * TILE_SIZE);
+  result->pixels = result->storage.data();
+  result->stride = TILE_SIZE;
+  if (file_) {
+    file_->read(level, offset, result->size, result->storage.data(), TILE_SIZE);
+  }
+  else if (ibuf_->float_buffer.data) {
+    read_float(ibuf_, offset, result->size, result->storage.data(), TILE_SIZE);
+  }
+  else if (ibuf_->byte_buffer.data) {
+    read_byte(ibuf_, offset, result->size, result->storage.data(), TILE_SIZE);
+  }
+  else {
+    result->storage.fill(float4(0.0f));
+  }
+  return result;
+}
+
+std::shared_ptr<const TiledImageTile> TiledImage::compute_tile(int level, int2 tile)
+{
+  std::shared_ptr<TiledImageTile> result = std::make_shared<TiledImageTile>();
+  const int2 offset = tile * TILE_SIZE;
+  const int2 src_level_size = level_sizes_[level - 1];
+  result->size = math::min(level_sizes_[level] - offset, int2(TILE_SIZE));
+  result->storage.reinitialize(TILE_SIZE * TILE_SIZE);
+  result->pixels = result->storage.data();
+  result->stride = TILE_SIZE;
+
+  /* Each tile is computed from up to 2x2 tiles of the level below, with a box filter. Pixels at
+   * the border of odd sized levels are clamped. */
+  for (int sub_y = 0; sub_y < 2; sub_y++) {
+    for (int sub_x = 0; sub_x < 2; sub_x++) {
+      const int2 sub_offset = int2(sub_x, sub_y) * (TILE_SIZE / 2);
+      if (sub_offset.x >= result->size.x || sub_offset.y >= result->size.y) {
+        continue;
+      }
+      const int2 src_tile = tile * 2 + int2(sub_x, sub_y);
+      std::shared_ptr<const TiledImageTile> src = acquire_tile(level - 1, src_tile);
+      const int2 src_tile_offset = src_tile * TILE_SIZE;
+
+      const int2 size = math::min(result->size - sub_offset, int2(TILE_SIZE / 2));
+      for (int y = 0; y < size.y; y++) {
+        const int src_y0 = 2 * y;
+        const int src_y1 = std::min(2 * y + 1, src_level_size.y - 1 - src_tile_offset.y);
+        const float4 *src_row0 = &src->pixel(0, src_y0);
+        const float4 *src_row1 = &src->pixel(0, std::max(src_y1, src_y0));
+        float4 *dst_row = &result->storage[(sub_offset.y + y) * TILE_SIZE + sub_offset.x];
+        for (int x = 0; x < size.x; x++) {
+          const int src_x0 = 2 * x;
+          const int src_x1 = std::max(
+              std::min(2 * x + 1, src_level_size.x - 1 - src_tile_offset.x), src_x0);
+          dst_row[x] = (src_row0[src_x0] + src_row0[src_x1] + src_row1[src_x0] +
+                        src_row1[src_x1]) *
+                       0.25f;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+void TiledImage::add_to_cache(const TileKey &key, std::shared_ptr<const TiledImageTile> tile)
+{
+  /* Another thread may have added the same tile in the meantime, keep the first one. */
+  if (tiles_.contains(key)) {
+    return;
+  }
+  tiles_.add_new(key, {std::move(tile), ++use_clock_});
+  stats_.memory_used += sizeof(float4) * TILE_SIZE * TILE_SIZE;
+  stats_.memory_peak = std::max(stats_.memory_peak, stats_.memory_used);
+  evict_tiles();
+}
+
+void TiledImage::evict_tiles()
+{
+  if (stats_.memory_used <= memory_limit_) {
+    return;
+  }
+  /* Remove the least recently used tiles until half of the memory limit is used, which keeps
+   * the number of times the cache is sorted low. */
+  Vector<std::pair<uint64_t, TileKey>> candidates;
+  for (const auto item : tiles_.items()) {
+    candidates.append({item.value.last_used, item.key});
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  for (const auto &candidate : candidates) {
+    if (stats_.memory_used <= memory_limit_ / 2) {
+      break;
+    }
+    tiles_.remove(candidate.second);
+    stats_.memory_used -= sizeof(float4) * TILE_SIZE * TILE_SIZE;
+    stats_.tiles_evicted++;
+  }
+}
+
+void TiledImage::sample_nearest(int level,
+                                const float2 &origin,
+                                const float2 &step,
+                                const int2 &dst_size,
+                                float *dst,
+                                int dst_stride)
+{
+  const int2 level_size = level_sizes_[level];
+  const float2 level_scale = float2(level_size) / float2(level_sizes_[0]);
+  const int2 tiles = tiles_num(level);
+
+  threading::parallel_for(IndexRange(dst_size.y), 32, [&](const IndexRange y_range) {
+    /* Tiles of the current tile row, acquired when first sampled. */
+    Vector<std::shared_ptr<const TiledImageTile>> row_tiles(tiles.x);
+    int current_tile_y = -1;
+
+    for (const int y : y_range) {
+      const float level_y = (origin.y + y * step.y) * level_scale.y;
+      const int pixel_y = int(math::floor(level_y));
+      if (pixel_y < 0 || pixel_y >= level_size.y) {
+        continue;
+      }
+      const int tile_y = pixel_y / TILE_SIZE;
+      if (tile_y != current_tile_y) {
+        row_tiles.fill(nullptr);
+        current_tile_y = tile_y;
+      }
+
+      float4 *dst_row = reinterpret_cast<float4 *>(dst) + int64_t(y) * dst_stride;
+      for (int x = 0; x < dst_size.x; x++) {
+        const float level_x = (origin.x + x * step.x) * level_scale.x;
+        const int pixel_x = int(math::floor(level_x));
+        if (pixel_x < 0 || pixel_x >= level_size.x) {
+          continue;
+        }
+        const int tile_x = pixel_x / TILE_SIZE;
+        std::shared_ptr<const TiledImageTile> &tile = row_tiles[tile_x];
+        if (!tile) {
+          tile = acquire_tile(level, int2(tile_x, tile_y));
+        }
+        dst_row[x] = tile->pixel(pixel_x - tile_x * TILE_SIZE, pixel_y - tile_y * TILE_SIZE);
+      }
+    }
+  });
+}
+
+void TiledImage::tag_dirty(const rcti &region)
+{
+  std::lock_guard lock(mutex_);
+  int2 min = int2(region.xmin, region.ymin);
+  int2 max = int2(region.xmax, region.ymax);
+  for (const int level : level_sizes_.index_range()) {
+    const int2 tile_min = math::max(min, int2(0)) / TILE_SIZE;
+    const int2 tile_max = math::min(max, level_sizes_[level]) / TILE_SIZE;
+    for (int tile_y = tile_min.y; tile_y <= tile_max.y; tile_y++) {
+      for (int tile_x = tile_min.x; tile_x <= tile_max.x; tile_x++) {
+        if (tiles_.remove({level, int2(tile_x, tile_y)})) {
+          stats_.memory_used -= sizeof(float4) * TILE_SIZE * TILE_SIZE;
+        }
+      }
+    }
+    /* Region of the next level that depends on the changed pixels. */
+    min = min / 2;
+    max = (max + 1) / 2;
+  }
+}
+
+TiledImageStats TiledImage::stats() const
+{
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+/** \} */
+
+}  // namespace blender::imbuf
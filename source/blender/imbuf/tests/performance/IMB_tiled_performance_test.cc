@@ -0,0 +1,172 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <string>
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+#include "IMB_tiled.hh"
+
+#include "BLI_fileops.h"
+#include "BLI_math_matrix.hh"
+#include "BLI_path_util.h"
+#include "BLI_rect.h"
+#include "BLI_tempfile.h"
+#include "BLI_time.h"
+
+using namespace blender;
+
+static constexpr int SRC_X = 8192;
+static constexpr int SRC_Y = 8192;
+
+static constexpr int VIEW_X = 1920;
+static constexpr int VIEW_Y = 1080;
+
+static ImBuf *create_src_image()
+{
+  ImBuf *img = IMB_allocImBuf(SRC_X, SRC_Y, 32, IB_rect);
+  uchar *pix = img->byte_buffer.data;
+  for (int64_t i = 0; i < int64_t(img->x) * img->y; i++) {
+    pix[0] = i & 0xFF;
+    pix[1] = (i * 3) & 0xFF;
+    pix[2] = (i + 12345) & 0xFF;
+    pix[3] = 255;
+    pix += 4;
+  }
+  return img;
+}
+
+/* Fit the whole image in the view, like the image editor does when opening an image. */
+static float view_scale()
+{
+  return math::max(float(SRC_X) / VIEW_X, float(SRC_Y) / VIEW_Y);
+}
+
+/* Display the image by converting all of it to float and scaling it down, which is what the
+ * image engine did before drawing from tiled images. */
+static void display_full(ImBuf *src)
+{
+  const double start = BLI_time_now_seconds();
+
+  ImBuf *float_buffer = IMB_allocImBuf(src->x, src->y, 32, IB_rectfloat);
+  rcti region;
+  BLI_rcti_init(&region, 0, src->x, 0, src->y);
+  IMB_float_from_rect_ex(float_buffer, src, &region);
+
+  ImBuf *dst = IMB_allocImBuf(VIEW_X, VIEW_Y, 32, IB_rectfloat);
+  const float scale = view_scale();
+  const float4x4 matrix = math::from_scale<float4x4>(float4(scale, scale, 1.0f, 1.0f));
+  IMB_transform(
+      float_buffer, dst, IMB_TRANSFORM_MODE_REGULAR, IMB_FILTER_NEAREST, matrix.ptr(), nullptr);
+
+  const double time = BLI_time_now_seconds() - start;
+  printf("full:  first display %.2f ms, %.1f MB\n",
+         time * 1000.0,
+         double(src->x) * src->y * sizeof(float[4]) / (1024.0 * 1024.0));
+
+  IMB_freeImBuf(dst);
+  IMB_freeImBuf(float_buffer);
+}
+
+/* Display a file by loading all of it, which is what opening an image does. */
+static void display_file_full(const char *filepath)
+{
+  const double start = BLI_time_now_seconds();
+
+  ImBuf *src = IMB_loadiffname(filepath, IB_rect, nullptr);
+  ImBuf *dst = IMB_allocImBuf(VIEW_X, VIEW_Y, 32, IB_rectfloat);
+  const float scale = view_scale();
+  const float4x4 matrix = math::from_scale<float4x4>(float4(scale, scale, 1.0f, 1.0f));
+  IMB_transform(src, dst, IMB_TRANSFORM_MODE_REGULAR, IMB_FILTER_NEAREST, matrix.ptr(), nullptr);
+
+  const double time = BLI_time_now_seconds() - start;
+  printf("file full: first display %.2f ms, %.1f MB\n",
+         time * 1000.0,
+         double(src->x) * src->y * sizeof(float[4]) / (1024.0 * 1024.0));
+
+  IMB_freeImBuf(dst);
+  IMB_freeImBuf(src);
+}
+
+static void display_tiled(imbuf::TiledImage &tiled_image, const char *name, const float scale)
+{
+  ImBuf *dst = IMB_allocImBuf(VIEW_X, VIEW_Y, 32, IB_rectfloat);
+  const int level = tiled_image.level_for_scale(scale);
+
+  double start = BLI_time_now_seconds();
+  /* Center the view on the image. */
+  const float2 origin = (float2(tiled_image.size()) - float2(VIEW_X, VIEW_Y) * scale) * 0.5f;
+  tiled_image.sample_nearest(
+      level, origin, float2(scale), int2(VIEW_X, VIEW_Y), dst->float_buffer.data, VIEW_X);
+  const double first_time = BLI_time_now_seconds() - start;
+
+  /* Redraw with the tiles cached, as when panning or redrawing the editor. */
+  start = BLI_time_now_seconds();
+  tiled_image.sample_nearest(
+      level, origin, float2(scale), int2(VIEW_X, VIEW_Y), dst->float_buffer.data, VIEW_X);
+  const double redraw_time = BLI_time_now_seconds() - start;
+
+  const imbuf::TiledImageStats stats = tiled_image.stats();
+  printf("%s: level %d, first display %.2f ms, redraw %.2f ms, %.1f MB, "
+         "%lld tiles loaded, %lld computed\n",
+         name,
+         level,
+         first_time * 1000.0,
+         redraw_time * 1000.0,
+         double(stats.memory_peak) / (1024.0 * 1024.0),
+         (long long)stats.tiles_loaded,
+         (long long)stats.tiles_computed);
+
+  IMB_freeImBuf(dst);
+}
+
+TEST(imbuf_tiled, tiled_display_perf)
+{
+  IMB_init();
+
+  ImBuf *src = create_src_image();
+  display_full(src);
+  {
+    std::unique_ptr<imbuf::TiledImage> tiled_image = imbuf::TiledImage::from_imbuf(src);
+    display_tiled(*tiled_image, "tiled byte", view_scale());
+  }
+
+  /* Float buffers are used as the full resolution level, only the lower levels use memory. */
+  ImBuf *float_src = IMB_allocImBuf(SRC_X, SRC_Y, 32, IB_rectfloat);
+  rcti region;
+  BLI_rcti_init(&region, 0, src->x, 0, src->y);
+  IMB_float_from_rect_ex(float_src, src, &region);
+  {
+    std::unique_ptr<imbuf::TiledImage> tiled_image = imbuf::TiledImage::from_imbuf(float_src);
+    display_tiled(*tiled_image, "tiled float", view_scale());
+  }
+
+  /* Files are read per tile, so a view at full resolution only reads the visible tiles. The
+   * file has no mip-map levels, so fitting it in the view still reads every tile once. */
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), temp_dir, "imb_tiled_performance_test.exr");
+  float_src->ftype = IMB_FTYPE_OPENEXR;
+  float_src->foptions.flag = OPENEXR_HALF;
+  if (IMB_saveiff(float_src, filepath, IB_rectfloat)) {
+    display_file_full(filepath);
+    {
+      std::unique_ptr<imbuf::TiledImage> tiled_image = imbuf::TiledImage::from_file(filepath);
+      display_tiled(*tiled_image, "file tiled 1:1", 1.0f);
+    }
+    {
+      std::unique_ptr<imbuf::TiledImage> tiled_image = imbuf::TiledImage::from_file(filepath);
+      display_tiled(*tiled_image, "file tiled fit", view_scale());
+    }
+    BLI_delete(filepath, false, false);
+  }
+  IMB_freeImBuf(float_src);
+
+  IMB_freeImBuf(src);
+  IMB_exit();
+}
@@ -219,4 +219,5 @@ enum {
   COLORMANAGE_VIEW_USE_CURVES = (1 << 0),
   COLORMANAGE_VIEW_USE_HDR = (1 << 1),
   COLORMANAGE_VIEW_USE_WHITE_BALANCE = (1 << 2),
+  COLORMANAGE_VIEW_USE_BAKED_LUT = (1 << 3),
 };
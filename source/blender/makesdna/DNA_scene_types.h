@@ -2599,6 +2599,9 @@ typedef enum eSculptFlags {
   SCULPT_DYNTOPO_DETAIL_BRUSH = (1 << 14),
   /* unused = (1 << 15), */
   SCULPT_DYNTOPO_DETAIL_MANUAL = (1 << 16),
+
+  /** If set, mesh elements are reordered spatially when entering sculpt mode. */
+  SCULPT_SPATIAL_REORDER = (1 << 17),
 } eSculptFlags;
 
 /** #Sculpt::transform_mode */
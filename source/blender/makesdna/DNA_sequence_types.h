@@ -849,6 +849,7 @@ enum {
 
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
   SEQ_CACHE_DISK_CACHE_ENABLE = (1 << 11),
+  SEQ_CACHE_PREFETCH_PARALLEL = (1 << 12),
 };
 
 /** #Sequence.color_tag. */
@@ -910,19 +910,20 @@ static FCurve *rna_Driver_new(
   FCurve *fcu = verify_driver_fcurve(id, rna_path, array_index, DRIVER_FCURVE_KEYFRAMES);
   BLI_assert(fcu != nullptr);
 
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, id);
 
   return fcu;
 }
 
-static void rna_Driver_remove(AnimData *adt, Main *bmain, ReportList *reports, FCurve *fcu)
+static void rna_Driver_remove(
+    ID *id, AnimData *adt, Main *bmain, ReportList *reports, FCurve *fcu)
 {
   if (!BLI_remlink_safe(&adt->drivers, fcu)) {
     BKE_report(reports, RPT_ERROR, "Driver not found in this animation data");
     return;
   }
   BKE_fcurve_free(fcu);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, id);
 }
 
 static FCurve *rna_Driver_find(AnimData *adt,
@@ -1513,7 +1514,7 @@ static void rna_api_animdata_drivers(BlenderRNA *brna, PropertyRNA *cprop)
 
   /* AnimData.drivers.remove(...) */
   func = RNA_def_function(srna, "remove", "rna_Driver_remove");
-  RNA_def_function_flag(func, FUNC_USE_REPORTS | FUNC_USE_MAIN);
+  RNA_def_function_flag(func, FUNC_USE_SELF_ID | FUNC_USE_REPORTS | FUNC_USE_MAIN);
   parm = RNA_def_pointer(func, "driver", "FCurve", "", "");
   RNA_def_parameter_flags(parm, PROP_NEVER_NULL, PARM_REQUIRED);
 
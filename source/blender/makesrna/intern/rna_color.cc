@@ -1329,6 +1329,14 @@ static void rna_def_colormanage(BlenderRNA *brna)
       prop, "Use White Balance", "Perform chromatic adaption from a different white point");
   RNA_def_property_update(prop, NC_WINDOW, "rna_ColorManagement_update");
 
+  prop = RNA_def_property(srna, "use_baked_lut", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", COLORMANAGE_VIEW_USE_BAKED_LUT);
+  RNA_def_property_ui_text(prop,
+                           "Baked LUT",
+                           "Apply the view transform on the CPU through a baked 3D lookup table, "
+                           "which is faster but less accurate");
+  RNA_def_property_update(prop, NC_WINDOW, "rna_ColorManagement_update");
+
   prop = RNA_def_property(srna, "white_balance_temperature", PROP_FLOAT, PROP_COLOR_TEMPERATURE);
   RNA_def_property_float_sdna(prop, nullptr, "temperature");
   RNA_def_property_float_default(prop, 6500.0f);
@@ -1622,7 +1622,7 @@ static bConstraint *rna_Object_constraints_new(Object *object, Main *bmain, int
   WM_main_add_notifier(NC_OBJECT | ND_CONSTRAINT | NA_ADDED, object);
 
   /* The Depsgraph needs to be updated to reflect the new relationship that was added. */
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &object->id);
 
   return new_con;
 }
@@ -1648,6 +1648,8 @@ static void rna_Object_constraints_remove(Object *object,
   blender::ed::object::constraint_update(bmain, object);
   blender::ed::object::constraint_active_set(object, nullptr);
   WM_main_add_notifier(NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, object);
+
+  DEG_id_relations_tag_update(bmain, &object->id);
 }
 
 static void rna_Object_constraints_clear(Object *object, Main *bmain)
@@ -1658,6 +1660,8 @@ static void rna_Object_constraints_clear(Object *object, Main *bmain)
   blender::ed::object::constraint_active_set(object, nullptr);
 
   WM_main_add_notifier(NC_OBJECT | ND_CONSTRAINT | NA_REMOVED, object);
+
+  DEG_id_relations_tag_update(bmain, &object->id);
 }
 
 static void rna_Object_constraints_move(
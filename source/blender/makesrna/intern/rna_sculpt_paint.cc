@@ -772,6 +772,15 @@ static void rna_def_sculpt(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_CONTEXT_UPDATE);
   RNA_def_property_update(prop, NC_OBJECT | ND_DRAW, "rna_Sculpt_update");
 
+  prop = RNA_def_property(srna, "use_spatial_reorder", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flags", SCULPT_SPATIAL_REORDER);
+  RNA_def_property_ui_text(prop,
+                           "Spatial Reorder",
+                           "Reorder vertices and faces by location when entering sculpt mode, "
+                           "making brushes faster on dense meshes. The original order is restored "
+                           "when leaving sculpt mode");
+  RNA_def_property_update(prop, NC_SCENE | ND_TOOLSETTINGS, nullptr);
+
   prop = RNA_def_property(srna, "detail_size", PROP_FLOAT, PROP_PIXEL);
   RNA_def_property_range(prop, 0.5, 40.0);
   RNA_def_property_ui_range(prop, 0.5, 40.0, 0.1, 2);
@@ -312,6 +312,46 @@ static void rna_SequenceEditor_update_cache(Main * /*bmain*/, Scene *scene, Poin
   SEQ_cache_cleanup(scene);
 }
 
+static SeqCacheStatistics rna_SequenceEditor_cache_statistics(PointerRNA *ptr)
+{
+  SeqCacheStatistics stats;
+  SEQ_cache_statistics_get((Scene *)ptr->owner_id, &stats);
+  return stats;
+}
+
+static int rna_SequenceEditor_cache_hits_get(PointerRNA *ptr)
+{
+  return int(std::min<int64_t>(rna_SequenceEditor_cache_statistics(ptr).hits, INT_MAX));
+}
+
+static int rna_SequenceEditor_cache_misses_get(PointerRNA *ptr)
+{
+  return int(std::min<int64_t>(rna_SequenceEditor_cache_statistics(ptr).misses, INT_MAX));
+}
+
+static float rna_SequenceEditor_cache_hit_ratio_get(PointerRNA *ptr)
+{
+  const SeqCacheStatistics stats = rna_SequenceEditor_cache_statistics(ptr);
+  const int64_t lookups = stats.hits + stats.misses;
+  return lookups > 0 ? float(double(stats.hits) / double(lookups)) : 0.0f;
+}
+
+static int rna_SequenceEditor_cache_evicted_frames_get(PointerRNA *ptr)
+{
+  return int(
+      std::min<int64_t>(rna_SequenceEditor_cache_statistics(ptr).evicted_frames, INT_MAX));
+}
+
+static int rna_SequenceEditor_cache_items_get(PointerRNA *ptr)
+{
+  return int(std::min<int64_t>(rna_SequenceEditor_cache_statistics(ptr).item_count, INT_MAX));
+}
+
+static float rna_SequenceEditor_cache_memory_get(PointerRNA *ptr)
+{
+  return float(double(rna_SequenceEditor_cache_statistics(ptr).mem_in_use) / (1024.0 * 1024.0));
+}
+
 /* internal use */
 static int rna_SequenceEditor_elements_length(PointerRNA *ptr)
 {
@@ -2532,6 +2572,55 @@ static void rna_def_editor(BlenderRNA *brna)
       "Render frames ahead of current frame in the background for faster playback");
   RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, nullptr);
 
+  prop = RNA_def_property(srna, "use_prefetch_parallel", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "cache_flag", SEQ_CACHE_PREFETCH_PARALLEL);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Prefetch",
+                           "Prefetch multiple frames at the same time, each using its own copy of "
+                           "the scene, at the cost of memory usage");
+  RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, nullptr);
+
+  /* cache statistics */
+
+  prop = RNA_def_property(srna, "cache_hits", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_cache_hits_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cache Hits", "Number of images found in the RAM cache since it was created");
+
+  prop = RNA_def_property(srna, "cache_misses", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_cache_misses_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Cache Misses",
+                           "Number of images not found in the RAM cache since it was created");
+
+  prop = RNA_def_property(srna, "cache_hit_ratio", PROP_FLOAT, PROP_FACTOR);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_hit_ratio_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cache Hit Ratio", "Fraction of RAM cache lookups which found an image");
+
+  prop = RNA_def_property(srna, "cache_evicted_frames", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(
+      prop, "rna_SequenceEditor_cache_evicted_frames_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Cache Evicted Frames",
+                           "Number of frames removed from the RAM cache to make room for new "
+                           "images, the least valuable frames are removed first");
+
+  prop = RNA_def_property(srna, "cache_items", PROP_INT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_cache_items_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop, "Cache Items", "Number of images stored in the RAM cache");
+
+  prop = RNA_def_property(srna, "cache_memory", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(prop, "rna_SequenceEditor_cache_memory_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Cache Memory", "Memory used by images stored in the RAM cache, in megabytes");
+
   /* functions */
 
   func = RNA_def_function(srna, "display_stack", "rna_SequenceEditor_display_stack");
@@ -7413,6 +7413,13 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, nullptr, "use_sculpt_texture_paint", 1);
   RNA_def_property_ui_text(prop, "Sculpt Texture Paint", "Use texture painting in Sculpt Mode");
 
+  prop = RNA_def_property(srna, "use_sculpt_undo_disk_spill", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_sculpt_undo_disk_spill", 1);
+  RNA_def_property_ui_text(prop,
+                           "Sculpt Undo Disk Spill",
+                           "Move the data of older Sculpt Mode undo steps to a temporary file "
+                           "to reduce memory usage");
+
   prop = RNA_def_property(srna, "use_extended_asset_browser", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(prop,
                            "Extended Asset Browser",
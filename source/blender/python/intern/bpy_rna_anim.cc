@@ -638,7 +638,7 @@ PyObject *pyrna_struct_driver_add(BPy_StructRNA *self, PyObject *args)
     bContext *context = BPY_context_get();
     WM_event_add_notifier(BPY_context_get(), NC_ANIMATION | ND_FCURVES_ORDER, nullptr);
     DEG_id_tag_update(id, ID_RECALC_SYNC_TO_EVAL);
-    DEG_relations_tag_update(CTX_data_main(context));
+    DEG_id_relations_tag_update(CTX_data_main(context), id);
   }
   else {
     /* XXX: should be handled by reports. */
@@ -698,7 +698,7 @@ PyObject *pyrna_struct_driver_remove(BPy_StructRNA *self, PyObject *args)
 
   bContext *context = BPY_context_get();
   WM_event_add_notifier(context, NC_ANIMATION | ND_FCURVES_ORDER, nullptr);
-  DEG_relations_tag_update(CTX_data_main(context));
+  DEG_id_relations_tag_update(CTX_data_main(context), self->ptr.owner_id);
 
   return PyBool_FromLong(result);
 }
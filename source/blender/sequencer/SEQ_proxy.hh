@@ -8,6 +8,8 @@
  * \ingroup sequencer
  */
 
+#include "BLI_threads.h"
+
 struct Depsgraph;
 struct GSet;
 struct ListBase;
@@ -37,9 +39,13 @@ struct ProxyJob {
   Main *main;
   Depsgraph *depsgraph;
   Scene *scene;
+  /* Strips can be added to the queue while the job runs, guarded by `queue_mutex`. */
   ListBase queue;
+  ThreadMutex queue_mutex;
   int stop;
 };
 
 wmJob *ED_seq_proxy_wm_job_get(const bContext *C);
 ProxyJob *ED_seq_proxy_job_get(const bContext *C, wmJob *wm_job);
+/** Move build contexts created by #SEQ_proxy_rebuild_context to the queue of the job. */
+void ED_seq_proxy_job_queue_append(ProxyJob *pj, ListBase *queue);
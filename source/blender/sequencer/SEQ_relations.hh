@@ -8,6 +8,9 @@
  * \ingroup sequencer
  */
 
+#include <cstddef>
+#include <cstdint>
+
 struct ListBase;
 struct Main;
 struct MovieClip;
@@ -59,6 +62,21 @@ void SEQ_cache_iterate(
     void *userdata,
     bool callback_init(void *userdata, size_t item_count),
     bool callback_iter(void *userdata, Sequence *seq, int timeline_frame, int cache_type));
+
+struct SeqCacheStatistics {
+  /** Lookups which found an image in the RAM cache, and lookups which did not. */
+  int64_t hits;
+  int64_t misses;
+  /** Frames freed to make room for new images since the cache was created. */
+  int64_t evicted_frames;
+  /** Images currently stored in the RAM cache, and the memory they use in bytes. */
+  int64_t item_count;
+  size_t mem_in_use;
+};
+/**
+ * Get statistics of the RAM cache of the scene, all zero if there is no cache.
+ */
+void SEQ_cache_statistics_get(Scene *scene, SeqCacheStatistics *r_stats);
 /**
  * Return immediate parent meta of sequence.
  */
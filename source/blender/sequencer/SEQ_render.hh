@@ -22,8 +22,13 @@ struct rctf;
 enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
   SEQ_TASK_PREFETCH_RENDER,
+  /* Parallel prefetch renders frames on multiple threads, each thread uses its own ID starting
+   * from #SEQ_TASK_PREFETCH_RENDER. */
+  SEQ_TASK_PREFETCH_RENDER_LAST = SEQ_TASK_PREFETCH_RENDER + 7,
 };
 
+#define SEQ_TASK_NUM (SEQ_TASK_PREFETCH_RENDER_LAST + 1)
+
 struct SeqRenderData {
   Main *bmain;
   Depsgraph *depsgraph;
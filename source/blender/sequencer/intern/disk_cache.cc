@@ -6,9 +6,18 @@
  * \ingroup sequencer
  */
 
+#include <atomic>
 #include <cstddef>
 #include <ctime>
+#include <fcntl.h>
 #include <memory.h>
+#include <zstd.h>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 #include "MEM_guardedalloc.h"
 
@@ -19,13 +28,16 @@
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "BKE_main.hh"
@@ -44,7 +56,11 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * ZLIB compression with user definable level can be used to compress image data(per image)
+ * Image data is split into blocks of DCACHE_BLOCK_SIZE bytes, which are compressed with ZSTD
+ * independently, so that they can be compressed and decompressed in parallel. Bytes of float
+ * images are shuffled before compression, so that bytes with the same significance are next to
+ * each other, which compresses much better. Compression level is user definable.
+ * Files are memory-mapped for reading, blocks are decompressed straight into the image buffer.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -57,7 +73,9 @@
  * `<cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf`. */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 2
+#define DCACHE_CURRENT_VERSION 3
+/* Must be a multiple of the size of a float pixel. */
+#define DCACHE_BLOCK_SIZE (1024 * 1024)
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
 struct DiskCacheHeaderEntry {
@@ -413,62 +431,240 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+/* Header of the image data, followed by the size of each block and the block data. */
+struct DiskCacheBlocksHeader {
+  uint32_t num_blocks;
+  uint32_t flag;
+};
+
+enum {
+  /* Bytes of 4 byte values are grouped by significance before compression. */
+  DCACHE_BLOCKS_SHUFFLED = (1 << 0),
+};
+
+static void *seq_disk_cache_imbuf_data(ImBuf *ibuf)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
+  return (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
+                                               (void *)ibuf->float_buffer.data;
+}
 
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+static int64_t seq_disk_cache_num_blocks(const uint64_t size_raw)
+{
+  return int64_t((size_raw + DCACHE_BLOCK_SIZE - 1) / DCACHE_BLOCK_SIZE);
+}
+
+static void byte_shuffle(const uchar *src, uchar *dst, const size_t size)
+{
+  const size_t num_values = size / 4;
+  for (size_t i = 0; i < num_values; i++) {
+    dst[i] = src[i * 4];
+    dst[num_values + i] = src[i * 4 + 1];
+    dst[num_values * 2 + i] = src[i * 4 + 2];
+    dst[num_values * 3 + i] = src[i * 4 + 3];
   }
+}
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+static void byte_unshuffle(const uchar *src, uchar *dst, const size_t size)
+{
+  const size_t num_values = size / 4;
+  for (size_t i = 0; i < num_values; i++) {
+    dst[i * 4] = src[i];
+    dst[i * 4 + 1] = src[num_values + i];
+    dst[i * 4 + 2] = src[num_values * 2 + i];
+    dst[i * 4 + 3] = src[num_values * 3 + i];
+  }
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+size_t seq_disk_cache_write_image_data(ImBuf *ibuf,
+                                       FILE *file,
+                                       const size_t offset,
+                                       const size_t size_raw,
+                                       const int level)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
-    return 0;
+  using namespace blender;
+
+  const uchar *data = static_cast<const uchar *>(seq_disk_cache_imbuf_data(ibuf));
+  const int64_t num_blocks = seq_disk_cache_num_blocks(size_raw);
+
+  DiskCacheBlocksHeader blocks_header;
+  blocks_header.num_blocks = uint32_t(num_blocks);
+  blocks_header.flag = (level > 0 && ibuf->float_buffer.data) ? DCACHE_BLOCKS_SHUFFLED : 0;
+
+  Array<uint64_t> block_sizes(num_blocks);
+  Array<uchar *> block_data(num_blocks, nullptr);
+
+  if (level > 0) {
+    threading::parallel_for(IndexRange(num_blocks), 1, [&](const IndexRange range) {
+      for (const int64_t block : range) {
+        const uchar *src = data + block * DCACHE_BLOCK_SIZE;
+        const size_t size = min_zz(DCACHE_BLOCK_SIZE, size_raw - block * DCACHE_BLOCK_SIZE);
+
+        uchar *shuffled = nullptr;
+        if (blocks_header.flag & DCACHE_BLOCKS_SHUFFLED) {
+          shuffled = static_cast<uchar *>(MEM_mallocN(size, __func__));
+          byte_shuffle(src, shuffled, size);
+          src = shuffled;
+        }
+
+        const size_t size_bound = ZSTD_compressBound(size);
+        uchar *compressed = static_cast<uchar *>(MEM_mallocN(size_bound, __func__));
+        const size_t size_compressed = ZSTD_compress(compressed, size_bound, src, size, level);
+
+        if (shuffled) {
+          MEM_freeN(shuffled);
+        }
+
+        /* Blocks which don't compress are stored as is, recognized by their size. */
+        if (ZSTD_isError(size_compressed) || size_compressed >= size) {
+          MEM_freeN(compressed);
+          block_sizes[block] = size;
+        }
+        else {
+          block_data[block] = compressed;
+          block_sizes[block] = size_compressed;
+        }
+      }
+    });
+  }
+  else {
+    for (const int64_t block : IndexRange(num_blocks)) {
+      block_sizes[block] = min_zz(DCACHE_BLOCK_SIZE, size_raw - block * DCACHE_BLOCK_SIZE);
+    }
   }
 
-  /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
+  BLI_fseek(file, offset, SEEK_SET);
+  size_t bytes_written = 0;
+  bool ok = fwrite(&blocks_header, sizeof(blocks_header), 1, file) == 1 &&
+            fwrite(block_sizes.data(), sizeof(uint64_t), num_blocks, file) == size_t(num_blocks);
+  bytes_written += sizeof(blocks_header) + sizeof(uint64_t) * num_blocks;
+
+  for (const int64_t block : IndexRange(num_blocks)) {
+    const uchar *src = block_data[block] ? block_data[block] : data + block * DCACHE_BLOCK_SIZE;
+    ok = ok && fwrite(src, 1, block_sizes[block], file) == block_sizes[block];
+    bytes_written += block_sizes[block];
+    MEM_SAFE_FREE(block_data[block]);
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
+  return ok ? bytes_written : 0;
 }
 
-static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
+bool seq_disk_cache_read_image_data(ImBuf *ibuf,
+                                    BLI_mmap_file *mmap_file,
+                                    const size_t offset,
+                                    const size_t size_compressed,
+                                    const size_t size_raw,
+                                    const bool switch_endian)
 {
-  BLI_fseek(file, 0LL, SEEK_SET);
-  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
-  if (num_items_read < 1) {
-    BLI_assert_msg(0, "unable to read disk cache header");
-    perror("unable to read disk cache header");
+  using namespace blender;
+
+  const int64_t num_blocks = seq_disk_cache_num_blocks(size_raw);
+  const size_t table_size = sizeof(DiskCacheBlocksHeader) + sizeof(uint64_t) * num_blocks;
+  if (size_compressed < table_size) {
     return false;
   }
 
+  DiskCacheBlocksHeader blocks_header;
+  Array<uint64_t> block_sizes(num_blocks);
+  if (!BLI_mmap_read(mmap_file, &blocks_header, offset, sizeof(blocks_header)) ||
+      !BLI_mmap_read(mmap_file,
+                     block_sizes.data(),
+                     offset + sizeof(blocks_header),
+                     sizeof(uint64_t) * num_blocks))
+  {
+    return false;
+  }
+
+  if (switch_endian) {
+    BLI_endian_switch_uint32(&blocks_header.num_blocks);
+    BLI_endian_switch_uint32(&blocks_header.flag);
+    BLI_endian_switch_uint64_array(block_sizes.data(), num_blocks);
+  }
+
+  if (blocks_header.num_blocks != num_blocks) {
+    return false;
+  }
+
+  /* Offsets of the blocks in the file, validated against the size of the image data. */
+  Array<size_t> block_offsets(num_blocks);
+  size_t block_offset = offset + table_size;
+  for (const int64_t block : IndexRange(num_blocks)) {
+    block_offsets[block] = block_offset;
+    block_offset += block_sizes[block];
+  }
+  if (block_offset - offset != size_compressed ||
+      block_offset > BLI_mmap_get_length(mmap_file))
+  {
+    return false;
+  }
+
+  uchar *data = static_cast<uchar *>(seq_disk_cache_imbuf_data(ibuf));
+  const uchar *memory = static_cast<const uchar *>(BLI_mmap_get_pointer(mmap_file));
+  const bool is_shuffled = blocks_header.flag & DCACHE_BLOCKS_SHUFFLED;
+  std::atomic<bool> ok = true;
+
+  threading::parallel_for(IndexRange(num_blocks), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      uchar *dst = data + block * DCACHE_BLOCK_SIZE;
+      const size_t size = min_zz(DCACHE_BLOCK_SIZE, size_raw - block * DCACHE_BLOCK_SIZE);
+
+      if (block_sizes[block] == size) {
+        if (!BLI_mmap_read(mmap_file, dst, block_offsets[block], size)) {
+          ok = false;
+        }
+        continue;
+      }
+
+      uchar *shuffled = nullptr;
+      if (is_shuffled) {
+        shuffled = static_cast<uchar *>(MEM_mallocN(size, __func__));
+      }
+
+      const size_t size_decompressed = ZSTD_decompress(
+          shuffled ? shuffled : dst, size, memory + block_offsets[block], block_sizes[block]);
+      if (ZSTD_isError(size_decompressed) || size_decompressed != size) {
+        ok = false;
+      }
+      else if (shuffled) {
+        byte_unshuffle(shuffled, dst, size);
+      }
+
+      if (shuffled) {
+        MEM_freeN(shuffled);
+      }
+    }
+  });
+
+  return ok && !BLI_mmap_any_io_error(mmap_file);
+}
+
+static bool seq_disk_cache_entry_needs_endian_switch(const DiskCacheHeaderEntry *entry)
+{
+  return (ENDIAN_ORDER == B_ENDIAN) && entry->encoding == 0;
+}
+
+static void seq_disk_cache_header_endian_switch(DiskCacheHeader *header)
+{
   for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
-    if ((ENDIAN_ORDER == B_ENDIAN) && header->entry[i].encoding == 0) {
+    if (seq_disk_cache_entry_needs_endian_switch(&header->entry[i])) {
       BLI_endian_switch_uint64(&header->entry[i].frameno);
       BLI_endian_switch_uint64(&header->entry[i].offset);
       BLI_endian_switch_uint64(&header->entry[i].size_compressed);
       BLI_endian_switch_uint64(&header->entry[i].size_raw);
     }
   }
+}
+
+static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
+{
+  BLI_fseek(file, 0LL, SEEK_SET);
+  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
+  if (num_items_read < 1) {
+    BLI_assert_msg(0, "unable to read disk cache header");
+    perror("unable to read disk cache header");
+    return false;
+  }
 
+  seq_disk_cache_header_endian_switch(header);
   return true;
 }
 
@@ -574,8 +770,11 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   }
   int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
 
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+  size_t bytes_written = seq_disk_cache_write_image_data(ibuf,
+                                                         file,
+                                                         header.entry[entry_index].offset,
+                                                         header.entry[entry_index].size_raw,
+                                                         seq_disk_cache_compression_level());
 
   if (bytes_written != 0) {
     /* Last step is writing header, as image data can be overwritten,
@@ -604,61 +803,76 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
-  FILE *file = BLI_fopen(filepath, "rb");
-  if (!file) {
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  if (!seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (mmap_file == nullptr) {
+    close(file);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
+
+  auto read_failed = [&](ImBuf *ibuf) -> ImBuf * {
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+    }
+    BLI_mmap_free(mmap_file);
+    close(file);
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    return nullptr;
+  };
+
+  if (!BLI_mmap_read(mmap_file, &header, 0, sizeof(header))) {
+    return read_failed(nullptr);
+  }
+  seq_disk_cache_header_endian_switch(&header);
+
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
   if (entry_index < 0) {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return nullptr;
+    return read_failed(nullptr);
   }
 
+  const DiskCacheHeaderEntry *entry = &header.entry[entry_index];
   ImBuf *ibuf;
   uint64_t size_char = uint64_t(key->context.rectx) * key->context.recty * 4;
   uint64_t size_float = uint64_t(key->context.rectx) * key->context.recty * 16;
-  size_t expected_size;
 
-  if (header.entry[entry_index].size_raw == size_char) {
-    expected_size = size_char;
+  if (entry->size_raw == size_char) {
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rect | IB_uninitialized_pixels);
-    IMB_colormanagement_assign_byte_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_byte_colorspace(ibuf, entry->colorspace_name);
   }
-  else if (header.entry[entry_index].size_raw == size_float) {
-    expected_size = size_float;
+  else if (entry->size_raw == size_float) {
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rectfloat | IB_uninitialized_pixels);
-    IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_float_colorspace(ibuf, entry->colorspace_name);
   }
   else {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return nullptr;
+    return read_failed(nullptr);
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
-
   /* Sanity check. */
-  if (bytes_read != expected_size) {
-    fclose(file);
-    IMB_freeImBuf(ibuf);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return nullptr;
+  if (!seq_disk_cache_read_image_data(ibuf,
+                                      mmap_file,
+                                      entry->offset,
+                                      entry->size_compressed,
+                                      entry->size_raw,
+                                      seq_disk_cache_entry_needs_endian_switch(entry)))
+  {
+    return read_failed(ibuf);
   }
+
+  BLI_mmap_free(mmap_file);
+  close(file);
+
   BLI_file_touch(filepath);
   seq_disk_cache_update_file(disk_cache, filepath);
-  fclose(file);
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return ibuf;
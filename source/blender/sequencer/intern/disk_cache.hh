@@ -12,6 +12,9 @@
  * \ingroup sequencer
  */
 
+#include <cstdio>
+
+struct BLI_mmap_file;
 struct ImBuf;
 struct Main;
 struct Scene;
@@ -30,3 +33,21 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
                                Sequence *seq,
                                Sequence *seq_changed,
                                int invalidate_types);
+
+/**
+ * Write the pixels of the image at the given offset in the file, using the disk cache format.
+ * The compression level is the ZSTD level, 0 stores the pixels uncompressed.
+ * Returns the number of bytes written, 0 on failure.
+ */
+size_t seq_disk_cache_write_image_data(
+    ImBuf *ibuf, FILE *file, size_t offset, size_t size_raw, int level);
+/**
+ * Read pixels written by #seq_disk_cache_write_image_data into the buffer of the image, which
+ * must have the same size and type as the written image.
+ */
+bool seq_disk_cache_read_image_data(ImBuf *ibuf,
+                                    BLI_mmap_file *mmap_file,
+                                    size_t offset,
+                                    size_t size_compressed,
+                                    size_t size_raw,
+                                    bool switch_endian);
@@ -20,6 +20,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_simd.hh"
 #include "BLI_string.h"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
@@ -121,7 +122,20 @@ static void slice_get_float_buffers(const SeqRenderData *context,
 static float4 load_premul_pixel(const uchar *ptr)
 {
   float4 res;
+#if BLI_HAVE_SSE2
+  /* Same arithmetic as #straight_uchar_to_premul_float, on all channels at once. */
+  const __m128i zero = _mm_setzero_si128();
+  int packed;
+  memcpy(&packed, ptr, sizeof(packed));
+  __m128i rgba32 = _mm_cvtsi32_si128(packed);
+  rgba32 = _mm_unpacklo_epi16(_mm_unpacklo_epi8(rgba32, zero), zero);
+  const float alpha = ptr[3] * (1.0f / 255.0f);
+  const float fac = alpha * (1.0f / 255.0f);
+  const __m128 scale = _mm_set_ps(1.0f / 255.0f, fac, fac, fac);
+  _mm_storeu_ps(res, _mm_mul_ps(_mm_cvtepi32_ps(rgba32), scale));
+#else
   straight_uchar_to_premul_float(res, ptr);
+#endif
   return res;
 }
 
@@ -132,7 +146,21 @@ static float4 load_premul_pixel(const float *ptr)
 
 static void store_premul_pixel(const float4 &pix, uchar *dst)
 {
+#if BLI_HAVE_SSE2
+  /* Same arithmetic as #premul_float_to_straight_uchar, on all channels at once. */
+  const float alpha = pix.w;
+  const float alpha_inv = (alpha == 0.0f || alpha == 1.0f) ? 1.0f : 1.0f / alpha;
+  __m128 rgba = _mm_mul_ps(_mm_loadu_ps(pix), _mm_set_ps(1.0f, alpha_inv, alpha_inv, alpha_inv));
+  rgba = _mm_min_ps(_mm_max_ps(rgba, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+  rgba = _mm_add_ps(_mm_mul_ps(rgba, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+  __m128i rgba8 = _mm_cvttps_epi32(rgba);
+  rgba8 = _mm_packs_epi32(rgba8, rgba8);
+  rgba8 = _mm_packus_epi16(rgba8, rgba8);
+  const int packed = _mm_cvtsi128_si32(rgba8);
+  memcpy(dst, &packed, sizeof(packed));
+#else
   premul_float_to_straight_uchar(dst, pix);
+#endif
 }
 
 static void store_premul_pixel(const float4 &pix, float *dst)
@@ -140,6 +168,26 @@ static void store_premul_pixel(const float4 &pix, float *dst)
   *reinterpret_cast<float4 *>(dst) = pix;
 }
 
+/* Add `src` shifted by `offset` pixels and multiplied by `weight` to `accum`, for the pixels
+ * where the shifted source is inside the row. Rows of RGBA pixels are processed as flat arrays of
+ * channels so the compiler vectorizes the loop, this is the building block of the separable blur
+ * filters. */
+template<typename T>
+static void blur_accumulate_row(const T *src, int width, int offset, float weight, float *accum)
+{
+  const int x_start = math::max(0, -offset);
+  const int x_end = math::min(width, width - offset);
+  if (x_start >= x_end) {
+    return;
+  }
+  const T *src_start = src + int64_t(x_start + offset) * 4;
+  float *accum_start = accum + int64_t(x_start) * 4;
+  const int64_t size = int64_t(x_end - x_start) * 4;
+  for (int64_t i = 0; i < size; i++) {
+    accum_start[i] += float(src_start[i]) * weight;
+  }
+}
+
 static void store_opaque_black_pixel(uchar *dst)
 {
   dst[0] = 0;
@@ -392,17 +440,32 @@ static void do_cross_effect_byte(float fac, int x, int y, uchar *rect1, uchar *r
   int temp_fac = int(256.0f * fac);
   int temp_mfac = 256 - temp_fac;
 
-  for (int i = 0; i < y; i++) {
-    for (int j = 0; j < x; j++) {
-      rt[0] = (temp_mfac * rt1[0] + temp_fac * rt2[0]) >> 8;
-      rt[1] = (temp_mfac * rt1[1] + temp_fac * rt2[1]) >> 8;
-      rt[2] = (temp_mfac * rt1[2] + temp_fac * rt2[2]) >> 8;
-      rt[3] = (temp_mfac * rt1[3] + temp_fac * rt2[3]) >> 8;
+  /* All channels are mixed the same way, so the image can be processed as a flat array. */
+  const int64_t size = int64_t(x) * y * 4;
+  int64_t i = 0;
 
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+#if BLI_HAVE_SSE2
+  /* 16 channels at a time in 16 bit lanes, `255 * 256` still fits. Factors outside of the 0..1
+   * range would overflow, those are left to the scalar loop. */
+  const bool use_simd = temp_fac >= 0 && temp_fac <= 256;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i fac16 = _mm_set1_epi16(short(temp_fac));
+  const __m128i mfac16 = _mm_set1_epi16(short(temp_mfac));
+  for (; use_simd && i + 16 <= size; i += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rt1 + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rt2 + i));
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), mfac16),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), fac16));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), mfac16),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), fac16));
+    lo = _mm_srli_epi16(lo, 8);
+    hi = _mm_srli_epi16(hi, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(rt + i), _mm_packus_epi16(lo, hi));
+  }
+#endif
+
+  for (; i < size; i++) {
+    rt[i] = (temp_mfac * rt1[i] + temp_fac * rt2[i]) >> 8;
   }
 }
 
@@ -414,17 +477,10 @@ static void do_cross_effect_float(float fac, int x, int y, float *rect1, float *
 
   float mfac = 1.0f - fac;
 
-  for (int i = 0; i < y; i++) {
-    for (int j = 0; j < x; j++) {
-      rt[0] = mfac * rt1[0] + fac * rt2[0];
-      rt[1] = mfac * rt1[1] + fac * rt2[1];
-      rt[2] = mfac * rt1[2] + fac * rt2[2];
-      rt[3] = mfac * rt1[3] + fac * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+  /* Flat loop over all channels, trivially vectorized by the compiler. */
+  const int64_t size = int64_t(x) * y * 4;
+  for (int64_t i = 0; i < size; i++) {
+    rt[i] = mfac * rt1[i] + fac * rt2[i];
   }
 }
 
@@ -468,7 +524,7 @@ static void do_cross_effect(const SeqRenderData *context,
  * maybe not even that, but do interpolation in some perceptual color space
  * like OKLAB. But currently it is fixed to just 2.0 gamma. */
 
-static float gammaCorrect(float c)
+[[maybe_unused]] static float gammaCorrect(float c)
 {
   if (UNLIKELY(c < 0)) {
     return -(c * c);
@@ -476,11 +532,34 @@ static float gammaCorrect(float c)
   return c * c;
 }
 
-static float invGammaCorrect(float c)
+[[maybe_unused]] static float invGammaCorrect(float c)
 {
   return sqrtf_signed(c);
 }
 
+static float4 gammacross_pixel(const float4 &col1, const float4 &col2, float fac, float mfac)
+{
+  float4 col;
+#if BLI_HAVE_SSE2
+  /* Same as #invGammaCorrect and #gammaCorrect, on all channels at once. */
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 a = _mm_loadu_ps(col1);
+  const __m128 b = _mm_loadu_ps(col2);
+  const __m128 a_inv = _mm_or_ps(_mm_sqrt_ps(_mm_andnot_ps(sign_mask, a)),
+                                 _mm_and_ps(sign_mask, a));
+  const __m128 b_inv = _mm_or_ps(_mm_sqrt_ps(_mm_andnot_ps(sign_mask, b)),
+                                 _mm_and_ps(sign_mask, b));
+  const __m128 mix = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(mfac), a_inv),
+                                _mm_mul_ps(_mm_set1_ps(fac), b_inv));
+  _mm_storeu_ps(col, _mm_mul_ps(mix, _mm_andnot_ps(sign_mask, mix)));
+#else
+  for (int c = 0; c < 4; ++c) {
+    col[c] = gammaCorrect(mfac * invGammaCorrect(col1[c]) + fac * invGammaCorrect(col2[c]));
+  }
+#endif
+  return col;
+}
+
 template<typename T>
 static void do_gammacross_effect(
     float fac, int width, int height, const T *src1, const T *src2, T *dst)
@@ -491,10 +570,7 @@ static void do_gammacross_effect(
     for (int x = 0; x < width; x++) {
       float4 col1 = load_premul_pixel(src1);
       float4 col2 = load_premul_pixel(src2);
-      float4 col;
-      for (int c = 0; c < 4; ++c) {
-        col[c] = gammaCorrect(mfac * invGammaCorrect(col1[c]) + fac * invGammaCorrect(col2[c]));
-      }
+      float4 col = gammacross_pixel(col1, col2, fac, mfac);
       store_premul_pixel(col, dst);
       src1 += 4;
       src2 += 4;
@@ -711,17 +787,27 @@ static void do_sub_effect(const SeqRenderData *context,
 #define XOFF 8
 #define YOFF 8
 
-static void do_drop_effect_byte(float fac, int x, int y, uchar *rect2i, uchar *rect1i, uchar *outi)
+/* The shadow is read from `YOFF` rows further in the frame, which can be outside of the slice
+ * starting at `start_line`, so the result does not depend on how the frame is sliced. */
+static void do_drop_effect_byte(float fac,
+                                int x,
+                                int y,
+                                int start_line,
+                                int frame_height,
+                                uchar *rect2i,
+                                uchar *rect1i,
+                                uchar *outi)
 {
   const int xoff = min_ii(XOFF, x);
-  const int yoff = min_ii(YOFF, y);
+  const int yoff = min_ii(YOFF, frame_height);
+  const int shadow_lines = clamp_i(frame_height - yoff - start_line, 0, y);
 
   int temp_fac = int(70.0f * fac);
 
   uchar *rt2 = rect2i + yoff * 4 * x;
   uchar *rt1 = rect1i;
   uchar *out = outi;
-  for (int i = 0; i < y - yoff; i++) {
+  for (int i = 0; i < shadow_lines; i++) {
     memcpy(out, rt1, sizeof(*out) * xoff * 4);
     rt1 += xoff * 4;
     out += xoff * 4;
@@ -741,21 +827,28 @@ static void do_drop_effect_byte(float fac, int x, int y, uchar *rect2i, uchar *r
     }
     rt2 += xoff * 4;
   }
-  memcpy(out, rt1, sizeof(*out) * yoff * 4 * x);
+  memcpy(out, rt1, sizeof(*out) * (y - shadow_lines) * 4 * x);
 }
 
-static void do_drop_effect_float(
-    float fac, int x, int y, float *rect2i, float *rect1i, float *outi)
+static void do_drop_effect_float(float fac,
+                                 int x,
+                                 int y,
+                                 int start_line,
+                                 int frame_height,
+                                 float *rect2i,
+                                 float *rect1i,
+                                 float *outi)
 {
   const int xoff = min_ii(XOFF, x);
-  const int yoff = min_ii(YOFF, y);
+  const int yoff = min_ii(YOFF, frame_height);
+  const int shadow_lines = clamp_i(frame_height - yoff - start_line, 0, y);
 
   float temp_fac = 70.0f * fac;
 
   float *rt2 = rect2i + yoff * 4 * x;
   float *rt1 = rect1i;
   float *out = outi;
-  for (int i = 0; i < y - yoff; i++) {
+  for (int i = 0; i < shadow_lines; i++) {
     memcpy(out, rt1, sizeof(*out) * xoff * 4);
     rt1 += xoff * 4;
     out += xoff * 4;
@@ -775,7 +868,7 @@ static void do_drop_effect_float(
     }
     rt2 += xoff * 4;
   }
-  memcpy(out, rt1, sizeof(*out) * yoff * 4 * x);
+  memcpy(out, rt1, sizeof(*out) * (y - shadow_lines) * 4 * x);
 }
 
 /** \} */
@@ -871,25 +964,136 @@ static void do_mul_effect(const SeqRenderData *context,
 /* blend_function has to be: void (T* dst, const T *src1, const T *src2) */
 template<typename T, typename Func>
 static void apply_blend_function(
-    float fac, int width, int height, const T *src1, T *src2, T *dst, Func blend_function)
+    float fac, int width, int height, const T *src1, const T *src2, T *dst, Func blend_function)
+{
+  const int64_t size = int64_t(width) * height;
+  for (int64_t i = 0; i < size; i++) {
+    /* Blend against a copy of the second input with the factor applied to its alpha, so the
+     * input buffer is not written to. */
+    const T col2[4] = {src2[0], src2[1], src2[2], T(src2[3] * fac)};
+    blend_function(dst, src1, col2);
+    dst[3] = src1[3];
+    src1 += 4;
+    src2 += 4;
+    dst += 4;
+  }
+}
+
+#if BLI_HAVE_SSE2
+
+/* Vectorized versions of the separable float blend modes from `BLI_math_color_blend.h`.
+ * blend_function has to be: __m128 (__m128 col1, __m128 col2, __m128 alpha1, __m128 fac2), where
+ * `fac2` is the alpha of `col2` with the effect factor applied. The alpha channel of the result is
+ * ignored, the alpha of `col1` is used instead. */
+template<typename Func>
+static void apply_blend_function_simd(
+    float fac, int64_t size, const float *src1, const float *src2, float *dst, Func blend_function)
 {
-  for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      T achannel = src2[3];
-      src2[3] = T(achannel * fac);
-      blend_function(dst, src1, src2);
-      src2[3] = achannel;
-      dst[3] = src1[3];
-      src1 += 4;
-      src2 += 4;
-      dst += 4;
+  const __m128 rgb_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  for (int64_t i = 0; i < size; i++) {
+    const __m128 col1 = _mm_loadu_ps(src1);
+    const float fac2 = src2[3] * fac;
+    if (fac2 == 0.0f) {
+      _mm_storeu_ps(dst, col1);
+    }
+    else {
+      const __m128 alpha1 = _mm_shuffle_ps(col1, col1, _MM_SHUFFLE(3, 3, 3, 3));
+      const __m128 col = blend_function(col1, _mm_loadu_ps(src2), alpha1, _mm_set1_ps(fac2));
+      _mm_storeu_ps(dst, _mm_or_ps(_mm_and_ps(rgb_mask, col), _mm_andnot_ps(rgb_mask, col1)));
     }
+    src1 += 4;
+    src2 += 4;
+    dst += 4;
   }
 }
 
+static __m128 blend_mix_simd(const __m128 col1, const __m128 col, const __m128 t)
+{
+  return _mm_add_ps(_mm_mul_ps(col, t), _mm_mul_ps(col1, _mm_sub_ps(_mm_set1_ps(1.0f), t)));
+}
+
+/* Returns false when the blend mode has no vectorized version. */
+static bool do_blend_effect_float_simd(
+    float fac, int64_t size, const float *rect1, const float *rect2, int btype, float *out)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  switch (btype) {
+    case SEQ_TYPE_ADD:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 a1, __m128 /*t*/) {
+            return _mm_add_ps(col1, _mm_mul_ps(col2, a1));
+          });
+      return true;
+    case SEQ_TYPE_SUB:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 a1, __m128 /*t*/) {
+            return _mm_max_ps(_mm_sub_ps(col1, _mm_mul_ps(col2, a1)), zero);
+          });
+      return true;
+    case SEQ_TYPE_MUL:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 a1, __m128 t) {
+            return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, t), col1),
+                              _mm_mul_ps(_mm_mul_ps(col1, col2), a1));
+          });
+      return true;
+    case SEQ_TYPE_DARKEN:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 a1, __m128 t) {
+            const __m128 map_alpha = _mm_div_ps(a1, t);
+            return blend_mix_simd(col1, _mm_min_ps(col1, _mm_mul_ps(col2, map_alpha)), t);
+          });
+      return true;
+    case SEQ_TYPE_LIGHTEN:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 a1, __m128 t) {
+            const __m128 map_alpha = _mm_div_ps(a1, t);
+            return blend_mix_simd(col1, _mm_max_ps(col1, _mm_mul_ps(col2, map_alpha)), t);
+          });
+      return true;
+    case SEQ_TYPE_SCREEN:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 /*a1*/, __m128 t) {
+            const __m128 screen = _mm_sub_ps(
+                one, _mm_mul_ps(_mm_sub_ps(one, col1), _mm_sub_ps(one, col2)));
+            return blend_mix_simd(col1, _mm_max_ps(screen, zero), t);
+          });
+      return true;
+    case SEQ_TYPE_DIFFERENCE:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 /*a1*/, __m128 t) {
+            const __m128 difference = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(col1, col2));
+            return blend_mix_simd(col1, difference, t);
+          });
+      return true;
+    case SEQ_TYPE_EXCLUSION:
+      apply_blend_function_simd(
+          fac, size, rect1, rect2, out, [&](__m128 col1, __m128 col2, __m128 /*a1*/, __m128 t) {
+            const __m128 exclusion = _mm_sub_ps(
+                half,
+                _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_sub_ps(col1, half)),
+                           _mm_sub_ps(col2, half)));
+            return blend_mix_simd(col1, exclusion, t);
+          });
+      return true;
+    default:
+      return false;
+  }
+}
+
+#endif /* BLI_HAVE_SSE2 */
+
 static void do_blend_effect_float(
-    float fac, int x, int y, const float *rect1, float *rect2, int btype, float *out)
+    float fac, int x, int y, const float *rect1, const float *rect2, int btype, float *out)
 {
+#if BLI_HAVE_SSE2
+  if (do_blend_effect_float_simd(fac, int64_t(x) * y, rect1, rect2, btype, out)) {
+    return;
+  }
+#endif
+
   switch (btype) {
     case SEQ_TYPE_ADD:
       apply_blend_function(fac, x, y, rect1, rect2, out, blend_color_add_float);
@@ -960,7 +1164,7 @@ static void do_blend_effect_float(
 }
 
 static void do_blend_effect_byte(
-    float fac, int x, int y, const uchar *rect1, uchar *rect2, int btype, uchar *out)
+    float fac, int x, int y, const uchar *rect1, const uchar *rect2, int btype, uchar *out)
 {
   switch (btype) {
     case SEQ_TYPE_ADD:
@@ -1706,29 +1910,33 @@ static void glow_blur_bitmap(
   /* Blur the rows: read map, write temp */
   threading::parallel_for(IndexRange(height), 32, [&](const IndexRange y_range) {
     for (const int y : y_range) {
-      for (int x = 0; x < width; x++) {
-        float4 curColor = float4(0.0f);
-        int xmin = math::max(x - halfWidth, 0);
-        int xmax = math::min(x + halfWidth, width);
-        for (int nx = xmin, index = (xmin - x) + halfWidth; nx < xmax; nx++, index++) {
-          curColor += map[nx + y * width] * filter[index];
-        }
-        temp[x + y * width] = curColor;
+      float *dst = reinterpret_cast<float *>(&temp[y * width]);
+      const float *row = reinterpret_cast<const float *>(&map[y * width]);
+      std::fill_n(dst, width * 4, 0.0f);
+      for (int index = 0; index < halfWidth * 2; index++) {
+        blur_accumulate_row(row, width, index - halfWidth, filter[index], dst);
       }
     }
   });
 
-  /* Blur the columns: read temp, write map */
-  threading::parallel_for(IndexRange(width), 32, [&](const IndexRange x_range) {
+  /* Blur the columns: read temp, write map. Whole rows are accumulated at once, which keeps the
+   * memory access sequential. */
+  threading::parallel_for(IndexRange(height), 32, [&](const IndexRange y_range) {
     const float4 one = float4(1.0f);
-    for (const int x : x_range) {
-      for (int y = 0; y < height; y++) {
-        float4 curColor = float4(0.0f);
-        int ymin = math::max(y - halfWidth, 0);
-        int ymax = math::min(y + halfWidth, height);
-        for (int ny = ymin, index = (ymin - y) + halfWidth; ny < ymax; ny++, index++) {
-          curColor += temp[x + ny * width] * filter[index];
-        }
+    Array<float4> accum(width);
+    for (const int y : y_range) {
+      accum.fill(float4(0.0f));
+      int ymin = math::max(y - halfWidth, 0);
+      int ymax = math::min(y + halfWidth, height);
+      for (int ny = ymin, index = (ymin - y) + halfWidth; ny < ymax; ny++, index++) {
+        blur_accumulate_row(reinterpret_cast<const float *>(&temp[ny * width]),
+                            width,
+                            0,
+                            filter[index],
+                            reinterpret_cast<float *>(accum.data()));
+      }
+      for (int x = 0; x < width; x++) {
+        float4 curColor = accum[x];
         if (src != nullptr) {
           curColor = math::min(one, src[x + y * width] + curColor);
         }
@@ -2339,7 +2547,7 @@ static void do_overdrop_effect(const SeqRenderData *context,
     slice_get_float_buffers(
         context, ibuf1, ibuf2, nullptr, out, start_line, &rect1, &rect2, nullptr, &rect_out);
 
-    do_drop_effect_float(fac, x, y, rect1, rect2, rect_out);
+    do_drop_effect_float(fac, x, y, start_line, context->recty, rect1, rect2, rect_out);
     do_alphaover_effect(fac, x, y, rect1, rect2, rect_out);
   }
   else {
@@ -2348,7 +2556,7 @@ static void do_overdrop_effect(const SeqRenderData *context,
     slice_get_byte_buffers(
         context, ibuf1, ibuf2, nullptr, out, start_line, &rect1, &rect2, nullptr, &rect_out);
 
-    do_drop_effect_byte(fac, x, y, rect1, rect2, rect_out);
+    do_drop_effect_byte(fac, x, y, start_line, context->recty, rect1, rect2, rect_out);
     do_alphaover_effect(fac, x, y, rect1, rect2, rect_out);
   }
 }
@@ -2413,8 +2621,22 @@ static Array<float> make_gaussian_blur_kernel(float rad, int size)
   return gaussian;
 }
 
+/* Store an accumulated row, scaled by the inverse of the kernel weight of each pixel. */
+template<typename T>
+static void gaussian_blur_store_row(const float *accum, const float *inv_weight, int width, T *dst)
+{
+  for (int x = 0; x < width; x++) {
+    for (int c = 0; c < 4; c++) {
+      dst[c] = accum[c] * inv_weight[x];
+    }
+    accum += 4;
+    dst += 4;
+  }
+}
+
 template<typename T>
 static void gaussian_blur_x(const Span<float> gaussian,
+                            const Span<float> inv_weight,
                             int half_size,
                             int start_line,
                             int width,
@@ -2423,27 +2645,18 @@ static void gaussian_blur_x(const Span<float> gaussian,
                             const T *rect,
                             T *dst)
 {
+  Array<float> accum(int64_t(width) * 4);
   dst += int64_t(start_line) * width * 4;
   for (int y = start_line; y < start_line + height; y++) {
-    for (int x = 0; x < width; x++) {
-      float4 accum(0.0f);
-      float accum_weight = 0.0f;
-
-      int xmin = math::max(x - half_size, 0);
-      int xmax = math::min(x + half_size, width - 1);
-      for (int nx = xmin, index = (xmin - x) + half_size; nx <= xmax; nx++, index++) {
-        float weight = gaussian[index];
-        int offset = (y * width + nx) * 4;
-        accum += float4(rect + offset) * weight;
-        accum_weight += weight;
-      }
-      accum *= (1.0f / accum_weight);
-      dst[0] = accum[0];
-      dst[1] = accum[1];
-      dst[2] = accum[2];
-      dst[3] = accum[3];
-      dst += 4;
+    /* Accumulate the shifted row for each kernel tap, pixels near the row ends only get the taps
+     * inside the image and are normalized by their total weight. */
+    const T *row = rect + int64_t(y) * width * 4;
+    accum.fill(0.0f);
+    for (int index = 0; index < half_size * 2 + 1; index++) {
+      blur_accumulate_row(row, width, index - half_size, gaussian[index], accum.data());
     }
+    gaussian_blur_store_row(accum.data(), inv_weight.data(), width, dst);
+    dst += int64_t(width) * 4;
   }
 }
 
@@ -2457,27 +2670,40 @@ static void gaussian_blur_y(const Span<float> gaussian,
                             const T *rect,
                             T *dst)
 {
+  Array<float> accum(int64_t(width) * 4);
+  Array<float> inv_weight(width);
   dst += int64_t(start_line) * width * 4;
   for (int y = start_line; y < start_line + height; y++) {
-    for (int x = 0; x < width; x++) {
-      float4 accum(0.0f);
-      float accum_weight = 0.0f;
-      int ymin = math::max(y - half_size, 0);
-      int ymax = math::min(y + half_size, frame_height - 1);
-      for (int ny = ymin, index = (ymin - y) + half_size; ny <= ymax; ny++, index++) {
-        float weight = gaussian[index];
-        int offset = (ny * width + x) * 4;
-        accum += float4(rect + offset) * weight;
-        accum_weight += weight;
-      }
-      accum *= (1.0f / accum_weight);
-      dst[0] = accum[0];
-      dst[1] = accum[1];
-      dst[2] = accum[2];
-      dst[3] = accum[3];
-      dst += 4;
+    /* Accumulate whole rows, which keeps the memory access sequential. */
+    accum.fill(0.0f);
+    float accum_weight = 0.0f;
+    int ymin = math::max(y - half_size, 0);
+    int ymax = math::min(y + half_size, frame_height - 1);
+    for (int ny = ymin, index = (ymin - y) + half_size; ny <= ymax; ny++, index++) {
+      float weight = gaussian[index];
+      blur_accumulate_row(rect + int64_t(ny) * width * 4, width, 0, weight, accum.data());
+      accum_weight += weight;
+    }
+    inv_weight.fill(1.0f / accum_weight);
+    gaussian_blur_store_row(accum.data(), inv_weight.data(), width, dst);
+    dst += int64_t(width) * 4;
+  }
+}
+
+/* Inverse of the sum of the kernel weights that fall inside the row, for each pixel of a row. */
+static Array<float> gaussian_blur_inv_weights(const Span<float> gaussian, int half_size, int width)
+{
+  Array<float> inv_weight(width);
+  for (int x = 0; x < width; x++) {
+    float accum_weight = 0.0f;
+    int xmin = math::max(x - half_size, 0);
+    int xmax = math::min(x + half_size, width - 1);
+    for (int nx = xmin, index = (xmin - x) + half_size; nx <= xmax; nx++, index++) {
+      accum_weight += gaussian[index];
     }
+    inv_weight[x] = 1.0f / accum_weight;
   }
+  return inv_weight;
 }
 
 static ImBuf *do_gaussian_blur_effect(const SeqRenderData *context,
@@ -2498,6 +2724,7 @@ static ImBuf *do_gaussian_blur_effect(const SeqRenderData *context,
   Array<float> gaussian_y = make_gaussian_blur_kernel(data->size_y, half_size_y);
 
   const int width = context->rectx;
+  const Array<float> inv_weight_x = gaussian_blur_inv_weights(gaussian_x, half_size_x, width);
   const int height = context->recty;
   const bool is_float = ibuf1->float_buffer.data;
 
@@ -2508,6 +2735,7 @@ static ImBuf *do_gaussian_blur_effect(const SeqRenderData *context,
     const int y_size = y_range.size();
     if (is_float) {
       gaussian_blur_x(gaussian_x,
+                      inv_weight_x,
                       half_size_x,
                       y_first,
                       width,
@@ -2518,6 +2746,7 @@ static ImBuf *do_gaussian_blur_effect(const SeqRenderData *context,
     }
     else {
       gaussian_blur_x(gaussian_x,
+                      inv_weight_x,
                       half_size_x,
                       y_first,
                       width,
@@ -2568,6 +2797,9 @@ static ImBuf *do_gaussian_blur_effect(const SeqRenderData *context,
 /** \name Text Effect
  * \{ */
 
+/* Serializes loading and drawing of the text strip fonts. */
+static ThreadMutex text_font_mutex = BLI_MUTEX_INITIALIZER;
+
 static void init_text_effect(Sequence *seq)
 {
   TextVars *data;
@@ -3126,18 +3358,14 @@ static void fill_rect_alpha_under(
   }
 }
 
-static ImBuf *do_text_effect(const SeqRenderData *context,
-                             Sequence *seq,
-                             float /*timeline_frame*/,
-                             float /*fac*/,
-                             ImBuf * /*ibuf1*/,
-                             ImBuf * /*ibuf2*/,
-                             ImBuf * /*ibuf3*/)
+/* Must be called with #text_font_mutex locked. */
+static void draw_text_locked(const SeqRenderData *context,
+                             TextVars *data,
+                             ImBuf *out,
+                             int &line_height,
+                             rcti &rect,
+                             rcti &outline_rect)
 {
-  /* NOTE: text rasterization only fills in part of output image,
-   * need to clear it. */
-  ImBuf *out = prepare_effect_imbufs(context, nullptr, nullptr, nullptr, false);
-  TextVars *data = static_cast<TextVars *>(seq->effectdata);
   const int width = out->x;
   const int height = out->y;
   int font = blf_mono_font_render;
@@ -3176,7 +3404,7 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
 
   BLF_buffer(font, nullptr, out->byte_buffer.data, width, height, display);
 
-  const int line_height = BLF_height_max(font);
+  line_height = BLF_height_max(font);
 
   y_ofs = -BLF_descender(font);
 
@@ -3184,7 +3412,6 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
   y = (data->loc[1] * height) + y_ofs;
 
   /* Calculate bounding box and wrapping information. */
-  rcti rect;
   ResultBLF wrap_info;
   BLF_boundbox(font, data->text, sizeof(data->text), &rect, &wrap_info);
 
@@ -3212,7 +3439,7 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
   BLI_rcti_translate(&rect, x, y);
 
   /* Draw text outline. */
-  rcti outline_rect = rect;
+  outline_rect = rect;
   if (data->flag & SEQ_TEXT_OUTLINE) {
     outline_rect = draw_text_outline(context, data, font, display, x, y, line_height, rect, out);
   }
@@ -3224,6 +3451,32 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
 
   BLF_buffer(font, nullptr, nullptr, 0, 0, nullptr);
   BLF_disable(font, font_flags);
+}
+
+static ImBuf *do_text_effect(const SeqRenderData *context,
+                             Sequence *seq,
+                             float /*timeline_frame*/,
+                             float /*fac*/,
+                             ImBuf * /*ibuf1*/,
+                             ImBuf * /*ibuf2*/,
+                             ImBuf * /*ibuf3*/)
+{
+  /* NOTE: text rasterization only fills in part of output image,
+   * need to clear it. */
+  ImBuf *out = prepare_effect_imbufs(context, nullptr, nullptr, nullptr, false);
+  TextVars *data = static_cast<TextVars *>(seq->effectdata);
+  const int width = out->x;
+  int line_height;
+  rcti rect, outline_rect;
+
+  /* Fonts are shared between the evaluated copies of the strip, which prefetch threads can render
+   * at the same time, and the BLF buffer drawing state is stored in the font. The outline is drawn
+   * with a parallel loop, isolate it so the lock is never waited for by a task of this thread. */
+  BLI_mutex_lock(&text_font_mutex);
+  threading::isolate_task([&]() {
+    draw_text_locked(context, data, out, line_height, rect, outline_rect);
+  });
+  BLI_mutex_unlock(&text_font_mutex);
 
   /* Draw shadow. */
   if (data->flag & SEQ_TEXT_SHADOW) {
@@ -6,6 +6,8 @@
  * \ingroup bke
  */
 
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <ctime>
 #include <memory.h>
@@ -21,8 +23,11 @@
 
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
+#include "BLI_hash.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
 
 #include "BKE_main.hh"
 
@@ -53,22 +58,49 @@
  * Entries are linked in order as they are put into cache.
  * Only permanent (is_temp_cache = 0) cache entries are linked.
  * Putting #SEQ_CACHE_STORE_FINAL_OUT will reset linking
+ * Each render task has its own chain, so frames rendered concurrently by prefetch threads are
+ * linked independently.
  *
  * Only entire frame can be freed to release resources for new entries (recycling).
  * Once again, this is to reduce number of iterations, but also more controllable than removing
  * entries one by one in reverse order to their creation.
+ * The frame to free is chosen by how expensive it was to render, how much memory it uses and how
+ * far it is from the current frame, see #seq_cache_frame_retain_score.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Locking:
+ * Entries are distributed over several shards by their hash, each with its own read-write lock.
+ * Lookups only lock a single shard for reading, so render threads and drawing rarely wait for
+ * each other. Changes to the cache lock `iterator_mutex` and, for the duration of the insertion
+ * or removal, the shard of the entry for writing. Linking, recycling and iteration therefore only
+ * need `iterator_mutex`.
  */
 
-struct SeqCache {
-  Main *bmain;
+/* Number of independently locked parts of the cache, must be a power of two. */
+#define SEQ_CACHE_SHARDS 16
+
+struct SeqCacheShard {
+  ThreadRWMutex lock;
   GHash *hash;
+};
+
+struct SeqCache {
+  Main *bmain = nullptr;
+  SeqCacheShard shards[SEQ_CACHE_SHARDS];
   ThreadMutex iterator_mutex;
-  BLI_mempool *keys_pool;
-  BLI_mempool *items_pool;
-  SeqCacheKey *last_key;
-  SeqDiskCache *disk_cache;
+  BLI_mempool *keys_pool = nullptr;
+  BLI_mempool *items_pool = nullptr;
+  /* Last linked key of each render task, see #eSeqTaskId. */
+  SeqCacheKey *last_key[SEQ_TASK_NUM] = {};
+  SeqDiskCache *disk_cache = nullptr;
+
+  /* Statistics, see #SeqCacheStatistics. */
+  std::atomic<int64_t> hits = 0;
+  std::atomic<int64_t> misses = 0;
+  std::atomic<int64_t> evicted_frames = 0;
+  std::atomic<int64_t> item_count = 0;
+  std::atomic<size_t> mem_in_use = 0;
 };
 
 struct SeqCacheItem {
@@ -122,6 +154,13 @@ static bool seq_cache_hashcmp(const void *a_, const void *b_)
           seq_cmp_render_data(&a->context, &b->context));
 }
 
+static SeqCacheShard &seq_cache_shard_get(SeqCache *cache, const SeqCacheKey *key)
+{
+  /* The key hash is mostly made of pointers and float bits, mix it to use all shards. */
+  const uint hash = BLI_hash_int(seq_cache_hashhash(key));
+  return cache->shards[hash & (SEQ_CACHE_SHARDS - 1)];
+}
+
 static float seq_cache_timeline_frame_to_frame_index(Scene *scene,
                                                      const Sequence *seq,
                                                      float timeline_frame,
@@ -192,6 +231,32 @@ static void seq_cache_valfree(void *val)
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
+/* Lookup without locking the shard, only valid while holding `iterator_mutex`. */
+static SeqCacheItem *seq_cache_item_lookup(SeqCache *cache, const SeqCacheKey *key)
+{
+  return static_cast<SeqCacheItem *>(BLI_ghash_lookup(seq_cache_shard_get(cache, key).hash, key));
+}
+
+static bool seq_cache_haskey(SeqCache *cache, const SeqCacheKey *key)
+{
+  return BLI_ghash_haskey(seq_cache_shard_get(cache, key).hash, key);
+}
+
+static void seq_cache_remove(SeqCache *cache, SeqCacheKey *key)
+{
+  SeqCacheShard &shard = seq_cache_shard_get(cache, key);
+  const size_t mem_size = key->mem_size;
+
+  BLI_rw_mutex_lock(&shard.lock, THREAD_LOCK_WRITE);
+  const bool removed = BLI_ghash_remove(shard.hash, key, seq_cache_keyfree, seq_cache_valfree);
+  BLI_rw_mutex_unlock(&shard.lock);
+
+  if (removed) {
+    cache->item_count--;
+    cache->mem_in_use -= mem_size;
+  }
+}
+
 static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
 {
   int flag;
@@ -208,7 +273,7 @@ static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
   return flag;
 }
 
-static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
+static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf, const float cost)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheItem *item;
@@ -218,44 +283,65 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
+  SeqCacheKey **last_key = &cache->last_key[key->task_id];
+
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = *last_key;
   }
 
-  BLI_assert(!BLI_ghash_haskey(cache->hash, key));
-  BLI_ghash_insert(cache->hash, key, item);
+  key->cost = cost;
+  key->mem_size = IMB_get_size_in_memory(ibuf);
+
+  SeqCacheShard &shard = seq_cache_shard_get(cache, key);
+  BLI_rw_mutex_lock(&shard.lock, THREAD_LOCK_WRITE);
+  BLI_assert(!BLI_ghash_haskey(shard.hash, key));
+  BLI_ghash_insert(shard.hash, key, item);
   IMB_refImBuf(ibuf);
+  BLI_rw_mutex_unlock(&shard.lock);
+
+  cache->item_count++;
+  cache->mem_in_use += key->mem_size;
 
   /* Store pointer to last cached key. */
-  SeqCacheKey *temp_last_key = cache->last_key;
-  cache->last_key = key;
+  SeqCacheKey *temp_last_key = *last_key;
+  *last_key = key;
 
   /* Set last_key's reference to this key so we can look up chain backwards.
-   * Item is already put in cache, so cache->last_key points to current key.
+   * Item is already put in cache, so last_key points to current key.
    */
   if (!key->is_temp_cache && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = *last_key;
   }
 
   /* Reset linking. */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = nullptr;
+    *last_key = nullptr;
+  }
+}
+
+static void seq_cache_reset_linking(SeqCache *cache)
+{
+  for (int i = 0; i < SEQ_TASK_NUM; i++) {
+    cache->last_key[i] = nullptr;
   }
 }
 
 static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
 {
-  SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghash_lookup(cache->hash, key));
+  SeqCacheShard &shard = seq_cache_shard_get(cache, key);
+  ImBuf *ibuf = nullptr;
 
+  BLI_rw_mutex_lock(&shard.lock, THREAD_LOCK_READ);
+  SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghash_lookup(shard.hash, key));
   if (item && item->ibuf) {
-    IMB_refImBuf(item->ibuf);
-
-    return item->ibuf;
+    ibuf = item->ibuf;
+    IMB_refImBuf(ibuf);
   }
+  BLI_rw_mutex_unlock(&shard.lock);
 
-  return nullptr;
+  return ibuf;
 }
 
 static void seq_cache_key_unlink(SeqCacheKey *key)
@@ -270,12 +356,9 @@ static void seq_cache_key_unlink(SeqCacheKey *key)
   }
 }
 
-/* Choose a key out of 2 candidates(leftmost and rightmost items)
- * to recycle based on currently used strategy */
-static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCacheKey *rkey)
+/* Whether the frame of `key` must be kept because the prefetch job is rendering it. */
+static bool seq_cache_key_is_prefetched(Scene *scene, const SeqCacheKey *key)
 {
-  SeqCacheKey *finalkey = nullptr;
-
   /* Ideally, cache would not need to check the state of prefetching task
    * that is tricky to do however, because prefetch would need to know,
    * if a key, that is about to be created would be removed by itself.
@@ -290,47 +373,33 @@ static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCac
     int pfjob_start, pfjob_end;
     seq_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
 
-    if (lkey) {
-      if (lkey->timeline_frame < pfjob_start || lkey->timeline_frame > pfjob_end) {
-        return lkey;
-      }
-    }
-
-    if (rkey) {
-      if (rkey->timeline_frame < pfjob_start || rkey->timeline_frame > pfjob_end) {
-        return rkey;
-      }
-    }
-
-    return nullptr;
+    return key->timeline_frame >= pfjob_start && key->timeline_frame <= pfjob_end;
   }
+  return false;
+}
 
-  if (rkey && lkey) {
-    if (lkey->timeline_frame > rkey->timeline_frame) {
-      SeqCacheKey *swapkey = lkey;
-      lkey = rkey;
-      rkey = swapkey;
-    }
+/**
+ * How valuable it is to keep the frame which ends with `key` in the cache, higher is better.
+ * Frames that took long to render are worth more than cheap ones using the same amount of memory,
+ * and frames close to the current frame are more likely to be displayed again soon.
+ */
+static float seq_cache_frame_retain_score(const Scene *scene, const SeqCacheKey *key)
+{
+  float cost = 0.0f;
+  size_t mem_size = 0;
 
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
+  for (const SeqCacheKey *link = key; link; link = link->link_prev) {
+    cost += link->cost;
+    mem_size += link->mem_size;
 
-    if (l_diff > r_diff) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  else {
-    if (lkey) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
+    if (link->link_prev != nullptr && link->link_prev->link_next != link) {
+      break; /* Key doesn't belong to this chain anymore, see #seq_cache_recycle_linked. */
     }
   }
-  return finalkey;
+
+  const float mem_mb = float(double(mem_size) / (1024.0 * 1024.0));
+  const float distance = fabsf(key->timeline_frame - float(scene->r.cfra));
+  return (1.0f + cost) / ((1.0f + mem_mb) * (1.0f + distance));
 }
 
 static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
@@ -343,7 +412,7 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   SeqCacheKey *next = base->link_next;
 
   while (base) {
-    if (!BLI_ghash_haskey(cache->hash, base)) {
+    if (!seq_cache_haskey(cache, base)) {
       break; /* Key has already been removed from cache. */
     }
 
@@ -355,14 +424,14 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
     }
 
     seq_cache_key_unlink(base);
-    BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
-    BLI_assert(base != cache->last_key);
+    BLI_assert(base != cache->last_key[base->task_id]);
+    seq_cache_remove(cache, base);
     base = prev;
   }
 
   base = next;
   while (base) {
-    if (!BLI_ghash_haskey(cache->hash, base)) {
+    if (!seq_cache_haskey(cache, base)) {
       break; /* Key has already been removed from cache. */
     }
 
@@ -374,8 +443,8 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
     }
 
     seq_cache_key_unlink(base);
-    BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
-    BLI_assert(base != cache->last_key);
+    BLI_assert(base != cache->last_key[base->task_id]);
+    seq_cache_remove(cache, base);
     base = next;
   }
 }
@@ -384,56 +453,31 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = nullptr;
-  /* Leftmost key. */
-  SeqCacheKey *lkey = nullptr;
-  /* Rightmost key. */
-  SeqCacheKey *rkey = nullptr;
-  SeqCacheKey *key = nullptr;
-
-  GHashIterator gh_iter;
-  BLI_ghashIterator_init(&gh_iter, cache->hash);
-  int total_count = 0;
-
-  while (!BLI_ghashIterator_done(&gh_iter)) {
-    key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
-    SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghashIterator_getValue(&gh_iter));
-    BLI_ghashIterator_step(&gh_iter);
-    BLI_assert(key->cache_owner == cache);
-
-    /* This shouldn't happen, but better be safe than sorry. */
-    if (!item->ibuf) {
-      seq_cache_recycle_linked(scene, key);
-      /* Can not continue iterating after linked remove. */
-      BLI_ghashIterator_init(&gh_iter, cache->hash);
-      continue;
-    }
-
-    if (key->is_temp_cache || key->link_next != nullptr) {
-      continue;
-    }
-
-    total_count++;
+  float finalkey_score = 0.0f;
+
+  for (SeqCacheShard &shard : cache->shards) {
+    GHashIterator gh_iter;
+    GHASH_ITER (gh_iter, shard.hash) {
+      SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+      SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghashIterator_getValue(&gh_iter));
+      BLI_assert(key->cache_owner == cache);
+
+      /* Only the last key of a frame is a candidate, the whole frame is freed. */
+      if (!item->ibuf || key->is_temp_cache || key->link_next != nullptr) {
+        continue;
+      }
 
-    if (lkey) {
-      if (key->timeline_frame < lkey->timeline_frame) {
-        lkey = key;
+      if (seq_cache_key_is_prefetched(scene, key)) {
+        continue;
       }
-    }
-    else {
-      lkey = key;
-    }
-    if (rkey) {
-      if (key->timeline_frame > rkey->timeline_frame) {
-        rkey = key;
+
+      const float score = seq_cache_frame_retain_score(scene, key);
+      if (finalkey == nullptr || score < finalkey_score) {
+        finalkey = key;
+        finalkey_score = score;
       }
     }
-    else {
-      rkey = key;
-    }
   }
-  (void)total_count; /* Quiet set-but-unused warning (may be removed). */
-
-  finalkey = seq_cache_choose_key(scene, lkey, rkey);
 
   return finalkey;
 }
@@ -452,6 +496,7 @@ bool seq_cache_recycle_item(Scene *scene)
 
     if (finalkey) {
       seq_cache_recycle_linked(scene, finalkey);
+      cache->evicted_frames++;
     }
     else {
       seq_cache_unlock(scene);
@@ -490,11 +535,13 @@ static void seq_cache_create(Main *bmain, Scene *scene)
 {
   BLI_mutex_lock(&cache_create_lock);
   if (scene->ed->cache == nullptr) {
-    SeqCache *cache = static_cast<SeqCache *>(MEM_callocN(sizeof(SeqCache), "SeqCache"));
+    SeqCache *cache = MEM_new<SeqCache>("SeqCache");
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
-    cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = nullptr;
+    for (SeqCacheShard &shard : cache->shards) {
+      shard.hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
+      BLI_rw_mutex_init(&shard.lock);
+    }
     cache->bmain = bmain;
     BLI_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
@@ -521,6 +568,8 @@ static void seq_cache_populate_key(SeqCacheKey *key,
   key->type = type;
   key->link_prev = nullptr;
   key->link_next = nullptr;
+  key->cost = 0.0f;
+  key->mem_size = 0;
   key->is_temp_cache = true;
   key->task_id = context->task_id;
 }
@@ -547,25 +596,28 @@ void seq_cache_free_temp_cache(Scene *scene, short id, int timeline_frame)
 
   seq_cache_lock(scene);
 
-  GHashIterator gh_iter;
-  BLI_ghashIterator_init(&gh_iter, cache->hash);
-  while (!BLI_ghashIterator_done(&gh_iter)) {
-    SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
-    BLI_ghashIterator_step(&gh_iter);
-    BLI_assert(key->cache_owner == cache);
-
-    if (key->is_temp_cache && key->task_id == id) {
-      /* Use frame_index here to avoid freeing raw images if they are used for multiple frames. */
-      float frame_index = seq_cache_timeline_frame_to_frame_index(
-          scene, key->seq, timeline_frame, key->type);
-      if (frame_index != key->frame_index ||
-          timeline_frame > SEQ_time_right_handle_frame_get(scene, key->seq) ||
-          timeline_frame < SEQ_time_left_handle_frame_get(scene, key->seq))
-      {
-        seq_cache_key_unlink(key);
-        BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
-        if (key == cache->last_key) {
-          cache->last_key = nullptr;
+  for (SeqCacheShard &shard : cache->shards) {
+    GHashIterator gh_iter;
+    BLI_ghashIterator_init(&gh_iter, shard.hash);
+    while (!BLI_ghashIterator_done(&gh_iter)) {
+      SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+      BLI_ghashIterator_step(&gh_iter);
+      BLI_assert(key->cache_owner == cache);
+
+      if (key->is_temp_cache && key->task_id == id) {
+        /* Use frame_index here to avoid freeing raw images if they are used for multiple
+         * frames. */
+        float frame_index = seq_cache_timeline_frame_to_frame_index(
+            scene, key->seq, timeline_frame, key->type);
+        if (frame_index != key->frame_index ||
+            timeline_frame > SEQ_time_right_handle_frame_get(scene, key->seq) ||
+            timeline_frame < SEQ_time_left_handle_frame_get(scene, key->seq))
+        {
+          seq_cache_key_unlink(key);
+          if (key == cache->last_key[key->task_id]) {
+            cache->last_key[key->task_id] = nullptr;
+          }
+          seq_cache_remove(cache, key);
         }
       }
     }
@@ -580,7 +632,10 @@ void seq_cache_destruct(Scene *scene)
     return;
   }
 
-  BLI_ghash_free(cache->hash, seq_cache_keyfree, seq_cache_valfree);
+  for (SeqCacheShard &shard : cache->shards) {
+    BLI_ghash_free(shard.hash, seq_cache_keyfree, seq_cache_valfree);
+    BLI_rw_mutex_end(&shard.lock);
+  }
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
   BLI_mutex_end(&cache->iterator_mutex);
@@ -589,7 +644,7 @@ void seq_cache_destruct(Scene *scene)
     seq_disk_cache_free(cache->disk_cache);
   }
 
-  MEM_freeN(cache);
+  MEM_delete(cache);
   scene->ed->cache = nullptr;
 }
 
@@ -604,18 +659,20 @@ void SEQ_cache_cleanup(Scene *scene)
 
   seq_cache_lock(scene);
 
-  GHashIterator gh_iter;
-  BLI_ghashIterator_init(&gh_iter, cache->hash);
-  while (!BLI_ghashIterator_done(&gh_iter)) {
-    SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
-    BLI_assert(key->cache_owner == cache);
+  for (SeqCacheShard &shard : cache->shards) {
+    GHashIterator gh_iter;
+    BLI_ghashIterator_init(&gh_iter, shard.hash);
+    while (!BLI_ghashIterator_done(&gh_iter)) {
+      SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+      BLI_assert(key->cache_owner == cache);
 
-    BLI_ghashIterator_step(&gh_iter);
+      BLI_ghashIterator_step(&gh_iter);
 
-    /* NOTE: no need to call #seq_cache_key_unlink as all keys are removed. */
-    BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
+      /* NOTE: no need to call #seq_cache_key_unlink as all keys are removed. */
+      seq_cache_remove(cache, key);
+    }
   }
-  cache->last_key = nullptr;
+  seq_cache_reset_linking(cache);
   seq_cache_unlock(scene);
 }
 
@@ -658,33 +715,39 @@ void seq_cache_cleanup_sequence(Scene *scene,
   int invalidate_source = invalidate_types & (SEQ_CACHE_STORE_RAW | SEQ_CACHE_STORE_PREPROCESSED |
                                               SEQ_CACHE_STORE_COMPOSITE);
 
-  GHashIterator gh_iter;
-  BLI_ghashIterator_init(&gh_iter, cache->hash);
-  while (!BLI_ghashIterator_done(&gh_iter)) {
-    SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
-    BLI_ghashIterator_step(&gh_iter);
-    BLI_assert(key->cache_owner == cache);
-
-    /* Clean all final and composite in intersection of seq and seq_changed. */
-    if (key->type & invalidate_composite && key->frame_index >= range_start &&
-        key->frame_index <= range_end)
-    {
-      seq_cache_key_unlink(key);
-      BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
-    }
-    else if (key->type & invalidate_source && key->seq == seq &&
-             key->frame_index >= range_start_seq_changed &&
-             key->frame_index <= range_end_seq_changed)
-    {
-      seq_cache_key_unlink(key);
-      BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
+  for (SeqCacheShard &shard : cache->shards) {
+    GHashIterator gh_iter;
+    BLI_ghashIterator_init(&gh_iter, shard.hash);
+    while (!BLI_ghashIterator_done(&gh_iter)) {
+      SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+      BLI_ghashIterator_step(&gh_iter);
+      BLI_assert(key->cache_owner == cache);
+
+      /* Clean all final and composite in intersection of seq and seq_changed. */
+      if (key->type & invalidate_composite && key->frame_index >= range_start &&
+          key->frame_index <= range_end)
+      {
+        seq_cache_key_unlink(key);
+        seq_cache_remove(cache, key);
+      }
+      else if (key->type & invalidate_source && key->seq == seq &&
+               key->frame_index >= range_start_seq_changed &&
+               key->frame_index <= range_end_seq_changed)
+      {
+        seq_cache_key_unlink(key);
+        seq_cache_remove(cache, key);
+      }
     }
   }
-  cache->last_key = nullptr;
+  seq_cache_reset_linking(cache);
   seq_cache_unlock(scene);
 }
 
-ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline_frame, int type)
+static ImBuf *seq_cache_lookup(const SeqRenderData *context,
+                               Sequence *seq,
+                               float timeline_frame,
+                               int type,
+                               const bool update_statistics)
 {
 
   if (context->skip_cache || context->is_proxy_render || context->for_render || !seq) {
@@ -707,7 +770,6 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
     seq_cache_create(context->bmain, scene);
   }
 
-  seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   ImBuf *ibuf = nullptr;
   SeqCacheKey key;
@@ -716,8 +778,16 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
   if (cache && seq) {
     seq_cache_populate_key(&key, context, seq, timeline_frame, type);
     ibuf = seq_cache_get_ex(cache, &key);
+
+    if (update_statistics) {
+      if (ibuf) {
+        cache->hits++;
+      }
+      else {
+        cache->misses++;
+      }
+    }
   }
-  seq_cache_unlock(scene);
 
   if (ibuf) {
     return ibuf;
@@ -729,24 +799,40 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
       cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
     }
 
+    const double read_start = BLI_time_now_seconds();
     ibuf = seq_disk_cache_read_file(cache->disk_cache, &key);
 
     if (ibuf == nullptr) {
       return nullptr;
     }
 
+    const float cost = seq_cache_render_cost(scene, BLI_time_now_seconds() - read_start);
+
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
-      SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-      seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_lock(scene);
+      if (!seq_cache_haskey(cache, &key)) {
+        SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+        seq_cache_put_ex(scene, new_key, ibuf, cost);
+      }
+      seq_cache_unlock(scene);
     }
   }
 
   return ibuf;
 }
 
-bool seq_cache_put_if_possible(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf)
+ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline_frame, int type)
+{
+  return seq_cache_lookup(context, seq, timeline_frame, type, true);
+}
+
+bool seq_cache_put_if_possible(const SeqRenderData *context,
+                               Sequence *seq,
+                               float timeline_frame,
+                               int type,
+                               ImBuf *ibuf,
+                               float cost)
 {
   Scene *scene = context->scene;
 
@@ -761,20 +847,27 @@ bool seq_cache_put_if_possible(
   }
 
   if (seq_cache_recycle_item(scene)) {
-    seq_cache_put(context, seq, timeline_frame, type, ibuf);
+    seq_cache_put(context, seq, timeline_frame, type, ibuf, cost);
     return true;
   }
 
   if (scene->ed->cache) {
-    seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-    scene->ed->cache->last_key = nullptr;
+    seq_cache_lock(scene);
+    SeqCacheKey **last_key = &scene->ed->cache->last_key[context->task_id];
+    seq_cache_set_temp_cache_linked(scene, *last_key);
+    *last_key = nullptr;
+    seq_cache_unlock(scene);
   }
 
   return false;
 }
 
-void seq_cache_put(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i)
+void seq_cache_put(const SeqRenderData *context,
+                   Sequence *seq,
+                   float timeline_frame,
+                   int type,
+                   ImBuf *i,
+                   float cost)
 {
   if (i == nullptr || context->skip_cache || context->is_proxy_render || context->for_render ||
       !seq)
@@ -792,7 +885,7 @@ void seq_cache_put(
   }
 
   /* Prevent reinserting, it breaks cache key linking. */
-  ImBuf *test = seq_cache_get(context, seq, timeline_frame, type);
+  ImBuf *test = seq_cache_lookup(context, seq, timeline_frame, type, false);
   if (test) {
     IMB_freeImBuf(test);
     return;
@@ -805,7 +898,13 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-  seq_cache_put_ex(scene, key, i);
+  /* Another prefetch thread may have put the same image since the check above. */
+  if (seq_cache_haskey(cache, key)) {
+    BLI_mempool_free(cache->keys_pool, key);
+    seq_cache_unlock(scene);
+    return;
+  }
+  seq_cache_put_ex(scene, key, i, cost);
   seq_cache_unlock(scene);
 
   if (!key->is_temp_cache) {
@@ -832,40 +931,63 @@ void SEQ_cache_iterate(
   }
 
   seq_cache_lock(scene);
-  bool interrupt = callback_init(userdata, BLI_ghash_len(cache->hash));
-
-  GHashIterator gh_iter;
-  BLI_ghashIterator_init(&gh_iter, cache->hash);
-
-  while (!BLI_ghashIterator_done(&gh_iter) && !interrupt) {
-    SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
-    BLI_ghashIterator_step(&gh_iter);
-    BLI_assert(key->cache_owner == cache);
-    int timeline_frame;
-    if (key->type & SEQ_CACHE_STORE_FINAL_OUT) {
-      timeline_frame = key->timeline_frame;
-    }
-    else {
-      /* This is not a final cache image. The cached frame is relative to where the strip is
-       * currently and where it was when it was cached. We can't use the timeline_frame, we need to
-       * derive the timeline frame from key->frame_index.
-       *
-       * NOTE This will not work for RAW caches if they have retiming, strobing, or different
-       * playback rate than the scene. Because it would take quite a bit of effort to properly
-       * convert RAW frames like that to a timeline frame, we skip doing this as visualizing these
-       * are a developer option that not many people will see.
-       */
-      timeline_frame = key->frame_index + SEQ_time_start_frame_get(key->seq);
-    }
+  bool interrupt = callback_init(userdata, size_t(cache->item_count));
+
+  for (SeqCacheShard &shard : cache->shards) {
+    GHashIterator gh_iter;
+    BLI_ghashIterator_init(&gh_iter, shard.hash);
+
+    while (!BLI_ghashIterator_done(&gh_iter) && !interrupt) {
+      SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+      BLI_ghashIterator_step(&gh_iter);
+      BLI_assert(key->cache_owner == cache);
+      int timeline_frame;
+      if (key->type & SEQ_CACHE_STORE_FINAL_OUT) {
+        timeline_frame = key->timeline_frame;
+      }
+      else {
+        /* This is not a final cache image. The cached frame is relative to where the strip is
+         * currently and where it was when it was cached. We can't use the timeline_frame, we need
+         * to derive the timeline frame from key->frame_index.
+         *
+         * NOTE This will not work for RAW caches if they have retiming, strobing, or different
+         * playback rate than the scene. Because it would take quite a bit of effort to properly
+         * convert RAW frames like that to a timeline frame, we skip doing this as visualizing
+         * these are a developer option that not many people will see.
+         */
+        timeline_frame = key->frame_index + SEQ_time_start_frame_get(key->seq);
+      }
 
-    interrupt = callback_iter(userdata, key->seq, timeline_frame, key->type);
+      interrupt = callback_iter(userdata, key->seq, timeline_frame, key->type);
+    }
   }
 
-  cache->last_key = nullptr;
+  seq_cache_reset_linking(cache);
   seq_cache_unlock(scene);
 }
 
+void SEQ_cache_statistics_get(Scene *scene, SeqCacheStatistics *r_stats)
+{
+  *r_stats = {};
+
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache) {
+    return;
+  }
+
+  r_stats->hits = cache->hits;
+  r_stats->misses = cache->misses;
+  r_stats->evicted_frames = cache->evicted_frames;
+  r_stats->item_count = cache->item_count;
+  r_stats->mem_in_use = cache->mem_in_use;
+}
+
 bool seq_cache_is_full()
 {
   return seq_cache_get_mem_total() < MEM_get_memory_in_use();
 }
+
+float seq_cache_render_cost(const Scene *scene, const double render_time)
+{
+  return float(render_time * FPS);
+}
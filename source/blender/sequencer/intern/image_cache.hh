@@ -27,6 +27,7 @@ struct SeqCacheKey {
   float frame_index;    /* Usually same as timeline_frame. Mapped to media for RAW entries. */
   float timeline_frame; /* Only for reference - used for freeing when cache is full. */
   float cost;           /* In short: render time(s) divided by playback frame duration(s) */
+  size_t mem_size;      /* Memory used by the cached image, in bytes. */
   bool is_temp_cache;   /* this cache entry will be freed before rendering next frame */
   /* ID of task for assigning temp cache entries to particular task(thread, etc.) */
   eSeqTaskId task_id;
@@ -34,10 +35,22 @@ struct SeqCacheKey {
 };
 
 ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline_frame, int type);
-void seq_cache_put(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i);
-bool seq_cache_put_if_possible(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf);
+/**
+ * \param cost: How expensive the image was to produce, see #seq_cache_render_cost. Frames with a
+ * higher cost are kept in the cache longer.
+ */
+void seq_cache_put(const SeqRenderData *context,
+                   Sequence *seq,
+                   float timeline_frame,
+                   int type,
+                   ImBuf *i,
+                   float cost = 0.0f);
+bool seq_cache_put_if_possible(const SeqRenderData *context,
+                               Sequence *seq,
+                               float timeline_frame,
+                               int type,
+                               ImBuf *ibuf,
+                               float cost = 0.0f);
 /**
  * Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
@@ -51,4 +64,9 @@ void seq_cache_cleanup_sequence(Scene *scene,
                                 int invalidate_types,
                                 bool force_seq_changed_range);
 bool seq_cache_is_full();
+/**
+ * Cost of an image that took `render_time` seconds to produce, relative to the frame duration
+ * of the scene. A cost above 1 means the frame can not be played back in real-time.
+ */
+float seq_cache_render_cost(const Scene *scene, double render_time);
 float seq_cache_frame_index_to_timeline_frame(Sequence *seq, float frame_index);
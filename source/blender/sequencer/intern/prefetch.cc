@@ -18,7 +18,10 @@
 #include "DNA_space_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_system.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
 
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
@@ -30,6 +33,8 @@
 #include "BKE_layer.hh"
 #include "BKE_main.hh"
 
+#include "CLG_log.h"
+
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_build.hh"
 #include "DEG_depsgraph_debug.hh"
@@ -46,34 +51,60 @@
 #include "prefetch.hh"
 #include "render.hh"
 
+static CLG_LogRef LOG = {"seq.prefetch"};
+
+#define PREFETCH_MAX_THREADS (SEQ_TASK_PREFETCH_RENDER_LAST - SEQ_TASK_PREFETCH_RENDER + 1)
+
+struct PrefetchJob;
+
+/**
+ * Renders frames on its own copy of the scene, so that multiple frames can be rendered at the
+ * same time. Rendered images are shared with the main thread through the cache of the original
+ * scene.
+ */
+struct PrefetchThread {
+  PrefetchJob *pfjob;
+
+  Scene *scene_eval;
+  Depsgraph *depsgraph;
+
+  /* context */
+  SeqRenderData context;
+  SeqRenderData context_cpy;
+
+  /* Frame being rendered by this thread. */
+  float cfra;
+};
+
 struct PrefetchJob {
   PrefetchJob *next, *prev;
 
   Main *bmain;
   Main *bmain_eval;
   Scene *scene;
-  Scene *scene_eval;
-  Depsgraph *depsgraph;
 
   ThreadMutex prefetch_suspend_mutex;
   ThreadCondition prefetch_suspend_cond;
 
   ListBase threads;
-
-  /* context */
-  SeqRenderData context;
-  SeqRenderData context_cpy;
-  ListBase *seqbasep;
-  ListBase *seqbasep_cpy;
+  PrefetchThread thread_data[PREFETCH_MAX_THREADS];
+  int num_threads;
 
   /* prefetch area */
   float cfra;
   int num_frames_prefetched;
 
+  /* Statistics, reported once all frames of the prefetch area are rendered. */
+  double start_time;
+  int num_frames_rendered;
+  bool is_reported;
+
   /* Control: */
   /* Set by prefetch. */
   bool running;
   bool waiting;
+  int num_threads_running;
+  int num_threads_waiting;
   bool stop;
   /* Set from outside. */
   bool is_scrubbing;
@@ -147,8 +178,16 @@ Sequence *seq_prefetch_get_original_sequence(Sequence *seq, Scene *scene)
 SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
+  const int thread_index = context->task_id - SEQ_TASK_PREFETCH_RENDER;
+  BLI_assert(thread_index >= 0 && thread_index < pfjob->num_threads);
+
+  return &pfjob->thread_data[thread_index].context;
+}
 
-  return &pfjob->context;
+bool seq_prefetch_is_parallel(const SeqRenderData *context)
+{
+  PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
+  return pfjob != nullptr && pfjob->num_threads > 1;
 }
 
 static bool seq_prefetch_is_cache_full(Scene *scene)
@@ -166,9 +205,9 @@ static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
   return pfjob->cfra + pfjob->num_frames_prefetched;
 }
-static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchJob *pfjob)
+static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchThread *thread)
 {
-  return BKE_animsys_eval_context_construct(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  return BKE_animsys_eval_context_construct(thread->depsgraph, thread->cfra);
 }
 
 void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
@@ -181,16 +220,19 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
 
 static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
 {
-  if (pfjob->depsgraph != nullptr) {
-    DEG_graph_free(pfjob->depsgraph);
+  for (int i = 0; i < pfjob->num_threads; i++) {
+    PrefetchThread *thread = &pfjob->thread_data[i];
+    if (thread->depsgraph != nullptr) {
+      DEG_graph_free(thread->depsgraph);
+    }
+    thread->depsgraph = nullptr;
+    thread->scene_eval = nullptr;
   }
-  pfjob->depsgraph = nullptr;
-  pfjob->scene_eval = nullptr;
 }
 
-static void seq_prefetch_update_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_update_depsgraph(PrefetchThread *thread)
 {
-  DEG_evaluate_on_framechange(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  DEG_evaluate_on_framechange(thread->depsgraph, thread->cfra);
 }
 
 static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
@@ -199,17 +241,23 @@ static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
   Scene *scene = pfjob->scene;
   ViewLayer *view_layer = BKE_view_layer_default_render(scene);
 
-  pfjob->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(pfjob->depsgraph, "SEQUENCER PREFETCH");
+  for (int i = 0; i < pfjob->num_threads; i++) {
+    PrefetchThread *thread = &pfjob->thread_data[i];
+    thread->pfjob = pfjob;
+    thread->cfra = seq_prefetch_cfra(pfjob);
+
+    thread->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_debug_name_set(thread->depsgraph, "SEQUENCER PREFETCH");
 
-  /* Make sure there is a correct evaluated scene pointer. */
-  DEG_graph_build_for_render_pipeline(pfjob->depsgraph);
+    /* Make sure there is a correct evaluated scene pointer. */
+    DEG_graph_build_for_render_pipeline(thread->depsgraph);
 
-  /* Update immediately so we have proper evaluated scene. */
-  seq_prefetch_update_depsgraph(pfjob);
+    /* Update immediately so we have proper evaluated scene. */
+    seq_prefetch_update_depsgraph(thread);
 
-  pfjob->scene_eval = DEG_get_evaluated_scene(pfjob->depsgraph);
-  pfjob->scene_eval->ed->cache_flag = 0;
+    thread->scene_eval = DEG_get_evaluated_scene(thread->depsgraph);
+    thread->scene_eval->ed->cache_flag = 0;
+  }
 }
 
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
@@ -256,7 +304,7 @@ void SEQ_prefetch_stop(Scene *scene)
   pfjob->stop = true;
 
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -265,32 +313,37 @@ static void seq_prefetch_update_context(const SeqRenderData *context)
   PrefetchJob *pfjob;
   pfjob = seq_prefetch_job_get(context->scene);
 
-  SEQ_render_new_render_data(pfjob->bmain_eval,
-                             pfjob->depsgraph,
-                             pfjob->scene_eval,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context_cpy);
-  pfjob->context_cpy.is_prefetch_render = true;
-  pfjob->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
-
-  SEQ_render_new_render_data(pfjob->bmain,
-                             pfjob->depsgraph,
-                             pfjob->scene,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context);
-  pfjob->context.is_prefetch_render = false;
-
-  /* Same ID as prefetch context, because context will be swapped, but we still
-   * want to assign this ID to cache entries created in this thread.
-   * This is to allow "temp cache" work correctly for both threads.
-   */
-  pfjob->context.task_id = SEQ_TASK_PREFETCH_RENDER;
+  for (int i = 0; i < pfjob->num_threads; i++) {
+    PrefetchThread *thread = &pfjob->thread_data[i];
+    const eSeqTaskId task_id = eSeqTaskId(SEQ_TASK_PREFETCH_RENDER + i);
+
+    SEQ_render_new_render_data(pfjob->bmain_eval,
+                               thread->depsgraph,
+                               thread->scene_eval,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &thread->context_cpy);
+    thread->context_cpy.is_prefetch_render = true;
+    thread->context_cpy.task_id = task_id;
+
+    SEQ_render_new_render_data(pfjob->bmain,
+                               thread->depsgraph,
+                               pfjob->scene,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &thread->context);
+    thread->context.is_prefetch_render = false;
+
+    /* Same ID as prefetch context, because context will be swapped, but we still
+     * want to assign this ID to cache entries created in this thread.
+     * This is to allow "temp cache" work correctly for both threads.
+     */
+    thread->context.task_id = task_id;
+  }
 }
 
 static void seq_prefetch_update_scene(Scene *scene)
@@ -309,14 +362,18 @@ static void seq_prefetch_update_scene(Scene *scene)
 static void seq_prefetch_update_active_seqbase(PrefetchJob *pfjob)
 {
   MetaStack *ms_orig = SEQ_meta_stack_active_get(SEQ_editing_get(pfjob->scene));
-  Editing *ed_eval = SEQ_editing_get(pfjob->scene_eval);
 
-  if (ms_orig != nullptr) {
-    Sequence *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, pfjob->scene_eval);
-    SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
-  }
-  else {
-    SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+  for (int i = 0; i < pfjob->num_threads; i++) {
+    Scene *scene_eval = pfjob->thread_data[i].scene_eval;
+    Editing *ed_eval = SEQ_editing_get(scene_eval);
+
+    if (ms_orig != nullptr) {
+      Sequence *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, scene_eval);
+      SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
+    }
+    else {
+      SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+    }
   }
 }
 
@@ -324,11 +381,24 @@ static void seq_prefetch_resume(Scene *scene)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
-  if (pfjob && pfjob->waiting) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+  if (pfjob && pfjob->num_threads_waiting > 0) {
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
+/**
+ * Number of frames rendered at the same time. Each frame is rendered on its own copy of the
+ * scene, so only use multiple threads when enabled by the user.
+ */
+static int seq_prefetch_num_threads(const Scene *scene)
+{
+  if ((scene->ed->cache_flag & SEQ_CACHE_PREFETCH_PARALLEL) == 0) {
+    return 1;
+  }
+  /* Rendering a single frame is multi-threaded too, leave room for that. */
+  return clamp_i(BLI_system_thread_count() / 4, 2, PREFETCH_MAX_THREADS);
+}
+
 void seq_prefetch_free(Scene *scene)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
@@ -338,7 +408,6 @@ void seq_prefetch_free(Scene *scene)
 
   SEQ_prefetch_stop(scene);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
@@ -348,12 +417,12 @@ void seq_prefetch_free(Scene *scene)
   scene->ed->prefetch_job = nullptr;
 }
 
-static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
+static bool seq_prefetch_seq_has_disk_cache(PrefetchThread *thread,
                                             Sequence *seq,
                                             bool can_have_final_image)
 {
-  SeqRenderData *ctx = &pfjob->context_cpy;
-  float cfra = seq_prefetch_cfra(pfjob);
+  SeqRenderData *ctx = &thread->context_cpy;
+  float cfra = thread->cfra;
 
   ImBuf *ibuf = seq_cache_get(ctx, seq, cfra, SEQ_CACHE_STORE_PREPROCESSED);
   if (ibuf != nullptr) {
@@ -380,28 +449,28 @@ static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
   return false;
 }
 
-static bool seq_prefetch_scene_strip_is_rendered(PrefetchJob *pfjob,
+static bool seq_prefetch_scene_strip_is_rendered(PrefetchThread *thread,
                                                  ListBase *channels,
                                                  ListBase *seqbase,
                                                  blender::Span<Sequence *> scene_strips,
                                                  bool is_recursive_check)
 {
-  float cfra = seq_prefetch_cfra(pfjob);
+  float cfra = thread->cfra;
   blender::Vector<Sequence *> strips = seq_get_shown_sequences(
-      pfjob->scene_eval, channels, seqbase, cfra, 0);
+      thread->scene_eval, channels, seqbase, cfra, 0);
 
   /* Iterate over rendered strips. */
   for (Sequence *seq : strips) {
     if (seq->type == SEQ_TYPE_META &&
         seq_prefetch_scene_strip_is_rendered(
-            pfjob, &seq->channels, &seq->seqbase, scene_strips, true))
+            thread, &seq->channels, &seq->seqbase, scene_strips, true))
     {
       return true;
     }
 
     /* Disable prefetching 3D scene strips, but check for disk cache. */
     if (seq->type == SEQ_TYPE_SCENE && (seq->flag & SEQ_SCENE_STRIPS) == 0 &&
-        !seq_prefetch_seq_has_disk_cache(pfjob, seq, !is_recursive_check))
+        !seq_prefetch_seq_has_disk_cache(thread, seq, !is_recursive_check))
     {
       return true;
     }
@@ -429,10 +498,12 @@ static blender::VectorSet<Sequence *> query_scene_strips(ListBase *seqbase)
 
 /* Prefetch must avoid rendering scene strips, because rendering in background locks UI and can
  * make it unresponsive for long time periods. */
-static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels, ListBase *seqbase)
+static bool seq_prefetch_must_skip_frame(PrefetchThread *thread,
+                                         ListBase *channels,
+                                         ListBase *seqbase)
 {
   blender::VectorSet<Sequence *> scene_strips = query_scene_strips(seqbase);
-  if (seq_prefetch_scene_strip_is_rendered(pfjob, channels, seqbase, scene_strips, false)) {
+  if (seq_prefetch_scene_strip_is_rendered(thread, channels, seqbase, scene_strips, false)) {
     return true;
   }
   return false;
@@ -444,32 +515,90 @@ static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
          (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
 }
 
+static void seq_prefetch_report(PrefetchJob *pfjob)
+{
+  if (pfjob->is_reported || pfjob->num_frames_rendered == 0) {
+    return;
+  }
+  pfjob->is_reported = true;
+
+  const double time = BLI_time_now_seconds() - pfjob->start_time;
+  CLOG_INFO(&LOG,
+            1,
+            "Prefetched %d frames in %.3f s with %d threads (%.2f frames/s)",
+            pfjob->num_frames_rendered,
+            time,
+            pfjob->num_threads,
+            time > 0.0 ? pfjob->num_frames_rendered / time : 0.0);
+}
+
+/* Must be called with #PrefetchJob.prefetch_suspend_mutex locked. */
 static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
 {
-  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   while (seq_prefetch_need_suspend(pfjob) &&
          (pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) && !pfjob->stop)
   {
-    pfjob->waiting = true;
+    if (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra) {
+      seq_prefetch_report(pfjob);
+    }
+
+    pfjob->num_threads_waiting++;
+    pfjob->waiting = pfjob->num_threads_waiting == pfjob->num_threads_running;
     BLI_condition_wait(&pfjob->prefetch_suspend_cond, &pfjob->prefetch_suspend_mutex);
+    pfjob->num_threads_waiting--;
+    pfjob->waiting = false;
     seq_prefetch_update_area(pfjob);
   }
-  pfjob->waiting = false;
+}
+
+static bool seq_prefetch_must_stop(PrefetchJob *pfjob)
+{
+  return !(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop;
+}
+
+/**
+ * Take the next frame to render, frames closest to the current frame are rendered first.
+ * Returns false when there are no frames left to render.
+ */
+static bool seq_prefetch_claim_frame(PrefetchThread *thread)
+{
+  PrefetchJob *pfjob = thread->pfjob;
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+
+  /* Suspend thread if there is nothing to be prefetched. */
+  seq_prefetch_do_suspend(pfjob);
+  seq_prefetch_update_area(pfjob);
+
+  /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
+  const bool collides_with_main_thread = pfjob->num_frames_prefetched > 5 &&
+                                         (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2;
+
+  const bool has_frame = !seq_prefetch_must_stop(pfjob) && !collides_with_main_thread &&
+                         seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra;
+  if (has_frame) {
+    thread->cfra = seq_prefetch_cfra(pfjob);
+    pfjob->num_frames_prefetched++;
+  }
+
   BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+  return has_frame;
 }
 
-static void *seq_prefetch_frames(void *job)
+static void *seq_prefetch_frames(void *thread_v)
 {
-  PrefetchJob *pfjob = (PrefetchJob *)job;
+  PrefetchThread *thread = static_cast<PrefetchThread *>(thread_v);
+  PrefetchJob *pfjob = thread->pfjob;
+  Scene *scene_eval = thread->scene_eval;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
-    pfjob->scene_eval->ed->prefetch_job = nullptr;
+  while (seq_prefetch_claim_frame(thread)) {
+    scene_eval->ed->prefetch_job = nullptr;
 
-    seq_prefetch_update_depsgraph(pfjob);
-    AnimData *adt = BKE_animdata_from_id(&pfjob->context_cpy.scene->id);
-    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(pfjob);
+    seq_prefetch_update_depsgraph(thread);
+    AnimData *adt = BKE_animdata_from_id(&thread->context_cpy.scene->id);
+    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(thread);
     BKE_animsys_evaluate_animdata(
-        &pfjob->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
+        &thread->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
 
     /* This is quite hacky solution:
      * We need cross-reference original scene with copy for cache.
@@ -477,43 +606,37 @@ static void *seq_prefetch_frames(void *job)
      * Scene copy don't reference original scene. Perhaps, this could be done by depsgraph.
      * Set to nullptr before return!
      */
-    pfjob->scene_eval->ed->prefetch_job = pfjob;
-
-    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(pfjob->scene_eval));
-    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(pfjob->scene_eval));
-    if (seq_prefetch_must_skip_frame(pfjob, channels, seqbase)) {
-      pfjob->num_frames_prefetched++;
-      /* Break instead of keep looping if the job should be terminated. */
-      if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
-        break;
-      }
+    scene_eval->ed->prefetch_job = pfjob;
+
+    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(scene_eval));
+    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(scene_eval));
+    if (seq_prefetch_must_skip_frame(thread, channels, seqbase)) {
       continue;
     }
 
-    ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
-    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+    ImBuf *ibuf = SEQ_render_give_ibuf(&thread->context_cpy, thread->cfra, 0);
+    seq_cache_free_temp_cache(pfjob->scene, thread->context.task_id, thread->cfra);
     IMB_freeImBuf(ibuf);
 
-    /* Suspend thread if there is nothing to be prefetched. */
-    seq_prefetch_do_suspend(pfjob);
-
-    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
-    if (pfjob->num_frames_prefetched > 5 && (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2)
-    {
-      break;
-    }
+    BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+    pfjob->num_frames_rendered++;
+    BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+  }
 
-    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
-      break;
-    }
+  seq_cache_free_temp_cache(pfjob->scene, thread->context.task_id, thread->cfra);
+  scene_eval->ed->prefetch_job = nullptr;
 
-    seq_prefetch_update_area(pfjob);
-    pfjob->num_frames_prefetched++;
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  pfjob->num_threads_running--;
+  if (pfjob->num_threads_running == 0) {
+    seq_prefetch_report(pfjob);
+    pfjob->running = false;
   }
-
-  seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
-  pfjob->scene_eval->ed->prefetch_job = nullptr;
+  else {
+    /* Threads waiting for the last frames to finish may have to stop now. */
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
+  }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 
   return nullptr;
 }
@@ -522,12 +645,20 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
 
+  const int num_threads = seq_prefetch_num_threads(context->scene);
+
+  if (pfjob && pfjob->num_threads != num_threads) {
+    seq_prefetch_free(context->scene);
+    pfjob = nullptr;
+  }
+
   if (!pfjob) {
     if (context->scene->ed) {
       pfjob = (PrefetchJob *)MEM_callocN(sizeof(PrefetchJob), "PrefetchJob");
       context->scene->ed->prefetch_job = pfjob;
 
-      BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
+      pfjob->num_threads = num_threads;
+      BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, num_threads);
       BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
       BLI_condition_init(&pfjob->prefetch_suspend_cond);
 
@@ -541,7 +672,13 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   pfjob->cfra = cfra;
   pfjob->num_frames_prefetched = 1;
 
+  pfjob->start_time = BLI_time_now_seconds();
+  pfjob->num_frames_rendered = 0;
+  pfjob->is_reported = false;
+
   pfjob->waiting = false;
+  pfjob->num_threads_waiting = 0;
+  pfjob->num_threads_running = pfjob->num_threads;
   pfjob->stop = false;
   pfjob->running = true;
 
@@ -549,8 +686,10 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   seq_prefetch_update_context(context);
   seq_prefetch_update_active_seqbase(pfjob);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
-  BLI_threadpool_insert(&pfjob->threads, pfjob);
+  BLI_threadpool_clear(&pfjob->threads);
+  for (int i = 0; i < pfjob->num_threads; i++) {
+    BLI_threadpool_insert(&pfjob->threads, &pfjob->thread_data[i]);
+  }
 
   return pfjob;
 }
@@ -23,6 +23,10 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end);
  * For cache context swapping.
  */
 SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context);
+/**
+ * Whether the prefetch job of a prefetch render context renders frames on multiple threads.
+ */
+bool seq_prefetch_is_parallel(const SeqRenderData *context);
 /**
  * For cache context swapping.
  */
@@ -16,8 +16,10 @@
 
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_time.h"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -30,6 +32,8 @@
 #include "BKE_main.hh"
 #include "BKE_scene.hh"
 
+#include "CLG_log.h"
+
 #include "WM_types.hh"
 
 #include "IMB_imbuf.hh"
@@ -48,6 +52,8 @@
 #include "sequencer.hh"
 #include "utils.hh"
 
+static CLG_LogRef LOG = {"seq.proxy"};
+
 struct SeqIndexBuildContext {
   IndexBuildContext *index_context;
 
@@ -514,10 +520,16 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_
 
   if (seq->type == SEQ_TYPE_MOVIE) {
     if (context->index_context) {
+      const double start_time = BLI_time_now_seconds();
       IMB_anim_index_rebuild(context->index_context,
                              &worker_status->stop,
                              &worker_status->do_update,
                              &worker_status->progress);
+      CLOG_INFO(&LOG,
+                1,
+                "Built proxies for %s in %.2f s",
+                seq->name + 2,
+                BLI_time_now_seconds() - start_time);
     }
 
     return;
@@ -545,6 +557,9 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_
 
   SeqRenderState state;
 
+  const double start_time = BLI_time_now_seconds();
+  int frames_built = 0;
+
   for (timeline_frame = SEQ_time_left_handle_frame_get(scene, seq);
        timeline_frame < SEQ_time_right_handle_frame_get(scene, seq);
        timeline_frame++)
@@ -566,11 +581,21 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_
                               (SEQ_time_right_handle_frame_get(scene, seq) -
                                SEQ_time_left_handle_frame_get(scene, seq));
     worker_status->do_update = true;
+    frames_built++;
 
     if (worker_status->stop || G.is_break) {
       break;
     }
   }
+
+  const double elapsed_time = BLI_time_now_seconds() - start_time;
+  CLOG_INFO(&LOG,
+            1,
+            "Built proxies for %s: %d frames in %.2f s (%.1f frames/s)",
+            seq->name + 2,
+            frames_built,
+            elapsed_time,
+            frames_built / max_dd(elapsed_time, 1e-6));
 }
 
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
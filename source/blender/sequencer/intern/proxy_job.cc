@@ -8,12 +8,24 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
 #include "BKE_context.hh"
+#include "BKE_global.hh"
 
 #include "SEQ_proxy.hh"
 #include "SEQ_relations.hh"
@@ -27,26 +39,129 @@ static void proxy_freejob(void *pjv)
   ProxyJob *pj = static_cast<ProxyJob *>(pjv);
 
   BLI_freelistN(&pj->queue);
+  BLI_mutex_end(&pj->queue_mutex);
 
   MEM_freeN(pj);
 }
 
+/* Number of strips built at the same time. Decoding and encoding a single movie is already
+ * multi-threaded, a few strips at a time are enough to keep all cores busy. */
+static int proxy_job_workers_num()
+{
+  return std::clamp(BLI_system_thread_count() / 4, 1, 8);
+}
+
+struct ProxyJobBuildState {
+  ProxyJob *pj;
+
+  /* Guards `last_link` and `strip_status`. */
+  ThreadMutex mutex;
+  /* Last strip in the queue which was started. Strips can be added to the queue while the job
+   * runs, so the next one is looked up with the queue locked. */
+  LinkData *last_link;
+  /* Status of every strip which was started, in queue order. */
+  blender::Vector<std::unique_ptr<wmJobWorkerStatus>> strip_status;
+
+  bool stop;
+  std::atomic<int> workers_running;
+};
+
+/* Call with the state mutex locked. */
+static LinkData *proxy_build_next_link(ProxyJobBuildState *state)
+{
+  ProxyJob *pj = state->pj;
+  BLI_mutex_lock(&pj->queue_mutex);
+  LinkData *link = state->last_link ? state->last_link->next :
+                                      static_cast<LinkData *>(pj->queue.first);
+  BLI_mutex_unlock(&pj->queue_mutex);
+  return link;
+}
+
+static void proxy_build_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  ProxyJobBuildState *state = static_cast<ProxyJobBuildState *>(BLI_task_pool_user_data(pool));
+
+  while (true) {
+    BLI_mutex_lock(&state->mutex);
+    LinkData *link = state->stop ? nullptr : proxy_build_next_link(state);
+    wmJobWorkerStatus *strip_status = nullptr;
+    if (link) {
+      state->last_link = link;
+      state->strip_status.append(std::make_unique<wmJobWorkerStatus>());
+      strip_status = state->strip_status.last().get();
+    }
+    BLI_mutex_unlock(&state->mutex);
+
+    if (link == nullptr) {
+      break;
+    }
+
+    SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
+    SEQ_proxy_rebuild(context, strip_status);
+    strip_status->progress = 1.0f;
+  }
+
+  state->workers_running--;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, wmJobWorkerStatus *worker_status)
 {
   ProxyJob *pj = static_cast<ProxyJob *>(pjv);
 
-  LISTBASE_FOREACH (LinkData *, link, &pj->queue) {
-    SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
-
-    SEQ_proxy_rebuild(context, worker_status);
+  ProxyJobBuildState state;
+  state.pj = pj;
+  BLI_mutex_init(&state.mutex);
+  state.last_link = nullptr;
+  state.stop = false;
+
+  const int workers_num = proxy_job_workers_num();
+  TaskPool *task_pool = BLI_task_pool_create_background(&state, TASK_PRIORITY_LOW);
+
+  /* Workers stop when the queue is empty, start them again for strips added afterwards. */
+  bool has_queued_strips = true;
+  while (has_queued_strips) {
+    state.workers_running = workers_num;
+    for (int i = 0; i < workers_num; i++) {
+      BLI_task_pool_push(task_pool, proxy_build_task, nullptr, false, nullptr);
+    }
 
-    if (worker_status->stop) {
-      pj->stop = true;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
-      break;
+    /* Forward cancellation to the strips being built and combine their progress. */
+    while (state.workers_running > 0) {
+      BLI_time_sleep_ms(50);
+
+      const bool stop = worker_status->stop || G.is_break;
+
+      BLI_mutex_lock(&state.mutex);
+      if (stop && !state.stop) {
+        state.stop = true;
+        fprintf(stderr, "Canceling proxy rebuild on users request...\n");
+      }
+
+      float progress = 0.0f;
+      for (std::unique_ptr<wmJobWorkerStatus> &strip_status : state.strip_status) {
+        strip_status->stop = stop;
+        progress += strip_status->progress;
+      }
+      BLI_mutex_lock(&pj->queue_mutex);
+      const int strips_num = BLI_listbase_count(&pj->queue);
+      BLI_mutex_unlock(&pj->queue_mutex);
+      worker_status->progress = progress / max_ii(strips_num, 1);
+      worker_status->do_update = true;
+      BLI_mutex_unlock(&state.mutex);
     }
+
+    BLI_task_pool_work_and_wait(task_pool);
+
+    BLI_mutex_lock(&state.mutex);
+    has_queued_strips = !state.stop && proxy_build_next_link(&state) != nullptr;
+    BLI_mutex_unlock(&state.mutex);
   }
+
+  BLI_task_pool_free(task_pool);
+  BLI_mutex_end(&state.mutex);
+
+  pj->stop = state.stop;
 }
 
 static void proxy_endjob(void *pjv)
@@ -73,6 +188,7 @@ ProxyJob *ED_seq_proxy_job_get(const bContext *C, wmJob *wm_job)
     pj->depsgraph = depsgraph;
     pj->scene = scene;
     pj->main = CTX_data_main(C);
+    BLI_mutex_init(&pj->queue_mutex);
     WM_jobs_customdata_set(wm_job, pj, proxy_freejob);
     WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_SEQUENCER, NC_SCENE | ND_SEQUENCER);
     WM_jobs_callbacks(wm_job, proxy_startjob, nullptr, nullptr, proxy_endjob);
@@ -80,6 +196,13 @@ ProxyJob *ED_seq_proxy_job_get(const bContext *C, wmJob *wm_job)
   return pj;
 }
 
+void ED_seq_proxy_job_queue_append(ProxyJob *pj, ListBase *queue)
+{
+  BLI_mutex_lock(&pj->queue_mutex);
+  BLI_movelisttolist(&pj->queue, queue);
+  BLI_mutex_unlock(&pj->queue_mutex);
+}
+
 wmJob *ED_seq_proxy_wm_job_get(const bContext *C)
 {
   Scene *scene = CTX_data_scene(C);
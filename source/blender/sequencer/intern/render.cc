@@ -25,6 +25,8 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -758,67 +760,6 @@ static ImBuf *seq_render_preprocess_ibuf(const SeqRenderData *context,
   return ibuf;
 }
 
-struct RenderEffectInitData {
-  SeqEffectHandle *sh;
-  const SeqRenderData *context;
-  Sequence *seq;
-  float timeline_frame, fac;
-  ImBuf *ibuf1, *ibuf2, *ibuf3;
-
-  ImBuf *out;
-};
-
-struct RenderEffectThread {
-  SeqEffectHandle *sh;
-  const SeqRenderData *context;
-  Sequence *seq;
-  float timeline_frame, fac;
-  ImBuf *ibuf1, *ibuf2, *ibuf3;
-
-  ImBuf *out;
-  int start_line, tot_line;
-};
-
-static void render_effect_execute_init_handle(void *handle_v,
-                                              int start_line,
-                                              int tot_line,
-                                              void *init_data_v)
-{
-  RenderEffectThread *handle = (RenderEffectThread *)handle_v;
-  RenderEffectInitData *init_data = (RenderEffectInitData *)init_data_v;
-
-  handle->sh = init_data->sh;
-  handle->context = init_data->context;
-  handle->seq = init_data->seq;
-  handle->timeline_frame = init_data->timeline_frame;
-  handle->fac = init_data->fac;
-  handle->ibuf1 = init_data->ibuf1;
-  handle->ibuf2 = init_data->ibuf2;
-  handle->ibuf3 = init_data->ibuf3;
-  handle->out = init_data->out;
-
-  handle->start_line = start_line;
-  handle->tot_line = tot_line;
-}
-
-static void *render_effect_execute_do_thread(void *thread_data_v)
-{
-  RenderEffectThread *thread_data = (RenderEffectThread *)thread_data_v;
-
-  thread_data->sh->execute_slice(thread_data->context,
-                                 thread_data->seq,
-                                 thread_data->timeline_frame,
-                                 thread_data->fac,
-                                 thread_data->ibuf1,
-                                 thread_data->ibuf2,
-                                 thread_data->ibuf3,
-                                 thread_data->start_line,
-                                 thread_data->tot_line,
-                                 thread_data->out);
-
-  return nullptr;
-}
-
 ImBuf *seq_render_effect_execute_threaded(SeqEffectHandle *sh,
                                           const SeqRenderData *context,
                                           Sequence *seq,
@@ -828,24 +769,22 @@ ImBuf *seq_render_effect_execute_threaded(SeqEffectHandle *sh,
                                           ImBuf *ibuf2,
                                           ImBuf *ibuf3)
 {
-  RenderEffectInitData init_data;
   ImBuf *out = sh->init_execution(context, ibuf1, ibuf2, ibuf3);
 
-  init_data.sh = sh;
-  init_data.context = context;
-  init_data.seq = seq;
-  init_data.timeline_frame = timeline_frame;
-  init_data.fac = fac;
-  init_data.ibuf1 = ibuf1;
-  init_data.ibuf2 = ibuf2;
-  init_data.ibuf3 = ibuf3;
-  init_data.out = out;
-
-  IMB_processor_apply_threaded(out->y,
-                               sizeof(RenderEffectThread),
-                               &init_data,
-                               render_effect_execute_init_handle,
-                               render_effect_execute_do_thread);
+  /* Slices of a fixed number of rows rather than one slice per thread, so the work is balanced
+   * between threads that also render other strips or frames. */
+  threading::parallel_for(IndexRange(out->y), 64, [&](const IndexRange y_range) {
+    sh->execute_slice(context,
+                      seq,
+                      timeline_frame,
+                      fac,
+                      ibuf1,
+                      ibuf2,
+                      ibuf3,
+                      int(y_range.first()),
+                      int(y_range.size()),
+                      out);
+  });
 
   return out;
 }
@@ -2121,18 +2060,31 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
   /* Make sure we only keep the `anim` data for strips that are in view. */
   SEQ_relations_free_all_anim_ibufs(context->scene, timeline_frame);
 
+  /* With parallel prefetch, the prefetch threads render at the same time as the main thread and
+   * each other. Each of them renders its own evaluated copy of the scene, with its own movie
+   * handles and strip data, so only the image cache and text fonts are shared, and those have
+   * their own locks. Scene strips, which use the global render state, are never rendered by
+   * prefetch threads. */
+  const bool use_render_lock = !(context->is_prefetch_render &&
+                                 seq_prefetch_is_parallel(context));
   if (!strips.is_empty() && !out) {
-    BLI_mutex_lock(&seq_render_mutex);
+    if (use_render_lock) {
+      BLI_mutex_lock(&seq_render_mutex);
+    }
+    const double render_start = BLI_time_now_seconds();
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
+    const float cost = seq_cache_render_cost(scene, BLI_time_now_seconds() - render_start);
 
     if (context->is_prefetch_render) {
-      seq_cache_put(context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+      seq_cache_put(context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out, cost);
     }
     else {
       seq_cache_put_if_possible(
-          context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+          context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out, cost);
+    }
+    if (use_render_lock) {
+      BLI_mutex_unlock(&seq_render_mutex);
     }
-    BLI_mutex_unlock(&seq_render_mutex);
   }
 
   seq_prefetch_start(context, timeline_frame);
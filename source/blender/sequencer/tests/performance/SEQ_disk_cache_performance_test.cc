@@ -0,0 +1,107 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "BLI_mmap.h"
+#include "BLI_time.h"
+
+#include "disk_cache.hh"
+
+static constexpr int SRC_X = 3840;
+static constexpr int SRC_Y = 2160;
+static constexpr int ITERATIONS = 10;
+
+static ImBuf *create_src_image(bool use_float)
+{
+  ImBuf *img = IMB_allocImBuf(SRC_X, SRC_Y, 32, use_float ? IB_rectfloat : IB_rect);
+  /* Smooth gradients with some noise, similar to rendered frames. */
+  if (use_float) {
+    float *pix = img->float_buffer.data;
+    for (int i = 0; i < img->x * img->y; i++) {
+      const int x = i % img->x, y = i / img->x;
+      pix[0] = float(x) / img->x + float(i % 7) * 0.001f;
+      pix[1] = float(y) / img->y;
+      pix[2] = 0.5f + float((i * 13) % 11) * 0.002f;
+      pix[3] = 1.0f;
+      pix += 4;
+    }
+  }
+  else {
+    uchar *pix = img->byte_buffer.data;
+    for (int i = 0; i < img->x * img->y; i++) {
+      const int x = i % img->x, y = i / img->x;
+      pix[0] = (x * 255 / img->x + i % 3) & 0xFF;
+      pix[1] = (y * 255 / img->y) & 0xFF;
+      pix[2] = (128 + (i * 13) % 5) & 0xFF;
+      pix[3] = 255;
+      pix += 4;
+    }
+  }
+  return img;
+}
+
+static void disk_cache_perf_impl(const char *name, bool use_float, int level)
+{
+  ImBuf *src = create_src_image(use_float);
+  ImBuf *dst = IMB_allocImBuf(SRC_X, SRC_Y, 32, use_float ? IB_rectfloat : IB_rect);
+  const size_t size_raw = size_t(SRC_X) * SRC_Y * (use_float ? 16 : 4);
+
+  FILE *file = tmpfile();
+  ASSERT_NE(file, nullptr);
+
+  size_t size_written = 0;
+  const double write_start = BLI_time_now_seconds();
+  for (int i = 0; i < ITERATIONS; i++) {
+    size_written = seq_disk_cache_write_image_data(src, file, 0, size_raw, level);
+  }
+  const double write_time = BLI_time_now_seconds() - write_start;
+  fflush(file);
+  ASSERT_NE(size_written, 0);
+
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  ASSERT_NE(mmap_file, nullptr);
+
+  bool ok = true;
+  const double read_start = BLI_time_now_seconds();
+  for (int i = 0; i < ITERATIONS; i++) {
+    ok &= seq_disk_cache_read_image_data(dst, mmap_file, 0, size_written, size_raw, false);
+  }
+  const double read_time = BLI_time_now_seconds() - read_start;
+  EXPECT_TRUE(ok);
+
+  const double size_mb = double(size_raw) * ITERATIONS / (1024.0 * 1024.0);
+  printf("%s: ratio %.2f, write %.1f MB/s, read %.1f MB/s\n",
+         name,
+         double(size_raw) / size_written,
+         size_mb / write_time,
+         size_mb / read_time);
+
+  BLI_mmap_free(mmap_file);
+  fclose(file);
+  IMB_freeImBuf(src);
+  IMB_freeImBuf(dst);
+}
+
+static void test_disk_cache_perf(bool use_float)
+{
+  disk_cache_perf_impl("uncompressed", use_float, 0);
+  disk_cache_perf_impl("compress_low", use_float, 1);
+  disk_cache_perf_impl("compress_high", use_float, 9);
+}
+
+TEST(sequencer_disk_cache, disk_cache_perf_byte)
+{
+  test_disk_cache_perf(false);
+}
+
+TEST(sequencer_disk_cache, disk_cache_perf_float)
+{
+  test_disk_cache_perf(true);
+}
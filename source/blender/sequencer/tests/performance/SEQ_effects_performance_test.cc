@@ -0,0 +1,140 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_scene_types.h"
+#include "DNA_sequence_types.h"
+#include "DNA_space_types.h"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "BLI_time.h"
+
+#include "SEQ_effects.hh"
+#include "SEQ_render.hh"
+
+#include "render.hh"
+
+static constexpr int SRC_X = 3840;
+static constexpr int SRC_Y = 2160;
+static constexpr int ITERATIONS = 10;
+
+static ImBuf *create_src_image(bool use_float, int seed)
+{
+  ImBuf *img = IMB_allocImBuf(SRC_X, SRC_Y, 32, use_float ? IB_rectfloat : IB_rect);
+  /* Gradients with partially transparent areas, so alpha dependent code paths are covered. */
+  if (use_float) {
+    float *pix = img->float_buffer.data;
+    for (int i = 0; i < img->x * img->y; i++) {
+      const int x = i % img->x, y = i / img->x;
+      const float alpha = float((x + seed * 97) % 512) / 511.0f;
+      pix[0] = alpha * float(x) / img->x;
+      pix[1] = alpha * float(y) / img->y;
+      pix[2] = alpha * (0.5f + float((i * 13 + seed) % 11) * 0.02f);
+      pix[3] = alpha;
+      pix += 4;
+    }
+  }
+  else {
+    uchar *pix = img->byte_buffer.data;
+    for (int i = 0; i < img->x * img->y; i++) {
+      const int x = i % img->x, y = i / img->x;
+      pix[0] = (x * 255 / img->x + seed) & 0xFF;
+      pix[1] = (y * 255 / img->y) & 0xFF;
+      pix[2] = (128 + (i * 13 + seed) % 5) & 0xFF;
+      pix[3] = (x + seed * 97) & 0xFF;
+      pix += 4;
+    }
+  }
+  return img;
+}
+
+static void effect_perf_impl(const char *name, int type, int blend_effect, bool use_float)
+{
+  Scene *scene = static_cast<Scene *>(MEM_callocN(sizeof(Scene), __func__));
+  scene->r.xsch = SRC_X;
+  scene->r.ysch = SRC_Y;
+  scene->r.size = 100;
+
+  SeqRenderData context;
+  SEQ_render_new_render_data(
+      nullptr, nullptr, scene, SRC_X, SRC_Y, SEQ_RENDER_SIZE_SCENE, true, &context);
+
+  Sequence seq = {};
+  seq.type = type;
+  SeqEffectHandle sh = SEQ_effect_handle_get(&seq);
+  if (sh.init) {
+    sh.init(&seq);
+  }
+  if (type == SEQ_TYPE_COLORMIX) {
+    static_cast<ColorMixVars *>(seq.effectdata)->blend_effect = blend_effect;
+  }
+  else if (type == SEQ_TYPE_GAUSSIAN_BLUR) {
+    GaussianBlurVars *data = static_cast<GaussianBlurVars *>(seq.effectdata);
+    data->size_x = 20.0f;
+    data->size_y = 20.0f;
+  }
+
+  ImBuf *ibuf1 = create_src_image(use_float, 0);
+  ImBuf *ibuf2 = create_src_image(use_float, 1);
+  const float fac = 0.5f;
+
+  const double start = BLI_time_now_seconds();
+  for (int i = 0; i < ITERATIONS; i++) {
+    ImBuf *out;
+    if (sh.multithreaded) {
+      out = seq_render_effect_execute_threaded(
+          &sh, &context, &seq, 1.0f, fac, ibuf1, ibuf2, nullptr);
+    }
+    else {
+      out = sh.execute(&context, &seq, 1.0f, fac, ibuf1, ibuf2, nullptr);
+    }
+    EXPECT_NE(out, nullptr);
+    IMB_freeImBuf(out);
+  }
+  const double time = BLI_time_now_seconds() - start;
+
+  printf("%s %s: %.2f ms/frame, %.1f Mpixels/s\n",
+         name,
+         use_float ? "float" : "byte",
+         time * 1000.0 / ITERATIONS,
+         double(SRC_X) * SRC_Y * ITERATIONS / (time * 1e6));
+
+  if (sh.free) {
+    sh.free(&seq, true);
+  }
+  IMB_freeImBuf(ibuf1);
+  IMB_freeImBuf(ibuf2);
+  MEM_freeN(scene);
+}
+
+static void test_effects_perf(bool use_float)
+{
+  effect_perf_impl("alpha_over", SEQ_TYPE_ALPHAOVER, 0, use_float);
+  effect_perf_impl("cross", SEQ_TYPE_CROSS, 0, use_float);
+  effect_perf_impl("gamma_cross", SEQ_TYPE_GAMCROSS, 0, use_float);
+  effect_perf_impl("blend_add", SEQ_TYPE_COLORMIX, SEQ_TYPE_ADD, use_float);
+  effect_perf_impl("blend_screen", SEQ_TYPE_COLORMIX, SEQ_TYPE_SCREEN, use_float);
+  effect_perf_impl("blend_overlay", SEQ_TYPE_COLORMIX, SEQ_TYPE_OVERLAY, use_float);
+  effect_perf_impl("blend_hue", SEQ_TYPE_COLORMIX, SEQ_TYPE_HUE, use_float);
+  effect_perf_impl("wipe", SEQ_TYPE_WIPE, 0, use_float);
+  effect_perf_impl("glow", SEQ_TYPE_GLOW, 0, use_float);
+  effect_perf_impl("gaussian_blur", SEQ_TYPE_GAUSSIAN_BLUR, 0, use_float);
+}
+
+TEST(sequencer_effects, effects_perf_byte)
+{
+  test_effects_perf(false);
+}
+
+TEST(sequencer_effects, effects_perf_float)
+{
+  test_effects_perf(true);
+}
@@ -110,6 +110,8 @@
 
 #include "NOD_composite.hh"
 
+#include "COM_compositor.hh"
+
 #include "GHOST_C-api.h"
 #include "GHOST_Path-api.hh"
 
@@ -670,6 +672,10 @@ static void wm_file_read_pre(bool use_data, bool /*use_userdef*/)
 {
   if (use_data) {
     BLI_timer_on_file_load();
+#ifdef WITH_COMPOSITOR_CPU
+    /* Compositor results cached for the previous file are of no use for the new one. */
+    COM_clear_caches();
+#endif
   }
 
   /* Always do this as both startup and preferences may have loaded in many font's
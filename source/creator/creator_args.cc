@@ -670,6 +670,8 @@ static void print_help(bArgs *ba, bool all)
     PRINT("\t# blender -b file.blend -f 20 -- --cycles-device OPTIX\n");
     PRINT("--cycles-print-stats\n");
     PRINT("\tLog statistics about render memory and time usage.\n");
+    PRINT("--cycles-trace-file <path>\n");
+    PRINT("\tWrite a Chrome trace of scene synchronization and update times to the file.\n");
   }
 
   PRINT("\n");
@@ -0,0 +1,81 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import re
+
+# Display transform benchmark.
+#
+# A 4K float image is converted to display space with a view transform,
+# either with the exact OpenColorIO processor or through a baked 3D LUT. The
+# error of the baked LUT is reported by Blender in debug mode when baking.
+
+VIEW_TRANSFORMS = ('AgX', 'Filmic')
+MODES = ('exact', 'baked_lut')
+
+NUM_ITERATIONS = 8
+ERROR_PATTERN = re.compile(r"Baked .* LUT .* max error ([0-9.]+), mean error ([0-9.]+)")
+
+
+def _run(args):
+    import bpy
+    import random
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.view_settings.view_transform = args['view_transform']
+    scene.view_settings.use_baked_lut = args['mode'] == 'baked_lut'
+    scene.render.image_settings.file_format = 'BMP'
+
+    width, height = 3840, 2160
+    image = bpy.data.images.new("Image", width, height, alpha=True, float_buffer=True)
+
+    # Scene linear values over a wide range, a few stops below and above 1.
+    rng = random.Random(0)
+    row = []
+    for x in range(width):
+        row.extend((2.0 ** rng.uniform(-8.0, 6.0), 2.0 ** rng.uniform(-8.0, 6.0), 2.0 ** rng.uniform(-8.0, 6.0), 1.0))
+    image.pixels.foreach_set(row * height)
+
+    # Saving applies the view transform of the scene to the float buffer.
+    start_time = time.perf_counter()
+    for i in range(NUM_ITERATIONS):
+        image.save_render(args['filepath'], scene=scene)
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time / NUM_ITERATIONS}
+
+
+class ColormanagementDisplayTest(api.Test):
+    def __init__(self, view_transform, mode):
+        self.view_transform = view_transform
+        self.mode = mode
+
+    def name(self):
+        return f"{self.view_transform.lower()}_{self.mode}"
+
+    def category(self):
+        return "colormanagement_display"
+
+    def run(self, env, device_id):
+        args = {'view_transform': self.view_transform,
+                'mode': self.mode,
+                'filepath': str(env.log_file.parent / (env.log_file.stem + '.bmp'))}
+
+        result, log = env.run_in_blender(_run, args, ['--debug'])
+
+        for line in log:
+            match = ERROR_PATTERN.search(line)
+            if match:
+                result['max_error'] = float(match.group(1))
+                result['mean_error'] = float(match.group(2))
+
+        return result
+
+
+def generate(env):
+    return [ColormanagementDisplayTest(view_transform, mode)
+            for view_transform in VIEW_TRANSFORMS
+            for mode in MODES]
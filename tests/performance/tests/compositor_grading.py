@@ -0,0 +1,109 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# CPU compositor color grading benchmark.
+#
+# A generated float image goes through a typical chain of color grading nodes
+# into the composite output, and only the compositor is executed. All these
+# nodes operate per pixel, so the time is dominated by memory traffic between
+# the operations rather than by the computations.
+
+RESOLUTIONS = {'4k': (3840, 2160), '8k': (7680, 4320)}
+
+NUM_ITERATIONS = 4
+
+
+def _build_grading_tree(scene, image):
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.nodes.clear()
+
+    image_node = tree.nodes.new('CompositorNodeImage')
+    image_node.image = image
+
+    exposure = tree.nodes.new('CompositorNodeExposure')
+    exposure.inputs['Exposure'].default_value = 0.5
+
+    balance = tree.nodes.new('CompositorNodeColorBalance')
+    balance.correction_method = 'OFFSET_POWER_SLOPE'
+    balance.slope = (1.1, 1.0, 0.9)
+
+    hue_sat = tree.nodes.new('CompositorNodeHueSat')
+    hue_sat.inputs['Saturation'].default_value = 1.2
+
+    curves = tree.nodes.new('CompositorNodeCurveRGB')
+    curve = curves.mapping.curves[3]
+    curve.points.new(0.25, 0.2)
+    curve.points.new(0.75, 0.8)
+    curves.mapping.update()
+
+    bright_contrast = tree.nodes.new('CompositorNodeBrightContrast')
+    bright_contrast.inputs['Contrast'].default_value = 10.0
+
+    gamma = tree.nodes.new('CompositorNodeGamma')
+    gamma.inputs['Gamma'].default_value = 1.1
+
+    vignette = tree.nodes.new('CompositorNodeMixRGB')
+    vignette.blend_type = 'MULTIPLY'
+    vignette.inputs['Fac'].default_value = 0.3
+    vignette.inputs[2].default_value = (0.8, 0.8, 0.9, 1.0)
+
+    composite = tree.nodes.new('CompositorNodeComposite')
+
+    chain = (image_node, exposure, balance, hue_sat, curves, bright_contrast, gamma, vignette, composite)
+    for from_node, to_node in zip(chain[:-1], chain[1:]):
+        tree.links.new(from_node.outputs['Image'], to_node.inputs['Image'])
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    width, height = args['resolution']
+    scene.render.resolution_x = width
+    scene.render.resolution_y = height
+    scene.render.resolution_percentage = 100
+    scene.render.use_compositing = True
+    scene.render.use_sequencer = False
+    scene.render.compositor_device = 'CPU'
+
+    image = bpy.data.images.new("Image", width, height, alpha=True, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    _build_grading_tree(scene, image)
+
+    # Warm up, so the image is generated before timing.
+    bpy.ops.render.render()
+
+    start_time = time.perf_counter()
+    for i in range(NUM_ITERATIONS):
+        bpy.ops.render.render()
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time / NUM_ITERATIONS}
+
+
+class CompositorGradingTest(api.Test):
+    def __init__(self, resolution_name):
+        self.resolution_name = resolution_name
+
+    def name(self):
+        return self.resolution_name
+
+    def category(self):
+        return "compositor_grading"
+
+    def run(self, env, device_id):
+        args = {'resolution': RESOLUTIONS[self.resolution_name]}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [CompositorGradingTest(resolution_name) for resolution_name in RESOLUTIONS]
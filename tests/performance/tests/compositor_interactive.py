@@ -0,0 +1,160 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import time
+
+import api
+
+# CPU compositor interactive latency benchmark.
+#
+# A multi-layer EXR with several render passes goes through a comp with
+# expensive filters shown in a node editor backdrop. A single node parameter is
+# changed repeatedly, as when tweaking the node in the editor, and the time
+# until the compositor job of the node editor finishes is measured. Depending
+# on where the changed node is, the results of the nodes before it can be
+# reused from the previous execution. Blender runs in the foreground, as
+# renders don't go through the node editor job.
+
+# Node changed between executions, and its value for each execution. Values
+# are never repeated, so the changed node itself is always executed.
+TWEAKS = {
+    'grade': ('Color Balance', 'lift', lambda i: (1.0 + 0.01 * i, 1.0, 1.0)),
+    'glare': ('Glare', 'threshold', lambda i: 1.0 - 0.02 * i),
+    'blur': ('Blur', 'size_x', lambda i: 20 + i),
+}
+
+NUM_ITERATIONS = 6
+LOG_KEY = "COMPOSITOR_INTERACTIVE: "
+
+
+def _render_passes(scene, filepath):
+    import bpy
+
+    scene.render.engine = 'CYCLES'
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 1
+    scene.render.resolution_x = 3840
+    scene.render.resolution_y = 2160
+    scene.render.resolution_percentage = 100
+    scene.render.use_compositing = False
+
+    view_layer = scene.view_layers[0]
+    view_layer.use_pass_z = True
+    view_layer.use_pass_normal = True
+    view_layer.use_pass_diffuse_color = True
+
+    scene.render.image_settings.file_format = 'OPEN_EXR_MULTILAYER'
+    scene.render.filepath = filepath
+    scene.render.use_file_extension = False
+    bpy.ops.render.render(write_still=True)
+
+
+def _build_tree(scene, image):
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.nodes.clear()
+
+    image_node = tree.nodes.new('CompositorNodeImage')
+    image_node.image = image
+    combined = image_node.outputs[0]
+    diffuse_color = image_node.outputs.get('DiffCol', combined)
+
+    blur = tree.nodes.new('CompositorNodeBlur')
+    blur.name = 'Blur'
+    blur.filter_type = 'GAUSS'
+    blur.size_x = 20
+    blur.size_y = 20
+
+    multiply = tree.nodes.new('CompositorNodeMixRGB')
+    multiply.blend_type = 'MULTIPLY'
+
+    glare = tree.nodes.new('CompositorNodeGlare')
+    glare.name = 'Glare'
+    glare.glare_type = 'FOG_GLOW'
+    glare.quality = 'MEDIUM'
+
+    balance = tree.nodes.new('CompositorNodeColorBalance')
+    balance.name = 'Color Balance'
+
+    viewer = tree.nodes.new('CompositorNodeViewer')
+    composite = tree.nodes.new('CompositorNodeComposite')
+
+    tree.links.new(combined, blur.inputs['Image'])
+    tree.links.new(blur.outputs['Image'], multiply.inputs[1])
+    tree.links.new(diffuse_color, multiply.inputs[2])
+    tree.links.new(multiply.outputs['Image'], glare.inputs['Image'])
+    tree.links.new(glare.outputs['Image'], balance.inputs['Image'])
+    tree.links.new(balance.outputs['Image'], viewer.inputs['Image'])
+    tree.links.new(balance.outputs['Image'], composite.inputs['Image'])
+
+
+def _run(args):
+    import bpy
+
+    scene = bpy.context.scene
+    _render_passes(scene, args['exr_filepath'])
+
+    scene.render.use_compositing = True
+    scene.render.use_sequencer = False
+    scene.render.compositor_device = 'CPU'
+
+    image = bpy.data.images.load(args['exr_filepath'])
+    _build_tree(scene, image)
+
+    # Show the viewer in the backdrop of the largest area, the node editor
+    # executes the compositor whenever the tree changes.
+    screen = bpy.context.window_manager.windows[0].screen
+    area = max(screen.areas, key=lambda area: area.width * area.height)
+    area.type = 'NODE_EDITOR'
+    area.ui_type = 'CompositorNodeTree'
+    area.spaces.active.show_backdrop = True
+
+    node_name, property_name, value_fn = TWEAKS[args['tweak']]
+    node = scene.node_tree.nodes[node_name]
+    state = {'iteration': 0, 'start_time': 0.0, 'elapsed_time': 0.0}
+
+    def tweak():
+        state['iteration'] += 1
+        state['start_time'] = time.perf_counter()
+        setattr(node, property_name, value_fn(state['iteration']))
+        return None
+
+    def composite_post(_scene):
+        # The first execution loads the image and computes every node, it
+        # isn't timed.
+        if state['iteration'] > 0:
+            state['elapsed_time'] += time.perf_counter() - state['start_time']
+        if state['iteration'] < NUM_ITERATIONS:
+            bpy.app.timers.register(tweak)
+            return
+        bpy.app.handlers.composite_post.remove(composite_post)
+        print(f"{LOG_KEY}{{'time': {state['elapsed_time'] / NUM_ITERATIONS}}}")
+        bpy.app.timers.register(lambda: bpy.ops.wm.quit_blender())
+
+    bpy.app.handlers.composite_post.append(composite_post)
+
+
+class CompositorInteractiveTest(api.Test):
+    def __init__(self, tweak):
+        self.tweak = tweak
+
+    def name(self):
+        return self.tweak
+
+    def category(self):
+        return "compositor_interactive"
+
+    def run(self, env, device_id):
+        args = {'tweak': self.tweak,
+                'exr_filepath': str(env.log_file.parent / (env.log_file.stem + '_passes.exr'))}
+        _, log = env.run_in_blender(_run, args, ['--factory-startup'], foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return eval(line[len(LOG_KEY):])
+
+        raise Exception("No compositor execution time found in log.")
+
+
+def generate(env):
+    return [CompositorInteractiveTest(tweak) for tweak in TWEAKS]
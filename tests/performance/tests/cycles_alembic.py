@@ -0,0 +1,106 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Alembic procedural benchmark.
+#
+# A set of deforming meshes is exported to an Alembic archive, imported again
+# as a cache file rendered with the Cycles procedural, and a range of frames is
+# rendered with a low sample count. The time per frame is dominated by reading
+# the archive, either for each frame or for the whole animation upfront.
+
+MODES = ('per_frame', 'prefetch')
+
+NUM_OBJECTS = 16
+NUM_FRAMES = 8
+
+
+def _export_archive(filepath):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    for i in range(NUM_OBJECTS):
+        bpy.ops.mesh.primitive_uv_sphere_add(segments=256,
+                                             ring_count=128,
+                                             radius=0.4,
+                                             location=((i % 4) - 1.5, (i // 4) - 1.5, 0.0))
+        sphere = bpy.context.object
+        wave = sphere.modifiers.new("Wave", 'WAVE')
+        wave.height = 0.1
+        wave.width = 0.2
+        wave.speed = 0.1 + i * 0.01
+
+    bpy.ops.wm.alembic_export(filepath=filepath, start=1, end=NUM_FRAMES, uvs=True, normals=True)
+
+
+def _run(args):
+    import bpy
+    import time
+
+    _export_archive(args['abc_filepath'])
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    bpy.ops.wm.alembic_import(filepath=args['abc_filepath'])
+    for cache_file in bpy.data.cache_files:
+        cache_file.use_render_procedural = True
+        cache_file.use_prefetch = args['mode'] == 'prefetch'
+        cache_file.prefetch_cache_size = 8192
+
+    bpy.ops.object.camera_add(location=(0.0, 0.0, 6.0))
+    camera = bpy.context.object
+    scene.camera = camera
+
+    bpy.ops.object.light_add(type='SUN')
+
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = 256
+    scene.render.resolution_y = 256
+    scene.render.resolution_percentage = 100
+    # Keep the render session, and with it the procedural, alive between frames.
+    scene.render.use_persistent_data = True
+
+    scene.cycles.feature_set = 'EXPERIMENTAL'
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 1
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = False
+
+    start_time = time.perf_counter()
+    for frame in range(scene.frame_start, scene.frame_end + 1):
+        scene.frame_set(frame)
+        bpy.ops.render.render()
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time / NUM_FRAMES}
+
+
+class CyclesAlembicTest(api.Test):
+    def __init__(self, mode):
+        self.mode = mode
+
+    def name(self):
+        return self.mode
+
+    def category(self):
+        return "cycles_alembic"
+
+    def run(self, env, device_id):
+        args = {'mode': self.mode,
+                'abc_filepath': str(env.log_file.parent / (env.log_file.stem + '.abc'))}
+
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [CyclesAlembicTest(mode) for mode in MODES]
@@ -0,0 +1,86 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Cycles CPU denoising benchmark.
+#
+# A large image is rendered with a single sample and denoised with
+# OpenImageDenoise, either for the full frame at once or in tiles with a
+# memory limit. The peak memory of the Blender process is reported along with
+# the render time, to compare the memory used by the two modes.
+
+MODES = {
+    'full': {'max_memory': 0},
+    'tiled': {'max_memory': 256},
+}
+
+RESOLUTION = 4096
+
+
+def _run(args):
+    import bpy
+    import math
+    import resource
+    import sys
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_plane_add(size=20.0)
+    for i in range(5):
+        bpy.ops.mesh.primitive_uv_sphere_add(radius=0.6, location=(i * 1.5 - 3.0, 0.0, 0.6))
+    bpy.ops.object.light_add(type='AREA', location=(0.0, -2.0, 4.0))
+    bpy.context.object.data.energy = 500.0
+    bpy.ops.object.camera_add(location=(0.0, -8.0, 4.0), rotation=(math.radians(65.0), 0.0, 0.0))
+    scene.camera = bpy.context.object
+
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = RESOLUTION
+    scene.render.resolution_y = RESOLUTION
+    scene.render.resolution_percentage = 100
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 1
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = True
+    scene.cycles.denoiser = 'OPENIMAGEDENOISE'
+    scene.cycles.denoising_input_passes = 'RGB_ALBEDO_NORMAL'
+    scene.cycles.denoising_prefilter = 'ACCURATE'
+    scene.cycles.denoising_use_gpu = False
+    scene.cycles.denoising_max_memory = args['max_memory']
+
+    start_time = time.perf_counter()
+    bpy.ops.render.render()
+    elapsed_time = time.perf_counter() - start_time
+
+    # Maximum resident set size, in kilobytes on Linux and in bytes on macOS.
+    peak_memory = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform != 'darwin':
+        peak_memory *= 1024
+
+    return {'time': elapsed_time, 'peak_memory': peak_memory / (1024 * 1024)}
+
+
+class CyclesDenoiseTest(api.Test):
+    def __init__(self, mode):
+        self.mode = mode
+
+    def name(self):
+        return self.mode
+
+    def category(self):
+        return "cycles_denoise"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, MODES[self.mode])
+        return result
+
+
+def generate(env):
+    import sys
+    if sys.platform == 'win32':
+        # Peak memory of the process is not available through the resource module.
+        return []
+    return [CyclesDenoiseTest(mode) for mode in MODES]
@@ -0,0 +1,108 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Cycles instancing benchmark.
+#
+# A small rock mesh is scattered on a grid of points with geometry nodes,
+# creating millions of instances, and rendered with a single sample at a low
+# resolution. The render time is dominated by synchronizing the instances and
+# building the BVH, and the peak memory by the per-instance data.
+
+SCENES = {
+    '1m_instances': {'instances_num': 1000000},
+    '10m_instances': {'instances_num': 10000000},
+}
+
+
+def _prepare_scene(args):
+    import bpy
+    import math
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_ico_sphere_add(subdivisions=1, radius=0.2)
+    rock = bpy.context.object
+    rock.hide_render = True
+
+    bpy.ops.mesh.primitive_plane_add()
+    scatter = bpy.context.object
+
+    side = int(math.ceil(math.sqrt(args['instances_num'])))
+    tree = bpy.data.node_groups.new("Scatter", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+    grid = tree.nodes.new('GeometryNodeMeshGrid')
+    grid.inputs['Size X'].default_value = side * 0.5
+    grid.inputs['Size Y'].default_value = side * 0.5
+    grid.inputs['Vertices X'].default_value = side
+    grid.inputs['Vertices Y'].default_value = side
+    object_info = tree.nodes.new('GeometryNodeObjectInfo')
+    object_info.inputs['Object'].default_value = rock
+    instance_on_points = tree.nodes.new('GeometryNodeInstanceOnPoints')
+    output = tree.nodes.new('NodeGroupOutput')
+    tree.links.new(grid.outputs['Mesh'], instance_on_points.inputs['Points'])
+    tree.links.new(object_info.outputs['Geometry'], instance_on_points.inputs['Instance'])
+    tree.links.new(instance_on_points.outputs['Instances'], output.inputs[0])
+    scatter.modifiers.new("Scatter", 'NODES').node_group = tree
+
+    bpy.ops.object.camera_add(location=(0.0, 0.0, side * 0.5), rotation=(0.0, 0.0, 0.0))
+    scene.camera = bpy.context.object
+    bpy.ops.object.light_add(type='SUN')
+
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = 256
+    scene.render.resolution_y = 256
+    scene.render.resolution_percentage = 100
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 1
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = False
+
+
+def _run(args):
+    import bpy
+    import time
+
+    _prepare_scene(args)
+
+    start_time = time.perf_counter()
+    bpy.ops.render.render()
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time}
+
+
+class CyclesInstancingTest(api.Test):
+    def __init__(self, scene_name):
+        self.scene_name = scene_name
+
+    def name(self):
+        return self.scene_name
+
+    def category(self):
+        return "cycles_instancing"
+
+    def run(self, env, device_id):
+        result, lines = env.run_in_blender(_run, SCENES[self.scene_name],
+                                           ['--debug-cycles', '--verbose', '2'])
+
+        # Parse peak memory from output, it includes the kernel object arrays and the BVH.
+        prefix_memory = "Peak: "
+        for line in lines:
+            line = line.strip()
+            offset = line.find(prefix_memory)
+            if offset != -1:
+                memory = line[offset + len(prefix_memory):]
+                result['peak_memory'] = float(memory.split()[0].replace(',', ''))
+
+        if 'peak_memory' not in result:
+            raise Exception("Error parsing peak memory output")
+
+        return result
+
+
+def generate(env):
+    return [CyclesInstancingTest(scene_name) for scene_name in SCENES]
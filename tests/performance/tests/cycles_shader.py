@@ -0,0 +1,155 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Shader evaluation micro-benchmark.
+#
+# A plane filling the camera view is rendered with a procedural material and
+# no light bounces, so the time is dominated by evaluating the material for a
+# fixed set of shading points.
+
+MATERIALS = ('math_chain', 'texture_mix', 'layered')
+
+
+def _add_noise(nodes, scale):
+    noise = nodes.new('ShaderNodeTexNoise')
+    noise.inputs["Scale"].default_value = scale
+    noise.inputs["Detail"].default_value = 4.0
+    return noise
+
+
+def _add_math_chain(nodes, links, socket):
+    for operation, value in (('MULTIPLY', 2.0),
+                             ('SUBTRACT', 0.5),
+                             ('ABSOLUTE', 0.0),
+                             ('POWER', 1.5),
+                             ('MULTIPLY_ADD', 0.25),
+                             ('MINIMUM', 1.0)):
+        math = nodes.new('ShaderNodeMath')
+        math.operation = operation
+        math.inputs[1].default_value = value
+        math.inputs[2].default_value = 0.1
+        links.new(socket, math.inputs[0])
+        socket = math.outputs[0]
+    return socket
+
+
+def _add_color_mix(nodes, links, factor, color_a, color_b):
+    mix = nodes.new('ShaderNodeMix')
+    mix.data_type = 'RGBA'
+    mix.inputs["A"].default_value = color_a
+    mix.inputs["B"].default_value = color_b
+    links.new(factor, mix.inputs["Factor"])
+    return mix.outputs["Result"]
+
+
+def _build_material(name):
+    import bpy
+
+    material = bpy.data.materials.new(name)
+    material.use_nodes = True
+    nodes = material.node_tree.nodes
+    links = material.node_tree.links
+    bsdf = nodes["Principled BSDF"]
+
+    if name == 'math_chain':
+        noise = _add_noise(nodes, 5.0)
+        links.new(_add_math_chain(nodes, links, noise.outputs["Fac"]), bsdf.inputs["Roughness"])
+    elif name == 'texture_mix':
+        noise = _add_noise(nodes, 5.0)
+        color = _add_color_mix(nodes, links, noise.outputs["Fac"],
+                               (0.8, 0.2, 0.1, 1.0), (0.1, 0.3, 0.8, 1.0))
+        links.new(color, bsdf.inputs["Base Color"])
+    elif name == 'layered':
+        color = None
+        for layer in range(3):
+            noise = _add_noise(nodes, 2.0 + layer * 4.0)
+            factor = _add_math_chain(nodes, links, noise.outputs["Fac"])
+            layer_color = _add_color_mix(nodes, links, factor,
+                                         (0.8, 0.2 * layer, 0.1, 1.0), (0.1, 0.3, 0.8, 1.0))
+            if color is None:
+                color = layer_color
+            else:
+                mix = nodes.new('ShaderNodeMix')
+                mix.data_type = 'RGBA'
+                mix.blend_type = 'OVERLAY'
+                mix.inputs["Factor"].default_value = 0.5
+                links.new(color, mix.inputs["A"])
+                links.new(layer_color, mix.inputs["B"])
+                color = mix.outputs["Result"]
+        links.new(color, bsdf.inputs["Base Color"])
+
+    return material
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_plane_add(size=2.0)
+    plane = bpy.context.object
+    plane.data.materials.append(_build_material(args['material']))
+
+    bpy.ops.object.camera_add(location=(0.0, 0.0, 1.0))
+    camera = bpy.context.object
+    camera.data.type = 'ORTHO'
+    camera.data.ortho_scale = 2.0
+    scene.camera = camera
+
+    bpy.ops.object.light_add(type='SUN')
+
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = 1024
+    scene.render.resolution_y = 1024
+    scene.render.resolution_percentage = 100
+    scene.render.filepath = args['render_filepath']
+    scene.render.image_settings.file_format = 'PNG'
+
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 64
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = False
+    scene.cycles.max_bounces = 0
+
+    bpy.ops.render.render(write_still=True)
+
+    return None
+
+
+class CyclesShaderTest(api.Test):
+    def __init__(self, material):
+        self.material = material
+
+    def name(self):
+        return self.material
+
+    def category(self):
+        return "cycles_shader"
+
+    def run(self, env, device_id):
+        args = {'material': self.material,
+                'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
+
+        _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '2'])
+
+        # Parse render time from output
+        prefix_time = "Render time (without synchronization): "
+        time = None
+        for line in lines:
+            line = line.strip()
+            offset = line.find(prefix_time)
+            if offset != -1:
+                time = float(line[offset + len(prefix_time):])
+
+        if not time:
+            raise Exception("Error parsing render time output")
+
+        return {'time': time}
+
+
+def generate(env):
+    return [CyclesShaderTest(material) for material in MATERIALS]
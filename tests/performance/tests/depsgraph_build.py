@@ -0,0 +1,81 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+from .depsgraph_relations import prepare_scene
+
+# Dependency graph build benchmark.
+#
+# A scene with many objects, each with a modifier, a constraint targeting the
+# previous object and a driver, has its whole dependency graph built again by
+# linking and unlinking an empty object, which is what happens when objects
+# are added, removed or moved between collections. The time to build the graph
+# of a new view layer is measured as well, which is what happens when
+# switching view layers.
+#
+# Every scene is built with a single thread as well, which runs the relation
+# builder workers one after the other, to compare with the parallel build.
+
+SCENES = {
+    '10k_objects': {'objects_num': 10000},
+    '50k_objects': {'objects_num': 50000},
+    '100k_objects': {'objects_num': 100000},
+}
+
+# Extra Blender arguments for the build modes.
+MODES = {
+    'serial': ['--threads', '1'],
+    'parallel': [],
+}
+
+NUM_BUILDS = 5
+
+
+def _run(args):
+    import bpy
+    import time
+
+    prepare_scene(args)
+    scene = bpy.context.scene
+    view_layer = bpy.context.view_layer
+    empty = bpy.data.objects.new("Empty", None)
+
+    build_time = 0.0
+    for i in range(NUM_BUILDS):
+        start = time.perf_counter()
+        if i % 2 == 0:
+            scene.collection.objects.link(empty)
+        else:
+            scene.collection.objects.unlink(empty)
+        view_layer.update()
+        build_time += time.perf_counter() - start
+
+    new_view_layer = scene.view_layers.new("New View Layer")
+    start = time.perf_counter()
+    new_view_layer.depsgraph.update()
+    view_layer_time = time.perf_counter() - start
+
+    return {'time': build_time / NUM_BUILDS,
+            'view_layer_time': view_layer_time}
+
+
+class DepsgraphBuildTest(api.Test):
+    def __init__(self, scene_name, mode):
+        self.scene_name = scene_name
+        self.mode = mode
+
+    def name(self):
+        return f"{self.scene_name}_{self.mode}"
+
+    def category(self):
+        return "depsgraph_build"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, SCENES[self.scene_name], MODES[self.mode])
+        return result
+
+
+def generate(env):
+    return [DepsgraphBuildTest(scene_name, mode) for scene_name in SCENES for mode in MODES]
@@ -0,0 +1,123 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Dependency graph relations update benchmark.
+#
+# A scene with many objects, each with a modifier, a constraint targeting the
+# previous object and a driver, is edited in ways which change the relations
+# of a single object. The time from the edit to the updated dependency graph
+# is measured for every kind of edit. Parenting is included as a reference for
+# edits which always build the whole graph.
+
+SCENES = {
+    '10k_objects': {'objects_num': 10000},
+    '50k_objects': {'objects_num': 50000},
+}
+
+EDITS = (
+    'modifier_add',
+    'modifier_remove',
+    'constraint_add',
+    'constraint_remove',
+    'driver_add',
+    'driver_remove',
+    'parent_set',
+)
+
+NUM_EDITS = 10
+
+
+def prepare_scene(args):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    mesh = bpy.data.meshes.new("Mesh")
+    mesh.from_pydata([(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (0.0, 1.0, 0.0)], [], [(0, 1, 2)])
+
+    previous = None
+    for i in range(args['objects_num']):
+        ob = bpy.data.objects.new("Object", mesh)
+        ob.location.x = i * 2.0
+        scene.collection.objects.link(ob)
+        ob.modifiers.new("Displace", 'DISPLACE')
+        if previous is not None:
+            constraint = ob.constraints.new('COPY_ROTATION')
+            constraint.target = previous
+        fcurve = ob.driver_add("location", 2)
+        variable = fcurve.driver.variables.new()
+        variable.targets[0].id = ob
+        variable.targets[0].data_path = "location.x"
+        fcurve.driver.expression = variable.name
+        previous = ob
+
+    bpy.context.view_layer.update()
+
+
+def _edit(args, ob, target):
+    edit = args['edit']
+    if edit == 'modifier_add':
+        ob.modifiers.new("Subdivision", 'SUBSURF')
+    elif edit == 'modifier_remove':
+        ob.modifiers.remove(ob.modifiers[0])
+    elif edit == 'constraint_add':
+        constraint = ob.constraints.new('COPY_LOCATION')
+        constraint.target = target
+    elif edit == 'constraint_remove':
+        ob.constraints.remove(ob.constraints[0])
+    elif edit == 'driver_add':
+        fcurve = ob.driver_add("rotation_euler", 0)
+        variable = fcurve.driver.variables.new()
+        variable.targets[0].id = target
+        variable.targets[0].data_path = "location.y"
+    elif edit == 'driver_remove':
+        ob.driver_remove("location", 2)
+    elif edit == 'parent_set':
+        ob.parent = target
+
+
+def _run(args):
+    import bpy
+    import time
+
+    prepare_scene(args)
+    view_layer = bpy.context.view_layer
+    objects = bpy.context.scene.collection.objects
+
+    update_time = 0.0
+    for i in range(NUM_EDITS):
+        ob = objects[len(objects) // 2 + i]
+        target = objects[i]
+        start = time.perf_counter()
+        _edit(args, ob, target)
+        view_layer.update()
+        update_time += time.perf_counter() - start
+
+    return {'time': update_time / NUM_EDITS}
+
+
+class DepsgraphRelationsTest(api.Test):
+    def __init__(self, scene_name, edit):
+        self.scene_name = scene_name
+        self.edit = edit
+
+    def name(self):
+        return self.scene_name + '_' + self.edit
+
+    def category(self):
+        return "depsgraph_relations"
+
+    def run(self, env, device_id):
+        args = dict(SCENES[self.scene_name], edit=self.edit)
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [DepsgraphRelationsTest(scene_name, edit)
+            for scene_name in SCENES
+            for edit in EDITS]
@@ -26,12 +26,16 @@ def set_view3d_context_override(context_override):
                 context_override["region"] = region
 
 
-def prepare_sculpt_scene(context):
+def prepare_sculpt_scene(context, scatter_elements=False, spatial_reorder=False):
     import bpy
     """
     Prepare a clean state of the scene suitable for benchmarking
 
     It creates a high-res object and moves it to a sculpt mode.
+
+    With `scatter_elements` the vertices and faces are stored in random order,
+    like meshes coming from other tools often are, instead of the grid order.
+    With `spatial_reorder` they are reordered spatially when entering sculpt mode.
     """
 
     # Ensure the current mode is object, as it might not be the always the case
@@ -56,7 +60,18 @@ def prepare_sculpt_scene(context):
     grid_node.inputs["Vertices X"].default_value = size
     grid_node.inputs["Vertices Y"].default_value = size
 
-    group.links.new(grid_node.outputs["Mesh"], group_output_node.inputs[0])
+    mesh_socket = grid_node.outputs["Mesh"]
+    if scatter_elements:
+        for domain in ('POINT', 'FACE'):
+            random_node = group.nodes.new('FunctionNodeRandomValue')
+            sort_node = group.nodes.new('GeometryNodeSortElements')
+            sort_node.domain = domain
+            group.links.new(mesh_socket, sort_node.inputs["Geometry"])
+            # The second output is the float value.
+            group.links.new(random_node.outputs[1], sort_node.inputs["Sort Key"])
+            mesh_socket = sort_node.outputs["Geometry"]
+
+    group.links.new(mesh_socket, group_output_node.inputs[0])
 
     bpy.ops.mesh.primitive_plane_add(size=2, align='WORLD', location=(0, 0, 0), scale=(1, 1, 1))
 
@@ -67,6 +82,13 @@ def prepare_sculpt_scene(context):
     bpy.ops.object.modifier_apply(modifier="Test")
 
     bpy.ops.object.select_all(action='SELECT')
+
+    if spatial_reorder:
+        # Sculpt settings are created when entering sculpt mode the first time.
+        bpy.ops.object.mode_set(mode='SCULPT')
+        bpy.ops.object.mode_set(mode='OBJECT')
+        context.scene.tool_settings.sculpt.use_spatial_reorder = True
+
     # Move the plane to the sculpt mode.
     bpy.ops.object.mode_set(mode='SCULPT')
 
@@ -116,7 +138,7 @@ def _run(args):
     # Create an undo stack explicitly. This isn't created by default in background mode.
     bpy.ops.ed.undo_push()
 
-    prepare_sculpt_scene(context)
+    prepare_sculpt_scene(context, args['scatter_elements'], args['spatial_reorder'])
 
     context_override = context.copy()
     set_view3d_context_override(context_override)
@@ -131,18 +153,30 @@ def _run(args):
     return result
 
 
+# Variants of the mesh element order: the grid order of the generated mesh, a
+# random order, and a random order reordered spatially when entering sculpt mode.
+ELEMENT_ORDERS = {
+    '': {'scatter_elements': False, 'spatial_reorder': False},
+    'scattered': {'scatter_elements': True, 'spatial_reorder': False},
+    'spatial_reorder': {'scatter_elements': True, 'spatial_reorder': True},
+}
+
+
 class SculptBrushTest(api.Test):
-    def __init__(self, filepath):
+    def __init__(self, filepath, element_order):
         self.filepath = filepath
+        self.element_order = element_order
 
     def name(self):
+        if self.element_order:
+            return self.filepath.stem + '_' + self.element_order
         return self.filepath.stem
 
     def category(self):
         return "sculpt"
 
     def run(self, env, device_id):
-        args = {}
+        args = ELEMENT_ORDERS[self.element_order]
 
         result, _ = env.run_in_blender(_run, args, [self.filepath])
 
@@ -151,4 +185,6 @@ class SculptBrushTest(api.Test):
 
 def generate(env):
     filepaths = env.find_blend_files('sculpt/*')
-    return [SculptBrushTest(filepath) for filepath in filepaths]
+    return [SculptBrushTest(filepath, element_order)
+            for filepath in filepaths
+            for element_order in ELEMENT_ORDERS]
@@ -0,0 +1,92 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+from .sculpt import generate_stroke, prepare_sculpt_scene, set_view3d_context_override
+
+# Sculpt brush type benchmark.
+#
+# A stroke is made over the whole mesh with a new brush of every type, to
+# measure the cost of the factor calculations and the deformation of each
+# brush type separately. Each brush is tested with a preset falloff and with
+# a custom falloff curve.
+
+BRUSH_TYPES = (
+    'DRAW',
+    'DRAW_SHARP',
+    'CLAY',
+    'CLAY_STRIPS',
+    'CLAY_THUMB',
+    'LAYER',
+    'INFLATE',
+    'BLOB',
+    'CREASE',
+    'SMOOTH',
+    'FLATTEN',
+    'FILL',
+    'SCRAPE',
+    'MULTIPLANE_SCRAPE',
+    'PINCH',
+    'GRAB',
+    'ELASTIC_DEFORM',
+    'SNAKE_HOOK',
+    'THUMB',
+    'ROTATE',
+    'MASK',
+)
+
+FALLOFFS = ('SMOOTH', 'CUSTOM')
+
+
+def _run(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    prepare_sculpt_scene(context)
+
+    brush = bpy.data.brushes.new("Test", mode='SCULPT')
+    brush.sculpt_tool = args['brush_type']
+    brush.curve_preset = args['falloff']
+    context.tool_settings.sculpt.brush = brush
+
+    context_override = context.copy()
+    set_view3d_context_override(context_override)
+
+    with context.temp_override(**context_override):
+        start = time.perf_counter()
+        bpy.ops.sculpt.brush_stroke(stroke=generate_stroke(context_override))
+        end = time.perf_counter()
+
+    return {'time': end - start}
+
+
+class SculptBrushTypeTest(api.Test):
+    def __init__(self, filepath, brush_type, falloff):
+        self.filepath = filepath
+        self.brush_type = brush_type
+        self.falloff = falloff
+
+    def name(self):
+        return self.filepath.stem + '_' + self.brush_type.lower() + '_' + self.falloff.lower()
+
+    def category(self):
+        return "sculpt_brushes"
+
+    def run(self, env, device_id):
+        args = {'brush_type': self.brush_type, 'falloff': self.falloff}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('sculpt/*')
+    return [SculptBrushTypeTest(filepath, brush_type, falloff)
+            for filepath in filepaths
+            for brush_type in BRUSH_TYPES
+            for falloff in FALLOFFS]
@@ -0,0 +1,93 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import re
+
+from .sculpt import prepare_sculpt_scene, set_view3d_context_override
+
+# Dynamic topology detail flood fill benchmark.
+#
+# Dynamic topology is enabled on a high-res grid, and the whole mesh is
+# remeshed with a constant detail. The detail is coarser, finer, or about the
+# same as the one of the grid, in which case the edges are only checked.
+#
+# Besides the total time, the time spent finding the edges to split and
+# collapse, which runs in parallel per node, and the time spent splitting and
+# collapsing them, which is serial, are parsed from the log.
+
+# Constant detail resolution, the grid has about 750 edges per unit.
+DETAILS = {
+    'coarsen': 200.0,
+    'unchanged': 500.0,
+    'refine': 1000.0,
+}
+
+QUEUE_PATTERN = re.compile(r"Edge queue creation for \d+ nodes took ([0-9.]+) seconds")
+REMESH_PATTERN = re.compile(r"(?:Long edge subdivision|Short edge collapse) took ([0-9.]+) seconds")
+
+
+def _run(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    prepare_sculpt_scene(context)
+
+    context_override = context.copy()
+    set_view3d_context_override(context_override)
+
+    sculpt = context.scene.tool_settings.sculpt
+    sculpt.detail_type_method = 'CONSTANT'
+    sculpt.constant_detail_resolution = args['detail']
+
+    with context.temp_override(**context_override):
+        bpy.ops.sculpt.dynamic_topology_toggle()
+
+        start = time.perf_counter()
+        bpy.ops.sculpt.detail_flood_fill()
+        end = time.perf_counter()
+
+    return {'time': end - start}
+
+
+class SculptDyntopoTest(api.Test):
+    def __init__(self, filepath, detail):
+        self.filepath = filepath
+        self.detail = detail
+
+    def name(self):
+        return self.filepath.stem + '_' + self.detail
+
+    def category(self):
+        return "sculpt_dyntopo"
+
+    def run(self, env, device_id):
+        args = {'detail': DETAILS[self.detail]}
+        result, lines = env.run_in_blender(
+            _run, args, ['--log', 'pbvh.bmesh', '--log-level', '2', self.filepath])
+
+        queue_time = 0.0
+        remesh_time = 0.0
+        for line in lines:
+            match = QUEUE_PATTERN.search(line)
+            if match:
+                queue_time += float(match.group(1))
+            match = REMESH_PATTERN.search(line)
+            if match:
+                remesh_time += float(match.group(1))
+        result['queue_time'] = queue_time
+        result['remesh_time'] = remesh_time
+
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('sculpt/*')
+    return [SculptDyntopoTest(filepath, detail)
+            for filepath in filepaths
+            for detail in DETAILS]
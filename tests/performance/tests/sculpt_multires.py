@@ -0,0 +1,91 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+from .sculpt import generate_stroke, set_view3d_context_override
+
+# Multires sculpt benchmark.
+#
+# A grid with a multires modifier is subdivided up to a given level, then a
+# stroke is made over the whole mesh in sculpt mode. The time of the
+# subdivision and of the stroke on the multires grids are measured.
+
+# Number of faces along each side of the base grid. Level 5 gives about a
+# million grid vertices, level 6 about four million.
+BASE_SIZE = 32
+
+LEVELS = (5, 6)
+
+
+def _prepare_multires_scene(context, levels):
+    import bpy
+    import time
+
+    if context.object:
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete(use_global=False)
+    bpy.ops.outliner.orphans_purge()
+
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=BASE_SIZE + 1,
+                                    y_subdivisions=BASE_SIZE + 1,
+                                    size=2,
+                                    location=(0, 0, 0))
+    ob = context.object
+    ob.modifiers.new("Multires", 'MULTIRES')
+
+    start = time.perf_counter()
+    for _ in range(levels):
+        bpy.ops.object.multires_subdivide(modifier="Multires", mode='CATMULL_CLARK')
+    subdivide_time = time.perf_counter() - start
+
+    bpy.ops.object.mode_set(mode='SCULPT')
+    return subdivide_time
+
+
+def _run(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    subdivide_time = _prepare_multires_scene(context, args['levels'])
+
+    context_override = context.copy()
+    set_view3d_context_override(context_override)
+
+    with context.temp_override(**context_override):
+        start = time.perf_counter()
+        bpy.ops.sculpt.brush_stroke(stroke=generate_stroke(context_override))
+        end = time.perf_counter()
+
+    return {'time': end - start, 'subdivide_time': subdivide_time}
+
+
+class SculptMultiresTest(api.Test):
+    def __init__(self, filepath, levels):
+        self.filepath = filepath
+        self.levels = levels
+
+    def name(self):
+        return self.filepath.stem + '_level_' + str(self.levels)
+
+    def category(self):
+        return "sculpt_multires"
+
+    def run(self, env, device_id):
+        args = {'levels': self.levels}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('sculpt/*')
+    return [SculptMultiresTest(filepath, levels)
+            for filepath in filepaths
+            for levels in LEVELS]
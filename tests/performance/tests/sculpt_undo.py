@@ -0,0 +1,93 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+from .sculpt import generate_stroke, prepare_sculpt_scene, set_view3d_context_override
+
+# Sculpt undo benchmark.
+#
+# Several strokes are made over the whole mesh, and the memory used by their
+# undo steps is measured, along with the time it takes to undo and redo all of
+# them. Optionally the data of older undo steps is moved to disk.
+
+NUM_STROKES = 8
+
+
+def _resident_memory():
+    import os
+    with open("/proc/self/statm") as f:
+        return int(f.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+
+
+def _run(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    preferences = context.preferences
+    preferences.view.show_developer_ui = args['disk_spill']
+    preferences.experimental.use_sculpt_undo_disk_spill = args['disk_spill']
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    prepare_sculpt_scene(context)
+
+    context_override = context.copy()
+    set_view3d_context_override(context_override)
+
+    with context.temp_override(**context_override):
+        stroke = generate_stroke(context_override)
+        memory_start = _resident_memory()
+        stroke_time = 0.0
+        for _ in range(NUM_STROKES):
+            start = time.perf_counter()
+            bpy.ops.sculpt.brush_stroke(stroke=stroke)
+            stroke_time += time.perf_counter() - start
+        memory_end = _resident_memory()
+
+        start = time.perf_counter()
+        for _ in range(NUM_STROKES):
+            bpy.ops.ed.undo()
+        undo_time = time.perf_counter() - start
+
+        start = time.perf_counter()
+        for _ in range(NUM_STROKES):
+            bpy.ops.ed.redo()
+        redo_time = time.perf_counter() - start
+
+    return {'time': stroke_time / NUM_STROKES,
+            'undo_time': undo_time / NUM_STROKES,
+            'redo_time': redo_time / NUM_STROKES,
+            'undo_memory': max(memory_end - memory_start, 0) / NUM_STROKES}
+
+
+VARIANTS = {
+    'memory': {'disk_spill': False},
+    'disk_spill': {'disk_spill': True},
+}
+
+
+class SculptUndoTest(api.Test):
+    def __init__(self, filepath, variant):
+        self.filepath = filepath
+        self.variant = variant
+
+    def name(self):
+        return self.filepath.stem + '_' + self.variant
+
+    def category(self):
+        return "sculpt_undo"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, VARIANTS[self.variant], [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('sculpt/*')
+    return [SculptUndoTest(filepath, variant)
+            for filepath in filepaths
+            for variant in VARIANTS]
@@ -0,0 +1,138 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import re
+
+# Video Sequencer prefetch benchmark.
+#
+# A 4K timeline with several stacked strips and effects is shown in the
+# sequencer preview, and prefetching renders the frames after the current
+# frame in the background. The prefetch job reports its throughput in the
+# log once all frames are rendered.
+#
+# Parallel prefetching uses a quarter of the system threads, so the number of
+# prefetch threads is varied by overriding the number of system threads. This
+# shows how the throughput scales with the number of frames rendered at the
+# same time.
+
+NUM_FRAMES = 96
+NUM_CHANNELS = 6
+TIMEOUT_SECONDS = 120
+# Number of prefetch threads and the system thread count override to get them.
+PREFETCH_THREADS = {1: None, 2: 8, 4: 16, 8: 32}
+LOG_PATTERN = re.compile(r"Prefetched (\d+) frames in ([0-9.]+) s with (\d+) threads \(([0-9.]+) frames/s\)")
+
+
+def _build_timeline(scene):
+    scene.render.resolution_x = 3840
+    scene.render.resolution_y = 2160
+    scene.render.resolution_percentage = 100
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+    scene.frame_current = 1
+
+    ed = scene.sequence_editor_create()
+    strips = ed.sequences
+
+    for channel in range(1, NUM_CHANNELS + 1):
+        color = strips.new_effect(f"Color {channel}", 'COLOR', channel, 1, frame_end=NUM_FRAMES + 1)
+        color.color = (channel / NUM_CHANNELS, 0.5, 1.0 - channel / NUM_CHANNELS)
+        color.blend_type = 'ADD' if channel > 1 else 'REPLACE'
+        color.blend_alpha = 0.5
+        color.transform.offset_x = channel * 40
+        color.transform.rotation = channel * 0.1
+        color.keyframe_insert("blend_alpha", frame=1)
+        color.blend_alpha = 1.0
+        color.keyframe_insert("blend_alpha", frame=NUM_FRAMES)
+
+    blur = strips.new_effect("Blur", 'GAUSSIAN_BLUR', NUM_CHANNELS + 1, 1,
+                             frame_end=NUM_FRAMES + 1, seq1=strips[f"Color {NUM_CHANNELS}"])
+    blur.size_x = 20.0
+    blur.size_y = 20.0
+
+    text = strips.new_effect("Text", 'TEXT', NUM_CHANNELS + 2, 1, frame_end=NUM_FRAMES + 1)
+    text.text = "Prefetch"
+    text.font_size = 200
+    text.blend_type = 'ALPHA_OVER'
+
+    ed.use_prefetch = True
+    ed.use_cache_raw = True
+    ed.use_cache_preprocessed = True
+    ed.use_cache_composite = True
+    ed.use_cache_final = True
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.context.preferences.system.memory_cache_limit = 16384
+
+    scene = bpy.context.scene
+    _build_timeline(scene)
+    scene.sequence_editor.use_prefetch_parallel = args['parallel']
+
+    # Show the timeline in a sequencer preview, drawing it starts prefetching.
+    window = bpy.context.window_manager.windows[0]
+    area = max(window.screen.areas, key=lambda area: area.width * area.height)
+    area.type = 'SEQUENCE_EDITOR'
+    area.spaces[0].view_type = 'PREVIEW'
+    area.spaces[0].proxy_render_size = 'FULL'
+
+    start_time = time.perf_counter()
+
+    def timer():
+        if time.perf_counter() - start_time > TIMEOUT_SECONDS:
+            bpy.ops.wm.quit_blender()
+            return None
+        area.tag_redraw()
+        return 1.0
+
+    bpy.app.timers.register(timer, first_interval=1.0)
+
+
+if __name__ == '__main__':
+    _run({'parallel': True})
+
+else:
+    import api
+
+    class SequencerPrefetchTest(api.Test):
+        def __init__(self, num_threads):
+            self.num_threads = num_threads
+
+        def name(self):
+            return 'single' if self.num_threads == 1 else f'parallel_{self.num_threads}_threads'
+
+        def category(self):
+            return "sequencer_prefetch"
+
+        def use_background(self):
+            return False
+
+        def run(self, env, device_id):
+            args = {'parallel': self.num_threads > 1}
+            blender_args = ['--log', 'seq.prefetch', '--log-level', '1']
+            system_threads = PREFETCH_THREADS[self.num_threads]
+            if system_threads:
+                blender_args += ['--threads', str(system_threads)]
+            _, log = env.run_in_blender(_run, args, blender_args, foreground=True)
+
+            result = None
+            for line in log:
+                match = LOG_PATTERN.search(line)
+                if match:
+                    num_frames = int(match.group(1))
+                    seconds = float(match.group(2))
+                    if int(match.group(3)) != self.num_threads:
+                        raise Exception(f"Prefetch used {match.group(3)} threads, expected {self.num_threads}.")
+                    result = {'time': seconds / num_frames, 'fps': float(match.group(4))}
+
+            if not result:
+                raise Exception("No prefetch performance result found in log.")
+
+            return result
+
+    def generate(env):
+        return [SequencerPrefetchTest(num_threads) for num_threads in PREFETCH_THREADS]
@@ -0,0 +1,79 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Sequencer render to movie benchmark.
+#
+# A timeline of color and text strips is rendered to a movie file. Rendering
+# each frame is cheap, so the time per frame is dominated by converting the
+# frames to the codec pixel format and encoding them.
+
+CODECS = (('H264', 'MPEG4'), ('DNXHD', 'QUICKTIME'), ('FFV1', 'MKV'))
+
+NUM_FRAMES = 120
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    ed = scene.sequence_editor_create()
+    color = ed.sequences.new_effect("Color", 'COLOR', 1, 1, frame_end=NUM_FRAMES + 1)
+    color.color = (0.2, 0.4, 0.8)
+    color.keyframe_insert("color", frame=1)
+    color.color = (0.8, 0.3, 0.1)
+    color.keyframe_insert("color", frame=NUM_FRAMES)
+
+    text = ed.sequences.new_effect("Text", 'TEXT', 2, 1, frame_end=NUM_FRAMES + 1)
+    text.text = "Render to movie"
+    text.font_size = 120
+    text.location = (0.0, 0.5)
+    text.keyframe_insert("location", frame=1)
+    text.location = (1.0, 0.5)
+    text.keyframe_insert("location", frame=NUM_FRAMES)
+
+    scene.render.filepath = args['movie_filepath']
+    scene.render.use_file_extension = False
+    scene.render.image_settings.file_format = 'FFMPEG'
+    scene.render.ffmpeg.format = args['format']
+    scene.render.ffmpeg.codec = args['codec']
+
+    start_time = time.perf_counter()
+    bpy.ops.render.render(animation=True)
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time / NUM_FRAMES}
+
+
+class SequencerRenderMovieTest(api.Test):
+    def __init__(self, codec, container):
+        self.codec = codec
+        self.container = container
+
+    def name(self):
+        return self.codec.lower()
+
+    def category(self):
+        return "sequencer_render_movie"
+
+    def run(self, env, device_id):
+        args = {'codec': self.codec,
+                'format': self.container,
+                'movie_filepath': str(env.log_file.parent / (env.log_file.stem + '_' + self.codec.lower()))}
+
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [SequencerRenderMovieTest(codec, container) for codec, container in CODECS]
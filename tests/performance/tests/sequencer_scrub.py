@@ -0,0 +1,114 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Movie strip scrubbing benchmark.
+#
+# A long-GOP H.264 clip is encoded, then its frames are rendered through the
+# sequencer in forward, reverse and random order. Without proxies, every
+# non-sequential frame requires seeking to the previous key frame and decoding
+# up to the requested frame, which dominates the time per frame.
+
+MODES = ('forward', 'reverse', 'random')
+
+NUM_FRAMES = 120
+GOP_SIZE = 120
+
+
+def _encode_clip(filepath):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    ed = scene.sequence_editor_create()
+    color = ed.sequences.new_effect("Color", 'COLOR', 1, 1, frame_end=NUM_FRAMES + 1)
+    color.color = (0.2, 0.4, 0.8)
+    color.keyframe_insert("color", frame=1)
+    color.color = (0.8, 0.3, 0.1)
+    color.keyframe_insert("color", frame=NUM_FRAMES)
+
+    text = ed.sequences.new_effect("Text", 'TEXT', 2, 1, frame_end=NUM_FRAMES + 1)
+    text.text = "Scrubbing"
+    text.font_size = 160
+    text.location = (0.0, 0.5)
+    text.keyframe_insert("location", frame=1)
+    text.location = (1.0, 0.5)
+    text.keyframe_insert("location", frame=NUM_FRAMES)
+
+    scene.render.filepath = filepath
+    scene.render.use_file_extension = False
+    scene.render.image_settings.file_format = 'FFMPEG'
+    scene.render.ffmpeg.format = 'MPEG4'
+    scene.render.ffmpeg.codec = 'H264'
+    scene.render.ffmpeg.gopsize = GOP_SIZE
+    scene.render.ffmpeg.use_max_b_frames = True
+    scene.render.ffmpeg.max_b_frames = 2
+    scene.render.ffmpeg.constant_rate_factor = 'HIGH'
+
+    bpy.ops.render.render(animation=True)
+
+
+def _run(args):
+    import bpy
+    import random
+    import time
+
+    _encode_clip(args['movie_filepath'])
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    ed = scene.sequence_editor_create()
+    ed.sequences.new_movie("Movie", args['movie_filepath'], 1, 1)
+    scene.render.filepath = args['render_filepath']
+    scene.render.image_settings.file_format = 'PNG'
+
+    frames = list(range(scene.frame_start, scene.frame_end + 1))
+    if args['mode'] == 'reverse':
+        frames.reverse()
+    elif args['mode'] == 'random':
+        random.Random(0).shuffle(frames)
+
+    start_time = time.perf_counter()
+    for frame in frames:
+        scene.frame_set(frame)
+        bpy.ops.render.render()
+    elapsed_time = time.perf_counter() - start_time
+
+    return {'time': elapsed_time / len(frames)}
+
+
+class SequencerScrubTest(api.Test):
+    def __init__(self, mode):
+        self.mode = mode
+
+    def name(self):
+        return self.mode
+
+    def category(self):
+        return "sequencer_scrub"
+
+    def run(self, env, device_id):
+        args = {'mode': self.mode,
+                'movie_filepath': str(env.log_file.parent / (env.log_file.stem + '.mp4')),
+                'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
+
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [SequencerScrubTest(mode) for mode in MODES]
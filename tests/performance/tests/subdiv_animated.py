@@ -0,0 +1,110 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Animated subdivision surface benchmark.
+#
+# A cylinder deformed by an animated armature, like a limb of a rigged
+# character, has a subdivision surface modifier after the armature. Copies of
+# the object sharing the same mesh have the same topology. The time to create
+# the subdivision surfaces on the first frame and to evaluate every following
+# frame is measured.
+
+SCENES = {
+    'single': {'objects_num': 1},
+    'instances': {'objects_num': 8},
+}
+
+NUM_FRAMES = 20
+
+SUBDIVISION_LEVELS = 2
+
+
+def _prepare_scene(args):
+    import bpy
+    import math
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+    scene.frame_start = 1
+    scene.frame_end = NUM_FRAMES
+
+    bpy.ops.mesh.primitive_cylinder_add(vertices=256, depth=4.0, location=(0.0, 0.0, 2.0))
+    ob = bpy.context.object
+    bpy.ops.object.mode_set(mode='EDIT')
+    bpy.ops.mesh.select_all(action='SELECT')
+    bpy.ops.mesh.subdivide(number_cuts=63)
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    bpy.ops.object.armature_add(enter_editmode=True, location=(0.0, 0.0, 0.0))
+    rig = bpy.context.object
+    lower_bone = rig.data.edit_bones[0]
+    lower_bone.head = (0.0, 0.0, 0.0)
+    lower_bone.tail = (0.0, 0.0, 2.0)
+    upper_bone = rig.data.edit_bones.new("Upper")
+    upper_bone.head = (0.0, 0.0, 2.0)
+    upper_bone.tail = (0.0, 0.0, 4.0)
+    upper_bone.parent = lower_bone
+    upper_bone.use_connect = True
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    pose_bone = rig.pose.bones["Upper"]
+    pose_bone.rotation_mode = 'XYZ'
+    for frame, angle in ((1, 0.0), (NUM_FRAMES // 2, 90.0), (NUM_FRAMES, 0.0)):
+        pose_bone.rotation_euler.x = math.radians(angle)
+        pose_bone.keyframe_insert("rotation_euler", frame=frame)
+
+    bpy.ops.object.select_all(action='DESELECT')
+    ob.select_set(True)
+    rig.select_set(True)
+    bpy.context.view_layer.objects.active = rig
+    bpy.ops.object.parent_set(type='ARMATURE_AUTO')
+
+    subsurf = ob.modifiers.new("Subdivision", 'SUBSURF')
+    subsurf.levels = SUBDIVISION_LEVELS
+
+    for i in range(1, args['objects_num']):
+        copy = ob.copy()
+        copy.location.x = i * 3.0
+        scene.collection.objects.link(copy)
+
+
+def _run(args):
+    import bpy
+    import time
+
+    _prepare_scene(args)
+    scene = bpy.context.scene
+
+    start = time.perf_counter()
+    scene.frame_set(1)
+    first_frame_time = time.perf_counter() - start
+
+    start = time.perf_counter()
+    for frame in range(2, NUM_FRAMES + 1):
+        scene.frame_set(frame)
+    frames_time = time.perf_counter() - start
+
+    return {'time': frames_time / (NUM_FRAMES - 1),
+            'first_frame_time': first_frame_time}
+
+
+class SubdivAnimatedTest(api.Test):
+    def __init__(self, scene_name):
+        self.scene_name = scene_name
+
+    def name(self):
+        return self.scene_name
+
+    def category(self):
+        return "subdiv_animated"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, SCENES[self.scene_name])
+        return result
+
+
+def generate(env):
+    return [SubdivAnimatedTest(scene_name) for scene_name in SCENES]
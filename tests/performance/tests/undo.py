@@ -0,0 +1,82 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Global undo benchmark.
+#
+# A scene with many objects and large meshes is created, then a single object
+# is moved before every undo push. The time of the undo pushes is measured,
+# and the time to undo and redo all of them.
+
+SCENES = {
+    'many_objects': {'objects_num': 2000, 'subdivisions': 10},
+    'large_meshes': {'objects_num': 20, 'subdivisions': 500},
+}
+
+NUM_STEPS = 10
+
+
+def _prepare_scene(args):
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    subdivisions = args['subdivisions']
+    for i in range(args['objects_num']):
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=subdivisions,
+                                        y_subdivisions=subdivisions,
+                                        location=(i * 2.5, 0.0, 0.0))
+    return scene.objects[0]
+
+
+def _run(args):
+    import bpy
+    import time
+
+    ob = _prepare_scene(args)
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    push_time = 0.0
+    for i in range(NUM_STEPS):
+        ob.location.z = i + 1.0
+        start = time.perf_counter()
+        bpy.ops.ed.undo_push(message="Move")
+        push_time += time.perf_counter() - start
+
+    start = time.perf_counter()
+    for _ in range(NUM_STEPS):
+        bpy.ops.ed.undo()
+    undo_time = time.perf_counter() - start
+
+    start = time.perf_counter()
+    for _ in range(NUM_STEPS):
+        bpy.ops.ed.redo()
+    redo_time = time.perf_counter() - start
+
+    return {'time': push_time / NUM_STEPS,
+            'undo_time': undo_time / NUM_STEPS,
+            'redo_time': redo_time / NUM_STEPS}
+
+
+class UndoTest(api.Test):
+    def __init__(self, scene_name):
+        self.scene_name = scene_name
+
+    def name(self):
+        return self.scene_name
+
+    def category(self):
+        return "undo"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, SCENES[self.scene_name])
+        return result
+
+
+def generate(env):
+    return [UndoTest(scene_name) for scene_name in SCENES]
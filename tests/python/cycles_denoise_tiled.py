@@ -0,0 +1,104 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+./blender.bin --background --factory-startup --python tests/python/cycles_denoise_tiled.py
+"""
+
+import array
+import math
+import os
+import tempfile
+import unittest
+
+import bpy
+
+RESOLUTION = 512
+
+# Denoising memory limit in megabytes which makes the denoiser use its minimum tile size.
+TILED_MEMORY_LIMIT = 1
+TILE_SIZE = 64
+
+
+def prepare_scene():
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_plane_add(size=20.0)
+    for i in range(5):
+        bpy.ops.mesh.primitive_uv_sphere_add(radius=0.6, location=(i * 1.5 - 3.0, 0.0, 0.6))
+        bpy.ops.object.shade_smooth()
+    bpy.ops.object.light_add(type='AREA', location=(0.0, -2.0, 4.0))
+    bpy.context.object.data.energy = 500.0
+    bpy.ops.object.camera_add(location=(0.0, -8.0, 4.0), rotation=(math.radians(65.0), 0.0, 0.0))
+    scene.camera = bpy.context.object
+
+    scene.render.engine = 'CYCLES'
+    scene.render.resolution_x = RESOLUTION
+    scene.render.resolution_y = RESOLUTION
+    scene.render.resolution_percentage = 100
+    scene.render.image_settings.file_format = 'OPEN_EXR'
+    scene.cycles.device = 'CPU'
+    scene.cycles.samples = 8
+    scene.cycles.seed = 0
+    scene.cycles.use_adaptive_sampling = False
+    scene.cycles.use_denoising = True
+    scene.cycles.denoiser = 'OPENIMAGEDENOISE'
+    scene.cycles.denoising_input_passes = 'RGB_ALBEDO_NORMAL'
+    # Accurate prefiltering denoises the albedo and normal passes of every tile as well.
+    scene.cycles.denoising_prefilter = 'ACCURATE'
+    scene.cycles.denoising_use_gpu = False
+
+
+def render_pixels(filepath, max_memory):
+    scene = bpy.context.scene
+    scene.cycles.denoising_max_memory = max_memory
+    scene.render.filepath = filepath
+    bpy.ops.render.render(write_still=True)
+
+    image = bpy.data.images.load(filepath)
+    pixels = array.array('f', [0.0]) * (len(image.pixels))
+    image.pixels.foreach_get(pixels)
+    bpy.data.images.remove(image)
+    return pixels
+
+
+class CyclesDenoiseTiledTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        prepare_scene()
+        with tempfile.TemporaryDirectory() as temp_dir:
+            cls.full = render_pixels(os.path.join(temp_dir, "full.exr"), 0)
+            cls.tiled = render_pixels(os.path.join(temp_dir, "tiled.exr"), TILED_MEMORY_LIMIT)
+
+    def _difference(self, x, y):
+        index = (y * RESOLUTION + x) * 4
+        return max(abs(self.full[index + c] - self.tiled[index + c]) for c in range(3))
+
+    def test_matches_full_frame(self):
+        differences = [self._difference(x, y)
+                       for y in range(RESOLUTION)
+                       for x in range(RESOLUTION)]
+        self.assertLess(sum(differences) / len(differences), 0.005)
+
+    def test_no_seams(self):
+        # Pixels on both sides of the tile borders are denoised by different tiles, they are to
+        # match the full frame denoising as well as pixels inside of the tiles.
+        seam_differences = []
+        inner_differences = []
+        for y in range(RESOLUTION):
+            for x in range(RESOLUTION):
+                if x % TILE_SIZE in {0, TILE_SIZE - 1} or y % TILE_SIZE in {0, TILE_SIZE - 1}:
+                    seam_differences.append(self._difference(x, y))
+                else:
+                    inner_differences.append(self._difference(x, y))
+        seam_mean = sum(seam_differences) / len(seam_differences)
+        inner_mean = sum(inner_differences) / len(inner_differences)
+        self.assertLess(seam_mean, inner_mean * 2.0 + 1e-4)
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()